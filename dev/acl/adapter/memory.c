@@ -471,8 +471,7 @@ PHP_METHOD(Phalcon_Acl_Adapter_Memory, addResourceAccess){
 				goto fee_c945_0;
 			}
 			
-			PHALCON_INIT_VAR(access_name);
-			ZVAL_ZVAL(access_name, *hd, 1, 0);
+			PHALCON_GET_FOREACH_VALUE(access_name);
 			PHALCON_INIT_VAR(t1);
 			phalcon_read_property(&t1, this_ptr, SL("_accessList"), PH_NOISY_CC);
 			PHALCON_INIT_VAR(r1);
@@ -545,8 +544,7 @@ PHP_METHOD(Phalcon_Acl_Adapter_Memory, dropResourceAccess){
 				goto fee_c945_1;
 			}
 			
-			PHALCON_INIT_VAR(access_name);
-			ZVAL_ZVAL(access_name, *hd, 1, 0);
+			PHALCON_GET_FOREACH_VALUE(access_name);
 			PHALCON_INIT_VAR(t0);
 			phalcon_read_property(&t0, this_ptr, SL("_accessList"), PH_NOISY_CC);
 			PHALCON_INIT_VAR(r0);
@@ -631,8 +629,7 @@ PHP_METHOD(Phalcon_Acl_Adapter_Memory, _allowOrDeny){
 				goto fee_c945_2;
 			}
 			
-			PHALCON_INIT_VAR(access_name);
-			ZVAL_ZVAL(access_name, *hd, 1, 0);
+			PHALCON_GET_FOREACH_VALUE(access_name);
 			PHALCON_INIT_VAR(t2);
 			phalcon_read_property(&t2, this_ptr, SL("_accessList"), PH_NOISY_CC);
 			PHALCON_INIT_VAR(r2);
@@ -663,8 +660,7 @@ PHP_METHOD(Phalcon_Acl_Adapter_Memory, _allowOrDeny){
 				goto fee_c945_3;
 			}
 			
-			PHALCON_INIT_VAR(access_name);
-			ZVAL_ZVAL(access_name, *hd, 1, 0);
+			PHALCON_GET_FOREACH_VALUE(access_name);
 			PHALCON_INIT_VAR(t3);
 			phalcon_read_property(&t3, this_ptr, SL("_access"), PH_NOISY_CC);
 			if (Z_TYPE_P(t3) == IS_ARRAY) {
@@ -951,8 +947,7 @@ PHP_METHOD(Phalcon_Acl_Adapter_Memory, isAllowed){
 		
 		PHALCON_INIT_VAR(resource_name);
 		PHALCON_GET_FOREACH_KEY(resource_name, ah0, hp0);
-		PHALCON_INIT_VAR(resource_access);
-		ZVAL_ZVAL(resource_access, *hd, 1, 0);
+		PHALCON_GET_FOREACH_VALUE(resource_access);
 		PHALCON_INIT_VAR(r0);
 		is_equal_function(r0, resource_name, resource TSRMLS_CC);
 		if (zend_is_true(r0)) {
@@ -987,8 +982,7 @@ PHP_METHOD(Phalcon_Acl_Adapter_Memory, isAllowed){
 		
 		PHALCON_INIT_VAR(resource_name);
 		PHALCON_GET_FOREACH_KEY(resource_name, ah1, hp1);
-		PHALCON_INIT_VAR(resource_access);
-		ZVAL_ZVAL(resource_access, *hd, 1, 0);
+		PHALCON_GET_FOREACH_VALUE(resource_access);
 		eval_int = phalcon_array_isset_string(resource_access, SL("*")+1);
 		if (eval_int) {
 			eval_int = phalcon_array_isset(resource_access, access);
@@ -1076,8 +1070,7 @@ PHP_METHOD(Phalcon_Acl_Adapter_Memory, _rebuildAccessList){
 			
 			PHALCON_INIT_VAR(role_name);
 			PHALCON_GET_FOREACH_KEY(role_name, ah0, hp0);
-			PHALCON_INIT_VAR(one);
-			ZVAL_ZVAL(one, *hd, 1, 0);
+			PHALCON_GET_FOREACH_VALUE(one);
 			PHALCON_INIT_VAR(t3);
 			phalcon_read_property(&t3, this_ptr, SL("_roleInherits"), PH_NOISY_CC);
 			eval_int = phalcon_array_isset(t3, role_name);
@@ -1097,8 +1090,7 @@ PHP_METHOD(Phalcon_Acl_Adapter_Memory, _rebuildAccessList){
 						goto fee_c945_8;
 					}
 					
-					PHALCON_INIT_VAR(role_inherit);
-					ZVAL_ZVAL(role_inherit, *hd, 1, 0);
+					PHALCON_GET_FOREACH_VALUE(role_inherit);
 					PHALCON_INIT_VAR(t5);
 					phalcon_read_property(&t5, this_ptr, SL("_access"), PH_NOISY_CC);
 					eval_int = phalcon_array_isset(t5, role_inherit);
@@ -1120,8 +1112,7 @@ PHP_METHOD(Phalcon_Acl_Adapter_Memory, _rebuildAccessList){
 							
 							PHALCON_INIT_VAR(resource_name);
 							PHALCON_GET_FOREACH_KEY(resource_name, ah2, hp2);
-							PHALCON_INIT_VAR(access);
-							ZVAL_ZVAL(access, *hd, 1, 0);
+							PHALCON_GET_FOREACH_VALUE(access);
 							if (!phalcon_valid_foreach(access TSRMLS_CC)) {
 								return;
 							}
@@ -1135,8 +1126,7 @@ PHP_METHOD(Phalcon_Acl_Adapter_Memory, _rebuildAccessList){
 								
 								PHALCON_INIT_VAR(name);
 								PHALCON_GET_FOREACH_KEY(name, ah3, hp3);
-								PHALCON_INIT_VAR(value);
-								ZVAL_ZVAL(value, *hd, 1, 0);
+								PHALCON_GET_FOREACH_VALUE(value);
 								PHALCON_INIT_VAR(t7);
 								phalcon_read_property(&t7, this_ptr, SL("_access"), PH_NOISY_CC);
 								if (Z_TYPE_P(t7) == IS_ARRAY) {
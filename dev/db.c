@@ -37,6 +37,9 @@
 #include "kernel/array.h"
 #include "kernel/exception.h"
 #include "kernel/concat.h"
+#include "kernel/operators.h"
+
+#include "ext/standard/php_smart_str.h"
 
 /**
  * Phalcon\Db
@@ -53,6 +56,76 @@
  * 
  */
 
+/**
+ * Appends a string to a SQL template key prefixed by its length, so different pieces never produce the same key
+ */
+static void phalcon_db_template_key(smart_str *key, char *str, uint str_length){
+	smart_str_append_long(key, str_length);
+	smart_str_appendc(key, ':');
+	smart_str_appendl(key, str, str_length);
+}
+
+/**
+ * Returns the SQL statement compiled for a template key or NULL when it wasn't compiled yet
+ */
+static zval *phalcon_db_get_template(zval *this_ptr, char *key, uint key_length TSRMLS_DC){
+
+	zval *templates;
+	zval **sql;
+
+	templates = zend_read_property(phalcon_db_ce, this_ptr, SL("_sqlTemplates"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(templates) == IS_ARRAY) {
+		if (zend_hash_find(Z_ARRVAL_P(templates), key, key_length + 1, (void**) &sql) == SUCCESS) {
+			return *sql;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Stores the SQL statement compiled for a template key. The oldest template is dropped when the limit is reached
+ */
+static void phalcon_db_set_template(zval *this_ptr, char *key, uint key_length, zval *sql TSRMLS_DC){
+
+	zval *templates, *limit, *copy;
+	char *str_index;
+	uint str_index_length;
+	ulong num_index;
+	long templates_limit;
+
+	limit = zend_read_property(phalcon_db_ce, this_ptr, SL("_sqlTemplatesLimit"), 1 TSRMLS_CC);
+	templates_limit = Z_TYPE_P(limit) == IS_LONG ? Z_LVAL_P(limit) : 0;
+	if (templates_limit <= 0 || Z_TYPE_P(sql) != IS_STRING) {
+		return;
+	}
+
+	templates = zend_read_property(phalcon_db_ce, this_ptr, SL("_sqlTemplates"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(templates) != IS_ARRAY || Z_REFCOUNT_P(templates) > 1) {
+		ALLOC_INIT_ZVAL(copy);
+		array_init(copy);
+		if (Z_TYPE_P(templates) == IS_ARRAY) {
+			zend_hash_copy(Z_ARRVAL_P(copy), Z_ARRVAL_P(templates), (copy_ctor_func_t) zval_add_ref, NULL, sizeof(zval *));
+		}
+		zend_update_property(phalcon_db_ce, this_ptr, SL("_sqlTemplates"), copy TSRMLS_CC);
+		zval_ptr_dtor(&copy);
+		templates = copy;
+	}
+
+	while (zend_hash_num_elements(Z_ARRVAL_P(templates)) >= (uint) templates_limit) {
+		zend_hash_internal_pointer_reset(Z_ARRVAL_P(templates));
+		if (zend_hash_get_current_key_ex(Z_ARRVAL_P(templates), &str_index, &str_index_length, &num_index, 0, NULL) == HASH_KEY_IS_STRING) {
+			zend_hash_del(Z_ARRVAL_P(templates), str_index, str_index_length);
+		} else {
+			zend_hash_index_del(Z_ARRVAL_P(templates), num_index);
+		}
+	}
+
+	ALLOC_INIT_ZVAL(copy);
+	ZVAL_STRINGL(copy, Z_STRVAL_P(sql), Z_STRLEN_P(sql), 1);
+	zend_hash_update(Z_ARRVAL_P(templates), key, key_length + 1, &copy, sizeof(zval *), NULL);
+}
+
 /**
  * Phalcon\Db constructor
  *
@@ -110,17 +183,19 @@ PHP_METHOD(Phalcon_Db, setEventsManager){
  *
  * @param string $sqlQuery
  * @param int $fetchMode
+ * @param array $placeholders
+ * @param array $dataTypes
  * @return array
  */
 PHP_METHOD(Phalcon_Db, fetchOne){
 
-	zval *sql_query = NULL, *fetch_mode = NULL, *result = NULL;
+	zval *sql_query = NULL, *fetch_mode = NULL, *placeholders = NULL, *data_types = NULL, *result = NULL;
 	zval *r0 = NULL;
 	zval *a0 = NULL;
 
 	PHALCON_MM_GROW();
 	
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &sql_query, &fetch_mode) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|zzz", &sql_query, &fetch_mode, &placeholders, &data_types) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
@@ -130,8 +205,18 @@ PHP_METHOD(Phalcon_Db, fetchOne){
 		ZVAL_LONG(fetch_mode, 2);
 	}
 	
+	if (!placeholders) {
+		PHALCON_ALLOC_ZVAL_MM(placeholders);
+		ZVAL_NULL(placeholders);
+	}
+	
+	if (!data_types) {
+		PHALCON_ALLOC_ZVAL_MM(data_types);
+		ZVAL_NULL(data_types);
+	}
+	
 	PHALCON_INIT_VAR(result);
-	PHALCON_CALL_METHOD_PARAMS_1(result, this_ptr, "query", sql_query, PH_NO_CHECK);
+	PHALCON_CALL_METHOD_PARAMS_3(result, this_ptr, "query", sql_query, placeholders, data_types, PH_NO_CHECK);
 	if (Z_TYPE_P(result) == IS_OBJECT) {
 		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(result, "setfetchmode", fetch_mode, PH_NO_CHECK);
 		
@@ -151,17 +236,19 @@ PHP_METHOD(Phalcon_Db, fetchOne){
  *
  * @param string $sqlQuery
  * @param int $fetchMode
+ * @param array $placeholders
+ * @param array $dataTypes
  * @return array
  */
 PHP_METHOD(Phalcon_Db, fetchAll){
 
-	zval *sql_query = NULL, *fetch_mode = NULL, *results = NULL, *result = NULL;
+	zval *sql_query = NULL, *fetch_mode = NULL, *placeholders = NULL, *data_types = NULL, *results = NULL, *result = NULL;
 	zval *row = NULL;
 	zval *r0 = NULL;
 
 	PHALCON_MM_GROW();
 	
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &sql_query, &fetch_mode) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|zzz", &sql_query, &fetch_mode, &placeholders, &data_types) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
@@ -171,11 +258,21 @@ PHP_METHOD(Phalcon_Db, fetchAll){
 		ZVAL_LONG(fetch_mode, 2);
 	}
 	
+	if (!placeholders) {
+		PHALCON_ALLOC_ZVAL_MM(placeholders);
+		ZVAL_NULL(placeholders);
+	}
+	
+	if (!data_types) {
+		PHALCON_ALLOC_ZVAL_MM(data_types);
+		ZVAL_NULL(data_types);
+	}
+	
 	PHALCON_INIT_VAR(results);
 	array_init(results);
 	
 	PHALCON_INIT_VAR(result);
-	PHALCON_CALL_METHOD_PARAMS_1(result, this_ptr, "query", sql_query, PH_NO_CHECK);
+	PHALCON_CALL_METHOD_PARAMS_3(result, this_ptr, "query", sql_query, placeholders, data_types, PH_NO_CHECK);
 	if (Z_TYPE_P(result) == IS_OBJECT) {
 		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(result, "setfetchmode", fetch_mode, PH_NO_CHECK);
 		ws_e7f0_0:
@@ -207,7 +304,7 @@ PHP_METHOD(Phalcon_Db, fetchAll){
 PHP_METHOD(Phalcon_Db, insert){
 
 	zval *table = NULL, *values = NULL, *fields = NULL, *placeholders = NULL, *value = NULL;
-	zval *n = NULL, *comma = NULL, *joined_values = NULL, *insert_sql = NULL;
+	zval *n = NULL, *comma = NULL, *joined_values = NULL, *insert_sql = NULL, *template = NULL;
 	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL, *r4 = NULL;
 	zval *i0 = NULL;
 	HashTable *ah0;
@@ -217,6 +314,8 @@ PHP_METHOD(Phalcon_Db, insert){
 	uint hash_index_len;
 	ulong hash_num;
 	int hash_type;
+	smart_str key = {0};
+	int cacheable;
 
 	PHALCON_MM_GROW();
 	
@@ -251,6 +350,31 @@ PHP_METHOD(Phalcon_Db, insert){
 			return;
 		}
 		
+		/** 
+		 * The statement only depends on the table, the fields and which values are raw SQL, so it is compiled once per shape
+		 */
+		cacheable = Z_TYPE_P(table) == IS_STRING;
+		if (cacheable) {
+			smart_str_appendc(&key, 'I');
+			phalcon_db_template_key(&key, Z_STRVAL_P(table), Z_STRLEN_P(table));
+			if (Z_TYPE_P(fields) == IS_ARRAY) { 
+				zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(fields), &hp0);
+				while (zend_hash_get_current_data_ex(Z_ARRVAL_P(fields), (void**) &hd, &hp0) == SUCCESS) {
+					if (Z_TYPE_PP(hd) != IS_STRING) {
+						cacheable = 0;
+						break;
+					}
+					phalcon_db_template_key(&key, Z_STRVAL_PP(hd), Z_STRLEN_PP(hd));
+					zend_hash_move_forward_ex(Z_ARRVAL_P(fields), &hp0);
+				}
+			} else {
+				if (Z_TYPE_P(fields) != IS_NULL) {
+					cacheable = 0;
+				}
+			}
+			smart_str_appendc(&key, '|');
+		}
+		
 		ALLOC_HASHTABLE(ah0);
 		zend_hash_init(ah0, 0, NULL, NULL, 0);
 		zend_hash_copy(ah0, Z_ARRVAL_P(values), NULL, NULL, sizeof(zval*));
@@ -266,33 +390,59 @@ PHP_METHOD(Phalcon_Db, insert){
 			ZVAL_ZVAL(value, *hd, 1, 0);
 			if (Z_TYPE_P(value) == IS_OBJECT) {
 				PHALCON_INIT_VAR(r2);
-				PHALCON_CALL_FUNC_PARAMS_1(r2, "strval", value);
+				ZVAL_ZVAL(r2, value, 1, 0);
+				convert_to_string(r2);
 				phalcon_array_append(&placeholders, r2, PH_SEPARATE TSRMLS_CC);
 				PHALCON_SEPARATE_PARAM(values);
 				phalcon_array_unset(values, n);
+				if (cacheable && Z_TYPE_P(r2) == IS_STRING) {
+					smart_str_appendc(&key, 'r');
+					phalcon_db_template_key(&key, Z_STRVAL_P(r2), Z_STRLEN_P(r2));
+				} else {
+					cacheable = 0;
+				}
 			} else {
 				phalcon_array_append_string(&placeholders, SL("?"), PH_SEPARATE TSRMLS_CC);
+				if (cacheable) {
+					smart_str_appendc(&key, '?');
+				}
 			}
 			zend_hash_move_forward_ex(ah0, &hp0);
 			goto fes_e7f0_1;
 		fee_e7f0_1:
 		zend_hash_destroy(ah0);
 		efree(ah0);
+		smart_str_0(&key);
 		
-		PHALCON_INIT_VAR(comma);
-		ZVAL_STRING(comma, ", ", 1);
+		PHALCON_INIT_VAR(insert_sql);
+		ZVAL_NULL(insert_sql);
+		if (cacheable) {
+			template = phalcon_db_get_template(this_ptr, key.c, key.len TSRMLS_CC);
+			if (template) {
+				ZVAL_ZVAL(insert_sql, template, 1, 0);
+			}
+		}
 		
-		PHALCON_INIT_VAR(joined_values);
-		phalcon_fast_join(joined_values, comma, placeholders TSRMLS_CC);
-		if (Z_TYPE_P(fields) == IS_ARRAY) { 
-			PHALCON_ALLOC_ZVAL_MM(r3);
-			phalcon_fast_join(r3, comma, fields TSRMLS_CC);
-			PHALCON_INIT_VAR(insert_sql);
-			PHALCON_CONCAT_SVSVSVS(insert_sql, "INSERT INTO ", table, " (", r3, ") VALUES (", joined_values, ")");
-		} else {
-			PHALCON_INIT_VAR(insert_sql);
-			PHALCON_CONCAT_SVSVS(insert_sql, "INSERT INTO ", table, " VALUES (", joined_values, ")");
+		if (Z_TYPE_P(insert_sql) == IS_NULL) {
+			PHALCON_INIT_VAR(comma);
+			ZVAL_STRING(comma, ", ", 1);
+			
+			PHALCON_INIT_VAR(joined_values);
+			phalcon_fast_join(joined_values, comma, placeholders TSRMLS_CC);
+			if (Z_TYPE_P(fields) == IS_ARRAY) { 
+				PHALCON_ALLOC_ZVAL_MM(r3);
+				phalcon_fast_join(r3, comma, fields TSRMLS_CC);
+				PHALCON_INIT_VAR(insert_sql);
+				PHALCON_CONCAT_SVSVSVS(insert_sql, "INSERT INTO ", table, " (", r3, ") VALUES (", joined_values, ")");
+			} else {
+				PHALCON_INIT_VAR(insert_sql);
+				PHALCON_CONCAT_SVSVS(insert_sql, "INSERT INTO ", table, " VALUES (", joined_values, ")");
+			}
+			if (cacheable) {
+				phalcon_db_set_template(this_ptr, key.c, key.len, insert_sql TSRMLS_CC);
+			}
 		}
+		smart_str_free(&key);
 		
 		PHALCON_ALLOC_ZVAL_MM(r4);
 		PHALCON_CALL_METHOD_PARAMS_2(r4, this_ptr, "execute", insert_sql, values, PH_NO_CHECK);
@@ -303,19 +453,375 @@ PHP_METHOD(Phalcon_Db, insert){
 }
 
 /**
- * Updates data on a table using custom RBDM SQL syntax
+ * Sends the rows passed to Phalcon\Db::insertMany in chunks
+ */
+static void phalcon_db_insert_many(zval *return_value, zval *this_ptr, zval *table, zval *rows, zval *fields, zval *options TSRMLS_DC){
+
+	zval *dialect = NULL;
+	zval *max_params = NULL, *option = NULL, *comma = NULL, *joined_fields = NULL;
+	zval *tuples = NULL, *bind_values = NULL, *placeholders = NULL, *raw_value = NULL;
+	zval *joined_placeholders = NULL, *tuple = NULL, *joined_tuples = NULL;
+	zval *insert_sql = NULL, *success = NULL;
+	zval *i0 = NULL;
+	zval *r0 = NULL;
+	zval **row, **value;
+	HashPosition hp0, hp1;
+	long number_values = -1, max_rows = 1000, max_bytes = 1048576;
+	long chunk_rows = 0, chunk_bytes = 0, row_bytes = 0;
+	int eval_int, end;
+
+	PHALCON_MM_GROW();
+	
+	if (Z_TYPE_P(rows) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "The second parameter for insertMany isn't an Array");
+		return;
+	}
+	
+	if (!zend_hash_num_elements(Z_ARRVAL_P(rows))) {
+		PHALCON_ALLOC_ZVAL_MM(i0);
+		object_init_ex(i0, phalcon_db_exception_ce);
+		PHALCON_ALLOC_ZVAL_MM(r0);
+		PHALCON_CONCAT_SVS(r0, "Unable to insert into ", table, " without data");
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(i0, "__construct", r0, PH_CHECK);
+		phalcon_throw_exception(i0 TSRMLS_CC);
+		return;
+	}
+	
+	if (options && Z_TYPE_P(options) == IS_ARRAY) { 
+		eval_int = phalcon_array_isset_string(options, SL("rows")+1);
+		if (eval_int) {
+			PHALCON_INIT_VAR(option);
+			phalcon_array_fetch_string(&option, options, SL("rows"), PH_NOISY_CC);
+			max_rows = phalcon_get_intval(option);
+		}
+		eval_int = phalcon_array_isset_string(options, SL("bytes")+1);
+		if (eval_int) {
+			PHALCON_INIT_VAR(option);
+			phalcon_array_fetch_string(&option, options, SL("bytes"), PH_NOISY_CC);
+			max_bytes = phalcon_get_intval(option);
+		}
+	}
+	
+	/** 
+	 * The dialect knows how many bind parameters can be used in a single statement
+	 */
+	PHALCON_INIT_VAR(max_params);
+	ZVAL_LONG(max_params, 0);
+	
+	PHALCON_INIT_VAR(dialect);
+	phalcon_read_property(&dialect, this_ptr, SL("_dialect"), PH_SILENT_CC);
+	if (Z_TYPE_P(dialect) == IS_OBJECT) {
+		PHALCON_INIT_VAR(max_params);
+		PHALCON_CALL_METHOD(max_params, dialect, "getmaxbindparams", PH_CHECK);
+	}
+	
+	PHALCON_INIT_VAR(comma);
+	ZVAL_STRING(comma, ", ", 1);
+	if (Z_TYPE_P(fields) == IS_ARRAY) { 
+		PHALCON_INIT_VAR(joined_fields);
+		phalcon_fast_join(joined_fields, comma, fields TSRMLS_CC);
+	}
+	
+	PHALCON_INIT_VAR(tuples);
+	array_init(tuples);
+	
+	PHALCON_INIT_VAR(bind_values);
+	array_init(bind_values);
+	
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(rows), &hp0);
+	while (1) {
+		
+		end = zend_hash_get_current_data_ex(Z_ARRVAL_P(rows), (void**) &row, &hp0) != SUCCESS;
+		if (!end) {
+			if (Z_TYPE_PP(row) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_PP(row))) {
+				PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Every row passed to insertMany must be a non empty Array");
+				return;
+			}
+			
+			if (number_values < 0) {
+				number_values = zend_hash_num_elements(Z_ARRVAL_PP(row));
+				if (phalcon_get_intval(max_params) > 0 && max_rows > phalcon_get_intval(max_params) / number_values) {
+					max_rows = phalcon_get_intval(max_params) / number_values;
+				}
+				if (max_rows < 1) {
+					max_rows = 1;
+				}
+			} else {
+				if (zend_hash_num_elements(Z_ARRVAL_PP(row)) != number_values) {
+					PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Every row passed to insertMany must have the same number of values");
+					return;
+				}
+			}
+			
+			/** 
+			 * Raw values are inlined in the statement like Phalcon\Db::insert does
+			 */
+			PHALCON_INIT_VAR(placeholders);
+			array_init(placeholders);
+			row_bytes = 4;
+			
+			zend_hash_internal_pointer_reset_ex(Z_ARRVAL_PP(row), &hp1);
+			while (zend_hash_get_current_data_ex(Z_ARRVAL_PP(row), (void**) &value, &hp1) == SUCCESS) {
+				if (Z_TYPE_PP(value) == IS_OBJECT) {
+					PHALCON_INIT_VAR(raw_value);
+					PHALCON_CALL_FUNC_PARAMS_1(raw_value, "strval", *value);
+					phalcon_array_append(&placeholders, raw_value, PH_SEPARATE TSRMLS_CC);
+					row_bytes += Z_STRLEN_P(raw_value) + 2;
+				} else {
+					phalcon_array_append_string(&placeholders, SL("?"), PH_SEPARATE TSRMLS_CC);
+					row_bytes += (Z_TYPE_PP(value) == IS_STRING ? Z_STRLEN_PP(value) : 8) + 3;
+				}
+				zend_hash_move_forward_ex(Z_ARRVAL_PP(row), &hp1);
+			}
+		}
+		
+		if (chunk_rows && (end || chunk_rows >= max_rows || chunk_bytes + row_bytes > max_bytes)) {
+			PHALCON_INIT_VAR(joined_tuples);
+			phalcon_fast_join(joined_tuples, comma, tuples TSRMLS_CC);
+			
+			PHALCON_INIT_VAR(insert_sql);
+			if (Z_TYPE_P(fields) == IS_ARRAY) { 
+				PHALCON_CONCAT_SVSVSV(insert_sql, "INSERT INTO ", table, " (", joined_fields, ") VALUES ", joined_tuples);
+			} else {
+				PHALCON_CONCAT_SVSV(insert_sql, "INSERT INTO ", table, " VALUES ", joined_tuples);
+			}
+			
+			PHALCON_INIT_VAR(success);
+			PHALCON_CALL_METHOD_PARAMS_2(success, this_ptr, "execute", insert_sql, bind_values, PH_NO_CHECK);
+			if (!zend_is_true(success)) {
+				PHALCON_MM_RESTORE();
+				RETURN_FALSE;
+			}
+			
+			PHALCON_INIT_VAR(tuples);
+			array_init(tuples);
+			
+			PHALCON_INIT_VAR(bind_values);
+			array_init(bind_values);
+			chunk_rows = 0;
+			chunk_bytes = 0;
+		}
+		
+		if (end) {
+			break;
+		}
+		
+		PHALCON_INIT_VAR(joined_placeholders);
+		phalcon_fast_join(joined_placeholders, comma, placeholders TSRMLS_CC);
+		
+		PHALCON_INIT_VAR(tuple);
+		PHALCON_CONCAT_SVS(tuple, "(", joined_placeholders, ")");
+		phalcon_array_append(&tuples, tuple, PH_SEPARATE TSRMLS_CC);
+		
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_PP(row), &hp1);
+		while (zend_hash_get_current_data_ex(Z_ARRVAL_PP(row), (void**) &value, &hp1) == SUCCESS) {
+			if (Z_TYPE_PP(value) != IS_OBJECT) {
+				phalcon_array_append(&bind_values, *value, PH_SEPARATE TSRMLS_CC);
+			}
+			zend_hash_move_forward_ex(Z_ARRVAL_PP(row), &hp1);
+		}
+		
+		chunk_rows++;
+		chunk_bytes += row_bytes;
+		zend_hash_move_forward_ex(Z_ARRVAL_P(rows), &hp0);
+	}
+	
+	PHALCON_MM_RESTORE();
+	RETURN_TRUE;
+}
+
+/**
+ * Inserts many rows into a table using multi-row INSERT statements. Rows are sent in chunks limited by
+ * the 'rows' and 'bytes' options and by the number of bind parameters the dialect accepts in a statement.
+ * Unless a transaction is already open, the statements run inside a transaction so the rows are inserted
+ * all together or none of them is
+ *
+ *<code>
+ * $success = $connection->insertMany(
+ *     "robots",
+ *     array(array("Astro Boy", 1952), array("Terminator", 2029)),
+ *     array("name", "year"),
+ *     array("rows" => 500)
+ * );
+ *</code>
+ *
+ * @param string $table
+ * @param array $rows
+ * @param array $fields
+ * @param array $options
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Db, insertMany){
+
+	zval *table = NULL, *rows = NULL, *fields = NULL, *options = NULL;
+	zval *under_transaction = NULL;
+	int own_transaction;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz|zz", &table, &rows, &fields, &options) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (!fields) {
+		PHALCON_ALLOC_ZVAL_MM(fields);
+		ZVAL_NULL(fields);
+	}
+	
+	PHALCON_INIT_VAR(under_transaction);
+	PHALCON_CALL_METHOD(under_transaction, this_ptr, "isundertransaction", PH_NO_CHECK);
+	own_transaction = !zend_is_true(under_transaction);
+	if (own_transaction) {
+		PHALCON_CALL_METHOD_NORETURN(this_ptr, "begin", PH_NO_CHECK);
+	}
+	
+	phalcon_db_insert_many(return_value, this_ptr, table, rows, fields, options TSRMLS_CC);
+	if (own_transaction) {
+		if (EG(exception) || !zend_is_true(return_value)) {
+			phalcon_call_method_cleanup(this_ptr, SL("rollback"), NULL TSRMLS_CC);
+		} else {
+			PHALCON_CALL_METHOD_NORETURN(this_ptr, "commit", PH_NO_CHECK);
+		}
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Inserts a row or updates it when a row with the same key already exists, using a single statement
+ * generated by the connection's dialect. On MySQL a conflict with any unique index of the table updates
+ * the row, not only a conflict on the key fields. $updateFields limits the fields updated on conflict,
+ * when an identity field is passed lastInsertId() reports the inserted or updated row
+ *
+ *<code>
+ * $success = $connection->upsert(
+ *     "robots",
+ *     array(10, "Astro Boy", 1952),
+ *     array("id", "name", "year"),
+ *     array("id")
+ * );
+ *</code>
+ *
+ * @param string $table
+ * @param array $values
+ * @param array $fields
+ * @param array $keyFields
+ * @param array $updateFields
+ * @param string $identityField
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Db, upsert){
+
+	zval *table = NULL, *values = NULL, *fields = NULL, *key_fields = NULL;
+	zval *update_fields = NULL, *identity_field = NULL;
+	zval *placeholders = NULL, *bind_values = NULL, *raw_value = NULL;
+	zval *dialect = NULL, *upsert_sql = NULL, *success = NULL;
+	zval *i0 = NULL;
+	zval *r0 = NULL;
+	zval *p0[] = { NULL, NULL, NULL, NULL, NULL, NULL };
+	zval **value;
+	HashPosition hp0;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zzzz|zz", &table, &values, &fields, &key_fields, &update_fields, &identity_field) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (!update_fields) {
+		PHALCON_ALLOC_ZVAL_MM(update_fields);
+		ZVAL_NULL(update_fields);
+	}
+	
+	if (!identity_field) {
+		PHALCON_ALLOC_ZVAL_MM(identity_field);
+		ZVAL_NULL(identity_field);
+	}
+
+	if (Z_TYPE_P(values) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "The second parameter for upsert isn't an Array");
+		return;
+	}
+	
+	if (!zend_hash_num_elements(Z_ARRVAL_P(values))) {
+		PHALCON_ALLOC_ZVAL_MM(i0);
+		object_init_ex(i0, phalcon_db_exception_ce);
+		PHALCON_ALLOC_ZVAL_MM(r0);
+		PHALCON_CONCAT_SVS(r0, "Unable to insert into ", table, " without data");
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(i0, "__construct", r0, PH_CHECK);
+		phalcon_throw_exception(i0 TSRMLS_CC);
+		return;
+	}
+	
+	if (Z_TYPE_P(fields) != IS_ARRAY || zend_hash_num_elements(Z_ARRVAL_P(fields)) != zend_hash_num_elements(Z_ARRVAL_P(values))) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "The fields passed to upsert must be an Array with a name for every value");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(dialect);
+	phalcon_read_property(&dialect, this_ptr, SL("_dialect"), PH_SILENT_CC);
+	if (Z_TYPE_P(dialect) != IS_OBJECT) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "The connection doesn't have a dialect to generate the upsert");
+		return;
+	}
+	
+	/** 
+	 * Raw values are inlined in the statement like Phalcon\Db::insert does
+	 */
+	PHALCON_INIT_VAR(placeholders);
+	array_init(placeholders);
+	
+	PHALCON_INIT_VAR(bind_values);
+	array_init(bind_values);
+	
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(values), &hp0);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(values), (void**) &value, &hp0) == SUCCESS) {
+		if (Z_TYPE_PP(value) == IS_OBJECT) {
+			PHALCON_INIT_VAR(raw_value);
+			PHALCON_CALL_FUNC_PARAMS_1(raw_value, "strval", *value);
+			phalcon_array_append(&placeholders, raw_value, PH_SEPARATE TSRMLS_CC);
+		} else {
+			phalcon_array_append_string(&placeholders, SL("?"), PH_SEPARATE TSRMLS_CC);
+			phalcon_array_append(&bind_values, *value, PH_SEPARATE TSRMLS_CC);
+		}
+		zend_hash_move_forward_ex(Z_ARRVAL_P(values), &hp0);
+	}
+	
+	p0[0] = table;
+	p0[1] = fields;
+	p0[2] = placeholders;
+	p0[3] = key_fields;
+	p0[4] = update_fields;
+	p0[5] = identity_field;
+	
+	PHALCON_INIT_VAR(upsert_sql);
+	PHALCON_CALL_METHOD_PARAMS(upsert_sql, dialect, "upsert", 6, p0, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(success);
+	PHALCON_CALL_METHOD_PARAMS_2(success, this_ptr, "execute", upsert_sql, bind_values, PH_NO_CHECK);
+	
+	RETURN_CCTOR(success);
+}
+
+/**
+ * Updates data on a table using custom RBDM SQL syntax. Bind parameters for the condition can be passed
+ * in $whereBind, the new values are then bound by name so every placeholder style works in the condition
  *
  * @param string $table
  * @param array $fields
  * @param array $values
  * @param string $whereCondition
+ * @param array $whereBind
  * @return boolean
  */
 PHP_METHOD(Phalcon_Db, update){
 
 	zval *table = NULL, *fields = NULL, *values = NULL, *where_condition = NULL;
 	zval *placeholders = NULL, *value = NULL, *n = NULL, *field = NULL, *set_clause = NULL;
-	zval *update_sql = NULL;
+	zval *update_sql = NULL, *where_bind = NULL, *bind_params = NULL, *bind_name = NULL;
+	zval *template = NULL;
 	zval *r0 = NULL, *r1 = NULL, *r2 = NULL;
 	zval *c0 = NULL;
 	HashTable *ah0;
@@ -325,11 +831,12 @@ PHP_METHOD(Phalcon_Db, update){
 	uint hash_index_len;
 	ulong hash_num;
 	int hash_type;
-	int eval_int;
+	int eval_int, named = 0, cacheable;
+	smart_str key = {0};
 
 	PHALCON_MM_GROW();
 	
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zzz|z", &table, &fields, &values, &where_condition) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zzz|zz", &table, &fields, &values, &where_condition, &where_bind) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
@@ -341,12 +848,36 @@ PHP_METHOD(Phalcon_Db, update){
 		ZVAL_NULL(where_condition);
 	}
 	
+	/** 
+	 * The new values are added after the condition's parameters so plain and numbered placeholders keep their positions
+	 */
+	if (where_bind && Z_TYPE_P(where_bind) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL_P(where_bind))) {
+		named = 1;
+		PHALCON_INIT_VAR(bind_params);
+		ZVAL_ZVAL(bind_params, where_bind, 1, 0);
+	}
+	
 	PHALCON_INIT_VAR(placeholders);
 	array_init(placeholders);
 	if (!phalcon_valid_foreach(values TSRMLS_CC)) {
 		return;
 	}
 	
+	/** 
+	 * Only conditions with bound parameters are cached, a condition with its values in the text would
+	 * produce a template per record and push the reusable ones out of the table
+	 */
+	cacheable = Z_TYPE_P(table) == IS_STRING && (Z_TYPE_P(where_condition) == IS_NULL || (named && Z_TYPE_P(where_condition) == IS_STRING));
+	if (cacheable) {
+		smart_str_appendc(&key, named ? 'N' : 'U');
+		phalcon_db_template_key(&key, Z_STRVAL_P(table), Z_STRLEN_P(table));
+		if (Z_TYPE_P(where_condition) == IS_STRING) {
+			phalcon_db_template_key(&key, Z_STRVAL_P(where_condition), Z_STRLEN_P(where_condition));
+		} else {
+			smart_str_appendc(&key, '-');
+		}
+	}
+	
 	ALLOC_HASHTABLE(ah0);
 	zend_hash_init(ah0, 0, NULL, NULL, 0);
 	zend_hash_copy(ah0, Z_ARRVAL_P(values), NULL, NULL, sizeof(zval*));
@@ -364,18 +895,46 @@ PHP_METHOD(Phalcon_Db, update){
 		if (eval_int) {
 			PHALCON_INIT_VAR(field);
 			phalcon_array_fetch(&field, fields, n, PH_NOISY_CC);
+			if (cacheable && Z_TYPE_P(field) == IS_STRING) {
+				smart_str_appendc(&key, Z_TYPE_P(n) == IS_STRING ? 's' : 'i');
+				if (Z_TYPE_P(n) == IS_STRING) {
+					phalcon_db_template_key(&key, Z_STRVAL_P(n), Z_STRLEN_P(n));
+				} else {
+					smart_str_append_long(&key, Z_LVAL_P(n));
+				}
+				phalcon_db_template_key(&key, Z_STRVAL_P(field), Z_STRLEN_P(field));
+			} else {
+				cacheable = 0;
+			}
 			if (Z_TYPE_P(value) == IS_OBJECT) {
 				PHALCON_INIT_VAR(r0);
 				PHALCON_CONCAT_VSV(r0, field, " = ", value);
 				phalcon_array_append(&placeholders, r0, PH_SEPARATE TSRMLS_CC);
 				PHALCON_SEPARATE_PARAM(values);
 				phalcon_array_unset(values, n);
+				if (cacheable) {
+					smart_str_appendc(&key, 'r');
+					phalcon_db_template_key(&key, Z_STRVAL_P(r0), Z_STRLEN_P(r0));
+				}
 			} else {
-				PHALCON_INIT_VAR(r1);
-				PHALCON_CONCAT_VS(r1, field, " = ?");
+				if (cacheable) {
+					smart_str_appendc(&key, '?');
+				}
+				if (named) {
+					PHALCON_INIT_VAR(bind_name);
+					PHALCON_CONCAT_SV(bind_name, "phalcon_set_", n);
+					phalcon_array_update_zval(&bind_params, bind_name, &value, PH_COPY | PH_SEPARATE TSRMLS_CC);
+					
+					PHALCON_INIT_VAR(r1);
+					PHALCON_CONCAT_VSVS(r1, field, " = :", bind_name, ":");
+				} else {
+					PHALCON_INIT_VAR(r1);
+					PHALCON_CONCAT_VS(r1, field, " = ?");
+				}
 				phalcon_array_append(&placeholders, r1, PH_SEPARATE TSRMLS_CC);
 			}
 		} else {
+			smart_str_free(&key);
 			PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "The number of values in the update is not the same as fields");
 			return;
 		}
@@ -384,22 +943,45 @@ PHP_METHOD(Phalcon_Db, update){
 	fee_e7f0_2:
 	zend_hash_destroy(ah0);
 	efree(ah0);
+	smart_str_0(&key);
 	
-	PHALCON_INIT_VAR(c0);
-	ZVAL_STRING(c0, ", ", 1);
+	/** 
+	 * Records of the same table changing the same fields reuse the statement, only the values are bound again
+	 */
+	PHALCON_INIT_VAR(update_sql);
+	ZVAL_NULL(update_sql);
+	if (cacheable) {
+		template = phalcon_db_get_template(this_ptr, key.c, key.len TSRMLS_CC);
+		if (template) {
+			ZVAL_ZVAL(update_sql, template, 1, 0);
+		}
+	}
 	
-	PHALCON_INIT_VAR(set_clause);
-	phalcon_fast_join(set_clause, c0, placeholders TSRMLS_CC);
-	if (Z_TYPE_P(where_condition) != IS_NULL) {
-		PHALCON_INIT_VAR(update_sql);
-		PHALCON_CONCAT_SVSVSV(update_sql, "UPDATE ", table, " SET ", set_clause, " WHERE ", where_condition);
-	} else {
-		PHALCON_INIT_VAR(update_sql);
-		PHALCON_CONCAT_SVSV(update_sql, "UPDATE ", table, " SET ", set_clause);
+	if (Z_TYPE_P(update_sql) == IS_NULL) {
+		PHALCON_INIT_VAR(c0);
+		ZVAL_STRING(c0, ", ", 1);
+		
+		PHALCON_INIT_VAR(set_clause);
+		phalcon_fast_join(set_clause, c0, placeholders TSRMLS_CC);
+		if (Z_TYPE_P(where_condition) != IS_NULL) {
+			PHALCON_INIT_VAR(update_sql);
+			PHALCON_CONCAT_SVSVSV(update_sql, "UPDATE ", table, " SET ", set_clause, " WHERE ", where_condition);
+		} else {
+			PHALCON_INIT_VAR(update_sql);
+			PHALCON_CONCAT_SVSV(update_sql, "UPDATE ", table, " SET ", set_clause);
+		}
+		if (cacheable) {
+			phalcon_db_set_template(this_ptr, key.c, key.len, update_sql TSRMLS_CC);
+		}
 	}
+	smart_str_free(&key);
 	
 	PHALCON_ALLOC_ZVAL_MM(r2);
-	PHALCON_CALL_METHOD_PARAMS_2(r2, this_ptr, "execute", update_sql, values, PH_NO_CHECK);
+	if (named) {
+		PHALCON_CALL_METHOD_PARAMS_2(r2, this_ptr, "execute", update_sql, bind_params, PH_NO_CHECK);
+	} else {
+		PHALCON_CALL_METHOD_PARAMS_2(r2, this_ptr, "execute", update_sql, values, PH_NO_CHECK);
+	}
 	RETURN_CTOR(r2);
 }
 
@@ -447,6 +1029,70 @@ PHP_METHOD(Phalcon_Db, delete){
 	RETURN_CTOR(r0);
 }
 
+/**
+ * Returns the SQL statement compiled for a template key or null if it was not compiled yet.
+ * Components building the same statement repeatedly use the templates to skip the string building
+ *
+ *<code>
+ * $sql = $connection->getSqlTemplate($key);
+ * if ($sql === null) {
+ *   $sql = "SELECT * FROM robots WHERE type = ?";
+ *   $connection->setSqlTemplate($key, $sql);
+ * }
+ *</code>
+ *
+ * @param string $key
+ * @return string
+ */
+PHP_METHOD(Phalcon_Db, getSqlTemplate){
+
+	zval *key = NULL, *template = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &key) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(key) == IS_STRING) {
+		template = phalcon_db_get_template(this_ptr, Z_STRVAL_P(key), Z_STRLEN_P(key) TSRMLS_CC);
+		if (template) {
+			RETURN_CCTOR(template);
+		}
+	}
+	
+	PHALCON_MM_RESTORE();
+	RETURN_NULL();
+}
+
+/**
+ * Stores the SQL statement compiled for a template key. Only the last compiled templates are kept
+ *
+ * @param string $key
+ * @param string $sqlStatement
+ */
+PHP_METHOD(Phalcon_Db, setSqlTemplate){
+
+	zval *key = NULL, *sql_statement = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz", &key, &sql_statement) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(key) != IS_STRING) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "The template key must be a string");
+		return;
+	}
+	
+	phalcon_db_set_template(this_ptr, Z_STRVAL_P(key), Z_STRLEN_P(key), sql_statement TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
 /**
  * Starts a transaction in the connection
  *
@@ -460,6 +1106,11 @@ PHP_METHOD(Phalcon_Db, begin){
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
 	phalcon_read_property(&t0, this_ptr, SL("_pdo"), PH_NOISY_CC);
+	if (Z_TYPE_P(t0) != IS_OBJECT) {
+		PHALCON_ALLOC_ZVAL_MM(t0);
+		PHALCON_CALL_METHOD(t0, this_ptr, "getinternalhandler", PH_NO_CHECK);
+	}
+	
 	PHALCON_ALLOC_ZVAL_MM(r0);
 	PHALCON_CALL_METHOD(r0, t0, "begintransaction", PH_NO_CHECK);
 	RETURN_CTOR(r0);
@@ -478,6 +1129,13 @@ PHP_METHOD(Phalcon_Db, rollback){
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
 	phalcon_read_property(&t0, this_ptr, SL("_pdo"), PH_NOISY_CC);
+	if (Z_TYPE_P(t0) != IS_OBJECT) {
+		PHALCON_ALLOC_ZVAL_MM(t0);
+		PHALCON_CALL_METHOD(t0, this_ptr, "getinternalhandler", PH_NO_CHECK);
+	}
+	
+	PHALCON_GLOBAL(db_write_generation)++;
+	
 	PHALCON_ALLOC_ZVAL_MM(r0);
 	PHALCON_CALL_METHOD(r0, t0, "rollback", PH_NO_CHECK);
 	RETURN_CTOR(r0);
@@ -496,6 +1154,11 @@ PHP_METHOD(Phalcon_Db, commit){
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
 	phalcon_read_property(&t0, this_ptr, SL("_pdo"), PH_NOISY_CC);
+	if (Z_TYPE_P(t0) != IS_OBJECT) {
+		PHALCON_ALLOC_ZVAL_MM(t0);
+		PHALCON_CALL_METHOD(t0, this_ptr, "getinternalhandler", PH_NO_CHECK);
+	}
+	
 	PHALCON_ALLOC_ZVAL_MM(r0);
 	PHALCON_CALL_METHOD(r0, t0, "commit", PH_NO_CHECK);
 	RETURN_CTOR(r0);
@@ -514,6 +1177,11 @@ PHP_METHOD(Phalcon_Db, isUnderTransaction){
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
 	phalcon_read_property(&t0, this_ptr, SL("_pdo"), PH_NOISY_CC);
+	if (Z_TYPE_P(t0) != IS_OBJECT) {
+		PHALCON_MM_RESTORE();
+		RETURN_FALSE;
+	}
+	
 	PHALCON_ALLOC_ZVAL_MM(r0);
 	PHALCON_CALL_METHOD(r0, t0, "intransaction", PH_NO_CHECK);
 	RETURN_CTOR(r0);
@@ -566,18 +1234,28 @@ PHP_METHOD(Phalcon_Db, getSQLStatement){
 }
 
 /**
- * Return internal PDO handler
+ * Return internal PDO handler. Lazy connections are opened the first time the handler is requested
  *
  * @return PDO
  */
 PHP_METHOD(Phalcon_Db, getInternalHandler){
 
-	zval *t0 = NULL;
+	zval *pdo = NULL, *descriptor = NULL;
 
 	PHALCON_MM_GROW();
-	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_pdo"), PH_NOISY_CC);
+	PHALCON_INIT_VAR(pdo);
+	phalcon_read_property(&pdo, this_ptr, SL("_pdo"), PH_NOISY_CC);
+	if (Z_TYPE_P(pdo) != IS_OBJECT) {
+		PHALCON_INIT_VAR(descriptor);
+		phalcon_read_property(&descriptor, this_ptr, SL("_pendingDescriptor"), PH_NOISY_CC);
+		if (Z_TYPE_P(descriptor) == IS_ARRAY) { 
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(this_ptr, "connect", descriptor, PH_NO_CHECK);
+			
+			PHALCON_INIT_VAR(pdo);
+			phalcon_read_property(&pdo, this_ptr, SL("_pdo"), PH_NOISY_CC);
+		}
+	}
 	
-	RETURN_CCTOR(t0);
+	RETURN_CCTOR(pdo);
 }
 
@@ -37,6 +37,9 @@
 #include "kernel/concat.h"
 #include "kernel/object.h"
 #include "kernel/fcall.h"
+#include "kernel/operators.h"
+
+#include "ext/standard/php_smart_str.h"
 
 /**
  * Phalcon\Db\Adapter\Pdo
@@ -45,14 +48,428 @@
  * 
  */
 
+/**
+ * Rewrites the ?N and :name: placeholders of a SQL statement as positional markers. The bind key of
+ * every marker is collected in order, plain ? markers take the next value in the placeholders array.
+ * Quoted literals, quoted identifiers and :: casts are copied as they are
+ */
+static void phalcon_db_adapter_pdo_compile(zval *compiled, zval *bind_keys, zval *sql_statement){
+
+	smart_str sql = {0};
+	char *cursor, *end, *start;
+	char quote = '\0';
+
+	array_init(bind_keys);
+
+	cursor = Z_STRVAL_P(sql_statement);
+	end = cursor + Z_STRLEN_P(sql_statement);
+	while (cursor < end) {
+
+		/** Placeholders are not replaced inside quoted literals or identifiers */
+		if (quote) {
+			smart_str_appendc(&sql, *cursor);
+			if (*cursor == '\\' && cursor + 1 < end) {
+				smart_str_appendc(&sql, cursor[1]);
+				cursor += 2;
+				continue;
+			}
+			if (*cursor == quote) {
+				quote = '\0';
+			}
+			cursor++;
+			continue;
+		}
+
+		switch (*cursor) {
+
+			case '\'':
+			case '"':
+			case '`':
+				quote = *cursor;
+				break;
+
+			case '?':
+				start = ++cursor;
+				while (cursor < end && isdigit((unsigned char) *cursor)) {
+					cursor++;
+				}
+				smart_str_appendc(&sql, '?');
+				if (cursor > start) {
+					add_next_index_long(bind_keys, ZEND_STRTOL(start, NULL, 10));
+				} else {
+					add_next_index_null(bind_keys);
+				}
+				continue;
+
+			case ':':
+				/** PostgreSQL casts like col::text are not placeholders */
+				if (cursor + 1 < end && cursor[1] == ':') {
+					smart_str_appendl(&sql, "::", 2);
+					cursor += 2;
+					continue;
+				}
+				start = cursor + 1;
+				while (start < end && (isalnum((unsigned char) *start) || *start == '_')) {
+					start++;
+				}
+				if (start > cursor + 1 && start < end && *start == ':') {
+					smart_str_appendc(&sql, '?');
+					add_next_index_stringl(bind_keys, cursor + 1, start - cursor - 1, 1);
+					cursor = start + 1;
+					continue;
+				}
+				break;
+		}
+
+		smart_str_appendc(&sql, *cursor);
+		cursor++;
+	}
+	smart_str_0(&sql);
+
+	if (sql.c) {
+		ZVAL_STRINGL(compiled, sql.c, sql.len, 0);
+	} else {
+		ZVAL_EMPTY_STRING(compiled);
+	}
+}
+
+/**
+ * A cached statement can be executed again only when no result is still reading from it
+ */
+static int phalcon_db_adapter_pdo_statement_idle(zval *statement TSRMLS_DC){
+	if (Z_TYPE_P(statement) != IS_OBJECT) {
+		return 0;
+	}
+	return Z_REFCOUNT_P(statement) == 1 && zend_objects_store_get_refcount(statement TSRMLS_CC) == 1;
+}
+
+/**
+ * Returns the statements cache ready to be modified, the array is separated when other zvals share it
+ */
+static zval *phalcon_db_adapter_pdo_separate_cache(zval *this_ptr, zval *cache TSRMLS_DC){
+
+	zval *separated;
+
+	if (Z_TYPE_P(cache) == IS_ARRAY && Z_REFCOUNT_P(cache) == 1) {
+		return cache;
+	}
+
+	ALLOC_INIT_ZVAL(separated);
+	array_init(separated);
+	if (Z_TYPE_P(cache) == IS_ARRAY) {
+		zend_hash_copy(Z_ARRVAL_P(separated), Z_ARRVAL_P(cache), (copy_ctor_func_t) zval_add_ref, NULL, sizeof(zval *));
+	}
+	zend_update_property(phalcon_db_adapter_pdo_ce, this_ptr, SL("_statements"), separated TSRMLS_CC);
+	zval_ptr_dtor(&separated);
+
+	return separated;
+}
+
+/**
+ * Fills the driver options of unbuffered statements. pdo_pgsql reads the whole result into the client unless
+ * the statement uses a server-side cursor, which is only declared when the "serverCursors" option of the
+ * descriptor is enabled: pdo_pgsql sends one FETCH to the server for every row read through the cursor, so it
+ * trades many round trips for a flat memory usage and is only worth it for results that don't fit in memory
+ */
+static void phalcon_db_adapter_pdo_cursor_options(zval *options, zval *this_ptr TSRMLS_DC){
+
+	zval *type, *descriptor;
+	zval **server_cursors;
+
+	array_init(options);
+
+	type = zend_read_property(Z_OBJCE_P(this_ptr), this_ptr, SL("_type"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(type) != IS_STRING || !PHALCON_COMPARE_STRING(type, "pgsql")) {
+		return;
+	}
+
+	descriptor = zend_read_property(Z_OBJCE_P(this_ptr), this_ptr, SL("_descriptor"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(descriptor) == IS_ARRAY && zend_hash_find(Z_ARRVAL_P(descriptor), SS("serverCursors"), (void**) &server_cursors) == SUCCESS) {
+		if (zend_is_true(*server_cursors)) {
+			/** PDO::ATTR_CURSOR => PDO::CURSOR_SCROLL declares a server-side cursor */
+			add_index_long(options, 10, 1);
+		}
+	}
+}
+
+/**
+ * Executes a prepared statement. pdo_mysql ignores PDO::MYSQL_ATTR_USE_BUFFERED_QUERY in the options of prepare(),
+ * it reads the attribute of the connection when the statement is executed, so unbuffered statements on MySQL are
+ * executed with the attribute turned off and the previous value is restored afterwards.
+ * On FAILURE the memory stack of the caller has already been restored
+ */
+static int phalcon_db_adapter_pdo_execute(zval *success, zval *this_ptr, zval *pdo, zval *statement, int unbuffered TSRMLS_DC){
+
+	zval *type, *attribute, *disabled, *buffered = NULL, *exception;
+	int status;
+
+	if (unbuffered) {
+		type = zend_read_property(Z_OBJCE_P(this_ptr), this_ptr, SL("_type"), 1 TSRMLS_CC);
+		if (Z_TYPE_P(type) != IS_STRING || !PHALCON_COMPARE_STRING(type, "mysql")) {
+			unbuffered = 0;
+		}
+	}
+
+	if (!unbuffered) {
+		return phalcon_call_method(success, statement, SL("execute"), PH_NO_CHECK, 1 TSRMLS_CC);
+	}
+
+	/** PDO::MYSQL_ATTR_USE_BUFFERED_QUERY */
+	ALLOC_INIT_ZVAL(attribute);
+	ZVAL_LONG(attribute, 1000);
+	ALLOC_INIT_ZVAL(disabled);
+	ZVAL_BOOL(disabled, 0);
+
+	zend_call_method_with_1_params(&pdo, Z_OBJCE_P(pdo), NULL, "getattribute", &buffered, attribute);
+	if (!buffered) {
+		ALLOC_INIT_ZVAL(buffered);
+		ZVAL_BOOL(buffered, 1);
+	}
+
+	zend_call_method_with_2_params(&pdo, Z_OBJCE_P(pdo), NULL, "setattribute", NULL, attribute, disabled);
+
+	status = phalcon_call_method(success, statement, SL("execute"), PH_NO_CHECK, 1 TSRMLS_CC);
+
+	/** The attribute is restored even when the statement threw an exception */
+	exception = EG(exception);
+	EG(exception) = NULL;
+	zend_call_method_with_2_params(&pdo, Z_OBJCE_P(pdo), NULL, "setattribute", NULL, attribute, buffered);
+	if (exception) {
+		if (EG(exception)) {
+			zval_ptr_dtor(&EG(exception));
+		}
+		EG(exception) = exception;
+	}
+
+	zval_ptr_dtor(&attribute);
+	zval_ptr_dtor(&disabled);
+	zval_ptr_dtor(&buffered);
+
+	return status;
+}
+
+/**
+ * Returns a prepared statement for a SQL statement and the bind keys of its markers. Statements are
+ * cached per connection by SQL text, the least recently used one is dropped when the cache is full.
+ * Unbuffered statements are prepared with the cursor options of the driver and never cached.
+ * On FAILURE the memory stack of the caller has already been restored
+ */
+static int phalcon_db_adapter_pdo_prepare(zval *statement, zval *bind_keys, zval *this_ptr, zval *pdo, zval *sql_statement, int unbuffered TSRMLS_DC){
+
+	zval *cache, *limit, *compiled, *entry, *cached_statement;
+	zval **cached, **item;
+	char *str_index;
+	uint str_index_length;
+	ulong num_index;
+	long statements_limit;
+	int busy = 0, status;
+
+	if (Z_TYPE_P(sql_statement) != IS_STRING) {
+		phalcon_throw_exception_string(phalcon_db_exception_ce, SL("SQL statements with placeholders must be strings") TSRMLS_CC);
+		return FAILURE;
+	}
+
+	limit = zend_read_property(phalcon_db_adapter_pdo_ce, this_ptr, SL("_statementsLimit"), 1 TSRMLS_CC);
+	statements_limit = Z_TYPE_P(limit) == IS_LONG ? Z_LVAL_P(limit) : 0;
+
+	if (unbuffered) {
+		ALLOC_INIT_ZVAL(compiled);
+		phalcon_db_adapter_pdo_compile(compiled, bind_keys, sql_statement);
+
+		ALLOC_INIT_ZVAL(entry);
+		phalcon_db_adapter_pdo_cursor_options(entry, this_ptr TSRMLS_CC);
+
+		status = phalcon_call_method_two_params(statement, pdo, SL("prepare"), compiled, entry, PH_NO_CHECK, 1 TSRMLS_CC);
+		zval_ptr_dtor(&compiled);
+		zval_ptr_dtor(&entry);
+		return status;
+	}
+
+	cache = zend_read_property(phalcon_db_adapter_pdo_ce, this_ptr, SL("_statements"), 1 TSRMLS_CC);
+	if (statements_limit > 0 && Z_TYPE_P(cache) == IS_ARRAY) {
+		if (zend_hash_find(Z_ARRVAL_P(cache), Z_STRVAL_P(sql_statement), Z_STRLEN_P(sql_statement) + 1, (void**) &cached) == SUCCESS) {
+			if (zend_hash_index_find(Z_ARRVAL_PP(cached), 0, (void**) &item) == SUCCESS) {
+				if (phalcon_db_adapter_pdo_statement_idle(*item TSRMLS_CC)) {
+
+					ZVAL_ZVAL(statement, *item, 1, 0);
+					if (zend_hash_index_find(Z_ARRVAL_PP(cached), 1, (void**) &item) == SUCCESS) {
+						ZVAL_ZVAL(bind_keys, *item, 1, 0);
+					}
+
+					/** Move the entry to the most recently used end */
+					entry = *cached;
+					Z_ADDREF_P(entry);
+					cache = phalcon_db_adapter_pdo_separate_cache(this_ptr, cache TSRMLS_CC);
+					zend_hash_del(Z_ARRVAL_P(cache), Z_STRVAL_P(sql_statement), Z_STRLEN_P(sql_statement) + 1);
+					zend_hash_update(Z_ARRVAL_P(cache), Z_STRVAL_P(sql_statement), Z_STRLEN_P(sql_statement) + 1, &entry, sizeof(zval *), NULL);
+					return SUCCESS;
+				}
+				busy = 1;
+			}
+		}
+	}
+
+	ALLOC_INIT_ZVAL(compiled);
+	phalcon_db_adapter_pdo_compile(compiled, bind_keys, sql_statement);
+
+	if (phalcon_call_method_one_param(statement, pdo, SL("prepare"), compiled, PH_NO_CHECK, 1 TSRMLS_CC) == FAILURE) {
+		zval_ptr_dtor(&compiled);
+		return FAILURE;
+	}
+
+	/** Statements still used by a result are not replaced, the new one is used only once */
+	if (busy || statements_limit <= 0 || Z_TYPE_P(statement) != IS_OBJECT) {
+		zval_ptr_dtor(&compiled);
+		return SUCCESS;
+	}
+
+	cache = phalcon_db_adapter_pdo_separate_cache(this_ptr, cache TSRMLS_CC);
+
+	ALLOC_INIT_ZVAL(cached_statement);
+	ZVAL_ZVAL(cached_statement, statement, 1, 0);
+
+	ALLOC_INIT_ZVAL(entry);
+	array_init(entry);
+	add_next_index_zval(entry, cached_statement);
+	Z_ADDREF_P(bind_keys);
+	add_next_index_zval(entry, bind_keys);
+	add_next_index_zval(entry, compiled);
+	zend_hash_update(Z_ARRVAL_P(cache), Z_STRVAL_P(sql_statement), Z_STRLEN_P(sql_statement) + 1, &entry, sizeof(zval *), NULL);
+
+	while (zend_hash_num_elements(Z_ARRVAL_P(cache)) > (uint) statements_limit) {
+		zend_hash_internal_pointer_reset(Z_ARRVAL_P(cache));
+		if (zend_hash_get_current_key_ex(Z_ARRVAL_P(cache), &str_index, &str_index_length, &num_index, 0, NULL) == HASH_KEY_IS_STRING) {
+			zend_hash_del(Z_ARRVAL_P(cache), str_index, str_index_length);
+		} else {
+			zend_hash_index_del(Z_ARRVAL_P(cache), num_index);
+		}
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * Binds the placeholders to the markers of a prepared statement. Explicit data types take precedence,
+ * otherwise the type is deduced from the value. On FAILURE the memory stack of the caller has already been restored
+ */
+static int phalcon_db_adapter_pdo_bind(zval *statement, zval *bind_keys, zval *placeholders, zval *data_types TSRMLS_DC){
+
+	zval **key, **value, **data_type;
+	zval *position, *type;
+	HashPosition key_position, value_position;
+	char *str_index, *message;
+	uint str_index_length;
+	ulong num_index;
+	long bind_type, marker = 1;
+	int found, status;
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(placeholders), &value_position);
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(bind_keys), &key_position);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(bind_keys), (void**) &key, &key_position) == SUCCESS) {
+
+		data_type = NULL;
+		switch (Z_TYPE_PP(key)) {
+
+			case IS_LONG:
+				found = zend_hash_index_find(Z_ARRVAL_P(placeholders), Z_LVAL_PP(key), (void**) &value);
+				if (found == SUCCESS && Z_TYPE_P(data_types) == IS_ARRAY) {
+					zend_hash_index_find(Z_ARRVAL_P(data_types), Z_LVAL_PP(key), (void**) &data_type);
+				}
+				break;
+
+			case IS_STRING:
+				found = zend_hash_find(Z_ARRVAL_P(placeholders), Z_STRVAL_PP(key), Z_STRLEN_PP(key) + 1, (void**) &value);
+				if (found == SUCCESS && Z_TYPE_P(data_types) == IS_ARRAY) {
+					zend_hash_find(Z_ARRVAL_P(data_types), Z_STRVAL_PP(key), Z_STRLEN_PP(key) + 1, (void**) &data_type);
+				}
+				break;
+
+			default:
+				found = zend_hash_get_current_data_ex(Z_ARRVAL_P(placeholders), (void**) &value, &value_position);
+				if (found == SUCCESS && Z_TYPE_P(data_types) == IS_ARRAY) {
+					if (zend_hash_get_current_key_ex(Z_ARRVAL_P(placeholders), &str_index, &str_index_length, &num_index, 0, &value_position) == HASH_KEY_IS_STRING) {
+						zend_hash_find(Z_ARRVAL_P(data_types), str_index, str_index_length, (void**) &data_type);
+					} else {
+						zend_hash_index_find(Z_ARRVAL_P(data_types), num_index, (void**) &data_type);
+					}
+				}
+				zend_hash_move_forward_ex(Z_ARRVAL_P(placeholders), &value_position);
+				break;
+		}
+
+		if (found != SUCCESS) {
+			if (Z_TYPE_PP(key) == IS_LONG) {
+				spprintf(&message, 0, "Bind parameter '?%ld' was not supplied", Z_LVAL_PP(key));
+			} else if (Z_TYPE_PP(key) == IS_STRING) {
+				spprintf(&message, 0, "Bind parameter ':%s:' was not supplied", Z_STRVAL_PP(key));
+			} else {
+				spprintf(&message, 0, "The number of bind parameters is lower than the number of placeholders");
+			}
+			phalcon_throw_exception_string(phalcon_db_exception_ce, message, strlen(message) TSRMLS_CC);
+			efree(message);
+			return FAILURE;
+		}
+
+		if (data_type && Z_TYPE_PP(data_type) == IS_LONG) {
+			bind_type = Z_LVAL_PP(data_type);
+		} else {
+			switch (Z_TYPE_PP(value)) {
+				case IS_NULL:
+					bind_type = 0;
+					break;
+				case IS_LONG:
+					bind_type = 1;
+					break;
+				case IS_BOOL:
+					bind_type = 5;
+					break;
+				default:
+					bind_type = 2;
+					break;
+			}
+		}
+
+		ALLOC_INIT_ZVAL(position);
+		ZVAL_LONG(position, marker);
+		ALLOC_INIT_ZVAL(type);
+		ZVAL_LONG(type, bind_type);
+
+		status = phalcon_call_method_three_params(NULL, statement, SL("bindvalue"), position, *value, type, PH_NO_CHECK, 0 TSRMLS_CC);
+
+		zval_ptr_dtor(&position);
+		zval_ptr_dtor(&type);
+		if (status == FAILURE) {
+			return FAILURE;
+		}
+
+		marker++;
+		zend_hash_move_forward_ex(Z_ARRVAL_P(bind_keys), &key_position);
+	}
+
+	return SUCCESS;
+}
+
 /**
  * Constructor for Phalcon\Db\Adapter\Pdo
  *
+ * When the descriptor has 'lazy' => true the connection is not opened until the first
+ * statement, transaction or escaping needs it
+ *
+ *<code>
+ * $connection = new Phalcon\Db\Adapter\Pdo\Mysql(array(
+ *   'host' => 'localhost',
+ *   'username' => 'sigma',
+ *   'password' => 'secret',
+ *   'dbname' => 'blog',
+ *   'lazy' => true
+ * ));
+ *</code>
+ *
  * @param array $descriptor
  */
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, __construct){
 
-	zval *descriptor = NULL, *dialect_class = NULL;
+	zval *descriptor = NULL, *dialect_class = NULL, *lazy = NULL;
 	zval *t0 = NULL;
 	zval *i0 = NULL;
 	int eval_int;
@@ -86,6 +503,18 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, __construct){
 	object_init_ex(i0, ce0);
 	PHALCON_CALL_METHOD_NORETURN(i0, "__construct", PH_CHECK);
 	phalcon_update_property_zval(this_ptr, SL("_dialect"), i0 TSRMLS_CC);
+	
+	eval_int = phalcon_array_isset_string(descriptor, SL("lazy")+1);
+	if (eval_int) {
+		PHALCON_INIT_VAR(lazy);
+		phalcon_array_fetch_string(&lazy, descriptor, SL("lazy"), PH_NOISY_CC);
+		if (zend_is_true(lazy)) {
+			phalcon_update_property_zval(this_ptr, SL("_pendingDescriptor"), descriptor TSRMLS_CC);
+			PHALCON_MM_RESTORE();
+			RETURN_NULL();
+		}
+	}
+	
 	PHALCON_CALL_METHOD_PARAMS_1_NORETURN(this_ptr, "connect", descriptor, PH_NO_CHECK);
 	
 	PHALCON_MM_RESTORE();
@@ -102,6 +531,7 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, connect){
 
 	zval *descriptor = NULL, *username = NULL, *password = NULL, *dsn_parts = NULL;
 	zval *value = NULL, *key = NULL, *dsn = NULL, *options = NULL, *persistent = NULL;
+	zval *native_prepares = NULL;
 	zval *r0 = NULL, *r1 = NULL;
 	zval *t0 = NULL;
 	zval *c0 = NULL;
@@ -156,6 +586,12 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, connect){
 		ZVAL_NULL(password);
 	}
 	
+	eval_int = phalcon_array_isset_string(descriptor, SL("lazy")+1);
+	if (eval_int) {
+		PHALCON_SEPARATE_PARAM(descriptor);
+		phalcon_array_unset_string(descriptor, SL("lazy")+1);
+	}
+	
 	PHALCON_INIT_VAR(dsn_parts);
 	array_init(dsn_parts);
 	if (!phalcon_valid_foreach(descriptor TSRMLS_CC)) {
@@ -171,6 +607,10 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, connect){
 		
 		PHALCON_INIT_VAR(key);
 		PHALCON_GET_FOREACH_KEY(key, ah0, hp0);
+		if (Z_TYPE_P(key) == IS_STRING && (PHALCON_COMPARE_STRING(key, "nativePrepares") || PHALCON_COMPARE_STRING(key, "serverCursors"))) {
+			zend_hash_move_forward_ex(ah0, &hp0);
+			goto fes_7f5d_0;
+		}
 		PHALCON_INIT_VAR(value);
 		ZVAL_ZVAL(value, *hd, 1, 0);
 		PHALCON_INIT_VAR(r0);
@@ -198,6 +638,17 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, connect){
 	add_index_long(options, 3, 0);
 	add_index_long(options, 8, 2);
 	add_index_long(options, 10, 1);
+	
+	/** PDO::ATTR_EMULATE_PREPARES is only disabled on request, the server then keeps the plans */
+	eval_int = phalcon_array_isset_string(descriptor, SL("nativePrepares")+1);
+	if (eval_int) {
+		PHALCON_INIT_VAR(native_prepares);
+		phalcon_array_fetch_string(&native_prepares, descriptor, SL("nativePrepares"), PH_NOISY_CC);
+		if (zend_is_true(native_prepares)) {
+			add_index_bool(options, 20, 0);
+		}
+	}
+	
 	eval_int = phalcon_array_isset_string(descriptor, SL("persistent")+1);
 	if (eval_int) {
 		PHALCON_INIT_VAR(persistent);
@@ -212,7 +663,11 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, connect){
 	PHALCON_ALLOC_ZVAL_MM(i0);
 	object_init_ex(i0, ce0);
 	PHALCON_CALL_METHOD_PARAMS_4_NORETURN(i0, "__construct", dsn, username, password, options, PH_CHECK);
+	phalcon_update_property_null(this_ptr, SL("_statements") TSRMLS_CC);
 	phalcon_update_property_zval(this_ptr, SL("_pdo"), i0 TSRMLS_CC);
+	
+	/** A lazy connection that failed to open is attempted again by the next query */
+	phalcon_update_property_null(this_ptr, SL("_pendingDescriptor") TSRMLS_CC);
 	PHALCON_CALL_PARENT_PARAMS_1_NORETURN(this_ptr, "Phalcon\\Db\\Adapter\\Pdo", "__construct", descriptor);
 	
 	PHALCON_MM_RESTORE();
@@ -222,28 +677,62 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, connect){
  * Sends SQL statements to the database server returning the success state.
  * Use this method only when the SQL statement sent to the server return rows
  *
+ * Statements with placeholders are prepared and cached per connection. With the "nativePrepares"
+ * option of the descriptor they are prepared by the database server, so executing the same SQL
+ * again only sends the bound values
+ *
+ * Unbuffered results read the rows from the server while they are fetched, keeping memory flat for
+ * big resultsets. They can be traversed only once and on MySQL the connection cannot run other
+ * queries until all the rows have been fetched. On PostgreSQL the rows are only read from the server
+ * while they are fetched when the "serverCursors" option of the descriptor is enabled, every row
+ * then costs a round trip to the server
+ *
  * //Querying data
  * $resultset = $connection->query("SELECT * FROM robots WHERE type='mechanical'");
- * $resultset = $connection->query("SELECT * FROM robots WHERE type=?", array("mechanical"));
+ * $resultset = $connection->query("SELECT * FROM robots WHERE type=?0", array("mechanical"));
+ * $resultset = $connection->query("SELECT * FROM robots WHERE id=:id:", array("id" => 10), array("id" => Phalcon\Db\Column::BIND_PARAM_INT));
+ *
+ * //Streaming data
+ * $resultset = $connection->query("SELECT * FROM robots", null, null, true);
  *
  * @param  string $sqlStatement
+ * @param  array $placeholders
+ * @param  array $dataTypes
+ * @param  boolean $unbuffered
  * @return Phalcon\Db\Result\Pdo
  */
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, query){
 
-	zval *sql_statement = NULL, *events_manager = NULL, *pdo = NULL, *result = NULL;
-	zval *error_info = NULL;
+	zval *sql_statement = NULL, *placeholders = NULL, *data_types = NULL, *unbuffered = NULL;
+	zval *events_manager = NULL, *pdo = NULL, *result = NULL, *statement = NULL;
+	zval *bind_keys = NULL, *success = NULL, *error_source = NULL, *error_info = NULL;
+	zval *type = NULL, *exact_row_count = NULL;
 	zval *c0 = NULL, *c1 = NULL;
 	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL, *r4 = NULL;
 	zval *i0 = NULL, *i1 = NULL;
 
 	PHALCON_MM_GROW();
 	
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &sql_statement) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|zzz", &sql_statement, &placeholders, &data_types, &unbuffered) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
 
+	if (!placeholders) {
+		PHALCON_ALLOC_ZVAL_MM(placeholders);
+		ZVAL_NULL(placeholders);
+	}
+	
+	if (!data_types) {
+		PHALCON_ALLOC_ZVAL_MM(data_types);
+		ZVAL_NULL(data_types);
+	}
+	
+	if (!unbuffered) {
+		PHALCON_ALLOC_ZVAL_MM(unbuffered);
+		ZVAL_BOOL(unbuffered, 0);
+	}
+
 	PHALCON_INIT_VAR(events_manager);
 	phalcon_read_property(&events_manager, this_ptr, SL("_eventsManager"), PH_NOISY_CC);
 	if (zend_is_true(events_manager)) {
@@ -262,9 +751,46 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, query){
 	
 	PHALCON_INIT_VAR(pdo);
 	phalcon_read_property(&pdo, this_ptr, SL("_pdo"), PH_NOISY_CC);
+	if (Z_TYPE_P(pdo) != IS_OBJECT) {
+		PHALCON_INIT_VAR(pdo);
+		PHALCON_CALL_METHOD(pdo, this_ptr, "getinternalhandler", PH_NO_CHECK);
+	}
+	PHALCON_CPY_WRT(error_source, pdo);
+	
+	if (zend_is_true(unbuffered) || (Z_TYPE_P(placeholders) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL_P(placeholders)))) {
+		PHALCON_INIT_VAR(statement);
+		PHALCON_INIT_VAR(bind_keys);
+		if (phalcon_db_adapter_pdo_prepare(statement, bind_keys, this_ptr, pdo, sql_statement, zend_is_true(unbuffered) TSRMLS_CC) == FAILURE) {
+			return;
+		}
+		
+		if (Z_TYPE_P(placeholders) != IS_ARRAY) {
+			PHALCON_INIT_VAR(placeholders);
+			array_init(placeholders);
+		}
+		
+		PHALCON_INIT_VAR(result);
+		ZVAL_BOOL(result, 0);
+		if (Z_TYPE_P(statement) == IS_OBJECT) {
+			if (phalcon_db_adapter_pdo_bind(statement, bind_keys, placeholders, data_types TSRMLS_CC) == FAILURE) {
+				return;
+			}
+			
+			PHALCON_INIT_VAR(success);
+			if (phalcon_db_adapter_pdo_execute(success, this_ptr, pdo, statement, zend_is_true(unbuffered) TSRMLS_CC) == FAILURE) {
+				return;
+			}
+			if (zend_is_true(success)) {
+				PHALCON_CPY_WRT(result, statement);
+			} else {
+				PHALCON_CPY_WRT(error_source, statement);
+			}
+		}
+	} else {
+		PHALCON_INIT_VAR(result);
+		PHALCON_CALL_METHOD_PARAMS_1(result, pdo, "query", sql_statement, PH_NO_CHECK);
+	}
 	
-	PHALCON_INIT_VAR(result);
-	PHALCON_CALL_METHOD_PARAMS_1(result, pdo, "query", sql_statement, PH_NO_CHECK);
 	if (Z_TYPE_P(result) == IS_OBJECT) {
 		if (zend_is_true(events_manager)) {
 			PHALCON_INIT_VAR(c1);
@@ -277,15 +803,22 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, query){
 			}
 		}
 		
+		/** MySQL buffered queries and PostgreSQL report the rows returned by a SELECT in rowCount() */
+		PHALCON_INIT_VAR(type);
+		phalcon_read_property(&type, this_ptr, SL("_type"), PH_NOISY_CC);
+		
+		PHALCON_INIT_VAR(exact_row_count);
+		ZVAL_BOOL(exact_row_count, Z_TYPE_P(type) == IS_STRING && (PHALCON_COMPARE_STRING(type, "mysql") || PHALCON_COMPARE_STRING(type, "pgsql")));
+		
 		PHALCON_ALLOC_ZVAL_MM(i0);
 		object_init_ex(i0, phalcon_db_result_pdo_ce);
-		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(i0, "__construct", result, PH_CHECK);
+		PHALCON_CALL_METHOD_PARAMS_3_NORETURN(i0, "__construct", result, unbuffered, exact_row_count, PH_CHECK);
 		
 		RETURN_CTOR(i0);
 	}
 	
 	PHALCON_INIT_VAR(error_info);
-	PHALCON_CALL_METHOD(error_info, pdo, "errorinfo", PH_NO_CHECK);
+	PHALCON_CALL_METHOD(error_info, error_source, "errorinfo", PH_NO_CHECK);
 	
 	PHALCON_ALLOC_ZVAL_MM(i1);
 	object_init_ex(i1, phalcon_db_exception_ce);
@@ -313,22 +846,20 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, query){
  *
  * @param  string $sqlStatement
  * @param  array $placeholders
+ * @param  array $dataTypes
  */
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, execute){
 
-	zval *sql_statement = NULL, *placeholders = NULL, *events_manager = NULL;
-	zval *pdo = NULL, *n = NULL, *statement = NULL, *value = NULL, *success = NULL, *affected_rows = NULL;
-	zval *error_info = NULL;
+	zval *sql_statement = NULL, *placeholders = NULL, *data_types = NULL, *events_manager = NULL;
+	zval *pdo = NULL, *statement = NULL, *bind_keys = NULL, *success = NULL, *affected_rows = NULL;
+	zval *error_source = NULL, *error_info = NULL;
 	zval *c0 = NULL, *c1 = NULL;
 	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL, *r4 = NULL, *r5 = NULL;
 	zval *i0 = NULL;
-	HashTable *ah0;
-	HashPosition hp0;
-	zval **hd;
 
 	PHALCON_MM_GROW();
 	
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &sql_statement, &placeholders) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|zz", &sql_statement, &placeholders, &data_types) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
@@ -338,6 +869,11 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, execute){
 		array_init(placeholders);
 	}
 	
+	if (!data_types) {
+		PHALCON_ALLOC_ZVAL_MM(data_types);
+		ZVAL_NULL(data_types);
+	}
+	
 	PHALCON_INIT_VAR(events_manager);
 	phalcon_read_property(&events_manager, this_ptr, SL("_eventsManager"), PH_NOISY_CC);
 	if (zend_is_true(events_manager)) {
@@ -356,41 +892,39 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, execute){
 	
 	PHALCON_INIT_VAR(pdo);
 	phalcon_read_property(&pdo, this_ptr, SL("_pdo"), PH_NOISY_CC);
+	if (Z_TYPE_P(pdo) != IS_OBJECT) {
+		PHALCON_INIT_VAR(pdo);
+		PHALCON_CALL_METHOD(pdo, this_ptr, "getinternalhandler", PH_NO_CHECK);
+	}
+	PHALCON_CPY_WRT(error_source, pdo);
 	
 	PHALCON_ALLOC_ZVAL_MM(r1);
 	phalcon_fast_count(r1, placeholders TSRMLS_CC);
 	if (zend_is_true(r1)) {
-		PHALCON_INIT_VAR(n);
-		ZVAL_LONG(n, 1);
+		if (!phalcon_valid_foreach(placeholders TSRMLS_CC)) {
+			return;
+		}
 		
 		PHALCON_INIT_VAR(statement);
-		PHALCON_CALL_METHOD_PARAMS_1(statement, pdo, "prepare", sql_statement, PH_NO_CHECK);
-		if (!phalcon_valid_foreach(placeholders TSRMLS_CC)) {
+		PHALCON_INIT_VAR(bind_keys);
+		if (phalcon_db_adapter_pdo_prepare(statement, bind_keys, this_ptr, pdo, sql_statement, 0 TSRMLS_CC) == FAILURE) {
 			return;
 		}
 		
-		ah0 = Z_ARRVAL_P(placeholders);
-		zend_hash_internal_pointer_reset_ex(ah0, &hp0);
-		fes_7f5d_1:
-			if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
-				goto fee_7f5d_1;
+		PHALCON_INIT_VAR(success);
+		ZVAL_BOOL(success, 0);
+		if (Z_TYPE_P(statement) == IS_OBJECT) {
+			if (phalcon_db_adapter_pdo_bind(statement, bind_keys, placeholders, data_types TSRMLS_CC) == FAILURE) {
+				return;
 			}
 			
-			PHALCON_INIT_VAR(value);
-			ZVAL_ZVAL(value, *hd, 1, 0);
-			PHALCON_CALL_METHOD_PARAMS_2_NORETURN(statement, "bindparam", n, value, PH_NO_CHECK);
-			PHALCON_SEPARATE(n);
-			increment_function(n);
-			zend_hash_move_forward_ex(ah0, &hp0);
-			goto fes_7f5d_1;
-		fee_7f5d_1:
-		if(0){}
-		
-		PHALCON_INIT_VAR(success);
-		PHALCON_CALL_METHOD(success, statement, "execute", PH_NO_CHECK);
-		
-		PHALCON_INIT_VAR(affected_rows);
-		PHALCON_CALL_METHOD(affected_rows, statement, "rowcount", PH_NO_CHECK);
+			PHALCON_INIT_VAR(success);
+			PHALCON_CALL_METHOD(success, statement, "execute", PH_NO_CHECK);
+			PHALCON_CPY_WRT(error_source, statement);
+			
+			PHALCON_INIT_VAR(affected_rows);
+			PHALCON_CALL_METHOD(affected_rows, statement, "rowcount", PH_NO_CHECK);
+		}
 	} else {
 		PHALCON_INIT_VAR(success);
 		ZVAL_BOOL(success, 1);
@@ -399,6 +933,9 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, execute){
 		PHALCON_CALL_METHOD_PARAMS_1(affected_rows, pdo, "exec", sql_statement, PH_NO_CHECK);
 	}
 	
+	/** Records cached by the models managers could have been changed by the statement */
+	PHALCON_GLOBAL(db_write_generation)++;
+	
 	if (zend_is_true(success)) {
 		if (Z_TYPE_P(affected_rows) == IS_LONG) {
 			phalcon_update_property_zval(this_ptr, SL("_affectedRows"), affected_rows TSRMLS_CC);
@@ -419,7 +956,7 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, execute){
 	}
 	
 	PHALCON_INIT_VAR(error_info);
-	PHALCON_CALL_METHOD(error_info, pdo, "errorinfo", PH_NO_CHECK);
+	PHALCON_CALL_METHOD(error_info, error_source, "errorinfo", PH_NO_CHECK);
 	
 	PHALCON_ALLOC_ZVAL_MM(i0);
 	object_init_ex(i0, phalcon_db_exception_ce);
@@ -463,9 +1000,12 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, close){
 	zval *t0 = NULL;
 
 	PHALCON_MM_GROW();
+	phalcon_update_property_null(this_ptr, SL("_pendingDescriptor") TSRMLS_CC);
+	
 	PHALCON_ALLOC_ZVAL_MM(t0);
 	phalcon_read_property(&t0, this_ptr, SL("_pdo"), PH_NOISY_CC);
 	if (zend_is_true(t0)) {
+		phalcon_update_property_null(this_ptr, SL("_statements") TSRMLS_CC);
 		phalcon_update_property_null(this_ptr, SL("_pdo") TSRMLS_CC);
 		PHALCON_MM_RESTORE();
 		RETURN_TRUE;
@@ -495,6 +1035,11 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, escapeString){
 
 	PHALCON_ALLOC_ZVAL_MM(t0);
 	phalcon_read_property(&t0, this_ptr, SL("_pdo"), PH_NOISY_CC);
+	if (Z_TYPE_P(t0) != IS_OBJECT) {
+		PHALCON_ALLOC_ZVAL_MM(t0);
+		PHALCON_CALL_METHOD(t0, this_ptr, "getinternalhandler", PH_NO_CHECK);
+	}
+	
 	PHALCON_ALLOC_ZVAL_MM(r0);
 	PHALCON_CALL_METHOD_PARAMS_1(r0, t0, "quote", str, PH_NO_CHECK);
 	RETURN_CTOR(r0);
@@ -533,6 +1078,10 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, bindParams){
 		
 		PHALCON_INIT_VAR(pdo);
 		phalcon_read_property(&pdo, this_ptr, SL("_pdo"), PH_NOISY_CC);
+		if (Z_TYPE_P(pdo) != IS_OBJECT) {
+			PHALCON_INIT_VAR(pdo);
+			PHALCON_CALL_METHOD(pdo, this_ptr, "getinternalhandler", PH_NO_CHECK);
+		}
 		if (!phalcon_valid_foreach(params TSRMLS_CC)) {
 			return;
 		}
@@ -48,6 +48,18 @@ PHP_METHOD(Phalcon_Db_Dialect, sharedLock){
 
 
 	
+}
+
+PHP_METHOD(Phalcon_Db_Dialect, escape){
+
+
+	
+}
+
+PHP_METHOD(Phalcon_Db_Dialect, escapeString){
+
+
+	
 }
 
 PHP_METHOD(Phalcon_Db_Dialect, getColumnList){
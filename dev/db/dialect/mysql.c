@@ -38,6 +38,8 @@
 #include "kernel/exception.h"
 #include "kernel/operators.h"
 
+#include "ext/standard/php_smart_str.h"
+
 /**
  * Phalcon\Db\Dialect\Mysql
  *
@@ -129,6 +131,228 @@ PHP_METHOD(Phalcon_Db_Dialect_Mysql, sharedLock){
 	RETURN_CTOR(r0);
 }
 
+/**
+ * Returns the maximum number of bind parameters a single statement can use.
+ * MySQL prepared statements accept up to 65535 placeholders
+ *
+ * @return int
+ */
+PHP_METHOD(Phalcon_Db_Dialect_Mysql, getMaxBindParams){
+
+
+	RETURN_LONG(65535);
+}
+
+/**
+ * Escapes an identifier so it can be used as the name of a table, a column or an alias. The name
+ * is enclosed in backquotes, the ones inside the name are doubled
+ *
+ *<code>
+ * echo $dialect->escape("robots");
+ * //`robots`
+ *</code>
+ *
+ * @param string $str
+ * @return string
+ */
+PHP_METHOD(Phalcon_Db_Dialect_Mysql, escape){
+
+	zval *str = NULL;
+	char *cursor, *end;
+	smart_str escaped = {0};
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &str) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(str) != IS_STRING) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Identifiers must be strings");
+		return;
+	}
+	
+	smart_str_appendc(&escaped, '`');
+	cursor = Z_STRVAL_P(str);
+	end = cursor + Z_STRLEN_P(str);
+	for (; cursor < end; cursor++) {
+		if (*cursor == '`') {
+			smart_str_appendc(&escaped, '`');
+		}
+		smart_str_appendc(&escaped, *cursor);
+	}
+	smart_str_appendc(&escaped, '`');
+	smart_str_0(&escaped);
+	
+	PHALCON_MM_RESTORE();
+	RETURN_STRINGL(escaped.c, escaped.len, 0);
+}
+
+/**
+ * Returns a string as a SQL literal. Single quotes are doubled and backslashes are
+ * escaped because MySQL reads them as escape characters unless NO_BACKSLASH_ESCAPES is enabled
+ *
+ *<code>
+ * echo $dialect->escapeString("Robotina's");
+ * //'Robotina''s'
+ *</code>
+ *
+ * @param string $str
+ * @return string
+ */
+PHP_METHOD(Phalcon_Db_Dialect_Mysql, escapeString){
+
+	zval *str = NULL;
+	char *cursor, *end;
+	smart_str escaped = {0};
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &str) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(str) != IS_STRING) {
+		PHALCON_SEPARATE_PARAM(str);
+		convert_to_string(str);
+	}
+	
+	smart_str_appendc(&escaped, '\'');
+	cursor = Z_STRVAL_P(str);
+	end = cursor + Z_STRLEN_P(str);
+	for (; cursor < end; cursor++) {
+		if (*cursor == '\'') {
+			smart_str_appendc(&escaped, '\'');
+		}
+		if (*cursor == '\\') {
+			smart_str_appendc(&escaped, '\\');
+		}
+		smart_str_appendc(&escaped, *cursor);
+	}
+	smart_str_appendc(&escaped, '\'');
+	smart_str_0(&escaped);
+	
+	PHALCON_MM_RESTORE();
+	RETURN_STRINGL(escaped.c, escaped.len, 0);
+}
+
+/**
+ * Generates a MySQL INSERT ... ON DUPLICATE KEY UPDATE statement. MySQL resolves the conflict
+ * with any unique index of the table, not only with the key fields, they are just excluded from
+ * the update list. When $updateFields is an array only those fields are updated. When an identity
+ * field is passed it is assigned with LAST_INSERT_ID() so lastInsertId() also reports the updated row
+ *
+ *<code>
+ * echo $dialect->upsert("robots", array("id", "name"), array("?", "?"), array("id"));
+ * //INSERT INTO robots (id, name) VALUES (?, ?) ON DUPLICATE KEY UPDATE name = VALUES(name)
+ *</code>
+ *
+ * @param string $table
+ * @param array $fields
+ * @param array $placeholders
+ * @param array $keyFields
+ * @param array $updateFields
+ * @param string $identityField
+ * @return string
+ */
+PHP_METHOD(Phalcon_Db_Dialect_Mysql, upsert){
+
+	zval *table = NULL, *fields = NULL, *placeholders = NULL, *key_fields = NULL;
+	zval *update_fields = NULL, *identity_field = NULL, *is_updated = NULL;
+	zval *assignments = NULL, *field = NULL, *is_key = NULL, *assignment = NULL;
+	zval *comma = NULL, *joined_fields = NULL, *joined_placeholders = NULL;
+	zval *joined_assignments = NULL, *sql = NULL;
+	zval *r0 = NULL;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zzzz|zz", &table, &fields, &placeholders, &key_fields, &update_fields, &identity_field) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(fields) != IS_ARRAY || Z_TYPE_P(placeholders) != IS_ARRAY || Z_TYPE_P(key_fields) != IS_ARRAY) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Fields, placeholders and key fields must be Arrays");
+		return;
+	}
+	if (!zend_hash_num_elements(Z_ARRVAL_P(key_fields))) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "At least one key field is required to generate an upsert");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(assignments);
+	array_init(assignments);
+	
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(fields), &hp0);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(fields), (void**) &hd, &hp0) == SUCCESS) {
+		PHALCON_INIT_VAR(field);
+		ZVAL_ZVAL(field, *hd, 1, 0);
+		
+		PHALCON_INIT_VAR(is_key);
+		PHALCON_CALL_FUNC_PARAMS_2(is_key, "in_array", field, key_fields);
+		if (!zend_is_true(is_key)) {
+			PHALCON_INIT_VAR(is_updated);
+			if (update_fields && Z_TYPE_P(update_fields) == IS_ARRAY) {
+				PHALCON_CALL_FUNC_PARAMS_2(is_updated, "in_array", field, update_fields);
+			} else {
+				ZVAL_BOOL(is_updated, 1);
+			}
+			if (zend_is_true(is_updated)) {
+				PHALCON_INIT_VAR(assignment);
+				PHALCON_CONCAT_VSVS(assignment, field, " = VALUES(", field, ")");
+				phalcon_array_append(&assignments, assignment, PH_SEPARATE TSRMLS_CC);
+			}
+		}
+		zend_hash_move_forward_ex(Z_ARRVAL_P(fields), &hp0);
+	}
+	
+	if (identity_field && zend_is_true(identity_field)) {
+		PHALCON_INIT_VAR(assignment);
+		PHALCON_CONCAT_VSVS(assignment, identity_field, " = LAST_INSERT_ID(", identity_field, ")");
+		phalcon_array_append(&assignments, assignment, PH_SEPARATE TSRMLS_CC);
+	}
+	
+	PHALCON_INIT_VAR(comma);
+	ZVAL_STRING(comma, ", ", 1);
+	
+	PHALCON_INIT_VAR(joined_fields);
+	phalcon_fast_join(joined_fields, comma, fields TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(joined_placeholders);
+	phalcon_fast_join(joined_placeholders, comma, placeholders TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(sql);
+	PHALCON_CONCAT_SVSVSVS(sql, "INSERT INTO ", table, " (", joined_fields, ") VALUES (", joined_placeholders, ")");
+	
+	/** 
+	 * A statement that only contains keys still needs an assignment to be valid
+	 */
+	if (!zend_hash_num_elements(Z_ARRVAL_P(assignments))) {
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(key_fields), &hp0);
+		zend_hash_get_current_data_ex(Z_ARRVAL_P(key_fields), (void**) &hd, &hp0);
+		
+		PHALCON_INIT_VAR(field);
+		ZVAL_ZVAL(field, *hd, 1, 0);
+		
+		PHALCON_INIT_VAR(assignment);
+		PHALCON_CONCAT_VSV(assignment, field, " = ", field);
+		phalcon_array_append(&assignments, assignment, PH_SEPARATE TSRMLS_CC);
+	}
+	
+	PHALCON_INIT_VAR(joined_assignments);
+	phalcon_fast_join(joined_assignments, comma, assignments TSRMLS_CC);
+	
+	PHALCON_ALLOC_ZVAL_MM(r0);
+	PHALCON_CONCAT_SV(r0, " ON DUPLICATE KEY UPDATE ", joined_assignments);
+	phalcon_concat_self(&sql, r0 TSRMLS_CC);
+	
+	RETURN_CTOR(sql);
+}
+
 /**
  * Gets a list of columns
  *
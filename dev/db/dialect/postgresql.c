@@ -38,6 +38,8 @@
 #include "kernel/exception.h"
 #include "kernel/operators.h"
 
+#include "ext/standard/php_smart_str.h"
+
 /**
  * Phalcon\Db\Dialect\Postgresql
  *
@@ -129,6 +131,209 @@ PHP_METHOD(Phalcon_Db_Dialect_Postgresql, sharedLock){
 	RETURN_CTOR(r0);
 }
 
+/**
+ * Returns the maximum number of bind parameters a single statement can use.
+ * PostgreSQL drivers count the parameters of a statement with a signed 16 bit integer
+ *
+ * @return int
+ */
+PHP_METHOD(Phalcon_Db_Dialect_Postgresql, getMaxBindParams){
+
+
+	RETURN_LONG(32767);
+}
+
+/**
+ * Escapes an identifier so it can be used as the name of a table, a column or an alias. The name
+ * is enclosed in double quotes, the ones inside the name are doubled
+ *
+ *<code>
+ * echo $dialect->escape("robots");
+ * //"robots"
+ *</code>
+ *
+ * @param string $str
+ * @return string
+ */
+PHP_METHOD(Phalcon_Db_Dialect_Postgresql, escape){
+
+	zval *str = NULL;
+	char *cursor, *end;
+	smart_str escaped = {0};
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &str) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(str) != IS_STRING) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Identifiers must be strings");
+		return;
+	}
+	
+	smart_str_appendc(&escaped, '"');
+	cursor = Z_STRVAL_P(str);
+	end = cursor + Z_STRLEN_P(str);
+	for (; cursor < end; cursor++) {
+		if (*cursor == '"') {
+			smart_str_appendc(&escaped, '"');
+		}
+		smart_str_appendc(&escaped, *cursor);
+	}
+	smart_str_appendc(&escaped, '"');
+	smart_str_0(&escaped);
+	
+	PHALCON_MM_RESTORE();
+	RETURN_STRINGL(escaped.c, escaped.len, 0);
+}
+
+/**
+ * Returns a string as a SQL literal. Single quotes are doubled, backslashes are kept as
+ * they are because standard conforming strings don't treat them as escape characters
+ *
+ *<code>
+ * echo $dialect->escapeString("Robotina's");
+ * //'Robotina''s'
+ *</code>
+ *
+ * @param string $str
+ * @return string
+ */
+PHP_METHOD(Phalcon_Db_Dialect_Postgresql, escapeString){
+
+	zval *str = NULL;
+	char *cursor, *end;
+	smart_str escaped = {0};
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &str) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(str) != IS_STRING) {
+		PHALCON_SEPARATE_PARAM(str);
+		convert_to_string(str);
+	}
+	
+	smart_str_appendc(&escaped, '\'');
+	cursor = Z_STRVAL_P(str);
+	end = cursor + Z_STRLEN_P(str);
+	for (; cursor < end; cursor++) {
+		if (*cursor == '\'') {
+			smart_str_appendc(&escaped, '\'');
+		}
+		smart_str_appendc(&escaped, *cursor);
+	}
+	smart_str_appendc(&escaped, '\'');
+	smart_str_0(&escaped);
+	
+	PHALCON_MM_RESTORE();
+	RETURN_STRINGL(escaped.c, escaped.len, 0);
+}
+
+/**
+ * Generates a PostgreSQL INSERT ... ON CONFLICT ... DO UPDATE statement using the key fields as
+ * conflict target. When $updateFields is an array only those fields are updated. The identity field
+ * is accepted for compatibility with other dialects, the conflict target already identifies the row
+ *
+ *<code>
+ * echo $dialect->upsert("robots", array("id", "name"), array("?", "?"), array("id"));
+ * //INSERT INTO robots (id, name) VALUES (?, ?) ON CONFLICT (id) DO UPDATE SET name = EXCLUDED.name
+ *</code>
+ *
+ * @param string $table
+ * @param array $fields
+ * @param array $placeholders
+ * @param array $keyFields
+ * @param array $updateFields
+ * @param string $identityField
+ * @return string
+ */
+PHP_METHOD(Phalcon_Db_Dialect_Postgresql, upsert){
+
+	zval *table = NULL, *fields = NULL, *placeholders = NULL, *key_fields = NULL;
+	zval *update_fields = NULL, *identity_field = NULL, *is_updated = NULL;
+	zval *assignments = NULL, *field = NULL, *is_key = NULL, *assignment = NULL;
+	zval *comma = NULL, *joined_fields = NULL, *joined_placeholders = NULL;
+	zval *joined_assignments = NULL, *sql = NULL;
+	zval *r0 = NULL;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zzzz|zz", &table, &fields, &placeholders, &key_fields, &update_fields, &identity_field) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(fields) != IS_ARRAY || Z_TYPE_P(placeholders) != IS_ARRAY || Z_TYPE_P(key_fields) != IS_ARRAY) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Fields, placeholders and key fields must be Arrays");
+		return;
+	}
+	if (!zend_hash_num_elements(Z_ARRVAL_P(key_fields))) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "At least one key field is required to generate an upsert");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(assignments);
+	array_init(assignments);
+	
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(fields), &hp0);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(fields), (void**) &hd, &hp0) == SUCCESS) {
+		PHALCON_INIT_VAR(field);
+		ZVAL_ZVAL(field, *hd, 1, 0);
+		
+		PHALCON_INIT_VAR(is_key);
+		PHALCON_CALL_FUNC_PARAMS_2(is_key, "in_array", field, key_fields);
+		if (!zend_is_true(is_key)) {
+			PHALCON_INIT_VAR(is_updated);
+			if (update_fields && Z_TYPE_P(update_fields) == IS_ARRAY) {
+				PHALCON_CALL_FUNC_PARAMS_2(is_updated, "in_array", field, update_fields);
+			} else {
+				ZVAL_BOOL(is_updated, 1);
+			}
+			if (zend_is_true(is_updated)) {
+				PHALCON_INIT_VAR(assignment);
+				PHALCON_CONCAT_VSV(assignment, field, " = EXCLUDED.", field);
+				phalcon_array_append(&assignments, assignment, PH_SEPARATE TSRMLS_CC);
+			}
+		}
+		zend_hash_move_forward_ex(Z_ARRVAL_P(fields), &hp0);
+	}
+	
+	PHALCON_INIT_VAR(comma);
+	ZVAL_STRING(comma, ", ", 1);
+	
+	PHALCON_INIT_VAR(joined_fields);
+	phalcon_fast_join(joined_fields, comma, fields TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(joined_placeholders);
+	phalcon_fast_join(joined_placeholders, comma, placeholders TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(sql);
+	PHALCON_CONCAT_SVSVSVS(sql, "INSERT INTO ", table, " (", joined_fields, ") VALUES (", joined_placeholders, ")");
+	
+	PHALCON_INIT_VAR(joined_fields);
+	phalcon_fast_join(joined_fields, comma, key_fields TSRMLS_CC);
+	
+	PHALCON_ALLOC_ZVAL_MM(r0);
+	if (zend_hash_num_elements(Z_ARRVAL_P(assignments))) {
+		PHALCON_INIT_VAR(joined_assignments);
+		phalcon_fast_join(joined_assignments, comma, assignments TSRMLS_CC);
+		PHALCON_CONCAT_SVSV(r0, " ON CONFLICT (", joined_fields, ") DO UPDATE SET ", joined_assignments);
+	} else {
+		PHALCON_CONCAT_SVS(r0, " ON CONFLICT (", joined_fields, ") DO NOTHING");
+	}
+	phalcon_concat_self(&sql, r0 TSRMLS_CC);
+	
+	RETURN_CTOR(sql);
+}
+
 /**
  * Gets a list of columns
  *
@@ -35,6 +35,7 @@
 #include "kernel/exception.h"
 #include "kernel/object.h"
 #include "kernel/fcall.h"
+#include "kernel/operators.h"
 
 /**
  * Phalcon\Db\Result\Pdo
@@ -44,18 +45,284 @@
  * 
  */
 
+/**
+ * Reads the names of the columns returned by a statement. Columns without a name keep their position.
+ * On FAILURE the memory stack of the caller has already been restored
+ */
+static int phalcon_db_result_pdo_columns(zval *columns, zval *statement TSRMLS_DC){
+
+	zval *column_count, *position, *meta;
+	zval **name;
+	long i, number_columns;
+
+	ALLOC_INIT_ZVAL(column_count);
+	if (phalcon_call_method(column_count, statement, SL("columncount"), PH_NO_CHECK, 1 TSRMLS_CC) == FAILURE) {
+		zval_ptr_dtor(&column_count);
+		return FAILURE;
+	}
+	number_columns = phalcon_get_intval(column_count);
+	zval_ptr_dtor(&column_count);
+
+	for (i = 0; i < number_columns; i++) {
+
+		ALLOC_INIT_ZVAL(position);
+		ZVAL_LONG(position, i);
+		ALLOC_INIT_ZVAL(meta);
+		if (phalcon_call_method_one_param(meta, statement, SL("getcolumnmeta"), position, PH_NO_CHECK, 1 TSRMLS_CC) == FAILURE) {
+			zval_ptr_dtor(&position);
+			zval_ptr_dtor(&meta);
+			return FAILURE;
+		}
+
+		if (Z_TYPE_P(meta) == IS_ARRAY && zend_hash_find(Z_ARRVAL_P(meta), SS("name"), (void**) &name) == SUCCESS) {
+			Z_ADDREF_PP(name);
+			add_next_index_zval(columns, *name);
+		} else {
+			add_next_index_long(columns, i);
+		}
+
+		zval_ptr_dtor(&position);
+		zval_ptr_dtor(&meta);
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * Fetches the next row directly from the statement of an unbuffered result. The cursor is closed after
+ * the last row so the connection can run other queries, the statement is kept for getInternalResult.
+ * On FAILURE the memory stack of the caller has already been restored
+ */
+static int phalcon_db_result_pdo_fetch_statement(zval *return_value, zval *this_ptr, zval *fetch_mode TSRMLS_DC){
+
+	zval *statement, *pointer;
+
+	statement = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_pdoStatement"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(statement) != IS_OBJECT) {
+		ZVAL_BOOL(return_value, 0);
+		return SUCCESS;
+	}
+
+	if (phalcon_call_method_one_param(return_value, statement, SL("fetch"), fetch_mode, PH_NO_CHECK, 1 TSRMLS_CC) == FAILURE) {
+		return FAILURE;
+	}
+
+	if (Z_TYPE_P(return_value) != IS_ARRAY) {
+		phalcon_call_method(NULL, statement, SL("closecursor"), PH_NO_CHECK, 0 TSRMLS_CC);
+		return SUCCESS;
+	}
+
+	pointer = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_pointer"), 1 TSRMLS_CC);
+	phalcon_update_property_long(this_ptr, SL("_pointer"), phalcon_get_intval(pointer) + 1 TSRMLS_CC);
+	return SUCCESS;
+}
+
+/**
+ * Returns the rows read so far, separating them when they are shared so new rows can be appended in place
+ */
+static zval *phalcon_db_result_pdo_rows(zval *this_ptr TSRMLS_DC){
+
+	zval *rows, *copy;
+
+	rows = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_rows"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(rows) == IS_ARRAY && Z_REFCOUNT_P(rows) == 1) {
+		return rows;
+	}
+
+	ALLOC_INIT_ZVAL(copy);
+	if (Z_TYPE_P(rows) == IS_ARRAY) {
+		ZVAL_ZVAL(copy, rows, 1, 0);
+	} else {
+		array_init(copy);
+	}
+	zend_update_property(phalcon_db_result_pdo_ce, this_ptr, SL("_rows"), copy TSRMLS_CC);
+	zval_ptr_dtor(&copy);
+
+	return zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_rows"), 1 TSRMLS_CC);
+}
+
+/**
+ * Reads the names of the columns before the first row is fetched, they are used to build associative rows
+ * from the numeric rows kept by the result. On FAILURE the memory stack of the caller has already been restored
+ */
+static int phalcon_db_result_pdo_load_columns(zval *this_ptr, zval *statement TSRMLS_DC){
+
+	zval *columns;
+
+	columns = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_columns"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(columns) == IS_ARRAY) {
+		return SUCCESS;
+	}
+
+	ALLOC_INIT_ZVAL(columns);
+	array_init(columns);
+	if (phalcon_db_result_pdo_columns(columns, statement TSRMLS_CC) == FAILURE) {
+		zval_ptr_dtor(&columns);
+		return FAILURE;
+	}
+	zend_update_property(phalcon_db_result_pdo_ce, this_ptr, SL("_columns"), columns TSRMLS_CC);
+	zval_ptr_dtor(&columns);
+
+	return SUCCESS;
+}
+
+/**
+ * Reads the next row of the statement into the rows kept by the result. Every row fetched is kept, so the
+ * result can move backwards or be counted without executing the statement again. *fetched is 0 when the
+ * statement has no more rows, its cursor is then closed so the connection can run other queries.
+ * On FAILURE the memory stack of the caller has already been restored
+ */
+static int phalcon_db_result_pdo_fetch_next(zval *this_ptr, int *fetched TSRMLS_DC){
+
+	zval *drained, *statement, *mode, *row;
+
+	*fetched = 0;
+
+	drained = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_drained"), 1 TSRMLS_CC);
+	if (zend_is_true(drained)) {
+		return SUCCESS;
+	}
+
+	statement = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_pdoStatement"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(statement) != IS_OBJECT) {
+		phalcon_update_property_bool(this_ptr, SL("_drained"), 1 TSRMLS_CC);
+		return SUCCESS;
+	}
+
+	if (phalcon_db_result_pdo_load_columns(this_ptr, statement TSRMLS_CC) == FAILURE) {
+		return FAILURE;
+	}
+
+	ALLOC_INIT_ZVAL(mode);
+	ZVAL_LONG(mode, 3);
+	ALLOC_INIT_ZVAL(row);
+	if (phalcon_call_method_one_param(row, statement, SL("fetch"), mode, PH_NO_CHECK, 1 TSRMLS_CC) == FAILURE) {
+		zval_ptr_dtor(&mode);
+		zval_ptr_dtor(&row);
+		return FAILURE;
+	}
+	zval_ptr_dtor(&mode);
+
+	if (Z_TYPE_P(row) != IS_ARRAY) {
+		zval_ptr_dtor(&row);
+		phalcon_call_method(NULL, statement, SL("closecursor"), PH_NO_CHECK, 0 TSRMLS_CC);
+		phalcon_update_property_bool(this_ptr, SL("_drained"), 1 TSRMLS_CC);
+		return SUCCESS;
+	}
+
+	add_next_index_zval(phalcon_db_result_pdo_rows(this_ptr TSRMLS_CC), row);
+	*fetched = 1;
+
+	return SUCCESS;
+}
+
+/**
+ * Finds the row at a position, fetching rows from the statement until it is reached. *row is NULL when the
+ * result has fewer rows. On FAILURE the memory stack of the caller has already been restored
+ */
+static int phalcon_db_result_pdo_row(zval ***row, zval *this_ptr, long position TSRMLS_DC){
+
+	zval *rows;
+	int fetched;
+
+	*row = NULL;
+	if (position < 0) {
+		return SUCCESS;
+	}
+
+	while (1) {
+		rows = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_rows"), 1 TSRMLS_CC);
+		if (Z_TYPE_P(rows) == IS_ARRAY && zend_hash_index_find(Z_ARRVAL_P(rows), position, (void**) row) == SUCCESS) {
+			return SUCCESS;
+		}
+		if (phalcon_db_result_pdo_fetch_next(this_ptr, &fetched TSRMLS_CC) == FAILURE) {
+			return FAILURE;
+		}
+		if (!fetched) {
+			*row = NULL;
+			return SUCCESS;
+		}
+	}
+}
+
+/**
+ * Reads the rows the statement has not returned yet with a single fetchAll, the rows fetched before are
+ * kept, so the statement is never executed again. It is only called when the rows must be counted and
+ * the driver doesn't report them. On FAILURE the memory stack of the caller has already been restored
+ */
+static int phalcon_db_result_pdo_buffer(zval *this_ptr TSRMLS_DC){
+
+	zval *drained, *statement, *mode, *remaining, *rows;
+	zval **row;
+	HashPosition hp;
+
+	drained = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_drained"), 1 TSRMLS_CC);
+	if (zend_is_true(drained)) {
+		phalcon_db_result_pdo_rows(this_ptr TSRMLS_CC);
+		return SUCCESS;
+	}
+
+	statement = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_pdoStatement"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(statement) == IS_OBJECT) {
+		Z_ADDREF_P(statement);
+
+		if (phalcon_db_result_pdo_load_columns(this_ptr, statement TSRMLS_CC) == FAILURE) {
+			zval_ptr_dtor(&statement);
+			return FAILURE;
+		}
+
+		ALLOC_INIT_ZVAL(mode);
+		ZVAL_LONG(mode, 3);
+		ALLOC_INIT_ZVAL(remaining);
+		if (phalcon_call_method_one_param(remaining, statement, SL("fetchall"), mode, PH_NO_CHECK, 1 TSRMLS_CC) == FAILURE) {
+			zval_ptr_dtor(&mode);
+			zval_ptr_dtor(&remaining);
+			zval_ptr_dtor(&statement);
+			return FAILURE;
+		}
+		zval_ptr_dtor(&mode);
+
+		phalcon_call_method(NULL, statement, SL("closecursor"), PH_NO_CHECK, 0 TSRMLS_CC);
+		zval_ptr_dtor(&statement);
+
+		rows = phalcon_db_result_pdo_rows(this_ptr TSRMLS_CC);
+		if (Z_TYPE_P(remaining) == IS_ARRAY) {
+			zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(remaining), &hp);
+			while (zend_hash_get_current_data_ex(Z_ARRVAL_P(remaining), (void**) &row, &hp) == SUCCESS) {
+				Z_ADDREF_PP(row);
+				add_next_index_zval(rows, *row);
+				zend_hash_move_forward_ex(Z_ARRVAL_P(remaining), &hp);
+			}
+		}
+		zval_ptr_dtor(&remaining);
+	} else {
+		phalcon_db_result_pdo_rows(this_ptr TSRMLS_CC);
+	}
+
+	phalcon_update_property_bool(this_ptr, SL("_drained"), 1 TSRMLS_CC);
+
+	return SUCCESS;
+}
+
 /**
  * Phalcon\Db\Result\Pdo constructor
  *
+ * Rows are fetched from the statement as they are read and kept by the result, so the statement is executed
+ * only once however the result is traversed. Unbuffered results fetch the rows directly from the statement
+ * without keeping them, they can be traversed only once.
+ * Drivers whose rowCount() reports the rows returned by a SELECT don't need to read them to count them
+ *
  * @param PDOStatement $result
+ * @param boolean $unbuffered
+ * @param boolean $exactRowCount
  */
 PHP_METHOD(Phalcon_Db_Result_Pdo, __construct){
 
-	zval *result = NULL;
+	zval *result = NULL, *unbuffered = NULL, *exact_row_count = NULL;
 
 	PHALCON_MM_GROW();
 	
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &result) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|zz", &result, &unbuffered, &exact_row_count) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
@@ -65,6 +332,12 @@ PHP_METHOD(Phalcon_Db_Result_Pdo, __construct){
 		return;
 	}
 	phalcon_update_property_zval(this_ptr, SL("_pdoStatement"), result TSRMLS_CC);
+	if (unbuffered && zend_is_true(unbuffered)) {
+		phalcon_update_property_bool(this_ptr, SL("_unbuffered"), 1 TSRMLS_CC);
+	}
+	if (exact_row_count && zend_is_true(exact_row_count)) {
+		phalcon_update_property_bool(this_ptr, SL("_exactRowCount"), 1 TSRMLS_CC);
+	}
 	
 	PHALCON_MM_RESTORE();
 }
@@ -77,45 +350,122 @@ PHP_METHOD(Phalcon_Db_Result_Pdo, __construct){
  */
 PHP_METHOD(Phalcon_Db_Result_Pdo, fetchArray){
 
-	zval *t0 = NULL;
-	zval *r0 = NULL;
+	zval *unbuffered, *columns, *pointer, *fetch_mode;
+	zval **row, **value, **name;
+	HashPosition hp;
+	long position;
 
 	PHALCON_MM_GROW();
-	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_pdoStatement"), PH_NOISY_CC);
-	PHALCON_ALLOC_ZVAL_MM(r0);
-	PHALCON_CALL_METHOD(r0, t0, "fetch", PH_NO_CHECK);
-	RETURN_CTOR(r0);
+	
+	fetch_mode = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_fetchMode"), 1 TSRMLS_CC);
+	
+	unbuffered = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_unbuffered"), 1 TSRMLS_CC);
+	if (zend_is_true(unbuffered)) {
+		if (phalcon_db_result_pdo_fetch_statement(return_value, this_ptr, fetch_mode TSRMLS_CC) == FAILURE) {
+			return;
+		}
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	pointer = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_pointer"), 1 TSRMLS_CC);
+	position = phalcon_get_intval(pointer);
+	if (phalcon_db_result_pdo_row(&row, this_ptr, position TSRMLS_CC) == FAILURE) {
+		return;
+	}
+	if (!row) {
+		PHALCON_MM_RESTORE();
+		RETURN_FALSE;
+	}
+	phalcon_update_property_long(this_ptr, SL("_pointer"), position + 1 TSRMLS_CC);
+	
+	if (phalcon_get_intval(fetch_mode) == 3 || Z_TYPE_PP(row) != IS_ARRAY) {
+		PHALCON_MM_RESTORE();
+		RETURN_ZVAL(*row, 1, 0);
+	}
+	
+	/** Associative rows are built from the numeric row kept by the result, later columns win like in PDO */
+	columns = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_columns"), 1 TSRMLS_CC);
+	array_init_size(return_value, zend_hash_num_elements(Z_ARRVAL_PP(row)) * (phalcon_get_intval(fetch_mode) == 4 ? 2 : 1));
+	
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(columns), &hp);
+	for (position = 0; zend_hash_index_find(Z_ARRVAL_PP(row), position, (void**) &value) == SUCCESS; position++) {
+		if (zend_hash_get_current_data_ex(Z_ARRVAL_P(columns), (void**) &name, &hp) == SUCCESS) {
+			Z_ADDREF_PP(value);
+			if (Z_TYPE_PP(name) == IS_STRING) {
+				zend_symtable_update(Z_ARRVAL_P(return_value), Z_STRVAL_PP(name), Z_STRLEN_PP(name) + 1, value, sizeof(zval *), NULL);
+			} else {
+				zend_hash_index_update(Z_ARRVAL_P(return_value), phalcon_get_intval(*name), value, sizeof(zval *), NULL);
+			}
+			zend_hash_move_forward_ex(Z_ARRVAL_P(columns), &hp);
+		}
+		if (phalcon_get_intval(fetch_mode) == 4) {
+			Z_ADDREF_PP(value);
+			zend_hash_index_update(Z_ARRVAL_P(return_value), position, value, sizeof(zval *), NULL);
+		}
+	}
+	
+	PHALCON_MM_RESTORE();
 }
 
 /**
- * Gets number of rows returned by a resulset
+ * Gets number of rows returned by a resulset. The rows not fetched yet are only read to count them
+ * when the driver doesn't report the number of rows returned by a SELECT
  *
  * @return int
  */
 PHP_METHOD(Phalcon_Db_Result_Pdo, numRows){
 
-	zval *t0 = NULL;
-	zval *r0 = NULL;
+	zval *rows, *drained, *statement, *unbuffered, *exact_row_count;
+	zval *r0 = NULL, *r1 = NULL;
 
 	PHALCON_MM_GROW();
-	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_pdoStatement"), PH_NOISY_CC);
-	PHALCON_ALLOC_ZVAL_MM(r0);
-	PHALCON_CALL_METHOD(r0, t0, "rowcount", PH_NO_CHECK);
-	RETURN_CTOR(r0);
+	
+	unbuffered = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_unbuffered"), 1 TSRMLS_CC);
+	if (zend_is_true(unbuffered)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "The number of rows is not available for unbuffered results");
+		return;
+	}
+	
+	drained = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_drained"), 1 TSRMLS_CC);
+	if (!zend_is_true(drained)) {
+		statement = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_pdoStatement"), 1 TSRMLS_CC);
+		if (Z_TYPE_P(statement) == IS_OBJECT) {
+			
+			/** Statements that do not return columns only report the number of affected rows */
+			exact_row_count = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_exactRowCount"), 1 TSRMLS_CC);
+			if (!zend_is_true(exact_row_count)) {
+				PHALCON_ALLOC_ZVAL_MM(r0);
+				PHALCON_CALL_METHOD(r0, statement, "columncount", PH_NO_CHECK);
+			}
+			if (zend_is_true(exact_row_count) || !zend_is_true(r0)) {
+				PHALCON_ALLOC_ZVAL_MM(r1);
+				PHALCON_CALL_METHOD(r1, statement, "rowcount", PH_NO_CHECK);
+				RETURN_CTOR(r1);
+			}
+		}
+		if (phalcon_db_result_pdo_buffer(this_ptr TSRMLS_CC) == FAILURE) {
+			return;
+		}
+	}
+	
+	rows = phalcon_db_result_pdo_rows(this_ptr TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+	RETURN_LONG(zend_hash_num_elements(Z_ARRVAL_P(rows)));
 }
 
 /**
- * Moves internal resulset cursor to another position letting us to fetch a certain row
+ * Moves internal resulset cursor to another position letting us to fetch a certain row.
+ * Rows are fetched from the statement when they are read and kept by the result, so moving
+ * backwards never executes the query again. Unbuffered results can only move forward
  *
  * @param int $number 
  */
 PHP_METHOD(Phalcon_Db_Result_Pdo, dataSeek){
 
-	zval *number = NULL, *n = NULL, *pdo_statement = NULL, *result = NULL;
-	zval *r0 = NULL, *r1 = NULL;
-	zval *t0 = NULL, *t1 = NULL;
+	zval *number = NULL, *unbuffered, *pointer, *mode = NULL, *row = NULL;
+	long position;
 
 	PHALCON_MM_GROW();
 	
@@ -124,39 +474,32 @@ PHP_METHOD(Phalcon_Db_Result_Pdo, dataSeek){
 		RETURN_NULL();
 	}
 
-	PHALCON_SEPARATE_PARAM(number);
+	unbuffered = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_unbuffered"), 1 TSRMLS_CC);
+	if (zend_is_true(unbuffered)) {
+		pointer = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_pointer"), 1 TSRMLS_CC);
+		position = phalcon_get_intval(pointer);
+		if (phalcon_get_intval(number) < position) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Unbuffered results cannot be rewound");
+			return;
+		}
+		PHALCON_INIT_VAR(mode);
+		ZVAL_LONG(mode, 3);
+		while (position < phalcon_get_intval(number)) {
+			PHALCON_INIT_VAR(row);
+			if (phalcon_db_result_pdo_fetch_statement(row, this_ptr, mode TSRMLS_CC) == FAILURE) {
+				return;
+			}
+			if (Z_TYPE_P(row) != IS_ARRAY) {
+				break;
+			}
+			position++;
+		}
+		PHALCON_MM_RESTORE();
+		return;
+	}
 	
-	PHALCON_INIT_VAR(t1);
-	ZVAL_LONG(t1, 1);
-	PHALCON_INIT_VAR(t0);
-	ZVAL_LONG(t0, -1);
-	PHALCON_ALLOC_ZVAL_MM(r0);
-	mul_function(r0, t0, t1 TSRMLS_CC);
-	PHALCON_CPY_WRT(n, r0);
-	decrement_function(number);
-	
-	PHALCON_INIT_VAR(pdo_statement);
-	phalcon_read_property(&pdo_statement, this_ptr, SL("_pdoStatement"), PH_NOISY_CC);
-	PHALCON_CALL_METHOD_NORETURN(pdo_statement, "execute", PH_NO_CHECK);
-	ws_a5eb_0:
-		
-		PHALCON_INIT_VAR(r1);
-		is_not_equal_function(r1, n, number TSRMLS_CC);
-		if (!zend_is_true(r1)) {
-			goto we_a5eb_0;
-		}
-		PHALCON_INIT_VAR(result);
-		PHALCON_CALL_METHOD(result, pdo_statement, "fetch", PH_NO_CHECK);
-		if (Z_TYPE_P(result) != IS_ARRAY) { 
-			PHALCON_MM_RESTORE();
-			RETURN_NULL();
-		}
-		
-		PHALCON_SEPARATE(n);
-		increment_function(n);
-		goto ws_a5eb_0;
-	we_a5eb_0:
-	if(0){}
+	/** The rows up to the new position are fetched when they are read */
+	phalcon_update_property_long(this_ptr, SL("_pointer"), phalcon_get_intval(number) TSRMLS_CC);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -168,10 +511,9 @@ PHP_METHOD(Phalcon_Db_Result_Pdo, dataSeek){
  */
 PHP_METHOD(Phalcon_Db_Result_Pdo, setFetchMode){
 
-	zval *fetch_mode = NULL, *pdo_statement = NULL;
+	zval *fetch_mode = NULL;
 	zval *t0 = NULL, *t1 = NULL, *t2 = NULL;
 	zval *r0 = NULL, *r1 = NULL, *r2 = NULL;
-	zval *c0 = NULL, *c1 = NULL, *c2 = NULL;
 
 	PHALCON_MM_GROW();
 	
@@ -180,18 +522,12 @@ PHP_METHOD(Phalcon_Db_Result_Pdo, setFetchMode){
 		RETURN_NULL();
 	}
 
-	PHALCON_INIT_VAR(pdo_statement);
-	phalcon_read_property(&pdo_statement, this_ptr, SL("_pdoStatement"), PH_NOISY_CC);
-	
 	PHALCON_INIT_VAR(t0);
 	ZVAL_LONG(t0, 1);
 	
 	PHALCON_ALLOC_ZVAL_MM(r0);
 	is_equal_function(r0, fetch_mode, t0 TSRMLS_CC);
 	if (zend_is_true(r0)) {
-		PHALCON_INIT_VAR(c0);
-		ZVAL_LONG(c0, 2);
-		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(pdo_statement, "setfetchmode", c0, PH_NO_CHECK);
 		phalcon_update_property_long(this_ptr, SL("_fetchMode"), 2 TSRMLS_CC);
 	} else {
 		PHALCON_INIT_VAR(t1);
@@ -199,9 +535,6 @@ PHP_METHOD(Phalcon_Db_Result_Pdo, setFetchMode){
 		PHALCON_ALLOC_ZVAL_MM(r1);
 		is_equal_function(r1, fetch_mode, t1 TSRMLS_CC);
 		if (zend_is_true(r1)) {
-			PHALCON_INIT_VAR(c1);
-			ZVAL_LONG(c1, 4);
-			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(pdo_statement, "setfetchmode", c1, PH_NO_CHECK);
 			phalcon_update_property_long(this_ptr, SL("_fetchMode"), 4 TSRMLS_CC);
 		} else {
 			PHALCON_INIT_VAR(t2);
@@ -209,9 +542,6 @@ PHP_METHOD(Phalcon_Db_Result_Pdo, setFetchMode){
 			PHALCON_ALLOC_ZVAL_MM(r2);
 			is_equal_function(r2, fetch_mode, t2 TSRMLS_CC);
 			if (zend_is_true(r2)) {
-				PHALCON_INIT_VAR(c2);
-				ZVAL_LONG(c2, 3);
-				PHALCON_CALL_METHOD_PARAMS_1_NORETURN(pdo_statement, "setfetchmode", c2, PH_NO_CHECK);
 				phalcon_update_property_long(this_ptr, SL("_fetchMode"), 3 TSRMLS_CC);
 			}
 		}
@@ -221,6 +551,95 @@ PHP_METHOD(Phalcon_Db_Result_Pdo, setFetchMode){
 	RETURN_NULL();
 }
 
+/**
+ * Returns the names of the columns in the result, in the same order they have in the rows
+ * returned by Phalcon\Db\Result\Pdo::fetchRows
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Db_Result_Pdo, getColumns){
+
+	zval *columns, *statement;
+
+	PHALCON_MM_GROW();
+	
+	statement = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_pdoStatement"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(statement) == IS_OBJECT) {
+		if (phalcon_db_result_pdo_load_columns(this_ptr, statement TSRMLS_CC) == FAILURE) {
+			return;
+		}
+	}
+	
+	columns = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_columns"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(columns) == IS_ARRAY) {
+		PHALCON_MM_RESTORE();
+		RETURN_ZVAL(columns, 1, 0);
+	}
+	
+	PHALCON_MM_RESTORE();
+	array_init(return_value);
+}
+
+/**
+ * Returns up to $limit numeric rows starting at the current position and moves the cursor after them.
+ * An empty array is returned when there are no more rows. This method is not affected by the fetch mode
+ *
+ * @param int $limit
+ * @return array
+ */
+PHP_METHOD(Phalcon_Db_Result_Pdo, fetchRows){
+
+	zval *limit = NULL, *unbuffered, *pointer, *mode, *row;
+	zval **kept_row;
+	long position, i, number_rows;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &limit) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	number_rows = phalcon_get_intval(limit);
+	array_init(return_value);
+	
+	unbuffered = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_unbuffered"), 1 TSRMLS_CC);
+	if (zend_is_true(unbuffered)) {
+		PHALCON_ALLOC_ZVAL_MM(mode);
+		ZVAL_LONG(mode, 3);
+		for (i = 0; i < number_rows; i++) {
+			ALLOC_INIT_ZVAL(row);
+			if (phalcon_db_result_pdo_fetch_statement(row, this_ptr, mode TSRMLS_CC) == FAILURE) {
+				zval_ptr_dtor(&row);
+				return;
+			}
+			if (Z_TYPE_P(row) != IS_ARRAY) {
+				zval_ptr_dtor(&row);
+				break;
+			}
+			add_next_index_zval(return_value, row);
+		}
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	pointer = zend_read_property(phalcon_db_result_pdo_ce, this_ptr, SL("_pointer"), 1 TSRMLS_CC);
+	position = phalcon_get_intval(pointer);
+	for (i = 0; i < number_rows; i++) {
+		if (phalcon_db_result_pdo_row(&kept_row, this_ptr, position + i TSRMLS_CC) == FAILURE) {
+			return;
+		}
+		if (!kept_row) {
+			break;
+		}
+		Z_ADDREF_PP(kept_row);
+		add_next_index_zval(return_value, *kept_row);
+	}
+	
+	phalcon_update_property_long(this_ptr, SL("_pointer"), position + i TSRMLS_CC);
+	PHALCON_MM_RESTORE();
+}
+
 /**
  * Gets the internal PDO result object
  *
@@ -232,8 +651,7 @@ PHP_METHOD(Phalcon_Db_Result_Pdo, getInternalResult){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_result"), PH_NOISY_CC);
+	phalcon_read_property(&t0, this_ptr, SL("_pdoStatement"), PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
-
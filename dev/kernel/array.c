@@ -78,6 +78,16 @@ int phalcon_array_isset_string(const zval *arr, char *index, uint index_length){
 	return zend_hash_exists(Z_ARRVAL_P(arr), index, index_length);
 }
 
+/**
+ * Check if char index exists on an array zval using a precomputed hash, index_length includes the trailing NUL
+ */
+int phalcon_array_isset_quick_string(const zval *arr, char *index, uint index_length, ulong key){
+	if (Z_TYPE_P(arr) != IS_ARRAY) {
+		return 0;
+	}
+	return zend_hash_quick_exists(Z_ARRVAL_P(arr), index, index_length, key);
+}
+
 /**
  * Check if char index exists on an array zval
  */
@@ -500,6 +510,36 @@ int phalcon_array_fetch_string(zval **return_value, zval *arr, char *index, uint
 
 }
 
+/**
+ * Reads an item from an array using a string as index and a precomputed hash, index_length includes the trailing NUL
+ */
+int phalcon_array_fetch_quick_string(zval **return_value, zval *arr, char *index, uint index_length, ulong key, int silent TSRMLS_DC){
+
+	zval **zv;
+
+	ZVAL_NULL(*return_value);
+
+	if (Z_TYPE_P(arr) != IS_ARRAY) {
+		if (silent == PH_NOISY) {
+			php_error_docref(NULL TSRMLS_CC, E_NOTICE, "Cannot use a scalar value as an array");
+		}
+		return FAILURE;
+	}
+
+	if (zend_hash_quick_find(Z_ARRVAL_P(arr), index, index_length, key, (void**)&zv) == SUCCESS) {
+		zval_ptr_dtor(return_value);
+		*return_value = *zv;
+		Z_ADDREF_PP(return_value);
+		return SUCCESS;
+	}
+
+	if (silent == PH_NOISY) {
+		php_error_docref(NULL TSRMLS_CC, E_NOTICE, "Undefined index: %s", index);
+	}
+
+	return FAILURE;
+}
+
 /**
  * Reads an item from an array using a long as index
  */
@@ -17,10 +17,15 @@
   +------------------------------------------------------------------------+
 */
 
+/** Quick access to indexes named by string literals, the hash is computed once per call site */
+#define PHALCON_ARRAY_ISSET_QUICK_STRING(result, arr, index) { static ulong phalcon_hash_key = 0; if (!phalcon_hash_key) { phalcon_hash_key = zend_inline_hash_func(SS(index)); } result = phalcon_array_isset_quick_string(arr, SS(index), phalcon_hash_key); }
+#define PHALCON_ARRAY_FETCH_QUICK_STRING(return_value, arr, index, silent) { static ulong phalcon_hash_key = 0; if (!phalcon_hash_key) { phalcon_hash_key = zend_inline_hash_func(SS(index)); } phalcon_array_fetch_quick_string(return_value, arr, SS(index), phalcon_hash_key, silent); }
+
 /** Check for index existence */
 extern int phalcon_array_isset(const zval *arr, zval *index);
 extern int phalcon_array_isset_long(const zval *arr, ulong index);
 extern int phalcon_array_isset_string(const zval *arr, char *index, uint index_length);
+extern int phalcon_array_isset_quick_string(const zval *arr, char *index, uint index_length, ulong key);
 
 /** Unset existing indexes */
 extern int phalcon_array_unset(zval *arr, zval *index);
@@ -56,5 +61,6 @@ extern void phalcon_array_update_multi_append_2(zval **arr, zval *index1, zval *
 /** Fetch items from arrays */
 extern int phalcon_array_fetch(zval **return_value, zval *arr, zval *index, int silent TSRMLS_DC);
 extern int phalcon_array_fetch_string(zval **return_value, zval *arr, char *index, uint index_length, int silent TSRMLS_DC);
+extern int phalcon_array_fetch_quick_string(zval **return_value, zval *arr, char *index, uint index_length, ulong key, int silent TSRMLS_DC);
 extern int phalcon_array_fetch_long(zval **return_value, zval *arr, ulong index, int silent TSRMLS_DC);
 
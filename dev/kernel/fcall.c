@@ -32,6 +32,7 @@
 #include "Zend/zend_API.h"
 #include "Zend/zend_exceptions.h"
 #include "Zend/zend_execute.h"
+#include "Zend/zend_interfaces.h"
 
 /**
  * Finds the correct scope to execute the function
@@ -354,6 +355,180 @@ int phalcon_call_method_four_params(zval *return_value, zval *object, char *meth
 	return phalcon_call_method_params(return_value, object, method_name, method_len, 4, params, check, noreturn TSRMLS_CC);
 }
 
+/**
+ * Checks whether a private or protected method can be called from the active scope
+ */
+static int phalcon_fcall_visible(zend_function *func TSRMLS_DC){
+
+	zend_class_entry *root;
+
+	if (func->common.fn_flags & ZEND_ACC_PRIVATE) {
+		return func->common.scope == EG(scope);
+	}
+
+	if (func->common.fn_flags & ZEND_ACC_PROTECTED) {
+		root = func->common.prototype ? func->common.prototype->common.scope : func->common.scope;
+		return EG(scope) && zend_check_protected(root, EG(scope));
+	}
+
+	return 1;
+}
+
+/**
+ * Resolves a function in a function table using the call site cache. Private and protected methods are
+ * only resolved when the active scope can call them, the check is repeated when the scope changes
+ */
+static zend_function *phalcon_fcall_cache_lookup(phalcon_fcall_cache_entry *cache, HashTable *function_table, zend_class_entry *ce, char *name, int name_len TSRMLS_DC){
+
+	zend_function *func;
+	char *lcname;
+
+	if (cache) {
+		if (cache->func && cache->ce == ce && cache->generation == PHALCON_GLOBAL(fcall_generation)) {
+			/** Some call sites pass a variable name */
+			if (!zend_binary_strcasecmp(cache->func->common.function_name, strlen(cache->func->common.function_name), name, name_len)) {
+				if (cache->scope == EG(scope) || !(cache->func->common.fn_flags & (ZEND_ACC_PRIVATE | ZEND_ACC_PROTECTED))) {
+					return cache->func;
+				}
+			}
+		}
+	}
+
+	lcname = zend_str_tolower_dup(name, name_len);
+	if (zend_hash_find(function_table, lcname, name_len+1, (void **) &func) != SUCCESS) {
+		efree(lcname);
+		return NULL;
+	}
+	efree(lcname);
+
+	if (func->common.fn_flags & ZEND_ACC_ABSTRACT) {
+		return NULL;
+	}
+
+	/** Methods that aren't visible are called in the normal way, which reports the error */
+	if (ce && !phalcon_fcall_visible(func TSRMLS_CC)) {
+		return NULL;
+	}
+
+	if (cache) {
+		cache->ce = ce;
+		cache->func = func;
+		cache->scope = EG(scope);
+		cache->generation = PHALCON_GLOBAL(fcall_generation);
+	}
+
+	return func;
+}
+
+/**
+ * Calls an already resolved function or method without looking it up by name
+ */
+static int phalcon_call_resolved_function(zval *return_value, zval *object, zend_class_entry *ce, zend_function *func, zend_uint param_count, zval *params[], int noreturn TSRMLS_DC){
+
+	zval fn, *local_retval_ptr = NULL;
+	zval ***params_array = NULL, **static_params_array[10];
+	zend_fcall_info fci;
+	zend_fcall_info_cache fcc;
+	zend_uint i;
+	int status;
+
+	if (!noreturn) {
+		ALLOC_INIT_ZVAL(return_value);
+	}
+
+	if (param_count) {
+		if (param_count > 10) {
+			params_array = (zval ***) emalloc(sizeof(zval **) * param_count);
+		} else {
+			params_array = static_params_array;
+		}
+		for (i = 0; i < param_count; i++) {
+			params_array[i] = &params[i];
+		}
+	}
+
+	INIT_ZVAL(fn);
+	ZVAL_STRING(&fn, (char *) func->common.function_name, 0);
+
+	fci.size = sizeof(fci);
+	fci.function_table = ce ? &ce->function_table : CG(function_table);
+	fci.function_name = &fn;
+	fci.symbol_table = NULL;
+	fci.object_ptr = object;
+	fci.retval_ptr_ptr = &local_retval_ptr;
+	fci.param_count = param_count;
+	fci.params = params_array;
+	fci.no_separation = 1;
+
+	fcc.initialized = 1;
+	fcc.function_handler = func;
+	fcc.calling_scope = ce;
+	fcc.called_scope = ce;
+	fcc.object_ptr = object;
+
+	status = zend_call_function(&fci, &fcc TSRMLS_CC);
+
+	if (local_retval_ptr) {
+		COPY_PZVAL_TO_ZVAL(*return_value, local_retval_ptr);
+	} else {
+		INIT_ZVAL(*return_value);
+	}
+
+	if (params_array && params_array != static_params_array) {
+		efree(params_array);
+	}
+
+	if (!noreturn) {
+		zval_ptr_dtor(&return_value);
+	}
+
+	if (EG(exception)){
+		status = FAILURE;
+	}
+
+	if (status == FAILURE) {
+		phalcon_memory_restore_stack(TSRMLS_C);
+	}
+
+	return status;
+}
+
+/**
+ * Calls a function resolving it through the call site cache
+ */
+int phalcon_call_func_cached(zval *return_value, char *func_name, int func_length, zend_uint param_count, zval *params[], int noreturn, phalcon_fcall_cache_entry *cache TSRMLS_DC){
+
+	zend_function *func;
+
+	func = phalcon_fcall_cache_lookup(cache, CG(function_table), NULL, func_name, func_length TSRMLS_CC);
+	if (!func) {
+		return phalcon_call_func_params_normal(return_value, func_name, func_length, param_count, params, noreturn TSRMLS_CC);
+	}
+
+	return phalcon_call_resolved_function(return_value, NULL, NULL, func, param_count, params, noreturn TSRMLS_CC);
+}
+
+/**
+ * Calls a method resolving it through the call site cache. Methods that can't be resolved,
+ * like the ones handled by __call, are called in the normal way
+ */
+int phalcon_call_method_cached(zval *return_value, zval *object, char *method_name, int method_len, zend_uint param_count, zval *params[], int check, int noreturn, phalcon_fcall_cache_entry *cache TSRMLS_DC){
+
+	zend_function *func = NULL;
+	zend_class_entry *ce = NULL;
+
+	if (Z_TYPE_P(object) == IS_OBJECT) {
+		ce = Z_OBJCE_P(object);
+		func = phalcon_fcall_cache_lookup(cache, &ce->function_table, ce, method_name, method_len TSRMLS_CC);
+	}
+
+	if (!func) {
+		return phalcon_call_method_params_normal(return_value, object, method_name, method_len, param_count, params, check, noreturn TSRMLS_CC);
+	}
+
+	return phalcon_call_resolved_function(return_value, object, ce, func, param_count, params, noreturn TSRMLS_CC);
+}
+
 /**
  * Call parent static function which not requires parameters
  */
@@ -725,6 +900,18 @@ int phalcon_call_static_ce_func_params(zval *return_value, zend_class_entry *ce,
 
 }
 
+/**
+ * Calls a method with one or no parameters even if an exception is pending, like a rollback after a
+ * failed statement or releasing a lock. The pending exception is kept aside during the call and restored
+ * afterwards
+ */
+void phalcon_call_method_cleanup(zval *object, char *method_name, int method_len, zval *param TSRMLS_DC){
+
+	zend_exception_save(TSRMLS_C);
+	zend_call_method(&object, Z_OBJCE_P(object), NULL, method_name, method_len, NULL, param ? 1 : 0, param, NULL TSRMLS_CC);
+	zend_exception_restore(TSRMLS_C);
+}
+
 #if PHP_VERSION_ID <= 50303
 
 int phalcon_call_user_function(HashTable *function_table, zval **object_pp, zval *function_name, zval *retval_ptr, zend_uint param_count, zval *params[] TSRMLS_DC) {
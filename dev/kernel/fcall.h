@@ -17,29 +17,48 @@
   +------------------------------------------------------------------------+
 */
 
-#define PHALCON_CALL_FUNC(return_value, func_name) if(phalcon_call_func(return_value, func_name, strlen(func_name), 1 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_FUNC_NORETURN(func_name) if(phalcon_call_func(NULL, func_name, strlen(func_name), 0 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_FUNC_PARAMS(return_value, func_name, param_count, params) if(phalcon_call_func_params(return_value, func_name, strlen(func_name), param_count, params, 1 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_FUNC_PARAMS_NORETURN(func_name, param_count, params) if(phalcon_call_func_params(NULL, func_name, strlen(func_name), param_count, params, 0 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_FUNC_PARAMS_1(return_value, func_name, param1) if(phalcon_call_func_one_param(return_value, func_name, strlen(func_name), param1, 1 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_FUNC_PARAMS_1_NORETURN(func_name, param1) if(phalcon_call_func_one_param(NULL, func_name, strlen(func_name), param1, 0 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_FUNC_PARAMS_2(return_value, func_name, param1, param2) if(phalcon_call_func_two_params(return_value, func_name, strlen(func_name), param1, param2, 1 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_FUNC_PARAMS_2_NORETURN(func_name, param1, param2) if(phalcon_call_func_two_params(NULL, func_name, strlen(func_name), param1, param2, 0 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_FUNC_PARAMS_3(return_value, func_name, param1, param2, param3) if(phalcon_call_func_three_params(return_value, func_name, strlen(func_name), param1, param2, param3, 1 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_FUNC_PARAMS_3_NORETURN(func_name, param1, param2, param3) if(phalcon_call_func_three_params(NULL, func_name, strlen(func_name), param1, param2, param3, 0 TSRMLS_CC)==FAILURE) return;
-
-#define PHALCON_CALL_METHOD(return_value, object, method_name, check) if(phalcon_call_method(return_value, object, method_name, strlen(method_name), check, 1 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_METHOD_NORETURN(object, method_name, check) if(phalcon_call_method(NULL, object, method_name, strlen(method_name), check, 0 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_METHOD_PARAMS(return_value, object, method_name, param_count, params, check) if(phalcon_call_method_params(return_value, object, method_name, strlen(method_name), param_count, params, check, 1 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_METHOD_PARAMS_NORETURN(object, method_name, param_count, params, check) if(phalcon_call_method_params(NULL, object, method_name, strlen(method_name), param_count, params, check, 0 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_METHOD_PARAMS_1(return_value, object, method_name, param1, check) if(phalcon_call_method_one_param(return_value, object, method_name, strlen(method_name), param1, check, 1 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_METHOD_PARAMS_1_NORETURN(object, method_name, param1, check) if(phalcon_call_method_one_param(NULL, object, method_name, strlen(method_name), param1, check, 0 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_METHOD_PARAMS_2(return_value, object, method_name, param1, param2, check) if(phalcon_call_method_two_params(return_value, object, method_name, strlen(method_name), param1, param2, check, 1 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_METHOD_PARAMS_2_NORETURN(object, method_name, param1, param2, check) if(phalcon_call_method_two_params(NULL, object, method_name, strlen(method_name), param1, param2, check, 0 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_METHOD_PARAMS_3(return_value, object, method_name, param1, param2, param3, check) if(phalcon_call_method_three_params(return_value, object, method_name, strlen(method_name), param1, param2, param3, check, 1 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_METHOD_PARAMS_3_NORETURN(object, method_name, param1, param2, param3, check) if(phalcon_call_method_three_params(NULL, object, method_name, strlen(method_name), param1, param2, param3, check, 0 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_METHOD_PARAMS_4(return_value, object, method_name, param1, param2, param3, param4, check) if(phalcon_call_method_four_params(return_value, object, method_name, strlen(method_name), param1, param2, param3, param4, check, 1 TSRMLS_CC)==FAILURE) return;
-#define PHALCON_CALL_METHOD_PARAMS_4_NORETURN(object, method_name, param1, param2, param3, param4, check) if(phalcon_call_method_four_params(NULL, object, method_name, strlen(method_name), param1, param2, param3, param4, check, 0 TSRMLS_CC)==FAILURE) return;
+/** Call site cache */
+typedef struct _phalcon_fcall_cache_entry {
+	zend_class_entry *ce;
+	zend_function *func;
+	zend_class_entry *scope;
+	ulong generation;
+} phalcon_fcall_cache_entry;
+
+/**
+ * Every call site keeps the function resolved the last time it ran. User classes and functions
+ * are destroyed at the end of the request, so entries from previous requests are discarded.
+ * Static entries are shared between threads, so the cache is only used in non-ZTS builds
+ */
+#ifndef ZTS
+#define PHALCON_FCALL_CACHE_DECL static phalcon_fcall_cache_entry phalcon_fcall_cache_site = { NULL, NULL, NULL, 0 }; phalcon_fcall_cache_entry *phalcon_fcall_cache = &phalcon_fcall_cache_site
+#else
+#define PHALCON_FCALL_CACHE_DECL phalcon_fcall_cache_entry *phalcon_fcall_cache = NULL
+#endif
+
+#define PHALCON_CALL_FUNC(return_value, func_name) do { PHALCON_FCALL_CACHE_DECL; if(phalcon_call_func_cached(return_value, func_name, strlen(func_name), 0, NULL, 1, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_FUNC_NORETURN(func_name) do { PHALCON_FCALL_CACHE_DECL; if(phalcon_call_func_cached(NULL, func_name, strlen(func_name), 0, NULL, 0, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_FUNC_PARAMS(return_value, func_name, param_count, params) do { PHALCON_FCALL_CACHE_DECL; if(phalcon_call_func_cached(return_value, func_name, strlen(func_name), param_count, params, 1, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_FUNC_PARAMS_NORETURN(func_name, param_count, params) do { PHALCON_FCALL_CACHE_DECL; if(phalcon_call_func_cached(NULL, func_name, strlen(func_name), param_count, params, 0, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_FUNC_PARAMS_1(return_value, func_name, param1) do { PHALCON_FCALL_CACHE_DECL; zval *phalcon_fcall_params[1]; phalcon_fcall_params[0] = param1; if(phalcon_call_func_cached(return_value, func_name, strlen(func_name), 1, phalcon_fcall_params, 1, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_FUNC_PARAMS_1_NORETURN(func_name, param1) do { PHALCON_FCALL_CACHE_DECL; zval *phalcon_fcall_params[1]; phalcon_fcall_params[0] = param1; if(phalcon_call_func_cached(NULL, func_name, strlen(func_name), 1, phalcon_fcall_params, 0, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_FUNC_PARAMS_2(return_value, func_name, param1, param2) do { PHALCON_FCALL_CACHE_DECL; zval *phalcon_fcall_params[2]; phalcon_fcall_params[0] = param1; phalcon_fcall_params[1] = param2; if(phalcon_call_func_cached(return_value, func_name, strlen(func_name), 2, phalcon_fcall_params, 1, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_FUNC_PARAMS_2_NORETURN(func_name, param1, param2) do { PHALCON_FCALL_CACHE_DECL; zval *phalcon_fcall_params[2]; phalcon_fcall_params[0] = param1; phalcon_fcall_params[1] = param2; if(phalcon_call_func_cached(NULL, func_name, strlen(func_name), 2, phalcon_fcall_params, 0, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_FUNC_PARAMS_3(return_value, func_name, param1, param2, param3) do { PHALCON_FCALL_CACHE_DECL; zval *phalcon_fcall_params[3]; phalcon_fcall_params[0] = param1; phalcon_fcall_params[1] = param2; phalcon_fcall_params[2] = param3; if(phalcon_call_func_cached(return_value, func_name, strlen(func_name), 3, phalcon_fcall_params, 1, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_FUNC_PARAMS_3_NORETURN(func_name, param1, param2, param3) do { PHALCON_FCALL_CACHE_DECL; zval *phalcon_fcall_params[3]; phalcon_fcall_params[0] = param1; phalcon_fcall_params[1] = param2; phalcon_fcall_params[2] = param3; if(phalcon_call_func_cached(NULL, func_name, strlen(func_name), 3, phalcon_fcall_params, 0, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+
+#define PHALCON_CALL_METHOD(return_value, object, method_name, check) do { PHALCON_FCALL_CACHE_DECL; if(phalcon_call_method_cached(return_value, object, method_name, strlen(method_name), 0, NULL, check, 1, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_METHOD_NORETURN(object, method_name, check) do { PHALCON_FCALL_CACHE_DECL; if(phalcon_call_method_cached(NULL, object, method_name, strlen(method_name), 0, NULL, check, 0, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_METHOD_PARAMS(return_value, object, method_name, param_count, params, check) do { PHALCON_FCALL_CACHE_DECL; if(phalcon_call_method_cached(return_value, object, method_name, strlen(method_name), param_count, params, check, 1, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_METHOD_PARAMS_NORETURN(object, method_name, param_count, params, check) do { PHALCON_FCALL_CACHE_DECL; if(phalcon_call_method_cached(NULL, object, method_name, strlen(method_name), param_count, params, check, 0, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_METHOD_PARAMS_1(return_value, object, method_name, param1, check) do { PHALCON_FCALL_CACHE_DECL; zval *phalcon_fcall_params[1]; phalcon_fcall_params[0] = param1; if(phalcon_call_method_cached(return_value, object, method_name, strlen(method_name), 1, phalcon_fcall_params, check, 1, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_METHOD_PARAMS_1_NORETURN(object, method_name, param1, check) do { PHALCON_FCALL_CACHE_DECL; zval *phalcon_fcall_params[1]; phalcon_fcall_params[0] = param1; if(phalcon_call_method_cached(NULL, object, method_name, strlen(method_name), 1, phalcon_fcall_params, check, 0, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_METHOD_PARAMS_2(return_value, object, method_name, param1, param2, check) do { PHALCON_FCALL_CACHE_DECL; zval *phalcon_fcall_params[2]; phalcon_fcall_params[0] = param1; phalcon_fcall_params[1] = param2; if(phalcon_call_method_cached(return_value, object, method_name, strlen(method_name), 2, phalcon_fcall_params, check, 1, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_METHOD_PARAMS_2_NORETURN(object, method_name, param1, param2, check) do { PHALCON_FCALL_CACHE_DECL; zval *phalcon_fcall_params[2]; phalcon_fcall_params[0] = param1; phalcon_fcall_params[1] = param2; if(phalcon_call_method_cached(NULL, object, method_name, strlen(method_name), 2, phalcon_fcall_params, check, 0, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_METHOD_PARAMS_3(return_value, object, method_name, param1, param2, param3, check) do { PHALCON_FCALL_CACHE_DECL; zval *phalcon_fcall_params[3]; phalcon_fcall_params[0] = param1; phalcon_fcall_params[1] = param2; phalcon_fcall_params[2] = param3; if(phalcon_call_method_cached(return_value, object, method_name, strlen(method_name), 3, phalcon_fcall_params, check, 1, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_METHOD_PARAMS_3_NORETURN(object, method_name, param1, param2, param3, check) do { PHALCON_FCALL_CACHE_DECL; zval *phalcon_fcall_params[3]; phalcon_fcall_params[0] = param1; phalcon_fcall_params[1] = param2; phalcon_fcall_params[2] = param3; if(phalcon_call_method_cached(NULL, object, method_name, strlen(method_name), 3, phalcon_fcall_params, check, 0, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_METHOD_PARAMS_4(return_value, object, method_name, param1, param2, param3, param4, check) do { PHALCON_FCALL_CACHE_DECL; zval *phalcon_fcall_params[4]; phalcon_fcall_params[0] = param1; phalcon_fcall_params[1] = param2; phalcon_fcall_params[2] = param3; phalcon_fcall_params[3] = param4; if(phalcon_call_method_cached(return_value, object, method_name, strlen(method_name), 4, phalcon_fcall_params, check, 1, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
+#define PHALCON_CALL_METHOD_PARAMS_4_NORETURN(object, method_name, param1, param2, param3, param4, check) do { PHALCON_FCALL_CACHE_DECL; zval *phalcon_fcall_params[4]; phalcon_fcall_params[0] = param1; phalcon_fcall_params[1] = param2; phalcon_fcall_params[2] = param3; phalcon_fcall_params[3] = param4; if(phalcon_call_method_cached(NULL, object, method_name, strlen(method_name), 4, phalcon_fcall_params, check, 0, phalcon_fcall_cache TSRMLS_CC)==FAILURE) return; } while (0)
 
 #define PHALCON_CALL_PARENT_PARAMS(return_value, object, active_class, method_name, param_count, params) if(phalcon_call_parent_func_params(return_value, object, active_class, strlen(active_class), method_name, strlen(method_name), param_count, params, 1 TSRMLS_CC)==FAILURE) return;
 #define PHALCON_CALL_PARENT_PARAMS_NORETURN(object, active_class, method_name, param_count, params) if(phalcon_call_parent_func_params(NULL, object, active_class, strlen(active_class),method_name, strlen(method_name), param_count, params, 0 TSRMLS_CC)==FAILURE) return;
@@ -87,6 +106,9 @@ int phalcon_cache_lookup_method(char *func_name, int func_name_length TSRMLS_DC)
 int phalcon_cache_lookup_function(char *func_name, int func_name_length, int fcache_pointer TSRMLS_DC);
 
 /** Call single functions */
+extern int phalcon_call_func_cached(zval *return_value, char *func_name, int func_length, zend_uint param_count, zval *params[], int noreturn, phalcon_fcall_cache_entry *cache TSRMLS_DC);
+extern int phalcon_call_method_cached(zval *return_value, zval *object, char *method_name, int method_len, zend_uint param_count, zval *params[], int check, int noreturn, phalcon_fcall_cache_entry *cache TSRMLS_DC);
+
 extern int phalcon_call_func(zval *return_value, char *func_name, int func_length, int noreturn TSRMLS_DC);
 extern int phalcon_call_func_params(zval *return_value, char *func_name, int func_length, zend_uint param_count, zval *params[], int noreturn TSRMLS_DC);
 extern int phalcon_call_func_one_param(zval *return_value, char *func_name, int func_length, zval *param1, int noreturn TSRMLS_DC);
@@ -127,6 +149,9 @@ extern int phalcon_call_static_zval_func(zval *return_value, zval *mixed_name, c
 extern int phalcon_call_static_zval_func_params(zval *return_value, zval *mixed_name, char *method_name, int method_len, zend_uint param_count, zval *params[], int noreturn TSRMLS_DC);
 extern int phalcon_call_static_zval_func_one_param(zval *return_value, zval *mixed_name, char *method_name, int method_len, zval *param1, int noreturn TSRMLS_DC);
 
+/** Call methods while an exception is pending */
+extern void phalcon_call_method_cleanup(zval *object, char *method_name, int method_len, zval *param TSRMLS_DC);
+
 /** Call functions */
 int phalcon_call_user_function(HashTable *function_table, zval **object_pp, zval *function_name, zval *retval_ptr, zend_uint param_count, zval *params[] TSRMLS_DC);
 int phalcon_call_user_function_ex(HashTable *function_table, zval **object_pp, zval *function_name, zval **retval_ptr_ptr, zend_uint param_count, zval **params[], int no_separation, HashTable *symbol_table TSRMLS_DC);
@@ -40,11 +40,43 @@ void php_phalcon_init_globals(zend_phalcon_globals *phalcon_globals TSRMLS_DC){
     phalcon_globals->phalcon_memory_stack = 0;
     phalcon_globals->start_memory = NULL;
 	phalcon_globals->active_memory = NULL;
+	phalcon_globals->router_cache = NULL;
+	phalcon_globals->metadata_maps = NULL;
+	phalcon_globals->phql_cache = NULL;
+	phalcon_globals->phql_plans = NULL;
+	phalcon_globals->fcall_generation = 0;
+	phalcon_globals->db_write_generation = 0;
 	#ifndef PHALCON_RELEASE
 	phalcon_globals->phalcon_stack_stats = 0;
 	#endif
 }
 
+/**
+ * Releases the persistent memory held by the globals when the process or thread finishes
+ */
+void php_phalcon_destroy_globals(zend_phalcon_globals *phalcon_globals TSRMLS_DC){
+	if (phalcon_globals->router_cache) {
+		zend_hash_destroy(phalcon_globals->router_cache);
+		pefree(phalcon_globals->router_cache, 1);
+		phalcon_globals->router_cache = NULL;
+	}
+	if (phalcon_globals->metadata_maps) {
+		zend_hash_destroy(phalcon_globals->metadata_maps);
+		pefree(phalcon_globals->metadata_maps, 1);
+		phalcon_globals->metadata_maps = NULL;
+	}
+	if (phalcon_globals->phql_cache) {
+		zend_hash_destroy(phalcon_globals->phql_cache);
+		pefree(phalcon_globals->phql_cache, 1);
+		phalcon_globals->phql_cache = NULL;
+	}
+	if (phalcon_globals->phql_plans) {
+		zend_hash_destroy(phalcon_globals->phql_plans);
+		pefree(phalcon_globals->phql_plans, 1);
+		phalcon_globals->phql_plans = NULL;
+	}
+}
+
 /**
  * Initilializes super global variables if doesn't
  */
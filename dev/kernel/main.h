@@ -48,6 +48,7 @@
 #endif
 
 #define SL(str) ZEND_STRL(str)
+#define SS(str) ZEND_STRS(str)
 
 /** SPL dependencies */
 #if defined(HAVE_SPL) && ((PHP_MAJOR_VERSION > 5) || (PHP_MAJOR_VERSION == 5 && PHP_MINOR_VERSION >= 1))
@@ -61,6 +62,7 @@ extern PHPAPI zend_class_entry *spl_ce_SeekableIterator;
 
 /** Startup functions */
 extern void php_phalcon_init_globals(zend_phalcon_globals *phalcon_globals TSRMLS_DC);
+extern void php_phalcon_destroy_globals(zend_phalcon_globals *phalcon_globals TSRMLS_DC);
 
 /** Globals functions */
 extern int phalcon_init_global(char *global, int global_length TSRMLS_DC);
@@ -157,6 +159,18 @@ extern int phalcon_set_symbol(zval *key_name, zval *value TSRMLS_DC);
 		}\
 	}
 
+/**
+ * Borrows the current foreach element by adding a reference instead of duplicating it.
+ * References are still copied. Code writing to the variable must separate it first
+ */
+#define PHALCON_GET_FOREACH_VALUE(var) \
+	if (Z_ISREF_PP(hd)) { \
+		PHALCON_INIT_VAR(var); \
+		ZVAL_ZVAL(var, *hd, 1, 0); \
+	} else { \
+		PHALCON_CPY_WRT(var, *hd); \
+	}
+
 #define PHALCON_REGISTER_CLASS(ns, classname, name, methods, flags) \
 	{ \
 		zend_class_entry ce; \
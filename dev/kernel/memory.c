@@ -61,25 +61,39 @@ inline void phalcon_cpy_wrt(zval **dest, zval *var TSRMLS_DC){
 }
 
 /**
- * Initializes memory stack for the active function
+ * Initializes memory stack for the active function. Frames are taken from a pool that is kept
+ * during the whole request, so entering a method doesn't need to allocate memory
  */
 int phalcon_memory_grow_stack(TSRMLS_D){
 
-	phalcon_memory_entry *entry;
+	phalcon_memory_entry *entry, *active_memory;
 
-	if(!PHALCON_GLOBAL(start_memory)){
-		PHALCON_GLOBAL(start_memory) = (phalcon_memory_entry *) emalloc(sizeof(phalcon_memory_entry));
-		PHALCON_GLOBAL(start_memory)->pointer = -1;
-		PHALCON_GLOBAL(start_memory)->prev = NULL;
-		PHALCON_GLOBAL(start_memory)->next = NULL;
-		PHALCON_GLOBAL(active_memory) = PHALCON_GLOBAL(start_memory);		
+	if (!PHALCON_GLOBAL(start_memory)) {
+		entry = (phalcon_memory_entry *) emalloc(sizeof(phalcon_memory_entry));
+		entry->pointer = -1;
+		entry->capacity = 0;
+		entry->addresses = NULL;
+		entry->prev = NULL;
+		entry->next = NULL;
+		PHALCON_GLOBAL(start_memory) = entry;
+	}
+
+	active_memory = PHALCON_GLOBAL(active_memory);
+	if (!active_memory) {
+		active_memory = PHALCON_GLOBAL(start_memory);
+	}
+
+	entry = active_memory->next;
+	if (!entry) {
+		entry = (phalcon_memory_entry *) emalloc(sizeof(phalcon_memory_entry));
+		entry->capacity = PHALCON_MEMORY_FRAME_CHUNK;
+		entry->addresses = (zval ***) emalloc(sizeof(zval **) * PHALCON_MEMORY_FRAME_CHUNK);
+		entry->prev = active_memory;
+		entry->next = NULL;
+		active_memory->next = entry;
 	}
 
-	entry = (phalcon_memory_entry *) emalloc(sizeof(phalcon_memory_entry));
-	entry->addresses[0] = NULL;
 	entry->pointer = -1;
-	entry->prev = PHALCON_GLOBAL(active_memory);
-	PHALCON_GLOBAL(active_memory)->next = entry;
 	PHALCON_GLOBAL(active_memory) = entry;
 
 	return SUCCESS;
@@ -94,51 +108,30 @@ int phalcon_memory_restore_stack(TSRMLS_D){
 	phalcon_memory_entry *prev;
 	phalcon_memory_entry *active_memory = PHALCON_GLOBAL(active_memory);
 
-	if(active_memory != NULL){
+	if (active_memory != NULL) {
 
-		/*#ifndef PHALCON_RELEASE
-		if(!PHALCON_GLOBAL(phalcon_stack_stats)){
-			PHALCON_GLOBAL(phalcon_stack_stats) = active_memory->pointer;
-		} else {
-			if (active_memory->pointer > PHALCON_GLOBAL(phalcon_stack_stats)) {
-				PHALCON_GLOBAL(phalcon_stack_stats) = active_memory->pointer;
-			}
-		}
-		#endif*/
-
-		if (active_memory->pointer > -1) {
-			for (i=active_memory->pointer;i>=0;i--) {
-				if(active_memory->addresses[i] != NULL){
-					if(*active_memory->addresses[i] != NULL ){
-						if (Z_REFCOUNT_PP(active_memory->addresses[i])-1 == 0) {
-							zval_ptr_dtor(active_memory->addresses[i]);
-							*active_memory->addresses[i] = NULL;
-							active_memory->addresses[i] = NULL;
-						} else {
-							Z_DELREF_PP(active_memory->addresses[i]);
-							if (Z_REFCOUNT_PP(active_memory->addresses[i]) == 1) {
-								active_memory->addresses[i] = NULL;
-							}
-						}
+		for (i = active_memory->pointer; i >= 0; i--) {
+			if (active_memory->addresses[i] != NULL) {
+				if (*active_memory->addresses[i] != NULL) {
+					if (Z_REFCOUNT_PP(active_memory->addresses[i])-1 == 0) {
+						zval_ptr_dtor(active_memory->addresses[i]);
+						*active_memory->addresses[i] = NULL;
+					} else {
+						Z_DELREF_PP(active_memory->addresses[i]);
 					}
 				}
 			}
 		}
 
+		/** The frame stays in the pool to be reused by the next method */
+		active_memory->pointer = -1;
+
 		prev = active_memory->prev;
-		efree(PHALCON_GLOBAL(active_memory));
-		PHALCON_GLOBAL(active_memory) = prev;
-		if (prev != NULL) {
-			PHALCON_GLOBAL(active_memory)->next = NULL;
-			if (PHALCON_GLOBAL(active_memory) == PHALCON_GLOBAL(start_memory)) {
-				efree(PHALCON_GLOBAL(active_memory));
-				PHALCON_GLOBAL(start_memory) = NULL;
-				PHALCON_GLOBAL(active_memory) = NULL;
-			}
-		} else {			
-			PHALCON_GLOBAL(start_memory) = NULL;
+		if (prev == PHALCON_GLOBAL(start_memory)) {
 			PHALCON_GLOBAL(active_memory) = NULL;
-		}		
+		} else {
+			PHALCON_GLOBAL(active_memory) = prev;
+		}
 
 	} else {
 		return FAILURE;
@@ -147,20 +140,24 @@ int phalcon_memory_restore_stack(TSRMLS_D){
 	return SUCCESS;
 }
 
+/**
+ * Reserves a slot in the active frame, growing it if needed
+ */
+static inline void phalcon_memory_reserve(phalcon_memory_entry *active_memory){
+	if (active_memory->pointer + 1 >= active_memory->capacity) {
+		active_memory->capacity *= 2;
+		active_memory->addresses = (zval ***) erealloc(active_memory->addresses, sizeof(zval **) * active_memory->capacity);
+	}
+	active_memory->pointer++;
+}
+
 /**
  * Observes a memory pointer to release its memory at the end of the request
  */
 int phalcon_memory_observe(zval **var TSRMLS_DC){
 	phalcon_memory_entry *active_memory = PHALCON_GLOBAL(active_memory);
-	active_memory->pointer++;
-	#ifndef PHALCON_RELEASE
-	if(active_memory->pointer>=(PHALCON_MAX_MEMORY_STACK-1)){
-		fprintf(stderr, "ERROR: Phalcon memory stack is too small %d", PHALCON_MAX_MEMORY_STACK);
-		return FAILURE;
-	}
-	#endif
+	phalcon_memory_reserve(active_memory);
 	active_memory->addresses[active_memory->pointer] = var;
-	active_memory->addresses[active_memory->pointer+1] = NULL;
 	return SUCCESS;
 }
 
@@ -169,15 +166,8 @@ int phalcon_memory_observe(zval **var TSRMLS_DC){
  */
 int phalcon_memory_alloc(zval **var TSRMLS_DC){
 	phalcon_memory_entry *active_memory = PHALCON_GLOBAL(active_memory);
-	active_memory->pointer++;
-	#ifndef PHALCON_RELEASE
-	if(active_memory->pointer>=(PHALCON_MAX_MEMORY_STACK-1)){
-		fprintf(stderr, "ERROR: Phalcon memory stack is too small %d", PHALCON_MAX_MEMORY_STACK);
-		return FAILURE;
-	}
-	#endif
+	phalcon_memory_reserve(active_memory);
 	active_memory->addresses[active_memory->pointer] = var;
-	active_memory->addresses[active_memory->pointer+1] = NULL;
 	ALLOC_ZVAL(*var);
 	INIT_PZVAL(*var);
 	return SUCCESS;
@@ -200,4 +190,163 @@ int phalcon_clean_restore_stack(TSRMLS_D){
 		phalcon_memory_restore_stack(TSRMLS_C);
 	}
 	return SUCCESS;
-}
\ No newline at end of file
+}
+
+/**
+ * Releases the frames pool at the end of the request. Frames left by an aborted request point
+ * to variables that no longer exist, so they are discarded without releasing them
+ */
+void phalcon_memory_destroy_pool(TSRMLS_D){
+
+	phalcon_memory_entry *entry, *next;
+
+	entry = PHALCON_GLOBAL(start_memory);
+	while (entry) {
+		next = entry->next;
+		if (entry->addresses) {
+			efree(entry->addresses);
+		}
+		efree(entry);
+		entry = next;
+	}
+
+	PHALCON_GLOBAL(start_memory) = NULL;
+	PHALCON_GLOBAL(active_memory) = NULL;
+}
+
+/**
+ * Destructor for zvals stored in persistent hash tables
+ */
+static void phalcon_persistent_dtor(void *data){
+	zval **value = (zval **) data;
+	phalcon_persistent_free(*value);
+}
+
+/**
+ * Copies a zval into persistent memory so it can be kept between requests.
+ * Only scalars, strings and arrays of them can be copied
+ */
+int phalcon_persistent_copy(zval **destiny, zval *value){
+
+	zval *copy, **item, *item_copy;
+	HashTable *ht;
+	HashPosition pos;
+	char *key;
+	uint key_length;
+	ulong index;
+
+	copy = (zval *) pemalloc(sizeof(zval), 1);
+	INIT_PZVAL(copy);
+
+	switch (Z_TYPE_P(value)) {
+
+		case IS_NULL:
+		case IS_BOOL:
+		case IS_LONG:
+		case IS_DOUBLE:
+			copy->value = value->value;
+			Z_TYPE_P(copy) = Z_TYPE_P(value);
+			break;
+
+		case IS_STRING:
+			Z_TYPE_P(copy) = IS_STRING;
+			Z_STRLEN_P(copy) = Z_STRLEN_P(value);
+			Z_STRVAL_P(copy) = (char *) pemalloc(Z_STRLEN_P(value) + 1, 1);
+			memcpy(Z_STRVAL_P(copy), Z_STRVAL_P(value), Z_STRLEN_P(value) + 1);
+			break;
+
+		case IS_ARRAY:
+			ht = (HashTable *) pemalloc(sizeof(HashTable), 1);
+			zend_hash_init(ht, zend_hash_num_elements(Z_ARRVAL_P(value)), NULL, phalcon_persistent_dtor, 1);
+			Z_TYPE_P(copy) = IS_ARRAY;
+			Z_ARRVAL_P(copy) = ht;
+
+			zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(value), &pos);
+			while (zend_hash_get_current_data_ex(Z_ARRVAL_P(value), (void**) &item, &pos) == SUCCESS) {
+
+				if (phalcon_persistent_copy(&item_copy, *item) == FAILURE) {
+					phalcon_persistent_free(copy);
+					return FAILURE;
+				}
+
+				if (zend_hash_get_current_key_ex(Z_ARRVAL_P(value), &key, &key_length, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+					zend_hash_update(ht, key, key_length, &item_copy, sizeof(zval *), NULL);
+				} else {
+					zend_hash_index_update(ht, index, &item_copy, sizeof(zval *), NULL);
+				}
+
+				zend_hash_move_forward_ex(Z_ARRVAL_P(value), &pos);
+			}
+			break;
+
+		default:
+			pefree(copy, 1);
+			return FAILURE;
+	}
+
+	*destiny = copy;
+	return SUCCESS;
+}
+
+/**
+ * Copies a zval created by phalcon_persistent_copy back into request memory
+ */
+void phalcon_persistent_restore(zval *destiny, zval *value){
+
+	zval **item, *item_copy;
+	HashPosition pos;
+	char *key;
+	uint key_length;
+	ulong index;
+
+	switch (Z_TYPE_P(value)) {
+
+		case IS_STRING:
+			ZVAL_STRINGL(destiny, Z_STRVAL_P(value), Z_STRLEN_P(value), 1);
+			break;
+
+		case IS_ARRAY:
+			array_init_size(destiny, zend_hash_num_elements(Z_ARRVAL_P(value)));
+
+			zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(value), &pos);
+			while (zend_hash_get_current_data_ex(Z_ARRVAL_P(value), (void**) &item, &pos) == SUCCESS) {
+
+				ALLOC_INIT_ZVAL(item_copy);
+				phalcon_persistent_restore(item_copy, *item);
+
+				if (zend_hash_get_current_key_ex(Z_ARRVAL_P(value), &key, &key_length, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+					zend_hash_update(Z_ARRVAL_P(destiny), key, key_length, &item_copy, sizeof(zval *), NULL);
+				} else {
+					zend_hash_index_update(Z_ARRVAL_P(destiny), index, &item_copy, sizeof(zval *), NULL);
+				}
+
+				zend_hash_move_forward_ex(Z_ARRVAL_P(value), &pos);
+			}
+			break;
+
+		default:
+			destiny->value = value->value;
+			Z_TYPE_P(destiny) = Z_TYPE_P(value);
+			break;
+	}
+}
+
+/**
+ * Releases a zval created by phalcon_persistent_copy
+ */
+void phalcon_persistent_free(zval *value){
+
+	switch (Z_TYPE_P(value)) {
+
+		case IS_STRING:
+			pefree(Z_STRVAL_P(value), 1);
+			break;
+
+		case IS_ARRAY:
+			zend_hash_destroy(Z_ARRVAL_P(value));
+			pefree(Z_ARRVAL_P(value), 1);
+			break;
+	}
+
+	pefree(value, 1);
+}
@@ -28,6 +28,12 @@ extern int phalcon_memory_remove(zval **var TSRMLS_DC);
 extern int phalcon_memory_alloc(zval **var TSRMLS_DC);
 
 extern int phalcon_clean_restore_stack(TSRMLS_D);
+extern void phalcon_memory_destroy_pool(TSRMLS_D);
+
+/** Persistent memory */
+extern int phalcon_persistent_copy(zval **destiny, zval *value);
+extern void phalcon_persistent_restore(zval *destiny, zval *value);
+extern void phalcon_persistent_free(zval *value);
 
 #define PHALCON_MM_GROW() phalcon_memory_grow_stack(TSRMLS_C)
 #define PHALCON_MM_RESTORE() phalcon_memory_restore_stack(TSRMLS_C)
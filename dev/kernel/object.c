@@ -212,6 +212,93 @@ int phalcon_read_property(zval **result, zval *object, char *property_name, int
 	return FAILURE;
 }
 
+/**
+ * Resolves the storage slot of a declared property, returns NULL when the standard handlers must be used
+ */
+static zval **phalcon_property_quick_slot(zval *object, char *property_name, int property_length, phalcon_property_cache_entry *cache TSRMLS_DC){
+
+	zend_class_entry *ce;
+	zend_property_info *info = NULL;
+	zend_object *zobj;
+	zval **slot = NULL;
+
+	if (Z_OBJ_HT_P(object) != &std_object_handlers) {
+		return NULL;
+	}
+
+	if (!cache->key) {
+		cache->key = zend_inline_hash_func(property_name, property_length + 1);
+	}
+
+	ce = Z_OBJCE_P(object);
+
+	#ifndef ZTS
+	if (cache->info && cache->ce == ce && cache->generation == PHALCON_GLOBAL(fcall_generation)) {
+		info = cache->info;
+	}
+	#endif
+
+	if (!info) {
+		if (zend_hash_quick_find(&ce->properties_info, property_name, property_length + 1, cache->key, (void **) &info) != SUCCESS) {
+			return NULL;
+		}
+		if (info->flags & (ZEND_ACC_STATIC | ZEND_ACC_SHADOW)) {
+			return NULL;
+		}
+		#ifndef ZTS
+		cache->ce = ce;
+		cache->info = info;
+		cache->generation = PHALCON_GLOBAL(fcall_generation);
+		#endif
+	}
+
+	zobj = zend_objects_get_address(object TSRMLS_CC);
+
+	#if PHP_VERSION_ID < 50400
+	if (zend_hash_quick_find(zobj->properties, info->name, info->name_length + 1, info->h, (void **) &slot) != SUCCESS) {
+		return NULL;
+	}
+	#else
+	if (info->offset < 0) {
+		return NULL;
+	}
+	if (zobj->properties) {
+		slot = (zval **) zobj->properties_table[info->offset];
+	} else {
+		slot = &zobj->properties_table[info->offset];
+	}
+	if (!slot || !*slot) {
+		return NULL;
+	}
+	#endif
+
+	return slot;
+}
+
+/**
+ * Reads a property from an object using a cached property slot
+ */
+int phalcon_read_property_quick(zval **result, zval *object, char *property_name, int property_length, phalcon_property_cache_entry *cache, int silent TSRMLS_DC){
+
+	zval **slot;
+
+	if (Z_TYPE_P(object) != IS_OBJECT) {
+		return phalcon_read_property(result, object, property_name, property_length, silent TSRMLS_CC);
+	}
+
+	slot = phalcon_property_quick_slot(object, property_name, property_length, cache TSRMLS_CC);
+	if (!slot) {
+		return phalcon_read_property(result, object, property_name, property_length, silent TSRMLS_CC);
+	}
+
+	ZVAL_NULL((*result));
+	Z_ADDREF_PP(slot);
+	zval_ptr_dtor(result);
+	*result = *slot;
+
+	return SUCCESS;
+}
+
 /**
  * Reads a property from an object
  */
@@ -328,6 +415,33 @@ int phalcon_update_property_zval(zval *obj, char *property_name, int property_le
 	return SUCCESS;
 }
 
+/**
+ * Checks whether obj is an object and updates a declared property through its cached slot
+ */
+int phalcon_update_property_quick(zval *obj, char *property_name, int property_length, zval *value, phalcon_property_cache_entry *cache TSRMLS_DC){
+
+	zval **slot, *garbage;
+
+	if (Z_TYPE_P(obj) != IS_OBJECT) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "Attempt to assign property of non-object");
+		return FAILURE;
+	}
+
+	slot = phalcon_property_quick_slot(obj, property_name, property_length, cache TSRMLS_CC);
+	if (!slot || PZVAL_IS_REF(*slot) || PZVAL_IS_REF(value)) {
+		return phalcon_update_property_zval(obj, property_name, property_length, value TSRMLS_CC);
+	}
+
+	if (*slot != value) {
+		garbage = *slot;
+		Z_ADDREF_P(value);
+		*slot = value;
+		zval_ptr_dtor(&garbage);
+	}
+
+	return SUCCESS;
+}
+
 /**
  * Checks wheter obj is an object and updates zval property with another zval
  */
@@ -351,6 +465,129 @@ int phalcon_update_property_zval_zval(zval *obj, zval *property, zval *value TSR
 	return SUCCESS;
 }
 
+/**
+ * Writes the columns of a row straight into the properties of an object. The keys of column_map are
+ * the property names, their hashes were computed once when the map was built, its values are the positions
+ * of the columns in the numeric row. When column_map is NULL the row is associative and its own keys are used.
+ * Declared public properties are written into their slots, the property table is only requested for columns
+ * without a declared property. Non-public properties, references and objects with custom handlers or __set
+ * go through the standard handlers. If snapshot is an array the values written are also copied into it
+ */
+int phalcon_hydrate_object(zval *object, zval *column_map, zval *row, zval *snapshot TSRMLS_DC){
+
+	HashTable *properties = NULL, *keys;
+	HashPosition hp;
+	zend_class_entry *ce;
+	zend_property_info *property_info;
+	zval **value, **data, **slot, *old_value;
+	int standard, direct;
+	char *key;
+	uint key_length;
+	ulong num_key;
+	#if PHP_VERSION_ID >= 50400
+	zend_object *zobj = NULL;
+	#endif
+
+	if (Z_TYPE_P(object) != IS_OBJECT) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "Attempt to assign property of non-object");
+		return FAILURE;
+	}
+
+	if (Z_TYPE_P(row) != IS_ARRAY || (column_map && Z_TYPE_P(column_map) != IS_ARRAY)) {
+		return FAILURE;
+	}
+
+	if (snapshot && Z_TYPE_P(snapshot) != IS_ARRAY) {
+		snapshot = NULL;
+	}
+
+	ce = Z_OBJCE_P(object);
+	standard = Z_OBJ_HT_P(object) == &std_object_handlers && !ce->__set;
+	#if PHP_VERSION_ID >= 50400
+	if (standard) {
+		zobj = zend_objects_get_address(object TSRMLS_CC);
+	}
+	#endif
+
+	keys = column_map ? Z_ARRVAL_P(column_map) : Z_ARRVAL_P(row);
+	zend_hash_internal_pointer_reset_ex(keys, &hp);
+	while (zend_hash_get_current_data_ex(keys, (void**) &data, &hp) == SUCCESS) {
+
+		if (zend_hash_get_current_key_ex(keys, &key, &key_length, &num_key, 0, &hp) == HASH_KEY_IS_STRING) {
+
+			value = data;
+			if (column_map) {
+				if (Z_TYPE_PP(data) != IS_LONG || zend_hash_index_find(Z_ARRVAL_P(row), Z_LVAL_PP(data), (void**) &value) != SUCCESS) {
+					value = NULL;
+				}
+			}
+
+			if (value) {
+				if (snapshot) {
+					Z_ADDREF_PP(value);
+					zend_hash_quick_update(Z_ARRVAL_P(snapshot), key, key_length, hp->h, value, sizeof(zval *), NULL);
+				}
+
+				slot = NULL;
+				direct = standard && !PZVAL_IS_REF(*value);
+				if (direct) {
+					if (zend_hash_quick_find(&ce->properties_info, key, key_length, hp->h, (void**) &property_info) == SUCCESS) {
+						/** Only public declared properties are stored under their plain name */
+						direct = (property_info->flags & (ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)) == ZEND_ACC_PUBLIC;
+					} else {
+						property_info = NULL;
+					}
+				}
+
+				if (direct) {
+					#if PHP_VERSION_ID >= 50400
+					if (property_info && property_info->offset >= 0) {
+						/** Declared properties live in the object slots, the property table is not built for them */
+						if (zobj->properties) {
+							slot = (zval **) zobj->properties_table[property_info->offset];
+						} else {
+							slot = &zobj->properties_table[property_info->offset];
+						}
+						if (!slot || !*slot) {
+							direct = 0;
+						}
+					} else
+					#endif
+					{
+						if (!properties) {
+							properties = Z_OBJ_HT_P(object)->get_properties(object TSRMLS_CC);
+						}
+						if (zend_hash_quick_find(properties, key, key_length, hp->h, (void**) &slot) != SUCCESS) {
+							slot = NULL;
+						}
+					}
+					if (slot && PZVAL_IS_REF(*slot)) {
+						direct = 0;
+					}
+				}
+
+				if (!direct) {
+					zend_update_property(phalcon_lookup_class_ce(object, key, key_length - 1 TSRMLS_CC), object, key, key_length - 1, *value TSRMLS_CC);
+				} else {
+					Z_ADDREF_PP(value);
+					if (slot) {
+						/** The slot is shared with the declared property table, replace its value in place */
+						old_value = *slot;
+						*slot = *value;
+						zval_ptr_dtor(&old_value);
+					} else {
+						zend_hash_quick_update(properties, key, key_length, hp->h, value, sizeof(zval *), NULL);
+					}
+				}
+			}
+		}
+
+		zend_hash_move_forward_ex(keys, &hp);
+	}
+
+	return SUCCESS;
+}
+
 /**
  * Check if method exists on certain object
  */
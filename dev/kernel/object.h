@@ -17,10 +17,26 @@
   +------------------------------------------------------------------------+
 */
 
+/**
+ * Per call-site cache used by the quick property accessors. The hash of the
+ * property name never changes, the resolved property info is bound to the
+ * class and the request where it was found
+ */
+typedef struct _phalcon_property_cache_entry {
+	ulong key;
+	zend_class_entry *ce;
+	zend_property_info *info;
+	ulong generation;
+} phalcon_property_cache_entry;
+
 /** New */
 #define PHALCON_NEW_STD(object) PHALCON_ALLOC_ZVAL(object); object_init(object)
 #define PHALCON_NEW(object, class) PHALCON_ALLOC_ZVAL(object); object_init_ex(object, class)
 
+/** Quick access to properties named by string literals */
+#define PHALCON_READ_PROPERTY_QUICK(result, object, name, silent) { static phalcon_property_cache_entry phalcon_property_cache = { 0, NULL, NULL, 0 }; phalcon_read_property_quick(result, object, SL(name), &phalcon_property_cache, silent); }
+#define PHALCON_UPDATE_PROPERTY_QUICK(object, name, value) { static phalcon_property_cache_entry phalcon_property_cache = { 0, NULL, NULL, 0 }; phalcon_update_property_quick(object, SL(name), value, &phalcon_property_cache TSRMLS_CC); }
+
 /** Class Constants */
 #define PHALCON_GET_CLASS_CONSTANT(var, class_entry, name) PHALCON_VAR_INIT(var); phalcon_get_class_constant(var, class_entry, name, strlen(name) TSRMLS_CC)
 
@@ -48,7 +64,11 @@ extern int phalcon_update_property_bool(zval *obj, char *property_name, int prop
 extern int phalcon_update_property_null(zval *obj, char *property_name, int property_length TSRMLS_DC);
 extern int phalcon_update_property_zval(zval *obj, char *property_name, int property_length, zval *value TSRMLS_DC);
 
+extern int phalcon_read_property_quick(zval **result, zval *object, char *property_name, int property_length, phalcon_property_cache_entry *cache, int silent TSRMLS_DC);
+extern int phalcon_update_property_quick(zval *obj, char *property_name, int property_length, zval *value, phalcon_property_cache_entry *cache TSRMLS_DC);
+
 extern int phalcon_update_property_zval_zval(zval *obj, zval *property, zval *value TSRMLS_DC);
+extern int phalcon_hydrate_object(zval *object, zval *column_map, zval *row, zval *snapshot TSRMLS_DC);
 
 /** Static properties **/
 extern int phalcon_read_static_property(zval **result, char *class_name, int class_length, char *property_name, int property_length TSRMLS_DC);
@@ -189,4 +189,26 @@ void phalcon_cast(zval *result, zval *var, zend_uint type){
 			break;
 	}
 
-}
\ No newline at end of file
+}
+/**
+ * Returns the integer value of a variable without modifying it
+ */
+long phalcon_get_intval(zval *op){
+
+	zval copy;
+
+	switch (Z_TYPE_P(op)) {
+		case IS_LONG:
+		case IS_BOOL:
+			return Z_LVAL_P(op);
+		case IS_DOUBLE:
+			return (long) Z_DVAL_P(op);
+		case IS_NULL:
+			return 0;
+	}
+
+	copy = *op;
+	zval_copy_ctor(&copy);
+	convert_to_long(&copy);
+	return Z_LVAL(copy);
+}
@@ -34,4 +34,6 @@ extern int phalcon_is_smaller_or_equal_strict_long(zval *op1, long op2 TSRMLS_DC
 extern void phalcon_increment_function(zval **var, int separate TSRMLS_DC);
 extern void phalcon_decrement_function(zval **var, int separate TSRMLS_DC);
 
-extern void phalcon_cast(zval *result, zval *var, zend_uint type);
\ No newline at end of file
+extern void phalcon_cast(zval *result, zval *var, zend_uint type);
+
+extern long phalcon_get_intval(zval *op);
@@ -78,7 +78,7 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, setDI){
 		RETURN_NULL();
 	}
 
-	phalcon_update_property_zval(this_ptr, SL("_dependencyInjector"), dependency_injector TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_dependencyInjector", dependency_injector);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -94,7 +94,7 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, getDI){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_dependencyInjector", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
@@ -115,7 +115,7 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, setEventsManager){
 		RETURN_NULL();
 	}
 
-	phalcon_update_property_zval(this_ptr, SL("_eventManager"), event_manager TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_eventManager", event_manager);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -136,7 +136,7 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, setDefaultNamespace){
 		RETURN_NULL();
 	}
 
-	phalcon_update_property_zval(this_ptr, SL("_defaultNamespace"), namespace TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_defaultNamespace", namespace);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -157,7 +157,7 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, setDefaultController){
 		RETURN_NULL();
 	}
 
-	phalcon_update_property_zval(this_ptr, SL("_defaultController"), controller_name TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_defaultController", controller_name);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -178,7 +178,7 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, setDefaultAction){
 		RETURN_NULL();
 	}
 
-	phalcon_update_property_zval(this_ptr, SL("_defaultAction"), action_name TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_defaultAction", action_name);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -199,7 +199,7 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, setControllerName){
 		RETURN_NULL();
 	}
 
-	phalcon_update_property_zval(this_ptr, SL("_controllerName"), controller_name TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_controllerName", controller_name);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -215,7 +215,7 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, getControllerName){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_controllerName"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_controllerName", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
@@ -236,7 +236,7 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, setActionName){
 		RETURN_NULL();
 	}
 
-	phalcon_update_property_zval(this_ptr, SL("_actionName"), action_name TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_actionName", action_name);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -252,7 +252,7 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, getActionName){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_actionName"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_actionName", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
@@ -273,7 +273,7 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, setParams){
 		RETURN_NULL();
 	}
 
-	phalcon_update_property_zval(this_ptr, SL("_params"), params TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_params", params);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -289,7 +289,7 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, getParams){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_params"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_params", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
@@ -313,9 +313,9 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, setParam){
 	}
 
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_params"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_params", PH_NOISY_CC);
 	phalcon_array_update_zval(&t0, param, &value, PH_COPY TSRMLS_CC);
-	phalcon_update_property_zval(this_ptr, SL("_params"), t0 TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_params", t0);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -340,7 +340,7 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, getParam){
 	}
 
 	PHALCON_INIT_VAR(params);
-	phalcon_read_property(&params, this_ptr, SL("_params"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&params, this_ptr, "_params", PH_NOISY_CC);
 	eval_int = phalcon_array_isset(params, param);
 	if (eval_int) {
 		PHALCON_ALLOC_ZVAL_MM(r0);
@@ -374,14 +374,14 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, dispatch){
 
 	PHALCON_MM_GROW();
 	PHALCON_INIT_VAR(dependency_injector);
-	phalcon_read_property(&dependency_injector, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&dependency_injector, this_ptr, "_dependencyInjector", PH_NOISY_CC);
 	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
 		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_dispatcher_exception_ce, "A dependency injection container is required to access related dispatching services");
 		return;
 	}
 	
 	PHALCON_INIT_VAR(events_manager);
-	phalcon_read_property(&events_manager, this_ptr, SL("_eventManager"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&events_manager, this_ptr, "_eventManager", PH_NOISY_CC);
 	if (zend_is_true(events_manager)) {
 		PHALCON_INIT_VAR(c0);
 		ZVAL_STRING(c0, "dispatch:beforeDispatchLoop", 1);
@@ -403,23 +403,23 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, dispatch){
 	ZVAL_LONG(number_dispatches, 0);
 	
 	PHALCON_INIT_VAR(default_namespace);
-	phalcon_read_property(&default_namespace, this_ptr, SL("_defaultNamespace"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&default_namespace, this_ptr, "_defaultNamespace", PH_NOISY_CC);
 	phalcon_update_property_bool(this_ptr, SL("_finished"), 0 TSRMLS_CC);
 	ws_1d57_0:
 		
 		PHALCON_INIT_VAR(t0);
-		phalcon_read_property(&t0, this_ptr, SL("_finished"), PH_NOISY_CC);
+		PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_finished", PH_NOISY_CC);
 		if (zend_is_true(t0)) {
 			goto we_1d57_0;
 		}
 		phalcon_update_property_bool(this_ptr, SL("_finished"), 1 TSRMLS_CC);
 		
 		PHALCON_INIT_VAR(controller_name);
-		phalcon_read_property(&controller_name, this_ptr, SL("_controllerName"), PH_NOISY_CC);
+		PHALCON_READ_PROPERTY_QUICK(&controller_name, this_ptr, "_controllerName", PH_NOISY_CC);
 		if (!zend_is_true(controller_name)) {
 			PHALCON_INIT_VAR(controller_name);
-			phalcon_read_property(&controller_name, this_ptr, SL("_defaultController"), PH_NOISY_CC);
-			phalcon_update_property_zval(this_ptr, SL("_controllerName"), controller_name TSRMLS_CC);
+			PHALCON_READ_PROPERTY_QUICK(&controller_name, this_ptr, "_defaultController", PH_NOISY_CC);
+			PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_controllerName", controller_name);
 		}
 		
 		if (zend_is_true(events_manager)) {
@@ -433,7 +433,7 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, dispatch){
 			}
 			
 			PHALCON_INIT_VAR(controller_name);
-			phalcon_read_property(&controller_name, this_ptr, SL("_controllerName"), PH_NOISY_CC);
+			PHALCON_READ_PROPERTY_QUICK(&controller_name, this_ptr, "_controllerName", PH_NOISY_CC);
 		}
 		
 		PHALCON_INIT_VAR(camelized_class);
@@ -449,15 +449,15 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, dispatch){
 		}
 		
 		PHALCON_INIT_VAR(action_name);
-		phalcon_read_property(&action_name, this_ptr, SL("_actionName"), PH_NOISY_CC);
+		PHALCON_READ_PROPERTY_QUICK(&action_name, this_ptr, "_actionName", PH_NOISY_CC);
 		if (!zend_is_true(action_name)) {
 			PHALCON_INIT_VAR(action_name);
-			phalcon_read_property(&action_name, this_ptr, SL("_defaultAction"), PH_NOISY_CC);
-			phalcon_update_property_zval(this_ptr, SL("_actionName"), action_name TSRMLS_CC);
+			PHALCON_READ_PROPERTY_QUICK(&action_name, this_ptr, "_defaultAction", PH_NOISY_CC);
+			PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_actionName", action_name);
 		}
 		
 		PHALCON_INIT_VAR(params);
-		phalcon_read_property(&params, this_ptr, SL("_params"), PH_NOISY_CC);
+		PHALCON_READ_PROPERTY_QUICK(&params, this_ptr, "_params", PH_NOISY_CC);
 		
 		PHALCON_INIT_VAR(action_method);
 		PHALCON_CONCAT_VS(action_method, action_name, "Action");
@@ -555,8 +555,8 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, dispatch){
 		}
 	}
 	
-	phalcon_update_property_zval(this_ptr, SL("_returnedValue"), value TSRMLS_CC);
-	phalcon_update_property_zval(this_ptr, SL("_lastController"), controller TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_returnedValue", value);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_lastController", controller);
 	
 	RETURN_CCTOR(controller);
 }
@@ -605,25 +605,25 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, forward){
 		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_dispatcher_exception_ce, "$forward parameter must be an Array");
 		return;
 	}
-	eval_int = phalcon_array_isset_string(forward, SL("controller")+1);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, forward, "controller");
 	if (eval_int) {
 		PHALCON_ALLOC_ZVAL_MM(r0);
-		phalcon_array_fetch_string(&r0, forward, SL("controller"), PH_NOISY_CC);
-		phalcon_update_property_zval(this_ptr, SL("_controllerName"), r0 TSRMLS_CC);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&r0, forward, "controller", PH_NOISY_CC);
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_controllerName", r0);
 	}
 	
-	eval_int = phalcon_array_isset_string(forward, SL("action")+1);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, forward, "action");
 	if (eval_int) {
 		PHALCON_ALLOC_ZVAL_MM(r1);
-		phalcon_array_fetch_string(&r1, forward, SL("action"), PH_NOISY_CC);
-		phalcon_update_property_zval(this_ptr, SL("_actionName"), r1 TSRMLS_CC);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&r1, forward, "action", PH_NOISY_CC);
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_actionName", r1);
 	}
 	
-	eval_int = phalcon_array_isset_string(forward, SL("params")+1);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, forward, "params");
 	if (eval_int) {
 		PHALCON_ALLOC_ZVAL_MM(r2);
-		phalcon_array_fetch_string(&r2, forward, SL("params"), PH_NOISY_CC);
-		phalcon_update_property_zval(this_ptr, SL("_params"), r2 TSRMLS_CC);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&r2, forward, "params", PH_NOISY_CC);
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_params", r2);
 	}
 	
 	phalcon_update_property_bool(this_ptr, SL("_finished"), 0 TSRMLS_CC);
@@ -642,7 +642,7 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, isFinished){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_finished"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_finished", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
@@ -658,7 +658,7 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, getLastController){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_lastController"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_lastController", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
@@ -674,7 +674,7 @@ PHP_METHOD(Phalcon_Mvc_Dispatcher, getReturnedValue){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_returnedValue"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_returnedValue", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
@@ -39,6 +39,8 @@
 #include "kernel/operators.h"
 #include "kernel/concat.h"
 
+#include "ext/standard/php_smart_str.h"
+
 /**
  * Phalcon\Mvc\Model
  *
@@ -58,6 +60,88 @@
  *
  */
 
+/**
+ * Checks whether a value differs from the one kept in the snapshot of a record. Empty strings and nulls are
+ * both stored as NULL so they are considered equal, other scalars are compared by their string representation
+ */
+static int phalcon_mvc_model_value_changed(zval *snapshot, zval *field, zval *value TSRMLS_DC){
+
+	zval **old_value, old_string, new_string;
+	int old_null, new_null, changed;
+
+	if (Z_TYPE_P(field) != IS_STRING || zend_symtable_find(Z_ARRVAL_P(snapshot), Z_STRVAL_P(field), Z_STRLEN_P(field) + 1, (void**) &old_value) != SUCCESS) {
+		return 1;
+	}
+
+	old_null = Z_TYPE_PP(old_value) == IS_NULL || (Z_TYPE_PP(old_value) == IS_STRING && !Z_STRLEN_PP(old_value));
+	new_null = Z_TYPE_P(value) == IS_NULL || (Z_TYPE_P(value) == IS_STRING && !Z_STRLEN_P(value));
+	if (old_null || new_null) {
+		return old_null != new_null;
+	}
+
+	if (Z_TYPE_PP(old_value) == IS_ARRAY || Z_TYPE_PP(old_value) == IS_OBJECT || Z_TYPE_PP(old_value) == IS_RESOURCE) {
+		return 1;
+	}
+	if (Z_TYPE_P(value) == IS_ARRAY || Z_TYPE_P(value) == IS_OBJECT || Z_TYPE_P(value) == IS_RESOURCE) {
+		return 1;
+	}
+
+	old_string = **old_value;
+	zval_copy_ctor(&old_string);
+	convert_to_string(&old_string);
+
+	new_string = *value;
+	zval_copy_ctor(&new_string);
+	convert_to_string(&new_string);
+
+	changed = Z_STRLEN(old_string) != Z_STRLEN(new_string) || memcmp(Z_STRVAL(old_string), Z_STRVAL(new_string), Z_STRLEN(old_string));
+
+	zval_dtor(&old_string);
+	zval_dtor(&new_string);
+
+	return changed;
+}
+
+/**
+ * Checks whether a resultset restored from the cache carries the records eager loaded with its rows
+ */
+static int phalcon_mvc_model_resultset_has_related(zval *resultset TSRMLS_DC){
+
+	zval *related;
+
+	if (Z_TYPE_P(resultset) != IS_OBJECT || !instanceof_function(Z_OBJCE_P(resultset), phalcon_mvc_model_resultset_ce TSRMLS_CC)) {
+		return 0;
+	}
+
+	related = zend_read_property(phalcon_mvc_model_resultset_ce, resultset, SL("_related"), 1 TSRMLS_CC);
+	return Z_TYPE_P(related) == IS_ARRAY;
+}
+
+/**
+ * Copies the current values of the attributes of a record into a new snapshot
+ */
+static void phalcon_mvc_model_build_snapshot(zval *snapshot, zval *record, zval *attributes TSRMLS_DC){
+
+	zval *value;
+	zval **attribute;
+	HashPosition hp;
+
+	array_init(snapshot);
+	if (Z_TYPE_P(attributes) != IS_ARRAY) {
+		return;
+	}
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(attributes), &hp);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(attributes), (void**) &attribute, &hp) == SUCCESS) {
+		if (Z_TYPE_PP(attribute) == IS_STRING) {
+			value = zend_read_property(phalcon_lookup_class_ce(record, Z_STRVAL_PP(attribute), Z_STRLEN_PP(attribute) TSRMLS_CC), record, Z_STRVAL_PP(attribute), Z_STRLEN_PP(attribute), 1 TSRMLS_CC);
+			Z_ADDREF_P(value);
+			add_assoc_zval_ex(snapshot, Z_STRVAL_PP(attribute), Z_STRLEN_PP(attribute) + 1, value);
+		}
+		zend_hash_move_forward_ex(Z_ARRVAL_P(attributes), &hp);
+	}
+}
+
 /**
  * Phalcon\Mvc\Model constructor
  *
@@ -104,7 +188,7 @@ PHP_METHOD(Phalcon_Mvc_Model, __construct){
 		return;
 	}
 	
-	phalcon_update_property_zval(this_ptr, SL("_dependencyInjector"), dependency_injector TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_dependencyInjector", dependency_injector);
 	
 	PHALCON_INIT_VAR(c0);
 	ZVAL_STRING(c0, "modelsManager", 1);
@@ -132,7 +216,7 @@ PHP_METHOD(Phalcon_Mvc_Model, setDI){
 		RETURN_NULL();
 	}
 
-	phalcon_update_property_zval(this_ptr, SL("_dependencyInjector"), dependency_injector TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_dependencyInjector", dependency_injector);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -148,11 +232,202 @@ PHP_METHOD(Phalcon_Mvc_Model, getDI){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_dependencyInjector", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
 
+/**
+ * Appends a tagged parameter of a query to the key of its SQL template. Only scalar parameters
+ * produce a stable SQL text, FAILURE is returned for any other value
+ */
+static int phalcon_mvc_model_template_key(smart_str *key, char tag, zval *value){
+
+	smart_str_appendc(key, tag);
+	switch (Z_TYPE_P(value)) {
+
+		case IS_STRING:
+			smart_str_append_long(key, Z_STRLEN_P(value));
+			smart_str_appendc(key, ':');
+			smart_str_appendl(key, Z_STRVAL_P(value), Z_STRLEN_P(value));
+			break;
+
+		case IS_LONG:
+		case IS_BOOL:
+			smart_str_appendc(key, Z_TYPE_P(value) == IS_LONG ? 'i' : 'b');
+			smart_str_append_long(key, Z_LVAL_P(value));
+			smart_str_appendc(key, ';');
+			break;
+
+		case IS_NULL:
+			smart_str_appendc(key, 'n');
+			break;
+
+		default:
+			return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * Resolves the 'cache' option of find(), findFirst() and aggregate() into the cache to use, which
+ * is returned, and the key and lifetime passed by the user. Null is returned when caching is disabled
+ */
+static void phalcon_mvc_model_get_cache(zval *return_value, zval *dependency_injector, zval *cache_options, zval *key, zval *lifetime TSRMLS_DC){
+
+	zval *cache = NULL, *cache_service = NULL, *value = NULL;
+	int eval_int;
+
+	PHALCON_MM_GROW();
+	
+	PHALCON_INIT_VAR(cache_service);
+	ZVAL_STRING(cache_service, "modelsCache", 1);
+	if (Z_TYPE_P(cache_options) == IS_BOOL) {
+		if (!Z_BVAL_P(cache_options)) {
+			PHALCON_MM_RESTORE();
+			RETURN_NULL();
+		}
+		ZVAL_LONG(lifetime, 3600);
+	} else {
+		if (Z_TYPE_P(cache_options) == IS_ARRAY) { 
+			PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, cache_options, "key");
+			if (eval_int) {
+				PHALCON_INIT_VAR(value);
+				PHALCON_ARRAY_FETCH_QUICK_STRING(&value, cache_options, "key", PH_NOISY_CC);
+				zval_dtor(key);
+				ZVAL_ZVAL(key, value, 1, 0);
+			}
+			PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, cache_options, "lifetime");
+			if (eval_int) {
+				PHALCON_INIT_VAR(value);
+				PHALCON_ARRAY_FETCH_QUICK_STRING(&value, cache_options, "lifetime", PH_NOISY_CC);
+				zval_dtor(lifetime);
+				ZVAL_ZVAL(lifetime, value, 1, 0);
+			}
+			PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, cache_options, "service");
+			if (eval_int) {
+				PHALCON_INIT_VAR(cache_service);
+				PHALCON_ARRAY_FETCH_QUICK_STRING(&cache_service, cache_options, "service", PH_NOISY_CC);
+			}
+		} else {
+			if (Z_TYPE_P(cache_options) == IS_LONG) {
+				ZVAL_LONG(lifetime, Z_LVAL_P(cache_options));
+			} else {
+				if (Z_TYPE_P(cache_options) == IS_OBJECT) {
+					RETURN_CCTOR(cache_options);
+				}
+				PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Invalid caching options");
+				return;
+			}
+		}
+	}
+	
+	PHALCON_INIT_VAR(cache);
+	PHALCON_CALL_METHOD_PARAMS_1(cache, dependency_injector, "getshared", cache_service, PH_NO_CHECK);
+	
+	RETURN_CCTOR(cache);
+}
+
+/**
+ * Computes the key of a cached result from its SQL and the bound parameters
+ */
+static void phalcon_mvc_model_cache_key(zval *return_value, zval *select, zval *bind_params TSRMLS_DC){
+
+	zval *serialized = NULL, *key_seed = NULL, *hash = NULL;
+
+	PHALCON_MM_GROW();
+	
+	PHALCON_INIT_VAR(hash);
+	if (Z_TYPE_P(bind_params) == IS_ARRAY) { 
+		PHALCON_INIT_VAR(serialized);
+		PHALCON_CALL_FUNC_PARAMS_1(serialized, "serialize", bind_params);
+		
+		PHALCON_INIT_VAR(key_seed);
+		PHALCON_CONCAT_VV(key_seed, select, serialized);
+		PHALCON_CALL_FUNC_PARAMS_1(hash, "md5", key_seed);
+	} else {
+		PHALCON_CALL_FUNC_PARAMS_1(hash, "md5", select);
+	}
+	
+	PHALCON_CONCAT_SV(return_value, "phc", hash);
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Appends the WHERE, GROUP BY, HAVING, ORDER BY and LIMIT clauses of the parameters of an aggregate to its
+ * SELECT. The conditions are taken from the 'conditions' parameter or from the first one
+ */
+static void phalcon_mvc_model_aggregate_clauses(zval *return_value, zval *select, zval *params, zval *connection TSRMLS_DC){
+
+	zval *sql = NULL, *conditions = NULL, *value = NULL, *limited = NULL;
+	zval *r0 = NULL;
+	int eval_int;
+
+	PHALCON_MM_GROW();
+	
+	PHALCON_INIT_VAR(sql);
+	ZVAL_ZVAL(sql, select, 1, 0);
+	
+	PHALCON_INIT_VAR(conditions);
+	ZVAL_NULL(conditions);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "conditions");
+	if (eval_int) {
+		PHALCON_INIT_VAR(conditions);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&conditions, params, "conditions", PH_NOISY_CC);
+	} else {
+		eval_int = phalcon_array_isset_long(params, 0);
+		if (eval_int) {
+			PHALCON_INIT_VAR(conditions);
+			phalcon_array_fetch_long(&conditions, params, 0, PH_NOISY_CC);
+		}
+	}
+	
+	if (zend_is_true(conditions)) {
+		PHALCON_INIT_VAR(r0);
+		PHALCON_CONCAT_SV(r0, " WHERE ", conditions);
+		phalcon_concat_self(&sql, r0 TSRMLS_CC);
+	}
+	
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "group");
+	if (eval_int) {
+		PHALCON_INIT_VAR(value);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&value, params, "group", PH_NOISY_CC);
+		PHALCON_INIT_VAR(r0);
+		PHALCON_CONCAT_SV(r0, " GROUP BY ", value);
+		phalcon_concat_self(&sql, r0 TSRMLS_CC);
+	}
+	
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "having");
+	if (eval_int) {
+		PHALCON_INIT_VAR(value);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&value, params, "having", PH_NOISY_CC);
+		PHALCON_INIT_VAR(r0);
+		PHALCON_CONCAT_SV(r0, " HAVING ", value);
+		phalcon_concat_self(&sql, r0 TSRMLS_CC);
+	}
+	
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "order");
+	if (eval_int) {
+		PHALCON_INIT_VAR(value);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&value, params, "order", PH_NOISY_CC);
+		PHALCON_INIT_VAR(r0);
+		PHALCON_CONCAT_SV(r0, " ORDER BY ", value);
+		phalcon_concat_self(&sql, r0 TSRMLS_CC);
+	}
+	
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "limit");
+	if (eval_int) {
+		PHALCON_INIT_VAR(value);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&value, params, "limit", PH_NOISY_CC);
+		PHALCON_INIT_VAR(limited);
+		PHALCON_CALL_METHOD_PARAMS_2(limited, connection, "limit", sql, value, PH_NO_CHECK);
+		RETURN_CCTOR(limited);
+	}
+	
+	RETURN_CCTOR(sql);
+}
+
 /**
  * Creates a SQL statement which returns many rows
  *
@@ -169,9 +444,12 @@ PHP_METHOD(Phalcon_Mvc_Model, _createSQLSelect){
 	zval *conditions = NULL, *no_primary = NULL, *primary_keys = NULL;
 	zval *c0 = NULL;
 	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL, *r4 = NULL, *r5 = NULL, *r6 = NULL;
-	zval *r7 = NULL, *r8 = NULL, *r9 = NULL, *r10 = NULL, *r11 = NULL, *r12 = NULL, *r13 = NULL;
+	zval *r9 = NULL, *r10 = NULL, *r11 = NULL, *r12 = NULL, *r13 = NULL;
 	zval *r14 = NULL, *r15 = NULL, *r16 = NULL, *r17 = NULL, *r18 = NULL, *r19 = NULL;
-	int eval_int;
+	zval *template_key = NULL, *template = NULL;
+	zval **value;
+	smart_str key = {0};
+	int eval_int, cacheable, bound;
 
 	PHALCON_MM_GROW();
 	
@@ -191,12 +469,85 @@ PHP_METHOD(Phalcon_Mvc_Model, _createSQLSelect){
 	PHALCON_INIT_VAR(schema);
 	PHALCON_CALL_METHOD(schema, model, "getschema", PH_NO_CHECK);
 	
+	/** 
+	 * The SQL only depends on the model, its table and the parameters building the statement. Statements
+	 * with the same shape are compiled once per connection, the next calls only bind their values
+	 */
+	cacheable = Z_TYPE_P(params) == IS_ARRAY && Z_TYPE_P(connection) == IS_OBJECT && instanceof_function(Z_OBJCE_P(connection), phalcon_db_ce TSRMLS_CC);
+	if (cacheable) {
+		smart_str_appendc(&key, 'S');
+		smart_str_appendl(&key, Z_OBJCE_P(model)->name, Z_OBJCE_P(model)->name_length);
+		if (phalcon_mvc_model_template_key(&key, 's', schema) == FAILURE) {
+			cacheable = 0;
+		}
+		if (phalcon_mvc_model_template_key(&key, 't', source) == FAILURE) {
+			cacheable = 0;
+		}
+		if (zend_hash_find(Z_ARRVAL_P(params), SS("columns"), (void**) &value) == SUCCESS) {
+			if (phalcon_mvc_model_template_key(&key, 'c', *value) == FAILURE) {
+				cacheable = 0;
+			}
+		}
+		/** 
+		 * Conditions are only cached when their values are bound, a condition with the values in its text
+		 * would produce a template per value and push the reusable ones out of the table
+		 */
+		bound = zend_hash_find(Z_ARRVAL_P(params), SS("bind"), (void**) &value) == SUCCESS && Z_TYPE_PP(value) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL_PP(value));
+		if (zend_hash_find(Z_ARRVAL_P(params), SS("conditions"), (void**) &value) == SUCCESS) {
+			if (!bound || phalcon_mvc_model_template_key(&key, 'w', *value) == FAILURE) {
+				cacheable = 0;
+			}
+		} else {
+			if (zend_hash_index_find(Z_ARRVAL_P(params), 0, (void**) &value) == SUCCESS) {
+				/** A primary key passed as an integer is embedded in the SQL */
+				if (!bound || Z_TYPE_PP(value) == IS_LONG || phalcon_mvc_model_template_key(&key, 'w', *value) == FAILURE) {
+					cacheable = 0;
+				}
+			}
+		}
+		if (zend_hash_find(Z_ARRVAL_P(params), SS("group"), (void**) &value) == SUCCESS) {
+			if (phalcon_mvc_model_template_key(&key, 'g', *value) == FAILURE) {
+				cacheable = 0;
+			}
+		}
+		if (zend_hash_find(Z_ARRVAL_P(params), SS("order"), (void**) &value) == SUCCESS) {
+			if (phalcon_mvc_model_template_key(&key, 'o', *value) == FAILURE) {
+				cacheable = 0;
+			}
+		}
+		if (zend_hash_find(Z_ARRVAL_P(params), SS("limit"), (void**) &value) == SUCCESS) {
+			if (phalcon_mvc_model_template_key(&key, 'l', *value) == FAILURE) {
+				cacheable = 0;
+			}
+		}
+		if (zend_hash_find(Z_ARRVAL_P(params), SS("for_update"), (void**) &value) == SUCCESS) {
+			smart_str_appendc(&key, zend_is_true(*value) ? 'U' : 'u');
+		}
+		if (zend_hash_find(Z_ARRVAL_P(params), SS("shared_lock"), (void**) &value) == SUCCESS) {
+			smart_str_appendc(&key, zend_is_true(*value) ? 'L' : 'l');
+		}
+		smart_str_0(&key);
+		
+		if (cacheable) {
+			PHALCON_INIT_VAR(template_key);
+			ZVAL_STRINGL(template_key, key.c, key.len, 0);
+			
+			PHALCON_INIT_VAR(template);
+			PHALCON_CALL_METHOD_PARAMS_1(template, connection, "getsqltemplate", template_key, PH_NO_CHECK);
+			if (Z_TYPE_P(template) == IS_STRING) {
+				RETURN_CCTOR(template);
+			}
+		} else {
+			smart_str_free(&key);
+		}
+	}
+	
 	PHALCON_INIT_VAR(select);
 	ZVAL_STRING(select, "SELECT ", 1);
-	eval_int = phalcon_array_isset_string(params, SL("columns")+1);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "columns");
 	if (eval_int) {
 		PHALCON_ALLOC_ZVAL_MM(r0);
-		phalcon_array_fetch_string(&r0, params, SL("columns"), PH_NOISY_CC);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&r0, params, "columns", PH_NOISY_CC);
 		phalcon_concat_self(&select, r0 TSRMLS_CC);
 	} else {
 		PHALCON_ALLOC_ZVAL_MM(r1);
@@ -218,10 +569,10 @@ PHP_METHOD(Phalcon_Mvc_Model, _createSQLSelect){
 	
 	PHALCON_INIT_VAR(conditions);
 	ZVAL_NULL(conditions);
-	eval_int = phalcon_array_isset_string(params, SL("conditions")+1);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "conditions");
 	if (eval_int) {
 		PHALCON_INIT_VAR(conditions);
-		phalcon_array_fetch_string(&conditions, params, SL("conditions"), PH_NOISY_CC);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&conditions, params, "conditions", PH_NOISY_CC);
 	} else {
 		eval_int = phalcon_array_isset_long(params, 0);
 		if (eval_int) {
@@ -254,51 +605,42 @@ PHP_METHOD(Phalcon_Mvc_Model, _createSQLSelect){
 	}
 	
 	if (zend_is_true(conditions)) {
-		eval_int = phalcon_array_isset_string(params, SL("bind")+1);
-		if (eval_int) {
-			PHALCON_ALLOC_ZVAL_MM(r7);
-			phalcon_array_fetch_string(&r7, params, SL("bind"), PH_NOISY_CC);
-			PHALCON_ALLOC_ZVAL_MM(r8);
-			PHALCON_CALL_METHOD_PARAMS_2(r8, connection, "bindparams", conditions, r7, PH_NO_CHECK);
-			PHALCON_CPY_WRT(conditions, r8);
-		}
-		
 		PHALCON_ALLOC_ZVAL_MM(r9);
 		PHALCON_CONCAT_SV(r9, " WHERE ", conditions);
 		phalcon_concat_self(&select, r9 TSRMLS_CC);
 	}
 	
-	eval_int = phalcon_array_isset_string(params, SL("group")+1);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "group");
 	if (eval_int) {
 		PHALCON_ALLOC_ZVAL_MM(r10);
-		phalcon_array_fetch_string(&r10, params, SL("group"), PH_NOISY_CC);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&r10, params, "group", PH_NOISY_CC);
 		PHALCON_ALLOC_ZVAL_MM(r11);
 		PHALCON_CONCAT_SV(r11, " GROUP BY ", r10);
 		phalcon_concat_self(&select, r11 TSRMLS_CC);
 	}
 	
-	eval_int = phalcon_array_isset_string(params, SL("order")+1);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "order");
 	if (eval_int) {
 		PHALCON_ALLOC_ZVAL_MM(r12);
-		phalcon_array_fetch_string(&r12, params, SL("order"), PH_NOISY_CC);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&r12, params, "order", PH_NOISY_CC);
 		PHALCON_ALLOC_ZVAL_MM(r13);
 		PHALCON_CONCAT_SV(r13, " ORDER BY ", r12);
 		phalcon_concat_self(&select, r13 TSRMLS_CC);
 	}
 	
-	eval_int = phalcon_array_isset_string(params, SL("limit")+1);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "limit");
 	if (eval_int) {
 		PHALCON_ALLOC_ZVAL_MM(r14);
-		phalcon_array_fetch_string(&r14, params, SL("limit"), PH_NOISY_CC);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&r14, params, "limit", PH_NOISY_CC);
 		PHALCON_ALLOC_ZVAL_MM(r15);
 		PHALCON_CALL_METHOD_PARAMS_2(r15, connection, "limit", select, r14, PH_NO_CHECK);
 		PHALCON_CPY_WRT(select, r15);
 	}
 	
-	eval_int = phalcon_array_isset_string(params, SL("for_update")+1);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "for_update");
 	if (eval_int) {
 		PHALCON_ALLOC_ZVAL_MM(r16);
-		phalcon_array_fetch_string(&r16, params, SL("for_update"), PH_NOISY_CC);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&r16, params, "for_update", PH_NOISY_CC);
 		if (zend_is_true(r16)) {
 			PHALCON_ALLOC_ZVAL_MM(r17);
 			PHALCON_CALL_METHOD_PARAMS_1(r17, connection, "forupdate", select, PH_NO_CHECK);
@@ -306,10 +648,10 @@ PHP_METHOD(Phalcon_Mvc_Model, _createSQLSelect){
 		}
 	}
 	
-	eval_int = phalcon_array_isset_string(params, SL("shared_lock")+1);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "shared_lock");
 	if (eval_int) {
 		PHALCON_ALLOC_ZVAL_MM(r18);
-		phalcon_array_fetch_string(&r18, params, SL("shared_lock"), PH_NOISY_CC);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&r18, params, "shared_lock", PH_NOISY_CC);
 		if (zend_is_true(r18)) {
 			PHALCON_ALLOC_ZVAL_MM(r19);
 			PHALCON_CALL_METHOD_PARAMS_1(r19, connection, "sharedlock", select, PH_NO_CHECK);
@@ -317,6 +659,9 @@ PHP_METHOD(Phalcon_Mvc_Model, _createSQLSelect){
 		}
 	}
 	
+	if (cacheable) {
+		PHALCON_CALL_METHOD_PARAMS_2_NORETURN(connection, "setsqltemplate", template_key, select, PH_NO_CHECK);
+	}
 	
 	RETURN_CCTOR(select);
 }
@@ -332,11 +677,14 @@ PHP_METHOD(Phalcon_Mvc_Model, _createSQLSelect){
 PHP_METHOD(Phalcon_Mvc_Model, _getOrCreateResultset){
 
 	zval *model_name = NULL, *params = NULL, *unique = NULL, *dependency_injector = NULL;
-	zval *cache = NULL, *select = NULL, *key = NULL, *lifetime = NULL, *cache_service = NULL;
+	zval *cache = NULL, *select = NULL, *key = NULL, *lifetime = NULL;
 	zval *cache_options = NULL, *model = NULL, *connection = NULL, *resultset = NULL;
 	zval *result = NULL, *count = NULL, *row = NULL, *result_data = NULL;
-	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL, *r4 = NULL;
-	zval *c0 = NULL, *c1 = NULL;
+	zval *bind_params = NULL, *bind_types = NULL, *meta_data = NULL;
+	zval *stream = NULL, *with = NULL, *manager = NULL;
+	zval *r1 = NULL, *r3 = NULL, *r4 = NULL, *r5 = NULL, *r6 = NULL;
+	zval *c0 = NULL, *c1 = NULL, *c2 = NULL, *c3 = NULL;
+	zval *a0 = NULL;
 	zval *p0[] = { NULL, NULL, NULL, NULL }, *p1[] = { NULL, NULL, NULL, NULL };
 	int eval_int;
 	zend_class_entry *ce0;
@@ -356,7 +704,7 @@ PHP_METHOD(Phalcon_Mvc_Model, _getOrCreateResultset){
 	
 	PHALCON_INIT_VAR(select);
 	ZVAL_NULL(select);
-	eval_int = phalcon_array_isset_string(params, SL("cache")+1);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "cache");
 	if (eval_int) {
 		PHALCON_INIT_VAR(key);
 		ZVAL_NULL(key);
@@ -364,57 +712,14 @@ PHP_METHOD(Phalcon_Mvc_Model, _getOrCreateResultset){
 		PHALCON_INIT_VAR(lifetime);
 		ZVAL_NULL(lifetime);
 		
-		PHALCON_INIT_VAR(cache_service);
-		ZVAL_STRING(cache_service, "modelsCache", 1);
-		
 		PHALCON_INIT_VAR(cache_options);
-		phalcon_array_fetch_string(&cache_options, params, SL("cache"), PH_NOISY_CC);
-		
-		PHALCON_ALLOC_ZVAL_MM(r0);
-		PHALCON_CALL_FUNC_PARAMS_1(r0, "is_bool", cache_options);
-		if (zend_is_true(r0)) {
-			if (zend_is_true(cache_options)) {
-				PHALCON_INIT_VAR(lifetime);
-				ZVAL_LONG(lifetime, 3600);
-				
-				PHALCON_INIT_VAR(cache);
-				PHALCON_CALL_METHOD_PARAMS_1(cache, dependency_injector, "getshared", cache_service, PH_NO_CHECK);
-			}
-		} else {
-			if (Z_TYPE_P(cache_options) == IS_ARRAY) { 
-				eval_int = phalcon_array_isset_string(cache_options, SL("key")+1);
-				if (eval_int) {
-					PHALCON_INIT_VAR(key);
-					phalcon_array_fetch_string(&key, cache_options, SL("key"), PH_NOISY_CC);
-				}
-				eval_int = phalcon_array_isset_string(cache_options, SL("lifetime")+1);
-				if (eval_int) {
-					PHALCON_INIT_VAR(lifetime);
-					phalcon_array_fetch_string(&lifetime, cache_options, SL("lifetime"), PH_NOISY_CC);
-				}
-				
-				eval_int = phalcon_array_isset_string(cache_options, SL("service")+1);
-				if (eval_int) {
-					PHALCON_INIT_VAR(cache_service);
-					phalcon_array_fetch_string(&cache_service, cache_options, SL("service"), PH_NOISY_CC);
-				}
-			} else {
-				if (Z_TYPE_P(cache_options) == IS_LONG) {
-					PHALCON_CPY_WRT(lifetime, cache_options);
-				} else {
-					if (Z_TYPE_P(cache_options) == IS_OBJECT) {
-						PHALCON_CPY_WRT(cache, cache_options);
-					} else {
-						PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Invalid caching options");
-						return;
-					}
-				}
-			}
-		}
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&cache_options, params, "cache", PH_NOISY_CC);
 		
-		if (Z_TYPE_P(cache) == IS_NULL) {
-			PHALCON_INIT_VAR(cache);
-			PHALCON_CALL_METHOD_PARAMS_1(cache, dependency_injector, "getshared", cache_service, PH_NO_CHECK);
+		PHALCON_INIT_VAR(cache);
+		phalcon_mvc_model_get_cache(cache, dependency_injector, cache_options, key, lifetime TSRMLS_CC);
+		if (EG(exception)) {
+			PHALCON_MM_RESTORE();
+			return;
 		}
 	}
 	
@@ -426,6 +731,58 @@ PHP_METHOD(Phalcon_Mvc_Model, _getOrCreateResultset){
 	
 	PHALCON_INIT_VAR(connection);
 	PHALCON_CALL_METHOD(connection, model, "getconnection", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(bind_params);
+	ZVAL_NULL(bind_params);
+	
+	PHALCON_INIT_VAR(bind_types);
+	ZVAL_NULL(bind_types);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "bind");
+	if (eval_int) {
+		PHALCON_INIT_VAR(bind_params);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&bind_params, params, "bind", PH_NOISY_CC);
+		PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "bindTypes");
+		if (eval_int) {
+			PHALCON_INIT_VAR(bind_types);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&bind_types, params, "bindTypes", PH_NOISY_CC);
+		} else {
+			PHALCON_INIT_VAR(c2);
+			ZVAL_STRING(c2, "modelsMetadata", 1);
+			
+			PHALCON_INIT_VAR(meta_data);
+			PHALCON_CALL_METHOD_PARAMS_1(meta_data, dependency_injector, "getshared", c2, PH_NO_CHECK);
+			
+			PHALCON_INIT_VAR(bind_types);
+			PHALCON_CALL_METHOD_PARAMS_2(bind_types, meta_data, "getbindtypes", model, bind_params, PH_NO_CHECK);
+		}
+	}
+	
+	PHALCON_INIT_VAR(stream);
+	ZVAL_BOOL(stream, 0);
+	if (Z_TYPE_P(unique) != IS_BOOL || !Z_BVAL_P(unique)) {
+		PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "stream");
+		if (eval_int) {
+			PHALCON_INIT_VAR(stream);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&stream, params, "stream", PH_NOISY_CC);
+			if (zend_is_true(stream) && Z_TYPE_P(cache) != IS_NULL) {
+				PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Streamed resultsets cannot be cached");
+				return;
+			}
+		}
+	}
+	
+	PHALCON_INIT_VAR(with);
+	ZVAL_NULL(with);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "with");
+	if (eval_int) {
+		PHALCON_INIT_VAR(with);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&with, params, "with", PH_NOISY_CC);
+		if (zend_is_true(stream)) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Streamed resultsets cannot be eager loaded");
+			return;
+		}
+	}
+	
 	if (Z_TYPE_P(cache) != IS_NULL) {
 		if (Z_TYPE_P(key) == IS_NULL) {
 			p0[0] = dependency_injector;
@@ -436,17 +793,27 @@ PHP_METHOD(Phalcon_Mvc_Model, _getOrCreateResultset){
 			PHALCON_CALL_SELF_PARAMS(r1, this_ptr, "_createsqlselect", 4, p0);
 			PHALCON_CPY_WRT(select, r1);
 			
-			PHALCON_ALLOC_ZVAL_MM(r2);
-			PHALCON_CALL_FUNC_PARAMS_1(r2, "md5", select);
-			
 			PHALCON_INIT_VAR(key);
-			PHALCON_CONCAT_SV(key, "phc", r2);
+			phalcon_mvc_model_cache_key(key, select, bind_params TSRMLS_CC);
+			if (EG(exception)) {
+				PHALCON_MM_RESTORE();
+				return;
+			}
 		}
 		
 		PHALCON_INIT_VAR(resultset);
 		PHALCON_CALL_METHOD_PARAMS_2(resultset, cache, "get", key, lifetime, PH_NO_CHECK);
 		if (Z_TYPE_P(resultset) != IS_NULL) {
 			
+			/** 
+			 * Resultsets cached with the eager loaded records restore them when the rows are accessed
+			 */
+			if (Z_TYPE_P(with) != IS_NULL && !phalcon_mvc_model_resultset_has_related(resultset TSRMLS_CC)) {
+				PHALCON_ALLOC_ZVAL_MM(r5);
+				PHALCON_CALL_SELF_PARAMS_3(r5, this_ptr, "_eagerload", model_name, resultset, with);
+				RETURN_CTOR(r5);
+			}
+			
 			RETURN_CCTOR(resultset);
 		}
 	}
@@ -461,8 +828,22 @@ PHP_METHOD(Phalcon_Mvc_Model, _getOrCreateResultset){
 		PHALCON_CPY_WRT(select, r3);
 	}
 	
+	/** 
+	 * Streamed resultsets read the rows from an unbuffered cursor, they are not counted before the iteration
+	 */
+	if (zend_is_true(stream)) {
+		PHALCON_INIT_VAR(result);
+		PHALCON_CALL_METHOD_PARAMS_4(result, connection, "query", select, bind_params, bind_types, stream, PH_NO_CHECK);
+		
+		PHALCON_INIT_VAR(resultset);
+		object_init_ex(resultset, phalcon_mvc_model_resultset_ce);
+		PHALCON_CALL_METHOD_PARAMS_3_NORETURN(resultset, "__construct", model, result, cache, PH_CHECK);
+		
+		RETURN_CCTOR(resultset);
+	}
+	
 	PHALCON_INIT_VAR(result);
-	PHALCON_CALL_METHOD_PARAMS_1(result, connection, "query", select, PH_NO_CHECK);
+	PHALCON_CALL_METHOD_PARAMS_3(result, connection, "query", select, bind_params, bind_types, PH_NO_CHECK);
 	
 	PHALCON_INIT_VAR(count);
 	PHALCON_CALL_METHOD_PARAMS_1(count, result, "numrows", result, PH_NO_CHECK);
@@ -484,6 +865,19 @@ PHP_METHOD(Phalcon_Mvc_Model, _getOrCreateResultset){
 			
 			PHALCON_ALLOC_ZVAL_MM(r4);
 			PHALCON_CALL_SELF_PARAMS_2(r4, this_ptr, "dumpresult", model, row);
+			if (Z_TYPE_P(with) != IS_NULL) {
+				PHALCON_ALLOC_ZVAL_MM(a0);
+				array_init(a0);
+				phalcon_array_append(&a0, r4, PH_SEPARATE TSRMLS_CC);
+				
+				PHALCON_INIT_VAR(c3);
+				ZVAL_STRING(c3, "modelsManager", 1);
+				
+				PHALCON_INIT_VAR(manager);
+				PHALCON_CALL_METHOD_PARAMS_1(manager, dependency_injector, "getshared", c3, PH_NO_CHECK);
+				PHALCON_CALL_METHOD_PARAMS_3_NORETURN(manager, "eagerload", model_name, a0, with, PH_NO_CHECK);
+			}
+			
 			RETURN_CTOR(r4);
 		}
 	}
@@ -498,6 +892,12 @@ PHP_METHOD(Phalcon_Mvc_Model, _getOrCreateResultset){
 	PHALCON_INIT_VAR(resultset);
 	object_init_ex(resultset, phalcon_mvc_model_resultset_ce);
 	PHALCON_CALL_METHOD_PARAMS_3_NORETURN(resultset, "__construct", model, result_data, cache, PH_CHECK);
+	if (Z_TYPE_P(with) != IS_NULL) {
+		PHALCON_ALLOC_ZVAL_MM(r6);
+		PHALCON_CALL_SELF_PARAMS_3(r6, this_ptr, "_eagerload", model_name, resultset, with);
+		PHALCON_CPY_WRT(resultset, r6);
+	}
+	
 	if (Z_TYPE_P(cache) != IS_NULL) {
 		PHALCON_CALL_METHOD_PARAMS_3_NORETURN(cache, "save", key, resultset, lifetime, PH_NO_CHECK);
 	}
@@ -507,39 +907,108 @@ PHP_METHOD(Phalcon_Mvc_Model, _getOrCreateResultset){
 }
 
 /**
- * Sets a transaction related to the Model instance
+ * Hydrates every record of a resultset and loads the requested relations with one query per relation
  *
- * @param Phalcon\Mvc\Model\Transaction $transaction
- * @return Phalcon\Mvc\Model
+ * @param string $modelName
+ * @param Phalcon\Mvc\Model\Resultset $resultset
+ * @param string|array $relations
+ * @return Phalcon\Mvc\Model\Resultset
  */
-PHP_METHOD(Phalcon_Mvc_Model, setTransaction){
+PHP_METHOD(Phalcon_Mvc_Model, _eagerLoad){
 
-	zval *transaction = NULL;
+	zval *model_name = NULL, *resultset = NULL, *relations = NULL, *records = NULL;
+	zval *record = NULL, *dependency_injector = NULL, *manager = NULL, *model = NULL;
+	zval *cache = NULL, *eager_resultset = NULL;
+	zval *c0 = NULL;
 	zval *r0 = NULL;
 
 	PHALCON_MM_GROW();
 	
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &transaction) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zzz", &model_name, &resultset, &relations) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
 
-	if (Z_TYPE_P(transaction) == IS_OBJECT) {
-		PHALCON_ALLOC_ZVAL_MM(r0);
-		PHALCON_CALL_METHOD(r0, transaction, "getconnection", PH_NO_CHECK);
-		phalcon_update_property_zval(this_ptr, SL("_connection"), r0 TSRMLS_CC);
-	} else {
-		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Transaction should be an object");
-		return;
+	PHALCON_INIT_VAR(records);
+	array_init(records);
+	PHALCON_CALL_METHOD_NORETURN(resultset, "rewind", PH_NO_CHECK);
+	ws_8adf_0:
+		
+		PHALCON_INIT_VAR(r0);
+		PHALCON_CALL_METHOD(r0, resultset, "valid", PH_NO_CHECK);
+		if (!zend_is_true(r0)) {
+			goto we_8adf_0;
+		}
+		
+		PHALCON_INIT_VAR(record);
+		PHALCON_CALL_METHOD(record, resultset, "current", PH_NO_CHECK);
+		phalcon_array_append(&records, record, PH_SEPARATE TSRMLS_CC);
+		PHALCON_CALL_METHOD_NORETURN(resultset, "next", PH_NO_CHECK);
+		goto ws_8adf_0;
+	we_8adf_0:
+	
+	if (!zend_hash_num_elements(Z_ARRVAL_P(records))) {
+		
+		RETURN_CCTOR(resultset);
 	}
 	
-	RETURN_CCTOR(this_ptr);
-}
-
-/**
- * Sets table name which model should be mapped
- *
- * @param string $source
+	PHALCON_INIT_VAR(dependency_injector);
+	PHALCON_CALL_STATIC(dependency_injector, "phalcon\\di", "getdefault");
+	
+	PHALCON_INIT_VAR(c0);
+	ZVAL_STRING(c0, "modelsManager", 1);
+	
+	PHALCON_INIT_VAR(manager);
+	PHALCON_CALL_METHOD_PARAMS_1(manager, dependency_injector, "getshared", c0, PH_NO_CHECK);
+	PHALCON_CALL_METHOD_PARAMS_3_NORETURN(manager, "eagerload", model_name, records, relations, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(model);
+	PHALCON_CALL_METHOD(model, resultset, "getsourcemodel", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(cache);
+	PHALCON_CALL_METHOD(cache, resultset, "getcache", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(eager_resultset);
+	object_init_ex(eager_resultset, phalcon_mvc_model_resultset_ce);
+	PHALCON_CALL_METHOD_PARAMS_3_NORETURN(eager_resultset, "__construct", model, records, cache, PH_CHECK);
+	
+	RETURN_CCTOR(eager_resultset);
+}
+
+/**
+ * Sets a transaction related to the Model instance
+ *
+ * @param Phalcon\Mvc\Model\Transaction $transaction
+ * @return Phalcon\Mvc\Model
+ */
+PHP_METHOD(Phalcon_Mvc_Model, setTransaction){
+
+	zval *transaction = NULL;
+	zval *r0 = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &transaction) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(transaction) == IS_OBJECT) {
+		PHALCON_ALLOC_ZVAL_MM(r0);
+		PHALCON_CALL_METHOD(r0, transaction, "getconnection", PH_NO_CHECK);
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_connection", r0);
+	} else {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Transaction should be an object");
+		return;
+	}
+	
+	RETURN_CCTOR(this_ptr);
+}
+
+/**
+ * Sets table name which model should be mapped
+ *
+ * @param string $source
  * @return Phalcon\Mvc\Model
  */
 PHP_METHOD(Phalcon_Mvc_Model, setSource){
@@ -553,7 +1022,7 @@ PHP_METHOD(Phalcon_Mvc_Model, setSource){
 		RETURN_NULL();
 	}
 
-	phalcon_update_property_zval(this_ptr, SL("_source"), source TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_source", source);
 	
 	RETURN_CCTOR(this_ptr);
 }
@@ -570,13 +1039,13 @@ PHP_METHOD(Phalcon_Mvc_Model, getSource){
 
 	PHALCON_MM_GROW();
 	PHALCON_INIT_VAR(source);
-	phalcon_read_property(&source, this_ptr, SL("_source"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&source, this_ptr, "_source", PH_NOISY_CC);
 	if (!zend_is_true(source)) {
 		PHALCON_ALLOC_ZVAL_MM(r0);
 		phalcon_get_class(r0, this_ptr TSRMLS_CC);
 		PHALCON_INIT_VAR(source);
 		PHALCON_CALL_STATIC_PARAMS_1(source, "phalcon\\text", "uncamelize", r0);
-		phalcon_update_property_zval(this_ptr, SL("_source"), source TSRMLS_CC);
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_source", source);
 	}
 	
 	
@@ -600,7 +1069,7 @@ PHP_METHOD(Phalcon_Mvc_Model, setSchema){
 		RETURN_NULL();
 	}
 
-	phalcon_update_property_zval(this_ptr, SL("_schema"), schema TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_schema", schema);
 	
 	RETURN_CCTOR(this_ptr);
 }
@@ -616,7 +1085,7 @@ PHP_METHOD(Phalcon_Mvc_Model, getSchema){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_schema"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_schema", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
@@ -637,7 +1106,7 @@ PHP_METHOD(Phalcon_Mvc_Model, setConnectionService){
 		RETURN_NULL();
 	}
 
-	phalcon_update_property_zval(this_ptr, SL("_connectionService"), connection_service TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_connectionService", connection_service);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -653,7 +1122,7 @@ PHP_METHOD(Phalcon_Mvc_Model, getConnectionService){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_connectionService"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_connectionService", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
@@ -672,7 +1141,7 @@ PHP_METHOD(Phalcon_Mvc_Model, setForceExists){
 		RETURN_NULL();
 	}
 
-	phalcon_update_property_zval(this_ptr, SL("_forceExists"), force_exists TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_forceExists", force_exists);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -689,15 +1158,15 @@ PHP_METHOD(Phalcon_Mvc_Model, getConnection){
 
 	PHALCON_MM_GROW();
 	PHALCON_INIT_VAR(connection);
-	phalcon_read_property(&connection, this_ptr, SL("_connection"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&connection, this_ptr, "_connection", PH_NOISY_CC);
 	if (!zend_is_true(connection)) {
 		PHALCON_ALLOC_ZVAL_MM(t0);
-		phalcon_read_property(&t0, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
+		PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_dependencyInjector", PH_NOISY_CC);
 		PHALCON_ALLOC_ZVAL_MM(t1);
-		phalcon_read_property(&t1, this_ptr, SL("_connectionService"), PH_NOISY_CC);
+		PHALCON_READ_PROPERTY_QUICK(&t1, this_ptr, "_connectionService", PH_NOISY_CC);
 		PHALCON_INIT_VAR(connection);
 		PHALCON_CALL_METHOD_PARAMS_1(connection, t0, "getshared", t1, PH_NO_CHECK);
-		phalcon_update_property_zval(this_ptr, SL("_connection"), connection TSRMLS_CC);
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_connection", connection);
 	}
 	
 	
@@ -705,7 +1174,7 @@ PHP_METHOD(Phalcon_Mvc_Model, getConnection){
 }
 
 /**
- * Assigns values to a model from an array returning a new model
+ * Assigns values to a model from an array returning a new model. The values are kept as the snapshot of the record
  *
  * @param array $result
  * @param Phalcon\Mvc\Model\Base $base
@@ -713,16 +1182,9 @@ PHP_METHOD(Phalcon_Mvc_Model, getConnection){
  */
 PHP_METHOD(Phalcon_Mvc_Model, dumpResult){
 
-	zval *base = NULL, *result = NULL, *object = NULL, *value = NULL, *key = NULL;
+	zval *base = NULL, *result = NULL, *object = NULL;
 	zval *i0 = NULL;
 	zval *c0 = NULL;
-	HashTable *ah0;
-	HashPosition hp0;
-	zval **hd;
-	char *hash_index;
-	uint hash_index_len;
-	ulong hash_num;
-	int hash_type;
 
 	PHALCON_MM_GROW();
 	
@@ -741,27 +1203,8 @@ PHP_METHOD(Phalcon_Mvc_Model, dumpResult){
 	ZVAL_BOOL(c0, 1);
 	PHALCON_CALL_METHOD_PARAMS_1_NORETURN(object, "setforceexists", c0, PH_NO_CHECK);
 	if (Z_TYPE_P(result) == IS_ARRAY) { 
-		if (!phalcon_valid_foreach(result TSRMLS_CC)) {
-			return;
-		}
-		
-		ah0 = Z_ARRVAL_P(result);
-		zend_hash_internal_pointer_reset_ex(ah0, &hp0);
-		fes_8adf_0:
-			if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
-				goto fee_8adf_0;
-			}
-			
-			PHALCON_INIT_VAR(key);
-			PHALCON_GET_FOREACH_KEY(key, ah0, hp0);
-			PHALCON_INIT_VAR(value);
-			ZVAL_ZVAL(value, *hd, 1, 0);
-			phalcon_update_property_zval_zval(object, key, value TSRMLS_CC);
-			zend_hash_move_forward_ex(ah0, &hp0);
-			goto fes_8adf_0;
-		fee_8adf_0:
-		if(0){}
-		
+		phalcon_hydrate_object(object, NULL, result, NULL TSRMLS_CC);
+		phalcon_update_property_zval(object, SL("_snapshot"), result TSRMLS_CC);
 	}
 	
 	
@@ -771,6 +1214,25 @@ PHP_METHOD(Phalcon_Mvc_Model, dumpResult){
 /**
  * Allows to query a set of records that match the specified conditions
  *
+ * Passing 'stream' => true reads the records from an unbuffered cursor while the resultset
+ * is traversed, keeping memory flat. Streamed resultsets can be traversed only once and they
+ * can't be counted, count() throws a Phalcon\Db\Exception. On MySQL the connection can't run
+ * other queries until the resultset has been traversed or released
+ *
+ *<code>
+ * foreach (Robots::find(array("type = 'mechanical'", "stream" => true)) as $robot) {
+ *    echo $robot->name, "\n";
+ * }
+ *</code>
+ *
+ * Passing 'with' loads the related records of every robot running one query per relation
+ *
+ *<code>
+ * foreach (Robots::find(array("type = 'mechanical'", "with" => array("RobotsParts"))) as $robot) {
+ *    echo count($robot->getRobotsParts()), "\n";
+ * }
+ *</code>
+ *
  * @param array $parameters
  * @return  Phalcon\Mvc\Model\Resultset
  */
@@ -816,7 +1278,9 @@ PHP_METHOD(Phalcon_Mvc_Model, find){
 }
 
 /**
- * Allows to query the first record that match the specified conditions
+ * Allows to query the first record that match the specified conditions. When the identity map of the
+ * models manager is enabled, lookups by an integer primary key return the instance already hydrated
+ * in the request unless it has changes that haven't been saved
  *
  * @param array $parameters
  * @return Phalcon\Mvc\Model
@@ -824,7 +1288,8 @@ PHP_METHOD(Phalcon_Mvc_Model, find){
 PHP_METHOD(Phalcon_Mvc_Model, findFirst){
 
 	zval *parameters = NULL, *model_name = NULL, *params = NULL;
-	zval *c0 = NULL;
+	zval *dependency_injector = NULL, *manager = NULL, *record = NULL;
+	zval *c0 = NULL, *c1 = NULL;
 	zval *r0 = NULL;
 	int eval_int;
 
@@ -855,7 +1320,31 @@ PHP_METHOD(Phalcon_Mvc_Model, findFirst){
 		PHALCON_CPY_WRT(params, parameters);
 	}
 	
-	eval_int = phalcon_array_isset_string(params, SL("limit")+1);
+	/** 
+	 * Lookups by primary key are served from the identity map of the models manager when it is enabled
+	 */
+	PHALCON_INIT_VAR(manager);
+	ZVAL_NULL(manager);
+	if (Z_TYPE_P(parameters) == IS_LONG) {
+		PHALCON_INIT_VAR(dependency_injector);
+		PHALCON_CALL_STATIC(dependency_injector, "phalcon\\di", "getdefault");
+		if (Z_TYPE_P(dependency_injector) == IS_OBJECT) {
+			PHALCON_INIT_VAR(c1);
+			ZVAL_STRING(c1, "modelsManager", 1);
+			
+			PHALCON_INIT_VAR(manager);
+			PHALCON_CALL_METHOD_PARAMS_1(manager, dependency_injector, "getshared", c1, PH_NO_CHECK);
+			
+			PHALCON_INIT_VAR(record);
+			PHALCON_CALL_METHOD_PARAMS_2(record, manager, "getrecord", model_name, parameters, PH_NO_CHECK);
+			if (Z_TYPE_P(record) == IS_OBJECT) {
+				
+				RETURN_CCTOR(record);
+			}
+		}
+	}
+	
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "limit");
 	if (!eval_int) {
 		phalcon_array_update_string_string(&params, SL("limit"), SL("1"), PH_SEPARATE TSRMLS_CC);
 	}
@@ -865,6 +1354,12 @@ PHP_METHOD(Phalcon_Mvc_Model, findFirst){
 	
 	PHALCON_ALLOC_ZVAL_MM(r0);
 	PHALCON_CALL_SELF_PARAMS_3(r0, this_ptr, "_getorcreateresultset", model_name, params, c0);
+	if (Z_TYPE_P(r0) == IS_OBJECT) {
+		if (Z_TYPE_P(manager) == IS_OBJECT) {
+			PHALCON_CALL_METHOD_PARAMS_3_NORETURN(manager, "addrecord", model_name, parameters, r0, PH_NO_CHECK);
+		}
+	}
+	
 	RETURN_CTOR(r0);
 }
 
@@ -878,16 +1373,17 @@ PHP_METHOD(Phalcon_Mvc_Model, findFirst){
 PHP_METHOD(Phalcon_Mvc_Model, _exists){
 
 	zval *meta_data = NULL, *connection = NULL, *primary_keys = NULL;
-	zval *where_pk = NULL, *field = NULL, *value = NULL, *sanitized_value = NULL;
+	zval *unique_key = NULL, *field = NULL, *value = NULL;
 	zval *schema = NULL, *source = NULL, *table = NULL, *select = NULL, *num = NULL;
-	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL, *r4 = NULL, *r5 = NULL, *r6 = NULL;
+	zval *where_bind = NULL, *bind_condition = NULL, *bind_params = NULL, *snapshot = NULL;
+	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL, *r5 = NULL;
 	zval *r7 = NULL;
-	zval *t0 = NULL, *t1 = NULL, *t2 = NULL, *t3 = NULL;
-	zval *c0 = NULL;
+	zval *t0 = NULL, *t1 = NULL, *t2 = NULL;
+	zval *c0 = NULL, *c1 = NULL;
 	HashTable *ah0;
 	HashPosition hp0;
 	zval **hd;
-	int eval_int;
+	int eval_int, snapshot_matches, known;
 
 	PHALCON_MM_GROW();
 	
@@ -898,14 +1394,25 @@ PHP_METHOD(Phalcon_Mvc_Model, _exists){
 
 	PHALCON_SEPARATE_PARAM(connection);
 	
+	/** 
+	 * Records loaded from the database or already saved have a snapshot, they are known to exist as long as
+	 * their primary key still has the values kept in it
+	 */
+	PHALCON_INIT_VAR(snapshot);
+	PHALCON_READ_PROPERTY_QUICK(&snapshot, this_ptr, "_snapshot", PH_NOISY_CC);
+	snapshot_matches = Z_TYPE_P(snapshot) == IS_ARRAY;
+	
 	PHALCON_INIT_VAR(primary_keys);
 	PHALCON_CALL_METHOD_PARAMS_1(primary_keys, meta_data, "getprimarykeyattributes", this_ptr, PH_NO_CHECK);
 	
 	PHALCON_ALLOC_ZVAL_MM(r0);
 	phalcon_fast_count(r0, primary_keys TSRMLS_CC);
 	if (zend_is_true(r0)) {
-		PHALCON_INIT_VAR(where_pk);
-		array_init(where_pk);
+		PHALCON_INIT_VAR(where_bind);
+		array_init(where_bind);
+		
+		PHALCON_INIT_VAR(bind_params);
+		array_init(bind_params);
 		
 		PHALCON_INIT_VAR(connection);
 		PHALCON_CALL_METHOD(connection, this_ptr, "getconnection", PH_NO_CHECK);
@@ -923,10 +1430,14 @@ PHP_METHOD(Phalcon_Mvc_Model, _exists){
 			PHALCON_INIT_VAR(field);
 			ZVAL_ZVAL(field, *hd, 1, 0);
 			eval_int = phalcon_isset_property_zval(this_ptr, field TSRMLS_CC);
+			PHALCON_INIT_VAR(value);
 			if (eval_int) {
-				PHALCON_INIT_VAR(value);
 				phalcon_read_property_zval(&value, this_ptr, field, PH_NOISY_CC);
-				
+			}
+			if (snapshot_matches && phalcon_mvc_model_value_changed(snapshot, field, value TSRMLS_CC)) {
+				snapshot_matches = 0;
+			}
+			if (eval_int) {
 				PHALCON_INIT_VAR(t0);
 				ZVAL_NULL(t0);
 				
@@ -942,12 +1453,10 @@ PHP_METHOD(Phalcon_Mvc_Model, _exists){
 				PHALCON_INIT_VAR(r3);
 				phalcon_and_function(r3, r1, r2);
 				if (zend_is_true(r3)) {
-					PHALCON_INIT_VAR(sanitized_value);
-					PHALCON_CALL_METHOD_PARAMS_1(sanitized_value, connection, "escapestring", value, PH_NO_CHECK);
-					
-					PHALCON_INIT_VAR(r4);
-					PHALCON_CONCAT_VSV(r4, field, " = ", sanitized_value);
-					phalcon_array_append(&where_pk, r4, PH_SEPARATE TSRMLS_CC);
+					PHALCON_INIT_VAR(bind_condition);
+					PHALCON_CONCAT_VS(bind_condition, field, " = ?");
+					phalcon_array_append(&where_bind, bind_condition, PH_SEPARATE TSRMLS_CC);
+					phalcon_array_append(&bind_params, value, PH_SEPARATE TSRMLS_CC);
 				}
 			}
 			zend_hash_move_forward_ex(ah0, &hp0);
@@ -955,22 +1464,35 @@ PHP_METHOD(Phalcon_Mvc_Model, _exists){
 		fee_8adf_1:
 		if(0){}
 		
+		/** 
+		 * The primary key condition is bound, so updating other records of the model reuses the same statement
+		 */
 		PHALCON_ALLOC_ZVAL_MM(r5);
-		phalcon_fast_count(r5, where_pk TSRMLS_CC);
+		phalcon_fast_count(r5, where_bind TSRMLS_CC);
 		if (zend_is_true(r5)) {
 			PHALCON_INIT_VAR(c0);
 			ZVAL_STRING(c0, " AND ", 1);
-			PHALCON_ALLOC_ZVAL_MM(r6);
-			phalcon_fast_join(r6, c0, where_pk TSRMLS_CC);
-			phalcon_update_property_zval(this_ptr, SL("_uniqueKey"), r6 TSRMLS_CC);
+			PHALCON_INIT_VAR(unique_key);
+			phalcon_fast_join(unique_key, c0, where_bind TSRMLS_CC);
+			PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_uniqueKey", unique_key);
+			PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_uniqueParams", bind_params);
 		} else {
 			PHALCON_MM_RESTORE();
 			RETURN_FALSE;
 		}
 		
-		PHALCON_ALLOC_ZVAL_MM(t2);
-		phalcon_read_property(&t2, this_ptr, SL("_forceExists"), PH_NOISY_CC);
-		if (!zend_is_true(t2)) {
+		/** 
+		 * A changed primary key identifies another row, its existence is checked against the database even when
+		 * the record was marked as existing
+		 */
+		if (Z_TYPE_P(snapshot) == IS_ARRAY) {
+			known = snapshot_matches;
+		} else {
+			PHALCON_ALLOC_ZVAL_MM(t2);
+			PHALCON_READ_PROPERTY_QUICK(&t2, this_ptr, "_forceExists", PH_NOISY_CC);
+			known = zend_is_true(t2);
+		}
+		if (!known) {
 			PHALCON_INIT_VAR(schema);
 			PHALCON_CALL_METHOD(schema, this_ptr, "getschema", PH_NO_CHECK);
 			
@@ -983,17 +1505,17 @@ PHP_METHOD(Phalcon_Mvc_Model, _exists){
 				PHALCON_CPY_WRT(table, source);
 			}
 			
-			PHALCON_ALLOC_ZVAL_MM(t3);
-			phalcon_read_property(&t3, this_ptr, SL("_uniqueKey"), PH_NOISY_CC);
-			
 			PHALCON_INIT_VAR(select);
-			PHALCON_CONCAT_SVSV(select, "SELECT COUNT(*) AS rowcount FROM ", table, " WHERE ", t3);
+			PHALCON_CONCAT_SVSV(select, "SELECT COUNT(*) AS rowcount FROM ", table, " WHERE ", unique_key);
+			
+			PHALCON_INIT_VAR(c1);
+			ZVAL_LONG(c1, 2);
 			
 			PHALCON_INIT_VAR(num);
-			PHALCON_CALL_METHOD_PARAMS_1(num, connection, "fetchone", select, PH_NO_CHECK);
+			PHALCON_CALL_METHOD_PARAMS_3(num, connection, "fetchone", select, c1, bind_params, PH_NO_CHECK);
 			
 			PHALCON_ALLOC_ZVAL_MM(r7);
-			phalcon_array_fetch_string(&r7, num, SL("rowcount"), PH_NOISY_CC);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&r7, num, "rowcount", PH_NOISY_CC);
 			
 			RETURN_CCTOR(r7);
 		} else {
@@ -1019,10 +1541,10 @@ PHP_METHOD(Phalcon_Mvc_Model, _prepareGroupResult){
 	zval *function = NULL, *alias = NULL, *parameters = NULL, *params = NULL, *group_column = NULL;
 	zval *dependency_injector = NULL, *class_name = NULL, *model = NULL;
 	zval *connection = NULL, *schema = NULL, *source = NULL, *table = NULL, *select = NULL;
-	zval *conditions = NULL;
+	zval *sql = NULL, *meta_data = NULL;
 	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL, *r4 = NULL, *r5 = NULL, *r6 = NULL;
-	zval *r7 = NULL, *r8 = NULL, *r9 = NULL, *r10 = NULL, *r11 = NULL, *r12 = NULL, *r13 = NULL;
-	zval *r14 = NULL, *r15 = NULL, *r16 = NULL;
+	zval *r16 = NULL;
+	zval *c0 = NULL;
 	zval *p0[] = { NULL, NULL, NULL, NULL };
 	int eval_int;
 	zend_class_entry *ce0;
@@ -1046,10 +1568,10 @@ PHP_METHOD(Phalcon_Mvc_Model, _prepareGroupResult){
 	} else {
 		PHALCON_CPY_WRT(params, parameters);
 	}
-	eval_int = phalcon_array_isset_string(params, SL("column")+1);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "column");
 	if (eval_int) {
 		PHALCON_INIT_VAR(group_column);
-		phalcon_array_fetch_string(&group_column, params, SL("column"), PH_NOISY_CC);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&group_column, params, "column", PH_NOISY_CC);
 	} else {
 		PHALCON_INIT_VAR(group_column);
 		ZVAL_STRING(group_column, "*", 1);
@@ -1081,105 +1603,66 @@ PHP_METHOD(Phalcon_Mvc_Model, _prepareGroupResult){
 		PHALCON_CPY_WRT(table, source);
 	}
 	
-	eval_int = phalcon_array_isset_string(params, SL("distinct")+1);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "distinct");
 	if (eval_int) {
 		PHALCON_ALLOC_ZVAL_MM(r0);
-		phalcon_array_fetch_string(&r0, params, SL("distinct"), PH_NOISY_CC);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&r0, params, "distinct", PH_NOISY_CC);
 		PHALCON_INIT_VAR(select);
 		PHALCON_CONCAT_SVSV(select, "SELECT ", function, "(DISTINCT ", r0);
 		
 		PHALCON_ALLOC_ZVAL_MM(r1);
-		PHALCON_CONCAT_SVSVS(r1, ") AS ", alias, " FROM ", table, " ");
+		PHALCON_CONCAT_SVSV(r1, ") AS ", alias, " FROM ", table);
 		phalcon_concat_self(&select, r1 TSRMLS_CC);
 	} else {
-		eval_int = phalcon_array_isset_string(params, SL("group")+1);
+		PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "group");
 		if (eval_int) {
 			PHALCON_ALLOC_ZVAL_MM(r2);
-			phalcon_array_fetch_string(&r2, params, SL("group"), PH_NOISY_CC);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&r2, params, "group", PH_NOISY_CC);
 			PHALCON_INIT_VAR(select);
 			PHALCON_CONCAT_SVSVSV(select, "SELECT ", r2, ", ", function, "(", group_column);
 			
 			PHALCON_ALLOC_ZVAL_MM(r3);
-			PHALCON_CONCAT_SVSVS(r3, ") AS ", alias, " FROM ", table, " ");
+			PHALCON_CONCAT_SVSV(r3, ") AS ", alias, " FROM ", table);
 			phalcon_concat_self(&select, r3 TSRMLS_CC);
 		} else {
 			PHALCON_INIT_VAR(select);
 			PHALCON_CONCAT_SVSVS(select, "SELECT ", function, "(", group_column, ") AS ");
 			
 			PHALCON_ALLOC_ZVAL_MM(r4);
-			PHALCON_CONCAT_VSVS(r4, alias, " FROM ", table, " ");
+			PHALCON_CONCAT_VSV(r4, alias, " FROM ", table);
 			phalcon_concat_self(&select, r4 TSRMLS_CC);
 		}
 	}
 	
-	PHALCON_INIT_VAR(conditions);
-	ZVAL_NULL(conditions);
-	eval_int = phalcon_array_isset_string(params, SL("conditions")+1);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "bind");
 	if (eval_int) {
-		PHALCON_INIT_VAR(conditions);
-		phalcon_array_fetch_string(&conditions, params, SL("conditions"), PH_NOISY_CC);
-	} else {
-		eval_int = phalcon_array_isset_long(params, 0);
-		if (eval_int) {
-			PHALCON_INIT_VAR(conditions);
-			phalcon_array_fetch_long(&conditions, params, 0, PH_NOISY_CC);
-		}
-	}
-	
-	if (zend_is_true(conditions)) {
-		eval_int = phalcon_array_isset_string(params, SL("bind")+1);
-		if (eval_int) {
+		PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "bindTypes");
+		if (!eval_int) {
 			PHALCON_ALLOC_ZVAL_MM(r5);
-			phalcon_array_fetch_string(&r5, params, SL("bind"), PH_NOISY_CC);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&r5, params, "bind", PH_NOISY_CC);
+			
+			PHALCON_INIT_VAR(c0);
+			ZVAL_STRING(c0, "modelsMetadata", 1);
+			
+			PHALCON_INIT_VAR(meta_data);
+			PHALCON_CALL_METHOD_PARAMS_1(meta_data, dependency_injector, "getshared", c0, PH_NO_CHECK);
+			
 			PHALCON_ALLOC_ZVAL_MM(r6);
-			PHALCON_CALL_METHOD_PARAMS_2(r6, connection, "bindparams", conditions, r5, PH_NO_CHECK);
-			PHALCON_CPY_WRT(conditions, r6);
+			PHALCON_CALL_METHOD_PARAMS_2(r6, meta_data, "getbindtypes", model, r5, PH_NO_CHECK);
+			phalcon_array_update_string(&params, SL("bindTypes"), &r6, PH_COPY | PH_SEPARATE TSRMLS_CC);
 		}
-		
-		PHALCON_ALLOC_ZVAL_MM(r7);
-		PHALCON_CONCAT_SV(r7, " WHERE ", conditions);
-		phalcon_concat_self(&select, r7 TSRMLS_CC);
-	}
-	
-	eval_int = phalcon_array_isset_string(params, SL("group")+1);
-	if (eval_int) {
-		PHALCON_ALLOC_ZVAL_MM(r8);
-		phalcon_array_fetch_string(&r8, params, SL("group"), PH_NOISY_CC);
-		PHALCON_ALLOC_ZVAL_MM(r9);
-		PHALCON_CONCAT_SVS(r9, " GROUP BY ", r8, " ");
-		phalcon_concat_self(&select, r9 TSRMLS_CC);
-	}
-	
-	eval_int = phalcon_array_isset_string(params, SL("having")+1);
-	if (eval_int) {
-		PHALCON_ALLOC_ZVAL_MM(r10);
-		phalcon_array_fetch_string(&r10, params, SL("having"), PH_NOISY_CC);
-		PHALCON_ALLOC_ZVAL_MM(r11);
-		PHALCON_CONCAT_SVS(r11, " HAVING ", r10, " ");
-		phalcon_concat_self(&select, r11 TSRMLS_CC);
 	}
 	
-	eval_int = phalcon_array_isset_string(params, SL("order")+1);
-	if (eval_int) {
-		PHALCON_ALLOC_ZVAL_MM(r12);
-		phalcon_array_fetch_string(&r12, params, SL("order"), PH_NOISY_CC);
-		PHALCON_ALLOC_ZVAL_MM(r13);
-		PHALCON_CONCAT_SVS(r13, " ORDER BY ", r12, " ");
-		phalcon_concat_self(&select, r13 TSRMLS_CC);
-	}
-	
-	eval_int = phalcon_array_isset_string(params, SL("limit")+1);
-	if (eval_int) {
-		PHALCON_ALLOC_ZVAL_MM(r14);
-		phalcon_array_fetch_string(&r14, params, SL("limit"), PH_NOISY_CC);
-		PHALCON_ALLOC_ZVAL_MM(r15);
-		PHALCON_CALL_METHOD_PARAMS_2(r15, connection, "_limit", select, r14, PH_NO_CHECK);
-		PHALCON_CPY_WRT(select, r15);
+	PHALCON_INIT_VAR(sql);
+	phalcon_mvc_model_aggregate_clauses(sql, select, params, connection TSRMLS_CC);
+	if (EG(exception)) {
+		PHALCON_MM_RESTORE();
+		return;
 	}
 	
 	p0[0] = connection;
 	p0[1] = params;
-	p0[2] = select;
+	p0[2] = sql;
 	p0[3] = alias;
 	
 	PHALCON_ALLOC_ZVAL_MM(r16);
@@ -1200,8 +1683,10 @@ PHP_METHOD(Phalcon_Mvc_Model, _getGroupResult){
 
 	zval *connection = NULL, *params = NULL, *sql_select = NULL, *alias = NULL;
 	zval *result = NULL, *count = NULL, *row_object = NULL, *num = NULL;
+	zval *bind_params = NULL, *bind_types = NULL;
 	zval *t0 = NULL;
 	zval *r0 = NULL, *r1 = NULL;
+	zval *c0 = NULL;
 	zval *i0 = NULL;
 	int eval_int;
 
@@ -1212,10 +1697,26 @@ PHP_METHOD(Phalcon_Mvc_Model, _getGroupResult){
 		RETURN_NULL();
 	}
 
-	eval_int = phalcon_array_isset_string(params, SL("group")+1);
+	PHALCON_INIT_VAR(bind_params);
+	ZVAL_NULL(bind_params);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "bind");
+	if (eval_int) {
+		PHALCON_INIT_VAR(bind_params);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&bind_params, params, "bind", PH_NOISY_CC);
+	}
+	
+	PHALCON_INIT_VAR(bind_types);
+	ZVAL_NULL(bind_types);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "bindTypes");
+	if (eval_int) {
+		PHALCON_INIT_VAR(bind_types);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&bind_types, params, "bindTypes", PH_NOISY_CC);
+	}
+	
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "group");
 	if (eval_int) {
 		PHALCON_INIT_VAR(result);
-		PHALCON_CALL_METHOD_PARAMS_1(result, connection, "query", sql_select, PH_NO_CHECK);
+		PHALCON_CALL_METHOD_PARAMS_3(result, connection, "query", sql_select, bind_params, bind_types, PH_NO_CHECK);
 		
 		PHALCON_INIT_VAR(count);
 		PHALCON_CALL_METHOD(count, result, "numrows", PH_NO_CHECK);
@@ -1244,8 +1745,11 @@ PHP_METHOD(Phalcon_Mvc_Model, _getGroupResult){
 		RETURN_CTOR(i0);
 	}
 	
+	PHALCON_INIT_VAR(c0);
+	ZVAL_LONG(c0, 2);
+	
 	PHALCON_INIT_VAR(num);
-	PHALCON_CALL_METHOD_PARAMS_1(num, connection, "fetchone", sql_select, PH_NO_CHECK);
+	PHALCON_CALL_METHOD_PARAMS_4(num, connection, "fetchone", sql_select, c0, bind_params, bind_types, PH_NO_CHECK);
 	
 	PHALCON_ALLOC_ZVAL_MM(r1);
 	phalcon_array_fetch(&r1, num, alias, PH_NOISY_CC);
@@ -1419,87 +1923,375 @@ PHP_METHOD(Phalcon_Mvc_Model, average){
 }
 
 /**
- * Fires an internal event
+ * Calculates several aggregates over the records matching the specified conditions using a single query
  *
- * @param string $eventName
- * @return boolean
+ *<code>
+ * $totals = Robots::aggregate(array('count' => '*', 'sum' => 'price', 'avg' => 'price'));
+ * echo $totals['count'], ' ', $totals['sum'], ' ', $totals['avg'];
+ *
+ * $byType = Robots::aggregate(array('total' => array('sum', 'price')), array('group' => 'type'));
+ *</code>
+ *
+ * Every key is used as alias of its aggregate, the value is the column or an array with the function and the column.
+ * The parameters accept the same options as count() plus the 'cache' option used by find()
+ *
+ * @param array $aggregates
+ * @param array $parameters
+ * @return array
  */
-PHP_METHOD(Phalcon_Mvc_Model, _callEvent){
+PHP_METHOD(Phalcon_Mvc_Model, aggregate){
 
-	zval *event_name = NULL;
-	zval *r0 = NULL;
+	zval *aggregates = NULL, *parameters = NULL, *params = NULL, *functions = NULL;
+	zval *columns = NULL, *alias = NULL, *spec = NULL, *function = NULL, *column = NULL;
+	zval *lower_function = NULL, *sql_function = NULL, *sql_column = NULL;
+	zval *dependency_injector = NULL, *class_name = NULL, *model = NULL;
+	zval *connection = NULL, *schema = NULL, *source = NULL, *table = NULL;
+	zval *group = NULL, *joined_columns = NULL, *select = NULL, *sql = NULL;
+	zval *bind_params = NULL, *bind_types = NULL, *meta_data = NULL;
+	zval *cache = NULL, *key = NULL, *lifetime = NULL, *cache_options = NULL;
+	zval *exception_message = NULL, *fetch_mode = NULL, *result = NULL;
+	zval *c0 = NULL, *c1 = NULL;
+	zval *i0 = NULL;
+	HashPosition hp0;
+	zval **hd;
+	char *hash_index;
+	uint hash_index_len;
+	ulong hash_num;
+	int hash_type;
+	int eval_int;
+	zend_class_entry *ce0;
 
 	PHALCON_MM_GROW();
 	
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &event_name) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &aggregates, &parameters) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
 
-	if (phalcon_method_exists(this_ptr, event_name TSRMLS_CC) == SUCCESS) {
-		PHALCON_ALLOC_ZVAL_MM(r0);
-		PHALCON_CALL_METHOD(r0, this_ptr, Z_STRVAL_P(event_name), PH_NO_CHECK);
-		if (Z_TYPE_P(r0) == IS_BOOL && !Z_BVAL_P(r0)) {
-			PHALCON_MM_RESTORE();
-			RETURN_FALSE;
-		}
+	if (!parameters) {
+		PHALCON_ALLOC_ZVAL_MM(parameters);
+		ZVAL_NULL(parameters);
 	}
-	PHALCON_MM_RESTORE();
-	RETURN_TRUE;
-}
-
-/**
- * Fires an internal event that cancels the operation
- *
- * @param string $eventName
- * @return boolean
- */
-PHP_METHOD(Phalcon_Mvc_Model, _callEventCancel){
-
-	zval *event_name = NULL;
-	zval *r0 = NULL;
-
-	PHALCON_MM_GROW();
 	
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &event_name) == FAILURE) {
-		PHALCON_MM_RESTORE();
-		RETURN_NULL();
+	if (Z_TYPE_P(aggregates) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(aggregates))) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Aggregates must be a non empty Array indexed by alias");
+		return;
 	}
-
-	if (phalcon_method_exists(this_ptr, event_name TSRMLS_CC) == SUCCESS) {
-		PHALCON_ALLOC_ZVAL_MM(r0);
-		PHALCON_CALL_METHOD(r0, this_ptr, Z_STRVAL_P(event_name), PH_NO_CHECK);
-		if (Z_TYPE_P(r0) == IS_BOOL && !Z_BVAL_P(r0)) {
-			PHALCON_MM_RESTORE();
-			RETURN_FALSE;
+	
+	if (Z_TYPE_P(parameters) != IS_ARRAY) { 
+		if (Z_TYPE_P(parameters) != IS_NULL) {
+			PHALCON_INIT_VAR(params);
+			array_init(params);
+			phalcon_array_append(&params, parameters, PH_SEPARATE TSRMLS_CC);
+		} else {
+			PHALCON_INIT_VAR(params);
+			array_init(params);
 		}
+	} else {
+		PHALCON_CPY_WRT(params, parameters);
 	}
-	PHALCON_MM_RESTORE();
-	RETURN_TRUE;
-}
-
-/**
- * Cancel the current operation
- *
- * @return boolean
- */
-PHP_METHOD(Phalcon_Mvc_Model, _cancelOperation){
-
-	zval *disable_events = NULL;
-	zval *t0 = NULL, *t1 = NULL;
-	zval *r0 = NULL;
-	zval *c0 = NULL, *c1 = NULL;
-
-	PHALCON_MM_GROW();
 	
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &disable_events) == FAILURE) {
-		PHALCON_MM_RESTORE();
-		RETURN_NULL();
+	PHALCON_INIT_VAR(functions);
+	array_init(functions);
+	phalcon_array_update_string_string(&functions, SL("count"), SL("COUNT"), PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_string_string(&functions, SL("sum"), SL("SUM"), PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_string_string(&functions, SL("max"), SL("MAX"), PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_string_string(&functions, SL("maximum"), SL("MAX"), PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_string_string(&functions, SL("min"), SL("MIN"), PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_string_string(&functions, SL("minimum"), SL("MIN"), PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_string_string(&functions, SL("avg"), SL("AVG"), PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_string_string(&functions, SL("average"), SL("AVG"), PH_SEPARATE TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(columns);
+	array_init(columns);
+	
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(aggregates), &hp0);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(aggregates), (void**) &hd, &hp0) == SUCCESS) {
+		PHALCON_INIT_VAR(alias);
+		PHALCON_GET_FOREACH_KEY(alias, Z_ARRVAL_P(aggregates), hp0);
+		PHALCON_INIT_VAR(spec);
+		ZVAL_ZVAL(spec, *hd, 1, 0);
+		zend_hash_move_forward_ex(Z_ARRVAL_P(aggregates), &hp0);
+		
+		if (Z_TYPE_P(alias) != IS_STRING) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Aggregates must be a non empty Array indexed by alias");
+			return;
+		}
+		
+		/** 
+		 * The alias is the function itself unless the function is passed with the column
+		 */
+		if (Z_TYPE_P(spec) == IS_ARRAY) { 
+			eval_int = phalcon_array_isset_long(spec, 0);
+			if (eval_int) {
+				eval_int = phalcon_array_isset_long(spec, 1);
+			}
+			if (!eval_int) {
+				PHALCON_INIT_VAR(exception_message);
+				PHALCON_CONCAT_SVS(exception_message, "The aggregate '", alias, "' must be passed as array(function, column)");
+				
+				PHALCON_INIT_VAR(i0);
+				object_init_ex(i0, phalcon_mvc_model_exception_ce);
+				PHALCON_CALL_METHOD_PARAMS_1_NORETURN(i0, "__construct", exception_message, PH_CHECK);
+				phalcon_throw_exception(i0 TSRMLS_CC);
+				return;
+			}
+			
+			PHALCON_INIT_VAR(function);
+			phalcon_array_fetch_long(&function, spec, 0, PH_NOISY_CC);
+			
+			PHALCON_INIT_VAR(column);
+			phalcon_array_fetch_long(&column, spec, 1, PH_NOISY_CC);
+		} else {
+			PHALCON_CPY_WRT(function, alias);
+			PHALCON_CPY_WRT(column, spec);
+		}
+		
+		PHALCON_INIT_VAR(lower_function);
+		PHALCON_CALL_FUNC_PARAMS_1(lower_function, "strtolower", function);
+		eval_int = phalcon_array_isset(functions, lower_function);
+		if (!eval_int) {
+			PHALCON_INIT_VAR(exception_message);
+			PHALCON_CONCAT_SVS(exception_message, "Unknown aggregate function '", function, "'");
+			
+			PHALCON_INIT_VAR(i0);
+			object_init_ex(i0, phalcon_mvc_model_exception_ce);
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(i0, "__construct", exception_message, PH_CHECK);
+			phalcon_throw_exception(i0 TSRMLS_CC);
+			return;
+		}
+		
+		PHALCON_INIT_VAR(sql_function);
+		phalcon_array_fetch(&sql_function, functions, lower_function, PH_NOISY_CC);
+		
+		PHALCON_INIT_VAR(sql_column);
+		PHALCON_CONCAT_VSVS(sql_column, sql_function, "(", column, ") AS ");
+		phalcon_concat_self(&sql_column, alias TSRMLS_CC);
+		phalcon_array_append(&columns, sql_column, PH_SEPARATE TSRMLS_CC);
+	}
+	
+	PHALCON_INIT_VAR(dependency_injector);
+	PHALCON_CALL_STATIC(dependency_injector, "phalcon\\di", "getdefault");
+	
+	PHALCON_INIT_VAR(class_name);
+	PHALCON_CALL_FUNC(class_name, "get_called_class");
+	ce0 = phalcon_fetch_class(class_name TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(model);
+	object_init_ex(model, ce0);
+	PHALCON_CALL_METHOD_PARAMS_1_NORETURN(model, "__construct", dependency_injector, PH_CHECK);
+	
+	PHALCON_INIT_VAR(connection);
+	PHALCON_CALL_METHOD(connection, model, "getconnection", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(schema);
+	PHALCON_CALL_METHOD(schema, model, "getschema", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(source);
+	PHALCON_CALL_METHOD(source, model, "getsource", PH_NO_CHECK);
+	if (zend_is_true(schema)) {
+		PHALCON_INIT_VAR(table);
+		PHALCON_CONCAT_VSV(table, schema, ".", source);
+	} else {
+		PHALCON_CPY_WRT(table, source);
+	}
+	
+	PHALCON_INIT_VAR(c0);
+	ZVAL_STRING(c0, ", ", 1);
+	
+	PHALCON_INIT_VAR(joined_columns);
+	phalcon_fast_join(joined_columns, c0, columns TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(group);
+	ZVAL_NULL(group);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "group");
+	if (eval_int) {
+		PHALCON_INIT_VAR(group);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&group, params, "group", PH_NOISY_CC);
+		
+		PHALCON_INIT_VAR(select);
+		PHALCON_CONCAT_SVSVSV(select, "SELECT ", group, ", ", joined_columns, " FROM ", table);
+	} else {
+		PHALCON_INIT_VAR(select);
+		PHALCON_CONCAT_SVSV(select, "SELECT ", joined_columns, " FROM ", table);
+	}
+	
+	PHALCON_INIT_VAR(bind_params);
+	ZVAL_NULL(bind_params);
+	
+	PHALCON_INIT_VAR(bind_types);
+	ZVAL_NULL(bind_types);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "bind");
+	if (eval_int) {
+		PHALCON_INIT_VAR(bind_params);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&bind_params, params, "bind", PH_NOISY_CC);
+		PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "bindTypes");
+		if (eval_int) {
+			PHALCON_INIT_VAR(bind_types);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&bind_types, params, "bindTypes", PH_NOISY_CC);
+		} else {
+			PHALCON_INIT_VAR(c1);
+			ZVAL_STRING(c1, "modelsMetadata", 1);
+			
+			PHALCON_INIT_VAR(meta_data);
+			PHALCON_CALL_METHOD_PARAMS_1(meta_data, dependency_injector, "getshared", c1, PH_NO_CHECK);
+			
+			PHALCON_INIT_VAR(bind_types);
+			PHALCON_CALL_METHOD_PARAMS_2(bind_types, meta_data, "getbindtypes", model, bind_params, PH_NO_CHECK);
+		}
+	}
+	
+	PHALCON_INIT_VAR(sql);
+	phalcon_mvc_model_aggregate_clauses(sql, select, params, connection TSRMLS_CC);
+	if (EG(exception)) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	/** 
+	 * The 'cache' option is resolved in the same way as in find()
+	 */
+	PHALCON_INIT_VAR(cache);
+	ZVAL_NULL(cache);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, params, "cache");
+	if (eval_int) {
+		PHALCON_INIT_VAR(key);
+		ZVAL_NULL(key);
+		
+		PHALCON_INIT_VAR(lifetime);
+		ZVAL_NULL(lifetime);
+		
+		PHALCON_INIT_VAR(cache_options);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&cache_options, params, "cache", PH_NOISY_CC);
+		
+		PHALCON_INIT_VAR(cache);
+		phalcon_mvc_model_get_cache(cache, dependency_injector, cache_options, key, lifetime TSRMLS_CC);
+		if (EG(exception)) {
+			PHALCON_MM_RESTORE();
+			return;
+		}
+		
+		if (Z_TYPE_P(cache) != IS_NULL) {
+			if (Z_TYPE_P(key) == IS_NULL) {
+				PHALCON_INIT_VAR(key);
+				phalcon_mvc_model_cache_key(key, sql, bind_params TSRMLS_CC);
+				if (EG(exception)) {
+					PHALCON_MM_RESTORE();
+					return;
+				}
+			}
+			
+			PHALCON_INIT_VAR(result);
+			PHALCON_CALL_METHOD_PARAMS_2(result, cache, "get", key, lifetime, PH_NO_CHECK);
+			if (Z_TYPE_P(result) != IS_NULL) {
+				RETURN_CCTOR(result);
+			}
+		}
+	}
+	
+	PHALCON_INIT_VAR(fetch_mode);
+	ZVAL_LONG(fetch_mode, 1);
+	
+	/** 
+	 * Grouped aggregates return one row per group, otherwise the only row is returned
+	 */
+	if (Z_TYPE_P(group) != IS_NULL) {
+		PHALCON_INIT_VAR(result);
+		PHALCON_CALL_METHOD_PARAMS_4(result, connection, "fetchall", sql, fetch_mode, bind_params, bind_types, PH_NO_CHECK);
+	} else {
+		PHALCON_INIT_VAR(result);
+		PHALCON_CALL_METHOD_PARAMS_4(result, connection, "fetchone", sql, fetch_mode, bind_params, bind_types, PH_NO_CHECK);
+	}
+	
+	if (Z_TYPE_P(cache) != IS_NULL) {
+		PHALCON_CALL_METHOD_PARAMS_3_NORETURN(cache, "save", key, result, lifetime, PH_NO_CHECK);
+	}
+	
+	RETURN_CCTOR(result);
+}
+
+/**
+ * Fires an internal event
+ *
+ * @param string $eventName
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model, _callEvent){
+
+	zval *event_name = NULL;
+	zval *r0 = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &event_name) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (phalcon_method_exists(this_ptr, event_name TSRMLS_CC) == SUCCESS) {
+		PHALCON_ALLOC_ZVAL_MM(r0);
+		PHALCON_CALL_METHOD(r0, this_ptr, Z_STRVAL_P(event_name), PH_NO_CHECK);
+		if (Z_TYPE_P(r0) == IS_BOOL && !Z_BVAL_P(r0)) {
+			PHALCON_MM_RESTORE();
+			RETURN_FALSE;
+		}
+	}
+	PHALCON_MM_RESTORE();
+	RETURN_TRUE;
+}
+
+/**
+ * Fires an internal event that cancels the operation
+ *
+ * @param string $eventName
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model, _callEventCancel){
+
+	zval *event_name = NULL;
+	zval *r0 = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &event_name) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (phalcon_method_exists(this_ptr, event_name TSRMLS_CC) == SUCCESS) {
+		PHALCON_ALLOC_ZVAL_MM(r0);
+		PHALCON_CALL_METHOD(r0, this_ptr, Z_STRVAL_P(event_name), PH_NO_CHECK);
+		if (Z_TYPE_P(r0) == IS_BOOL && !Z_BVAL_P(r0)) {
+			PHALCON_MM_RESTORE();
+			RETURN_FALSE;
+		}
+	}
+	PHALCON_MM_RESTORE();
+	RETURN_TRUE;
+}
+
+/**
+ * Cancel the current operation
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model, _cancelOperation){
+
+	zval *disable_events = NULL;
+	zval *t0 = NULL, *t1 = NULL;
+	zval *r0 = NULL;
+	zval *c0 = NULL, *c1 = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &disable_events) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
 	}
 
 	if (!zend_is_true(disable_events)) {
 		PHALCON_ALLOC_ZVAL_MM(t0);
-		phalcon_read_property(&t0, this_ptr, SL("_operationMade"), PH_NOISY_CC);
+		PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_operationMade", PH_NOISY_CC);
 		PHALCON_INIT_VAR(t1);
 		ZVAL_LONG(t1, 3);
 		PHALCON_ALLOC_ZVAL_MM(r0);
@@ -1550,9 +2342,9 @@ PHP_METHOD(Phalcon_Mvc_Model, appendMessage){
 	}
 	
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_errorMessages"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_errorMessages", PH_NOISY_CC);
 	phalcon_array_append(&t0, message, 0 TSRMLS_CC);
-	phalcon_update_property_zval(this_ptr, SL("_errorMessages"), t0 TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_errorMessages", t0);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -1603,9 +2395,9 @@ PHP_METHOD(Phalcon_Mvc_Model, validate){
 			PHALCON_INIT_VAR(message);
 			ZVAL_ZVAL(message, *hd, 1, 0);
 			PHALCON_INIT_VAR(t0);
-			phalcon_read_property(&t0, this_ptr, SL("_errorMessages"), PH_NOISY_CC);
+			PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_errorMessages", PH_NOISY_CC);
 			phalcon_array_append(&t0, message, 0 TSRMLS_CC);
-			phalcon_update_property_zval(this_ptr, SL("_errorMessages"), t0 TSRMLS_CC);
+			PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_errorMessages", t0);
 			zend_hash_move_forward_ex(ah0, &hp0);
 			goto fes_8adf_2;
 		fee_8adf_2:
@@ -1628,7 +2420,7 @@ PHP_METHOD(Phalcon_Mvc_Model, validationHasFailed){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_errorMessages"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_errorMessages", PH_NOISY_CC);
 	PHALCON_INIT_VAR(number_messages);
 	phalcon_fast_count(number_messages, t0 TSRMLS_CC);
 	if (zend_is_true(number_messages)) {
@@ -1651,13 +2443,14 @@ PHP_METHOD(Phalcon_Mvc_Model, getMessages){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_errorMessages"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_errorMessages", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
 
 /**
- * Reads "belongs to" relations and check the virtual foreign keys when inserting or updating records
+ * Reads "belongs to" relations and check the virtual foreign keys when inserting or updating records.
+ * Referenced keys found once are remembered by the models manager for the rest of the request
  *
  * @return boolean
  */
@@ -1668,7 +2461,7 @@ PHP_METHOD(Phalcon_Mvc_Model, _checkForeignKeys){
 	zval *foreign_key = NULL, *conditions = NULL, *relation_class = NULL;
 	zval *referenced_model = NULL, *fields = NULL, *referenced_fields = NULL;
 	zval *field = NULL, *n = NULL, *value = NULL, *rowcount = NULL, *user_message = NULL;
-	zval *message = NULL;
+	zval *message = NULL, *verified = NULL;
 	zval *c0 = NULL, *c1 = NULL, *c2 = NULL, *c3 = NULL, *c4 = NULL;
 	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL, *r4 = NULL, *r5 = NULL, *r6 = NULL;
 	zval *r7 = NULL, *r8 = NULL, *r9 = NULL, *r10 = NULL, *r11 = NULL;
@@ -1722,31 +2515,26 @@ PHP_METHOD(Phalcon_Mvc_Model, _checkForeignKeys){
 			
 			PHALCON_INIT_VAR(relation);
 			ZVAL_ZVAL(relation, *hd, 1, 0);
-			eval_int = phalcon_array_isset_string(relation, SL("op")+1);
+			PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, relation, "op");
 			if (eval_int) {
 				PHALCON_INIT_VAR(options);
-				phalcon_array_fetch_string(&options, relation, SL("op"), PH_NOISY_CC);
-				eval_int = phalcon_array_isset_string(options, SL("foreignKey")+1);
+				PHALCON_ARRAY_FETCH_QUICK_STRING(&options, relation, "op", PH_NOISY_CC);
+				PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, options, "foreignKey");
 				if (eval_int) {
 					PHALCON_INIT_VAR(foreign_key);
-					phalcon_array_fetch_string(&foreign_key, options, SL("foreignKey"), PH_NOISY_CC);
+					PHALCON_ARRAY_FETCH_QUICK_STRING(&foreign_key, options, "foreignKey", PH_NOISY_CC);
 					if (zend_is_true(foreign_key)) {
 						PHALCON_INIT_VAR(conditions);
 						array_init(conditions);
 						
 						PHALCON_INIT_VAR(relation_class);
-						phalcon_array_fetch_string(&relation_class, relation, SL("rt"), PH_NOISY_CC);
-						ce0 = phalcon_fetch_class(relation_class TSRMLS_CC);
-						
-						PHALCON_INIT_VAR(referenced_model);
-						object_init_ex(referenced_model, ce0);
-						PHALCON_CALL_METHOD_PARAMS_1_NORETURN(referenced_model, "__construct", dependency_injector, PH_CHECK);
+						PHALCON_ARRAY_FETCH_QUICK_STRING(&relation_class, relation, "rt", PH_NOISY_CC);
 						
 						PHALCON_INIT_VAR(fields);
-						phalcon_array_fetch_string(&fields, relation, SL("fi"), PH_NOISY_CC);
+						PHALCON_ARRAY_FETCH_QUICK_STRING(&fields, relation, "fi", PH_NOISY_CC);
 						if (Z_TYPE_P(fields) == IS_ARRAY) { 
 							PHALCON_INIT_VAR(referenced_fields);
-							phalcon_array_fetch_string(&referenced_fields, relation, SL("rf"), PH_NOISY_CC);
+							PHALCON_ARRAY_FETCH_QUICK_STRING(&referenced_fields, relation, "rf", PH_NOISY_CC);
 							if (!phalcon_valid_foreach(fields TSRMLS_CC)) {
 								return;
 							}
@@ -1795,41 +2583,60 @@ PHP_METHOD(Phalcon_Mvc_Model, _checkForeignKeys){
 							PHALCON_INIT_VAR(r5);
 							ZVAL_BOOL(r5, zend_is_true(r3) || zend_is_true(r4));
 							if (zend_is_true(r5)) {
+								zend_hash_move_forward_ex(ah0, &hp0);
 								goto fes_8adf_3;
 							}
 							
 							PHALCON_INIT_VAR(r6);
-							phalcon_array_fetch_string(&r6, relation, SL("rf"), PH_NOISY_CC);
+							PHALCON_ARRAY_FETCH_QUICK_STRING(&r6, relation, "rf", PH_NOISY_CC);
 							
 							PHALCON_INIT_VAR(r7);
 							PHALCON_CONCAT_VSVS(r7, r6, " = '", value, "'");
 							phalcon_array_append(&conditions, r7, PH_SEPARATE TSRMLS_CC);
 						}
 						
-						eval_int = phalcon_array_isset_string(foreign_key, SL("conditions")+1);
+						PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, foreign_key, "conditions");
 						if (eval_int) {
 							PHALCON_INIT_VAR(r8);
-							phalcon_array_fetch_string(&r8, foreign_key, SL("conditions"), PH_NOISY_CC);
+							PHALCON_ARRAY_FETCH_QUICK_STRING(&r8, foreign_key, "conditions", PH_NOISY_CC);
 							phalcon_array_append(&conditions, r8, PH_SEPARATE TSRMLS_CC);
 						}
 						
-						PHALCON_INIT_VAR(r9);
-						PHALCON_CALL_METHOD(r9, this_ptr, "getconnectionservice", PH_NO_CHECK);
-						PHALCON_CALL_METHOD_PARAMS_1_NORETURN(referenced_model, "setconnectionservice", r9, PH_NO_CHECK);
-						
 						PHALCON_INIT_VAR(c1);
 						ZVAL_STRING(c1, " AND ", 1);
 						
 						PHALCON_INIT_VAR(r10);
 						phalcon_fast_join(r10, c1, conditions TSRMLS_CC);
 						
+						/** 
+						 * Keys already found in this request are not queried again
+						 */
+						PHALCON_INIT_VAR(verified);
+						PHALCON_CALL_METHOD_PARAMS_2(verified, manager, "isverifiedreference", relation_class, r10, PH_NO_CHECK);
+						if (zend_is_true(verified)) {
+							zend_hash_move_forward_ex(ah0, &hp0);
+							goto fes_8adf_3;
+						}
+						
+						ce0 = phalcon_fetch_class(relation_class TSRMLS_CC);
+						
+						PHALCON_INIT_VAR(referenced_model);
+						object_init_ex(referenced_model, ce0);
+						PHALCON_CALL_METHOD_PARAMS_1_NORETURN(referenced_model, "__construct", dependency_injector, PH_CHECK);
+						
+						PHALCON_INIT_VAR(r9);
+						PHALCON_CALL_METHOD(r9, this_ptr, "getconnectionservice", PH_NO_CHECK);
+						PHALCON_CALL_METHOD_PARAMS_1_NORETURN(referenced_model, "setconnectionservice", r9, PH_NO_CHECK);
+						
 						PHALCON_INIT_VAR(rowcount);
 						PHALCON_CALL_METHOD_PARAMS_1(rowcount, referenced_model, "count", r10, PH_NO_CHECK);
-						if (!zend_is_true(rowcount)) {
-							eval_int = phalcon_array_isset_string(foreign_key, SL("message")+1);
+						if (zend_is_true(rowcount)) {
+							PHALCON_CALL_METHOD_PARAMS_2_NORETURN(manager, "addverifiedreference", relation_class, r10, PH_NO_CHECK);
+						} else {
+							PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, foreign_key, "message");
 							if (eval_int) {
 								PHALCON_INIT_VAR(user_message);
-								phalcon_array_fetch_string(&user_message, foreign_key, SL("message"), PH_NOISY_CC);
+								PHALCON_ARRAY_FETCH_QUICK_STRING(&user_message, foreign_key, "message", PH_NOISY_CC);
 							} else {
 								if (Z_TYPE_P(fields) == IS_ARRAY) { 
 									PHALCON_INIT_VAR(c2);
@@ -1879,33 +2686,35 @@ PHP_METHOD(Phalcon_Mvc_Model, _checkForeignKeys){
 }
 
 /**
- * Reads both "hasMany" and "hasOne" relations and check the virtual foreign keys when deleting records
+ * Verifies the "belongs to" virtual foreign keys of many records at once. The distinct values of every
+ * single field relation are searched with IN queries, as many as the bind parameters limit of the dialect
+ * requires, and the keys found are remembered by the models manager, so the checks done later for each
+ * record don't query them again
  *
- * @return boolean
+ * @param Phalcon\DI $dependencyInjector
+ * @param Phalcon\Mvc\Model[] $records
  */
-PHP_METHOD(Phalcon_Mvc_Model, _checkForeignKeysReverse){
-
-	zval *dependency_injector = NULL, *disable_events = NULL;
-	zval *manager = NULL, *relations = NULL, *error = NULL, *relation = NULL, *options = NULL;
-	zval *foreign_key = NULL, *fields = NULL, *referenced_name = NULL;
-	zval *referenced_fields = NULL, *referenced_model = NULL;
-	zval *conditions = NULL, *field = NULL, *n = NULL, *value = NULL, *rowcount = NULL, *user_message = NULL;
-	zval *message = NULL;
-	zval *c0 = NULL, *c1 = NULL, *c2 = NULL, *c3 = NULL;
-	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL, *r4 = NULL, *r5 = NULL, *r6 = NULL;
-	HashTable *ah0, *ah1;
-	HashPosition hp0, hp1;
+PHP_METHOD(Phalcon_Mvc_Model, _checkForeignKeysBatch){
+
+	zval *dependency_injector = NULL, *records = NULL, *manager = NULL, *belongs_to = NULL;
+	zval *relation = NULL, *options = NULL, *foreign_key = NULL, *fields = NULL;
+	zval *referenced_fields = NULL, *relation_class = NULL, *extra_conditions = NULL;
+	zval *distinct = NULL, *record = NULL, *value = NULL, *placeholders = NULL, *bind = NULL;
+	zval *referenced_model = NULL, *connection = NULL, *schema = NULL, *source = NULL;
+	zval *table = NULL, *sql = NULL, *rows = NULL, *row = NULL, *found = NULL, *condition = NULL;
+	zval *dialect = NULL, *found_values = NULL;
+	zval *c0 = NULL, *c1 = NULL, *c2 = NULL;
+	zval *r0 = NULL, *r1 = NULL;
+	HashTable *ah0;
+	HashPosition hp0, hp1, hp2;
 	zval **hd;
-	char *hash_index;
-	uint hash_index_len;
-	ulong hash_num;
-	int hash_type;
-	int eval_int;
+	int eval_int, has_value, matched;
+	long max_params;
 	zend_class_entry *ce0;
 
 	PHALCON_MM_GROW();
 	
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz", &dependency_injector, &disable_events) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz", &dependency_injector, &records) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
@@ -1921,44 +2730,335 @@ PHP_METHOD(Phalcon_Mvc_Model, _checkForeignKeysReverse){
 	PHALCON_INIT_VAR(manager);
 	PHALCON_CALL_METHOD_PARAMS_1(manager, dependency_injector, "getshared", c0, PH_NO_CHECK);
 	
-	PHALCON_INIT_VAR(relations);
-	PHALCON_CALL_METHOD_PARAMS_1(relations, manager, "gethasoneandhasmany", this_ptr, PH_NO_CHECK);
+	PHALCON_INIT_VAR(belongs_to);
+	PHALCON_CALL_METHOD_PARAMS_1(belongs_to, manager, "getbelongsto", this_ptr, PH_NO_CHECK);
+	if (Z_TYPE_P(belongs_to) != IS_ARRAY || Z_TYPE_P(records) != IS_ARRAY) { 
+		PHALCON_MM_RESTORE();
+		RETURN_TRUE;
+	}
 	
-	PHALCON_ALLOC_ZVAL_MM(r0);
-	phalcon_fast_count(r0, relations TSRMLS_CC);
-	if (zend_is_true(r0)) {
-		PHALCON_INIT_VAR(error);
-		ZVAL_BOOL(error, 0);
-		if (!phalcon_valid_foreach(relations TSRMLS_CC)) {
-			return;
+	PHALCON_INIT_VAR(c1);
+	ZVAL_STRING(c1, ", ", 1);
+	
+	ah0 = Z_ARRVAL_P(belongs_to);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	fes_8adf_21:
+		if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
+			goto fee_8adf_21;
 		}
 		
-		ah0 = Z_ARRVAL_P(relations);
-		zend_hash_internal_pointer_reset_ex(ah0, &hp0);
-		fes_8adf_5:
-			if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
-				goto fee_8adf_5;
-			}
-			
-			PHALCON_INIT_VAR(relation);
+		PHALCON_INIT_VAR(relation);
+		ZVAL_ZVAL(relation, *hd, 1, 0);
+		zend_hash_move_forward_ex(ah0, &hp0);
+		
+		PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, relation, "op");
+		if (!eval_int) {
+			goto fes_8adf_21;
+		}
+		
+		PHALCON_INIT_VAR(options);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&options, relation, "op", PH_NOISY_CC);
+		PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, options, "foreignKey");
+		if (!eval_int) {
+			goto fes_8adf_21;
+		}
+		
+		PHALCON_INIT_VAR(foreign_key);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&foreign_key, options, "foreignKey", PH_NOISY_CC);
+		if (!zend_is_true(foreign_key)) {
+			goto fes_8adf_21;
+		}
+		
+		/** 
+		 * Relations over many fields are left to the check of every record
+		 */
+		PHALCON_INIT_VAR(fields);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&fields, relation, "fi", PH_NOISY_CC);
+		if (Z_TYPE_P(fields) == IS_ARRAY) { 
+			goto fes_8adf_21;
+		}
+		
+		PHALCON_INIT_VAR(distinct);
+		array_init(distinct);
+		
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(records), &hp1);
+		while (zend_hash_get_current_data_ex(Z_ARRVAL_P(records), (void**) &hd, &hp1) == SUCCESS) {
+			PHALCON_INIT_VAR(record);
+			ZVAL_ZVAL(record, *hd, 1, 0);
+			zend_hash_move_forward_ex(Z_ARRVAL_P(records), &hp1);
+			
+			if (Z_TYPE_P(record) != IS_OBJECT || !phalcon_isset_property_zval(record, fields TSRMLS_CC)) {
+				continue;
+			}
+			
+			PHALCON_INIT_VAR(value);
+			phalcon_read_property_zval(&value, record, fields, PH_NOISY_CC);
+			if (Z_TYPE_P(value) == IS_NULL || Z_TYPE_P(value) == IS_ARRAY || Z_TYPE_P(value) == IS_OBJECT) {
+				continue;
+			}
+			
+			PHALCON_INIT_VAR(r0);
+			ZVAL_ZVAL(r0, value, 1, 0);
+			convert_to_string(r0);
+			if (!Z_STRLEN_P(r0)) {
+				continue;
+			}
+			phalcon_array_update_zval(&distinct, r0, &r0, PH_COPY | PH_SEPARATE TSRMLS_CC);
+		}
+		
+		if (zend_hash_num_elements(Z_ARRVAL_P(distinct)) < 2) {
+			goto fes_8adf_21;
+		}
+		
+		PHALCON_INIT_VAR(referenced_fields);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&referenced_fields, relation, "rf", PH_NOISY_CC);
+		
+		PHALCON_INIT_VAR(relation_class);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&relation_class, relation, "rt", PH_NOISY_CC);
+		ce0 = phalcon_fetch_class(relation_class TSRMLS_CC);
+		
+		PHALCON_INIT_VAR(referenced_model);
+		object_init_ex(referenced_model, ce0);
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(referenced_model, "__construct", dependency_injector, PH_CHECK);
+		
+		PHALCON_INIT_VAR(r0);
+		PHALCON_CALL_METHOD(r0, this_ptr, "getconnectionservice", PH_NO_CHECK);
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(referenced_model, "setconnectionservice", r0, PH_NO_CHECK);
+		
+		PHALCON_INIT_VAR(connection);
+		PHALCON_CALL_METHOD(connection, referenced_model, "getconnection", PH_NO_CHECK);
+		
+		PHALCON_INIT_VAR(schema);
+		PHALCON_CALL_METHOD(schema, referenced_model, "getschema", PH_NO_CHECK);
+		
+		PHALCON_INIT_VAR(source);
+		PHALCON_CALL_METHOD(source, referenced_model, "getsource", PH_NO_CHECK);
+		if (zend_is_true(schema)) {
+			PHALCON_INIT_VAR(table);
+			PHALCON_CONCAT_VSV(table, schema, ".", source);
+		} else {
+			PHALCON_CPY_WRT(table, source);
+		}
+		
+		/** 
+		 * The IN list is split in statements that don't exceed the bind parameters the dialect allows
+		 */
+		PHALCON_INIT_VAR(dialect);
+		phalcon_read_property(&dialect, connection, SL("_dialect"), PH_SILENT_CC);
+		max_params = 0;
+		if (Z_TYPE_P(dialect) == IS_OBJECT) {
+			PHALCON_INIT_VAR(r1);
+			PHALCON_CALL_METHOD(r1, dialect, "getmaxbindparams", PH_NO_CHECK);
+			max_params = phalcon_get_intval(r1);
+		}
+		
+		PHALCON_INIT_VAR(extra_conditions);
+		ZVAL_NULL(extra_conditions);
+		if (Z_TYPE_P(foreign_key) == IS_ARRAY) { 
+			PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, foreign_key, "conditions");
+			if (eval_int) {
+				PHALCON_INIT_VAR(extra_conditions);
+				PHALCON_ARRAY_FETCH_QUICK_STRING(&extra_conditions, foreign_key, "conditions", PH_NOISY_CC);
+			}
+		}
+		
+		PHALCON_INIT_VAR(found_values);
+		array_init(found_values);
+		
+		PHALCON_INIT_VAR(placeholders);
+		array_init(placeholders);
+		
+		PHALCON_INIT_VAR(bind);
+		array_init(bind);
+		
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(distinct), &hp1);
+		while (1) {
+			
+			has_value = zend_hash_get_current_data_ex(Z_ARRVAL_P(distinct), (void**) &hd, &hp1) == SUCCESS;
+			if (has_value) {
+				phalcon_array_append_string(&placeholders, SL("?"), PH_SEPARATE TSRMLS_CC);
+				phalcon_array_append(&bind, *hd, PH_SEPARATE TSRMLS_CC);
+				zend_hash_move_forward_ex(Z_ARRVAL_P(distinct), &hp1);
+				if (max_params <= 0 || zend_hash_num_elements(Z_ARRVAL_P(bind)) < max_params) {
+					continue;
+				}
+			} else {
+				if (!zend_hash_num_elements(Z_ARRVAL_P(bind))) {
+					break;
+				}
+			}
+			
+			PHALCON_INIT_VAR(r1);
+			phalcon_fast_join(r1, c1, placeholders TSRMLS_CC);
+			
+			PHALCON_INIT_VAR(sql);
+			PHALCON_CONCAT_SVSVSV(sql, "SELECT ", referenced_fields, " FROM ", table, " WHERE ", referenced_fields);
+			
+			PHALCON_INIT_VAR(r0);
+			PHALCON_CONCAT_SVS(r0, " IN (", r1, ")");
+			phalcon_concat_self(&sql, r0 TSRMLS_CC);
+			if (Z_TYPE_P(extra_conditions) != IS_NULL) {
+				PHALCON_INIT_VAR(r1);
+				PHALCON_CONCAT_SVS(r1, " AND (", extra_conditions, ")");
+				phalcon_concat_self(&sql, r1 TSRMLS_CC);
+			}
+			
+			PHALCON_INIT_VAR(c2);
+			ZVAL_LONG(c2, 3);
+			
+			PHALCON_INIT_VAR(rows);
+			PHALCON_CALL_METHOD_PARAMS_3(rows, connection, "fetchall", sql, c2, bind, PH_NO_CHECK);
+			if (Z_TYPE_P(rows) == IS_ARRAY) { 
+				zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(rows), &hp2);
+				while (zend_hash_get_current_data_ex(Z_ARRVAL_P(rows), (void**) &hd, &hp2) == SUCCESS) {
+					PHALCON_INIT_VAR(row);
+					ZVAL_ZVAL(row, *hd, 1, 0);
+					zend_hash_move_forward_ex(Z_ARRVAL_P(rows), &hp2);
+					
+					PHALCON_INIT_VAR(found);
+					phalcon_array_fetch_long(&found, row, 0, PH_NOISY_CC);
+					convert_to_string(found);
+					phalcon_array_update_zval(&found_values, found, &found, PH_COPY | PH_SEPARATE TSRMLS_CC);
+				}
+			}
+			
+			if (!has_value) {
+				break;
+			}
+			
+			PHALCON_INIT_VAR(placeholders);
+			array_init(placeholders);
+			
+			PHALCON_INIT_VAR(bind);
+			array_init(bind);
+		}
+		
+		/** 
+		 * The verified references are keyed with the values of the records, the database may return them
+		 * normalized ("01" is returned as "1"), so the values not returned verbatim are compared loosely.
+		 * The condition has to be built exactly like _checkForeignKeys does to be found there
+		 */
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(distinct), &hp1);
+		while (zend_hash_get_current_data_ex(Z_ARRVAL_P(distinct), (void**) &hd, &hp1) == SUCCESS) {
+			PHALCON_INIT_VAR(value);
+			ZVAL_ZVAL(value, *hd, 1, 0);
+			zend_hash_move_forward_ex(Z_ARRVAL_P(distinct), &hp1);
+			
+			matched = phalcon_array_isset(found_values, value);
+			if (!matched) {
+				zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(found_values), &hp2);
+				while (zend_hash_get_current_data_ex(Z_ARRVAL_P(found_values), (void**) &hd, &hp2) == SUCCESS) {
+					PHALCON_INIT_VAR(r1);
+					is_equal_function(r1, value, *hd TSRMLS_CC);
+					if (zend_is_true(r1)) {
+						matched = 1;
+						break;
+					}
+					zend_hash_move_forward_ex(Z_ARRVAL_P(found_values), &hp2);
+				}
+			}
+			if (!matched) {
+				continue;
+			}
+			
+			PHALCON_INIT_VAR(condition);
+			PHALCON_CONCAT_VSVS(condition, referenced_fields, " = '", value, "'");
+			if (Z_TYPE_P(extra_conditions) != IS_NULL) {
+				PHALCON_INIT_VAR(r1);
+				PHALCON_CONCAT_SV(r1, " AND ", extra_conditions);
+				phalcon_concat_self(&condition, r1 TSRMLS_CC);
+			}
+			PHALCON_CALL_METHOD_PARAMS_2_NORETURN(manager, "addverifiedreference", relation_class, condition, PH_NO_CHECK);
+		}
+		goto fes_8adf_21;
+	fee_8adf_21:
+	if(0){}
+	
+	PHALCON_MM_RESTORE();
+	RETURN_TRUE;
+}
+
+/**
+ * Reads both "hasMany" and "hasOne" relations and check the virtual foreign keys when deleting records
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model, _checkForeignKeysReverse){
+
+	zval *dependency_injector = NULL, *disable_events = NULL;
+	zval *manager = NULL, *relations = NULL, *error = NULL, *relation = NULL, *options = NULL;
+	zval *foreign_key = NULL, *fields = NULL, *referenced_name = NULL;
+	zval *referenced_fields = NULL, *referenced_model = NULL;
+	zval *conditions = NULL, *field = NULL, *n = NULL, *value = NULL, *rowcount = NULL, *user_message = NULL;
+	zval *message = NULL;
+	zval *c0 = NULL, *c1 = NULL, *c2 = NULL, *c3 = NULL;
+	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL, *r4 = NULL, *r5 = NULL, *r6 = NULL;
+	HashTable *ah0, *ah1;
+	HashPosition hp0, hp1;
+	zval **hd;
+	char *hash_index;
+	uint hash_index_len;
+	ulong hash_num;
+	int hash_type;
+	int eval_int;
+	zend_class_entry *ce0;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz", &dependency_injector, &disable_events) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A dependency injector container is required to obtain the services related to the ORM");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(c0);
+	ZVAL_STRING(c0, "modelsManager", 1);
+	
+	PHALCON_INIT_VAR(manager);
+	PHALCON_CALL_METHOD_PARAMS_1(manager, dependency_injector, "getshared", c0, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(relations);
+	PHALCON_CALL_METHOD_PARAMS_1(relations, manager, "gethasoneandhasmany", this_ptr, PH_NO_CHECK);
+	
+	PHALCON_ALLOC_ZVAL_MM(r0);
+	phalcon_fast_count(r0, relations TSRMLS_CC);
+	if (zend_is_true(r0)) {
+		PHALCON_INIT_VAR(error);
+		ZVAL_BOOL(error, 0);
+		if (!phalcon_valid_foreach(relations TSRMLS_CC)) {
+			return;
+		}
+		
+		ah0 = Z_ARRVAL_P(relations);
+		zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+		fes_8adf_5:
+			if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
+				goto fee_8adf_5;
+			}
+			
+			PHALCON_INIT_VAR(relation);
 			ZVAL_ZVAL(relation, *hd, 1, 0);
-			eval_int = phalcon_array_isset_string(relation, SL("op")+1);
+			PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, relation, "op");
 			if (eval_int) {
 				PHALCON_INIT_VAR(options);
-				phalcon_array_fetch_string(&options, relation, SL("op"), PH_NOISY_CC);
-				eval_int = phalcon_array_isset_string(options, SL("foreignKey")+1);
+				PHALCON_ARRAY_FETCH_QUICK_STRING(&options, relation, "op", PH_NOISY_CC);
+				PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, options, "foreignKey");
 				if (eval_int) {
 					PHALCON_INIT_VAR(foreign_key);
-					phalcon_array_fetch_string(&foreign_key, options, SL("foreignKey"), PH_NOISY_CC);
+					PHALCON_ARRAY_FETCH_QUICK_STRING(&foreign_key, options, "foreignKey", PH_NOISY_CC);
 					if (zend_is_true(foreign_key)) {
 						PHALCON_INIT_VAR(fields);
-						phalcon_array_fetch_string(&fields, relation, SL("fi"), PH_NOISY_CC);
+						PHALCON_ARRAY_FETCH_QUICK_STRING(&fields, relation, "fi", PH_NOISY_CC);
 						
 						PHALCON_INIT_VAR(referenced_name);
-						phalcon_array_fetch_string(&referenced_name, relation, SL("rt"), PH_NOISY_CC);
+						PHALCON_ARRAY_FETCH_QUICK_STRING(&referenced_name, relation, "rt", PH_NOISY_CC);
 						
 						PHALCON_INIT_VAR(referenced_fields);
-						phalcon_array_fetch_string(&referenced_fields, relation, SL("rf"), PH_NOISY_CC);
+						PHALCON_ARRAY_FETCH_QUICK_STRING(&referenced_fields, relation, "rf", PH_NOISY_CC);
 						ce0 = phalcon_fetch_class(referenced_name TSRMLS_CC);
 						
 						PHALCON_INIT_VAR(referenced_model);
@@ -2018,10 +3118,10 @@ PHP_METHOD(Phalcon_Mvc_Model, _checkForeignKeysReverse){
 							phalcon_array_append(&conditions, r3, PH_SEPARATE TSRMLS_CC);
 						}
 						
-						eval_int = phalcon_array_isset_string(foreign_key, SL("conditions")+1);
+						PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, foreign_key, "conditions");
 						if (eval_int) {
 							PHALCON_INIT_VAR(r4);
-							phalcon_array_fetch_string(&r4, foreign_key, SL("conditions"), PH_NOISY_CC);
+							PHALCON_ARRAY_FETCH_QUICK_STRING(&r4, foreign_key, "conditions", PH_NOISY_CC);
 							phalcon_array_append(&conditions, r4, PH_SEPARATE TSRMLS_CC);
 						}
 						
@@ -2038,10 +3138,10 @@ PHP_METHOD(Phalcon_Mvc_Model, _checkForeignKeysReverse){
 						PHALCON_INIT_VAR(rowcount);
 						PHALCON_CALL_METHOD_PARAMS_1(rowcount, referenced_model, "count", r6, PH_NO_CHECK);
 						if (zend_is_true(rowcount)) {
-							eval_int = phalcon_array_isset_string(foreign_key, SL("message")+1);
+							PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, foreign_key, "message");
 							if (eval_int) {
 								PHALCON_INIT_VAR(user_message);
-								phalcon_array_fetch_string(&user_message, foreign_key, SL("message"), PH_NOISY_CC);
+								PHALCON_ARRAY_FETCH_QUICK_STRING(&user_message, foreign_key, "message", PH_NOISY_CC);
 							} else {
 								PHALCON_INIT_VAR(user_message);
 								PHALCON_CONCAT_SV(user_message, "Record is referenced by model ", referenced_name);
@@ -2226,9 +3326,9 @@ PHP_METHOD(Phalcon_Mvc_Model, _preSave){
 				PHALCON_CALL_METHOD_PARAMS_3_NORETURN(i0, "__construct", r10, field, c3, PH_CHECK);
 				
 				PHALCON_INIT_VAR(t2);
-				phalcon_read_property(&t2, this_ptr, SL("_errorMessages"), PH_NOISY_CC);
+				PHALCON_READ_PROPERTY_QUICK(&t2, this_ptr, "_errorMessages", PH_NOISY_CC);
 				phalcon_array_append(&t2, i0, 0 TSRMLS_CC);
-				phalcon_update_property_zval(this_ptr, SL("_errorMessages"), t2 TSRMLS_CC);
+				PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_errorMessages", t2);
 				
 				PHALCON_INIT_VAR(error);
 				ZVAL_BOOL(error, 1);
@@ -2504,179 +3604,1477 @@ PHP_METHOD(Phalcon_Mvc_Model, _doLowInsert){
 		}
 	}
 	
-	PHALCON_INIT_VAR(success);
-	PHALCON_CALL_METHOD_PARAMS_3(success, connection, "insert", table, values, fields, PH_NO_CHECK);
-	if (zend_is_true(identity_field)) {
-		PHALCON_ALLOC_ZVAL_MM(r7);
-		PHALCON_CALL_METHOD(r7, connection, "lastinsertid", PH_NO_CHECK);
-		phalcon_update_property_zval_zval(this_ptr, identity_field, r7 TSRMLS_CC);
+	PHALCON_INIT_VAR(success);
+	PHALCON_CALL_METHOD_PARAMS_3(success, connection, "insert", table, values, fields, PH_NO_CHECK);
+	if (zend_is_true(identity_field)) {
+		PHALCON_ALLOC_ZVAL_MM(r7);
+		PHALCON_CALL_METHOD(r7, connection, "lastinsertid", PH_NO_CHECK);
+		phalcon_update_property_zval_zval(this_ptr, identity_field, r7 TSRMLS_CC);
+	}
+	
+	
+	RETURN_CCTOR(success);
+}
+
+/**
+ * Sends a pre-build UPDATE SQL statement to the relational database system. When the record has a snapshot
+ * only the columns that changed are updated and no statement is sent if nothing changed
+ *
+ * @param Phalcon\Mvc\Model\Metadata $metaData
+ * @param Phalcon\Db $connection
+ * @param string $table
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model, _doLowUpdate){
+
+	zval *meta_data = NULL, *connection = NULL, *table = NULL, *null_value = NULL;
+	zval *fields = NULL, *values = NULL, *non_primary = NULL, *field = NULL, *value = NULL;
+	zval *snapshot = NULL, *unique_params = NULL;
+	zval *c0 = NULL;
+	zval *t0 = NULL, *t1 = NULL, *t2 = NULL;
+	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL;
+	zval *p0[] = { NULL, NULL, NULL, NULL, NULL };
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	int eval_int;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zzz", &meta_data, &connection, &table) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_INIT_VAR(null_value);
+	object_init_ex(null_value, phalcon_db_rawvalue_ce);
+	PHALCON_INIT_VAR(c0);
+	ZVAL_STRING(c0, "null", 1);
+	PHALCON_CALL_METHOD_PARAMS_1_NORETURN(null_value, "__construct", c0, PH_CHECK);
+	
+	PHALCON_INIT_VAR(fields);
+	array_init(fields);
+	
+	PHALCON_INIT_VAR(values);
+	array_init(values);
+	
+	PHALCON_INIT_VAR(snapshot);
+	PHALCON_READ_PROPERTY_QUICK(&snapshot, this_ptr, "_snapshot", PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(non_primary);
+	PHALCON_CALL_METHOD_PARAMS_1(non_primary, meta_data, "getnonprimarykeyattributes", this_ptr, PH_NO_CHECK);
+	if (!phalcon_valid_foreach(non_primary TSRMLS_CC)) {
+		return;
+	}
+	
+	ah0 = Z_ARRVAL_P(non_primary);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	fes_8adf_9:
+		if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
+			goto fee_8adf_9;
+		}
+		
+		PHALCON_INIT_VAR(field);
+		ZVAL_ZVAL(field, *hd, 1, 0);
+		if (Z_TYPE_P(snapshot) == IS_ARRAY) { 
+			PHALCON_INIT_VAR(value);
+			if (phalcon_isset_property_zval(this_ptr, field TSRMLS_CC)) {
+				phalcon_read_property_zval(&value, this_ptr, field, PH_NOISY_CC);
+			}
+			if (!phalcon_mvc_model_value_changed(snapshot, field, value TSRMLS_CC)) {
+				zend_hash_move_forward_ex(ah0, &hp0);
+				goto fes_8adf_9;
+			}
+		}
+		phalcon_array_append(&fields, field, PH_SEPARATE TSRMLS_CC);
+		eval_int = phalcon_isset_property_zval(this_ptr, field TSRMLS_CC);
+		if (eval_int) {
+			PHALCON_INIT_VAR(value);
+			phalcon_read_property_zval(&value, this_ptr, field, PH_NOISY_CC);
+			
+			PHALCON_INIT_VAR(t0);
+			ZVAL_STRING(t0, "", 1);
+			
+			PHALCON_INIT_VAR(r0);
+			is_identical_function(r0, t0, value TSRMLS_CC);
+			
+			PHALCON_INIT_VAR(t1);
+			ZVAL_NULL(t1);
+			
+			PHALCON_INIT_VAR(r1);
+			is_identical_function(r1, t1, value TSRMLS_CC);
+			
+			PHALCON_INIT_VAR(r2);
+			ZVAL_BOOL(r2, zend_is_true(r0) || zend_is_true(r1));
+			if (zend_is_true(r2)) {
+				phalcon_array_append(&values, null_value, PH_SEPARATE TSRMLS_CC);
+			} else {
+				phalcon_array_append(&values, value, PH_SEPARATE TSRMLS_CC);
+			}
+		} else {
+			phalcon_array_append(&values, null_value, PH_SEPARATE TSRMLS_CC);
+		}
+		zend_hash_move_forward_ex(ah0, &hp0);
+		goto fes_8adf_9;
+	fee_8adf_9:
+	if(0){}
+	
+	if (Z_TYPE_P(snapshot) == IS_ARRAY && !zend_hash_num_elements(Z_ARRVAL_P(fields))) {
+		PHALCON_MM_RESTORE();
+		RETURN_TRUE;
+	}
+	
+	PHALCON_ALLOC_ZVAL_MM(t2);
+	PHALCON_READ_PROPERTY_QUICK(&t2, this_ptr, "_uniqueKey", PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(unique_params);
+	PHALCON_READ_PROPERTY_QUICK(&unique_params, this_ptr, "_uniqueParams", PH_NOISY_CC);
+	
+	PHALCON_ALLOC_ZVAL_MM(r3);
+	p0[0] = table;
+	p0[1] = fields;
+	p0[2] = values;
+	p0[3] = t2;
+	p0[4] = unique_params;
+	PHALCON_CALL_METHOD_PARAMS(r3, connection, "update", 5, p0, PH_NO_CHECK);
+	RETURN_CTOR(r3);
+}
+
+/**
+ * Returns the key that identifies the record in the identity map or null if the primary key is not complete
+ *
+ * @param Phalcon\Mvc\Model\Metadata $metaData
+ * @return string
+ */
+PHP_METHOD(Phalcon_Mvc_Model, _getIdentityKey){
+
+	zval *meta_data = NULL, *primary_keys = NULL, *values = NULL, *primary_key = NULL;
+	zval *value = NULL, *key = NULL;
+	zval *c0 = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &meta_data) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_INIT_VAR(primary_keys);
+	PHALCON_CALL_METHOD_PARAMS_1(primary_keys, meta_data, "getprimarykeyattributes", this_ptr, PH_NO_CHECK);
+	if (Z_TYPE_P(primary_keys) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(primary_keys))) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+	
+	PHALCON_INIT_VAR(values);
+	array_init(values);
+	if (!phalcon_valid_foreach(primary_keys TSRMLS_CC)) {
+		return;
+	}
+	
+	ah0 = Z_ARRVAL_P(primary_keys);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	fes_8adf_13:
+		if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
+			goto fee_8adf_13;
+		}
+		
+		PHALCON_GET_FOREACH_VALUE(primary_key);
+		if (!phalcon_isset_property_zval(this_ptr, primary_key TSRMLS_CC)) {
+			PHALCON_MM_RESTORE();
+			RETURN_NULL();
+		}
+		
+		PHALCON_INIT_VAR(value);
+		phalcon_read_property_zval(&value, this_ptr, primary_key, PH_NOISY_CC);
+		if (Z_TYPE_P(value) == IS_NULL) {
+			PHALCON_MM_RESTORE();
+			RETURN_NULL();
+		}
+		
+		phalcon_array_append(&values, value, PH_SEPARATE TSRMLS_CC);
+		zend_hash_move_forward_ex(ah0, &hp0);
+		goto fes_8adf_13;
+	fee_8adf_13:
+	if(0){}
+	
+	PHALCON_INIT_VAR(c0);
+	ZVAL_STRING(c0, ",", 1);
+	
+	PHALCON_INIT_VAR(key);
+	phalcon_fast_join(key, c0, values TSRMLS_CC);
+	
+	RETURN_CTOR(key);
+}
+
+/**
+ * Checks if the record has a snapshot of the values it had when it was loaded or saved
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model, hasSnapshotData){
+
+	zval *snapshot = NULL;
+
+	PHALCON_MM_GROW();
+	PHALCON_INIT_VAR(snapshot);
+	PHALCON_READ_PROPERTY_QUICK(&snapshot, this_ptr, "_snapshot", PH_NOISY_CC);
+	if (Z_TYPE_P(snapshot) == IS_ARRAY) { 
+		PHALCON_MM_RESTORE();
+		RETURN_TRUE;
+	}
+	
+	PHALCON_MM_RESTORE();
+	RETURN_FALSE;
+}
+
+/**
+ * Returns the snapshot of the values the record had when it was loaded or saved
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model, getSnapshotData){
+
+	zval *snapshot = NULL;
+
+	PHALCON_MM_GROW();
+	PHALCON_INIT_VAR(snapshot);
+	PHALCON_READ_PROPERTY_QUICK(&snapshot, this_ptr, "_snapshot", PH_NOISY_CC);
+	
+	RETURN_CCTOR(snapshot);
+}
+
+/**
+ * Sets the snapshot of the record, the record is considered persisted with these values
+ *
+ * @param array $data
+ */
+PHP_METHOD(Phalcon_Mvc_Model, setSnapshotData){
+
+	zval *data = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &data) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(data) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The snapshot data must be an array");
+		return;
+	}
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_snapshot", data);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns the names of the attributes whose values differ from the snapshot
+ *
+ *<code>
+ * $robot = Robots::findFirst();
+ * $robot->name = 'Voltron';
+ * print_r($robot->getChangedFields()); // array('name')
+ *</code>
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model, getChangedFields){
+
+	zval *snapshot = NULL, *dependency_injector = NULL, *meta_data = NULL;
+	zval *attributes = NULL, *changed = NULL, *field = NULL, *value = NULL;
+	zval *c0 = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+	PHALCON_INIT_VAR(snapshot);
+	PHALCON_READ_PROPERTY_QUICK(&snapshot, this_ptr, "_snapshot", PH_NOISY_CC);
+	if (Z_TYPE_P(snapshot) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The record doesn't have a valid data snapshot");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(dependency_injector);
+	PHALCON_READ_PROPERTY_QUICK(&dependency_injector, this_ptr, "_dependencyInjector", PH_NOISY_CC);
+	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A dependency injector container is required to obtain the services related to the ORM");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(c0);
+	ZVAL_STRING(c0, "modelsMetadata", 1);
+	
+	PHALCON_INIT_VAR(meta_data);
+	PHALCON_CALL_METHOD_PARAMS_1(meta_data, dependency_injector, "getshared", c0, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(attributes);
+	PHALCON_CALL_METHOD_PARAMS_1(attributes, meta_data, "getattributes", this_ptr, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(changed);
+	array_init(changed);
+	if (!phalcon_valid_foreach(attributes TSRMLS_CC)) {
+		return;
+	}
+	
+	ah0 = Z_ARRVAL_P(attributes);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	fes_8adf_14:
+		if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
+			goto fee_8adf_14;
+		}
+		
+		PHALCON_GET_FOREACH_VALUE(field);
+		
+		PHALCON_INIT_VAR(value);
+		if (phalcon_isset_property_zval(this_ptr, field TSRMLS_CC)) {
+			phalcon_read_property_zval(&value, this_ptr, field, PH_NOISY_CC);
+		}
+		if (phalcon_mvc_model_value_changed(snapshot, field, value TSRMLS_CC)) {
+			phalcon_array_append(&changed, field, PH_SEPARATE TSRMLS_CC);
+		}
+		zend_hash_move_forward_ex(ah0, &hp0);
+		goto fes_8adf_14;
+	fee_8adf_14:
+	if(0){}
+	
+	
+	RETURN_CTOR(changed);
+}
+
+/**
+ * Checks if an attribute, or any attribute if no name is passed, differs from the snapshot
+ *
+ * @param string $fieldName
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model, hasChanged){
+
+	zval *field_name = NULL, *snapshot = NULL, *value = NULL, *changed = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|z", &field_name) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (field_name && Z_TYPE_P(field_name) == IS_STRING) {
+		PHALCON_INIT_VAR(snapshot);
+		PHALCON_READ_PROPERTY_QUICK(&snapshot, this_ptr, "_snapshot", PH_NOISY_CC);
+		if (Z_TYPE_P(snapshot) != IS_ARRAY) { 
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The record doesn't have a valid data snapshot");
+			return;
+		}
+		
+		PHALCON_INIT_VAR(value);
+		if (phalcon_isset_property_zval(this_ptr, field_name TSRMLS_CC)) {
+			phalcon_read_property_zval(&value, this_ptr, field_name, PH_NOISY_CC);
+		}
+		if (phalcon_mvc_model_value_changed(snapshot, field_name, value TSRMLS_CC)) {
+			PHALCON_MM_RESTORE();
+			RETURN_TRUE;
+		}
+		
+		PHALCON_MM_RESTORE();
+		RETURN_FALSE;
+	}
+	
+	PHALCON_INIT_VAR(changed);
+	PHALCON_CALL_METHOD(changed, this_ptr, "getchangedfields", PH_NO_CHECK);
+	if (Z_TYPE_P(changed) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL_P(changed))) {
+		PHALCON_MM_RESTORE();
+		RETURN_TRUE;
+	}
+	
+	PHALCON_MM_RESTORE();
+	RETURN_FALSE;
+}
+
+/**
+ * Inserts or updates a model instance. Returning true on success or false otherwise.
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model, save){
+
+	zval *dependency_injector = NULL, *meta_data = NULL, *connection = NULL;
+	zval *exists = NULL, *disable_events = NULL, *identity_field = NULL;
+	zval *schema = NULL, *source = NULL, *table = NULL, *success = NULL;
+	zval *attributes = NULL, *snapshot = NULL, *manager = NULL, *class_name = NULL;
+	zval *c0 = NULL, *c1 = NULL;
+	zval *a0 = NULL;
+	zval *r0 = NULL, *r1 = NULL;
+	zval *p0[] = { NULL, NULL, NULL, NULL, NULL };
+
+	PHALCON_MM_GROW();
+	PHALCON_INIT_VAR(dependency_injector);
+	PHALCON_READ_PROPERTY_QUICK(&dependency_injector, this_ptr, "_dependencyInjector", PH_NOISY_CC);
+	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A dependency injector container is required to obtain the services related to the ORM");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(c0);
+	ZVAL_STRING(c0, "modelsMetadata", 1);
+	
+	PHALCON_INIT_VAR(meta_data);
+	PHALCON_CALL_METHOD_PARAMS_1(meta_data, dependency_injector, "getshared", c0, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(connection);
+	PHALCON_CALL_METHOD(connection, this_ptr, "getconnection", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(exists);
+	PHALCON_CALL_METHOD_PARAMS_2(exists, this_ptr, "_exists", meta_data, connection, PH_NO_CHECK);
+	if (!zend_is_true(exists)) {
+		phalcon_update_property_long(this_ptr, SL("_operationMade"), 1 TSRMLS_CC);
+	} else {
+		phalcon_update_property_long(this_ptr, SL("_operationMade"), 2 TSRMLS_CC);
+	}
+	
+	PHALCON_ALLOC_ZVAL_MM(a0);
+	array_init(a0);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_errorMessages", a0);
+	PHALCON_OBSERVE_VAR(disable_events);
+	phalcon_read_static_property(&disable_events, SL("phalcon\\mvc\\model"), SL("_disableEvents") TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(identity_field);
+	PHALCON_CALL_METHOD_PARAMS_1(identity_field, meta_data, "getidentityfield", this_ptr, PH_NO_CHECK);
+	p0[0] = dependency_injector;
+	p0[1] = meta_data;
+	p0[2] = disable_events;
+	p0[3] = exists;
+	p0[4] = identity_field;
+	
+	PHALCON_ALLOC_ZVAL_MM(r0);
+	PHALCON_CALL_METHOD_PARAMS(r0, this_ptr, "_presave", 5, p0, PH_NO_CHECK);
+	if (Z_TYPE_P(r0) == IS_BOOL && !Z_BVAL_P(r0)) {
+		PHALCON_MM_RESTORE();
+		RETURN_FALSE;
+	}
+	
+	PHALCON_INIT_VAR(schema);
+	PHALCON_CALL_METHOD(schema, this_ptr, "getschema", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(source);
+	PHALCON_CALL_METHOD(source, this_ptr, "getsource", PH_NO_CHECK);
+	if (zend_is_true(schema)) {
+		PHALCON_INIT_VAR(table);
+		PHALCON_CONCAT_VSV(table, schema, ".", source);
+	} else {
+		PHALCON_CPY_WRT(table, source);
+	}
+	
+	if (zend_is_true(exists)) {
+		PHALCON_INIT_VAR(success);
+		PHALCON_CALL_METHOD_PARAMS_3(success, this_ptr, "_dolowupdate", meta_data, connection, table, PH_NO_CHECK);
+		
+		/** 
+		 * The updated values may be the ones other records were verified against
+		 */
+		if (zend_is_true(success)) {
+			PHALCON_INIT_VAR(c1);
+			ZVAL_STRING(c1, "modelsManager", 1);
+			
+			PHALCON_INIT_VAR(manager);
+			PHALCON_CALL_METHOD_PARAMS_1(manager, dependency_injector, "getshared", c1, PH_NO_CHECK);
+			
+			PHALCON_INIT_VAR(class_name);
+			phalcon_get_class(class_name, this_ptr TSRMLS_CC);
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(manager, "clearverifiedreferences", class_name, PH_NO_CHECK);
+		}
+	} else {
+		PHALCON_INIT_VAR(success);
+		PHALCON_CALL_METHOD_PARAMS_4(success, this_ptr, "_dolowinsert", meta_data, connection, table, identity_field, PH_NO_CHECK);
+	}
+	
+	PHALCON_ALLOC_ZVAL_MM(r1);
+	PHALCON_CALL_METHOD_PARAMS_3(r1, this_ptr, "_postsave", disable_events, success, exists, PH_NO_CHECK);
+	if (zend_is_true(r1)) {
+		phalcon_update_property_null(this_ptr, SL("_related") TSRMLS_CC);
+		
+		PHALCON_INIT_VAR(attributes);
+		PHALCON_CALL_METHOD_PARAMS_1(attributes, meta_data, "getattributes", this_ptr, PH_NO_CHECK);
+		
+		PHALCON_INIT_VAR(snapshot);
+		phalcon_mvc_model_build_snapshot(snapshot, this_ptr, attributes TSRMLS_CC);
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_snapshot", snapshot);
+	}
+	
+	RETURN_CTOR(r1);
+}
+
+/**
+ * Saves the records passed to Phalcon\Mvc\Model::saveMany, the caller has checked they belong to the same model
+ */
+static void phalcon_mvc_model_save_many(zval *return_value, zval *first, zval *records, zval *dependency_injector, zval *meta_data, zval *connection TSRMLS_DC){
+
+	zval *record = NULL, *disable_events = NULL, *identity_field = NULL, *attributes = NULL;
+	zval *schema = NULL, *source = NULL, *table = NULL, *exists = NULL, *success = NULL;
+	zval *inserted = NULL, *inserted_identity = NULL, *group_records = NULL;
+	zval *fields = NULL, *fields_identity = NULL, *group_fields = NULL;
+	zval *rows = NULL, *row = NULL, *field = NULL, *identity = NULL;
+	zval *value = NULL, *null_value = NULL, *snapshot = NULL, *status = NULL;
+	zval *c0 = NULL;
+	zval *a0 = NULL;
+	zval *r0 = NULL;
+	zval *p0[] = { NULL, NULL, NULL, NULL, NULL };
+	HashTable *ah0, *ah1, *ah2, *ah3;
+	HashPosition hp0, hp1, hp2, hp3;
+	zval **hd;
+	int all_saved = 1, group;
+
+	PHALCON_MM_GROW();
+	
+	PHALCON_INIT_VAR(identity_field);
+	PHALCON_CALL_METHOD_PARAMS_1(identity_field, meta_data, "getidentityfield", first, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(attributes);
+	PHALCON_CALL_METHOD_PARAMS_1(attributes, meta_data, "getattributes", first, PH_NO_CHECK);
+	if (!phalcon_valid_foreach(attributes TSRMLS_CC)) {
+		return;
+	}
+	
+	PHALCON_OBSERVE_VAR(disable_events);
+	phalcon_read_static_property(&disable_events, SL("phalcon\\mvc\\model"), SL("_disableEvents") TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(inserted);
+	array_init(inserted);
+	
+	PHALCON_INIT_VAR(inserted_identity);
+	array_init(inserted_identity);
+	
+	PHALCON_INIT_VAR(exists);
+	ZVAL_BOOL(exists, 0);
+	
+	/** 
+	 * The foreign keys shared by the records are verified together before validating each one
+	 */
+	PHALCON_CALL_METHOD_PARAMS_2_NORETURN(first, "_checkforeignkeysbatch", dependency_injector, records, PH_NO_CHECK);
+	
+	/** 
+	 * Existing records are updated individually, new ones are validated and queued for the batch.
+	 * Records with a value for the identity column are inserted in their own statements
+	 */
+	ah0 = Z_ARRVAL_P(records);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	fes_8adf_16:
+		if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
+			goto fee_8adf_16;
+		}
+		
+		PHALCON_INIT_VAR(record);
+		ZVAL_ZVAL(record, *hd, 1, 0);
+		
+		PHALCON_INIT_VAR(r0);
+		PHALCON_CALL_METHOD_PARAMS_2(r0, record, "_exists", meta_data, connection, PH_NO_CHECK);
+		if (zend_is_true(r0)) {
+			PHALCON_INIT_VAR(status);
+			PHALCON_CALL_METHOD(status, record, "save", PH_NO_CHECK);
+			if (!zend_is_true(status)) {
+				all_saved = 0;
+			}
+		} else {
+			phalcon_update_property_long(record, SL("_operationMade"), 1 TSRMLS_CC);
+			
+			PHALCON_INIT_VAR(a0);
+			array_init(a0);
+			PHALCON_UPDATE_PROPERTY_QUICK(record, "_errorMessages", a0);
+			p0[0] = dependency_injector;
+			p0[1] = meta_data;
+			p0[2] = disable_events;
+			p0[3] = exists;
+			p0[4] = identity_field;
+			
+			PHALCON_INIT_VAR(status);
+			PHALCON_CALL_METHOD_PARAMS(status, record, "_presave", 5, p0, PH_NO_CHECK);
+			if (Z_TYPE_P(status) == IS_BOOL && !Z_BVAL_P(status)) {
+				all_saved = 0;
+			} else {
+				PHALCON_INIT_VAR(identity);
+				ZVAL_NULL(identity);
+				if (zend_is_true(identity_field) && phalcon_isset_property_zval(record, identity_field TSRMLS_CC)) {
+					phalcon_read_property_zval(&identity, record, identity_field, PH_NOISY_CC);
+				}
+				if (Z_TYPE_P(identity) == IS_NULL || (Z_TYPE_P(identity) == IS_STRING && !Z_STRLEN_P(identity))) {
+					phalcon_array_append(&inserted, record, PH_SEPARATE TSRMLS_CC);
+				} else {
+					phalcon_array_append(&inserted_identity, record, PH_SEPARATE TSRMLS_CC);
+				}
+			}
+		}
+		zend_hash_move_forward_ex(ah0, &hp0);
+		goto fes_8adf_16;
+	fee_8adf_16:
+	if(0){}
+	
+	if (!zend_hash_num_elements(Z_ARRVAL_P(inserted)) && !zend_hash_num_elements(Z_ARRVAL_P(inserted_identity))) {
+		if (all_saved) {
+			PHALCON_MM_RESTORE();
+			RETURN_TRUE;
+		}
+		PHALCON_MM_RESTORE();
+		RETURN_FALSE;
+	}
+	
+	PHALCON_INIT_VAR(null_value);
+	object_init_ex(null_value, phalcon_db_rawvalue_ce);
+	
+	PHALCON_INIT_VAR(c0);
+	ZVAL_STRING(c0, "null", 1);
+	PHALCON_CALL_METHOD_PARAMS_1_NORETURN(null_value, "__construct", c0, PH_CHECK);
+	
+	PHALCON_INIT_VAR(fields);
+	array_init(fields);
+	
+	PHALCON_INIT_VAR(fields_identity);
+	array_init(fields_identity);
+	
+	ah1 = Z_ARRVAL_P(attributes);
+	zend_hash_internal_pointer_reset_ex(ah1, &hp1);
+	while (zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) == SUCCESS) {
+		PHALCON_INIT_VAR(r0);
+		is_equal_function(r0, *hd, identity_field TSRMLS_CC);
+		if (!zend_is_true(r0)) {
+			phalcon_array_append(&fields, *hd, PH_SEPARATE TSRMLS_CC);
+		}
+		phalcon_array_append(&fields_identity, *hd, PH_SEPARATE TSRMLS_CC);
+		zend_hash_move_forward_ex(ah1, &hp1);
+	}
+	
+	PHALCON_INIT_VAR(schema);
+	PHALCON_CALL_METHOD(schema, first, "getschema", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(source);
+	PHALCON_CALL_METHOD(source, first, "getsource", PH_NO_CHECK);
+	if (zend_is_true(schema)) {
+		PHALCON_INIT_VAR(table);
+		PHALCON_CONCAT_VSV(table, schema, ".", source);
+	} else {
+		PHALCON_CPY_WRT(table, source);
+	}
+	
+	for (group = 0; group < 2; group++) {
+		
+		if (group == 0) {
+			PHALCON_CPY_WRT(group_records, inserted);
+			PHALCON_CPY_WRT(group_fields, fields);
+		} else {
+			PHALCON_CPY_WRT(group_records, inserted_identity);
+			PHALCON_CPY_WRT(group_fields, fields_identity);
+		}
+		if (!zend_hash_num_elements(Z_ARRVAL_P(group_records))) {
+			continue;
+		}
+		
+		PHALCON_INIT_VAR(rows);
+		array_init(rows);
+		
+		ah2 = Z_ARRVAL_P(group_records);
+		zend_hash_internal_pointer_reset_ex(ah2, &hp2);
+		while (zend_hash_get_current_data_ex(ah2, (void**) &hd, &hp2) == SUCCESS) {
+			
+			PHALCON_INIT_VAR(record);
+			ZVAL_ZVAL(record, *hd, 1, 0);
+			
+			PHALCON_INIT_VAR(row);
+			array_init(row);
+			
+			ah3 = Z_ARRVAL_P(group_fields);
+			zend_hash_internal_pointer_reset_ex(ah3, &hp3);
+			while (zend_hash_get_current_data_ex(ah3, (void**) &hd, &hp3) == SUCCESS) {
+				PHALCON_INIT_VAR(field);
+				ZVAL_ZVAL(field, *hd, 1, 0);
+				if (phalcon_isset_property_zval(record, field TSRMLS_CC)) {
+					PHALCON_INIT_VAR(value);
+					phalcon_read_property_zval(&value, record, field, PH_NOISY_CC);
+					if (Z_TYPE_P(value) == IS_NULL || (Z_TYPE_P(value) == IS_STRING && !Z_STRLEN_P(value))) {
+						phalcon_array_append(&row, null_value, PH_SEPARATE TSRMLS_CC);
+					} else {
+						phalcon_array_append(&row, value, PH_SEPARATE TSRMLS_CC);
+					}
+				} else {
+					phalcon_array_append(&row, null_value, PH_SEPARATE TSRMLS_CC);
+				}
+				zend_hash_move_forward_ex(ah3, &hp3);
+			}
+			
+			phalcon_array_append(&rows, row, PH_SEPARATE TSRMLS_CC);
+			zend_hash_move_forward_ex(ah2, &hp2);
+		}
+		
+		PHALCON_INIT_VAR(success);
+		PHALCON_CALL_METHOD_PARAMS_3(success, connection, "insertmany", table, rows, group_fields, PH_NO_CHECK);
+		
+		/** 
+		 * Records without a known identity value can't be tracked by a snapshot
+		 */
+		zend_hash_internal_pointer_reset_ex(ah2, &hp2);
+		while (zend_hash_get_current_data_ex(ah2, (void**) &hd, &hp2) == SUCCESS) {
+			PHALCON_INIT_VAR(record);
+			ZVAL_ZVAL(record, *hd, 1, 0);
+			
+			PHALCON_INIT_VAR(status);
+			PHALCON_CALL_METHOD_PARAMS_3(status, record, "_postsave", disable_events, success, exists, PH_NO_CHECK);
+			if (zend_is_true(status)) {
+				phalcon_update_property_null(record, SL("_related") TSRMLS_CC);
+				if (group == 1 || !zend_is_true(identity_field)) {
+					PHALCON_INIT_VAR(snapshot);
+					phalcon_mvc_model_build_snapshot(snapshot, record, attributes TSRMLS_CC);
+					PHALCON_UPDATE_PROPERTY_QUICK(record, "_snapshot", snapshot);
+				}
+			} else {
+				all_saved = 0;
+			}
+			zend_hash_move_forward_ex(ah2, &hp2);
+		}
+	}
+	
+	if (all_saved) {
+		PHALCON_MM_RESTORE();
+		RETURN_TRUE;
+	}
+	
+	PHALCON_MM_RESTORE();
+	RETURN_FALSE;
+}
+
+/**
+ * Saves many records of the same model at once. Records that already exist are saved one by one, new records
+ * are validated individually and then inserted using multi-row INSERT statements through Phalcon\Db::insertMany.
+ * The identity column is only left out for records that don't have a value for it, the values it generates
+ * are not read back into the inserted records. Unless a transaction is already open on the connection the
+ * whole batch runs inside a transaction that is rolled back if any record can't be saved
+ *
+ *<code>
+ * $robots = array();
+ * foreach (array("Astro Boy", "Terminator") as $name) {
+ *     $robot = new Robots();
+ *     $robot->name = $name;
+ *     $robots[] = $robot;
+ * }
+ * $success = Robots::saveMany($robots);
+ *</code>
+ *
+ * @param Phalcon\Mvc\Model[] $records
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model, saveMany){
+
+	zval *records = NULL, *record = NULL, *first = NULL;
+	zval *dependency_injector = NULL, *meta_data = NULL, *connection = NULL;
+	zval *under_transaction = NULL;
+	zval *c0 = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	int own_transaction;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &records) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(records) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Records passed to saveMany must be an Array");
+		return;
+	}
+	
+	if (!zend_hash_num_elements(Z_ARRVAL_P(records))) {
+		PHALCON_MM_RESTORE();
+		RETURN_TRUE;
+	}
+	
+	/** 
+	 * Every record must belong to the same model so they can share a statement
+	 */
+	ah0 = Z_ARRVAL_P(records);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	fes_8adf_15:
+		if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
+			goto fee_8adf_15;
+		}
+		
+		PHALCON_INIT_VAR(record);
+		ZVAL_ZVAL(record, *hd, 1, 0);
+		if (Z_TYPE_P(record) != IS_OBJECT || !instanceof_function(Z_OBJCE_P(record), phalcon_mvc_model_ce TSRMLS_CC)) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Every record passed to saveMany must be an instance of Phalcon\\Mvc\\Model");
+			return;
+		}
+		
+		if (!first) {
+			PHALCON_CPY_WRT(first, record);
+		} else {
+			if (Z_OBJCE_P(record) != Z_OBJCE_P(first)) {
+				PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Every record passed to saveMany must belong to the same model");
+				return;
+			}
+		}
+		zend_hash_move_forward_ex(ah0, &hp0);
+		goto fes_8adf_15;
+	fee_8adf_15:
+	if(0){}
+	
+	PHALCON_INIT_VAR(dependency_injector);
+	PHALCON_READ_PROPERTY_QUICK(&dependency_injector, first, "_dependencyInjector", PH_NOISY_CC);
+	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A dependency injector container is required to obtain the services related to the ORM");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(c0);
+	ZVAL_STRING(c0, "modelsMetadata", 1);
+	
+	PHALCON_INIT_VAR(meta_data);
+	PHALCON_CALL_METHOD_PARAMS_1(meta_data, dependency_injector, "getshared", c0, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(connection);
+	PHALCON_CALL_METHOD(connection, first, "getconnection", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(under_transaction);
+	PHALCON_CALL_METHOD(under_transaction, connection, "isundertransaction", PH_NO_CHECK);
+	own_transaction = !zend_is_true(under_transaction);
+	if (own_transaction) {
+		PHALCON_CALL_METHOD_NORETURN(connection, "begin", PH_NO_CHECK);
+	}
+	
+	phalcon_mvc_model_save_many(return_value, first, records, dependency_injector, meta_data, connection TSRMLS_CC);
+	if (own_transaction) {
+		if (EG(exception) || !zend_is_true(return_value)) {
+			phalcon_call_method_cleanup(connection, SL("rollback"), NULL TSRMLS_CC);
+		} else {
+			PHALCON_CALL_METHOD_NORETURN(connection, "commit", PH_NO_CHECK);
+		}
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Inserts the record or updates the row that has the same primary key using a single statement, without
+ * checking first whether the record exists. The creation events and validations are the ones executed.
+ * Only the attributes set in the record are written, and a record read from the database only updates
+ * the attributes that changed. On MySQL a conflict with any unique index of the table updates that row,
+ * not only a conflict on the primary key
+ *
+ *<code>
+ * $counter = new Counters();
+ * $counter->name = "visits";
+ * $counter->total = 10;
+ * $counter->upsert();
+ *</code>
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model, upsert){
+
+	zval *dependency_injector = NULL, *meta_data = NULL, *connection = NULL;
+	zval *disable_events = NULL, *identity_field = NULL, *primary_keys = NULL;
+	zval *attributes = NULL, *null_value = NULL, *fields = NULL, *values = NULL;
+	zval *field = NULL, *value = NULL, *schema = NULL, *source = NULL, *table = NULL;
+	zval *exists = NULL, *success = NULL, *id = NULL, *snapshot = NULL;
+	zval *update_fields = NULL, *upsert_identity = NULL, *is_key = NULL;
+	zval *identity_key = NULL, *manager = NULL, *class_name = NULL;
+	zval *c0 = NULL, *c1 = NULL, *c2 = NULL;
+	zval *a0 = NULL;
+	zval *r0 = NULL, *r1 = NULL, *r2 = NULL;
+	zval *p0[] = { NULL, NULL, NULL, NULL, NULL };
+	zval *p1[] = { NULL, NULL, NULL, NULL, NULL, NULL };
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	int identity_missing = 0;
+
+	PHALCON_MM_GROW();
+	PHALCON_INIT_VAR(dependency_injector);
+	PHALCON_READ_PROPERTY_QUICK(&dependency_injector, this_ptr, "_dependencyInjector", PH_NOISY_CC);
+	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A dependency injector container is required to obtain the services related to the ORM");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(c0);
+	ZVAL_STRING(c0, "modelsMetadata", 1);
+	
+	PHALCON_INIT_VAR(meta_data);
+	PHALCON_CALL_METHOD_PARAMS_1(meta_data, dependency_injector, "getshared", c0, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(primary_keys);
+	PHALCON_CALL_METHOD_PARAMS_1(primary_keys, meta_data, "getprimarykeyattributes", this_ptr, PH_NO_CHECK);
+	if (Z_TYPE_P(primary_keys) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(primary_keys))) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A primary key must be defined in the model in order to perform an upsert");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(connection);
+	PHALCON_CALL_METHOD(connection, this_ptr, "getconnection", PH_NO_CHECK);
+	phalcon_update_property_long(this_ptr, SL("_operationMade"), 1 TSRMLS_CC);
+	
+	PHALCON_ALLOC_ZVAL_MM(a0);
+	array_init(a0);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_errorMessages", a0);
+	PHALCON_OBSERVE_VAR(disable_events);
+	phalcon_read_static_property(&disable_events, SL("phalcon\\mvc\\model"), SL("_disableEvents") TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(identity_field);
+	PHALCON_CALL_METHOD_PARAMS_1(identity_field, meta_data, "getidentityfield", this_ptr, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(exists);
+	ZVAL_BOOL(exists, 0);
+	p0[0] = dependency_injector;
+	p0[1] = meta_data;
+	p0[2] = disable_events;
+	p0[3] = exists;
+	p0[4] = identity_field;
+	
+	PHALCON_ALLOC_ZVAL_MM(r0);
+	PHALCON_CALL_METHOD_PARAMS(r0, this_ptr, "_presave", 5, p0, PH_NO_CHECK);
+	if (Z_TYPE_P(r0) == IS_BOOL && !Z_BVAL_P(r0)) {
+		PHALCON_MM_RESTORE();
+		RETURN_FALSE;
+	}
+	
+	PHALCON_INIT_VAR(null_value);
+	object_init_ex(null_value, phalcon_db_rawvalue_ce);
+	
+	PHALCON_INIT_VAR(c1);
+	ZVAL_STRING(c1, "null", 1);
+	PHALCON_CALL_METHOD_PARAMS_1_NORETURN(null_value, "__construct", c1, PH_CHECK);
+	
+	PHALCON_INIT_VAR(fields);
+	array_init(fields);
+	
+	PHALCON_INIT_VAR(values);
+	array_init(values);
+	
+	PHALCON_INIT_VAR(attributes);
+	PHALCON_CALL_METHOD_PARAMS_1(attributes, meta_data, "getattributes", this_ptr, PH_NO_CHECK);
+	if (!phalcon_valid_foreach(attributes TSRMLS_CC)) {
+		return;
+	}
+	
+	PHALCON_INIT_VAR(update_fields);
+	array_init(update_fields);
+	
+	PHALCON_INIT_VAR(snapshot);
+	PHALCON_READ_PROPERTY_QUICK(&snapshot, this_ptr, "_snapshot", PH_NOISY_CC);
+	
+	/** 
+	 * Attributes that are not set are left out so the database applies its defaults, an identity column
+	 * without value is left out so the database generates it. Like _doLowUpdate, a record with a snapshot
+	 * only updates the attributes that changed
+	 */
+	ah0 = Z_ARRVAL_P(attributes);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	fes_8adf_18:
+		if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
+			goto fee_8adf_18;
+		}
+		
+		PHALCON_INIT_VAR(field);
+		ZVAL_ZVAL(field, *hd, 1, 0);
+		if (!phalcon_isset_property_zval(this_ptr, field TSRMLS_CC)) {
+			zend_hash_move_forward_ex(ah0, &hp0);
+			goto fes_8adf_18;
+		}
+		
+		PHALCON_INIT_VAR(value);
+		phalcon_read_property_zval(&value, this_ptr, field, PH_NOISY_CC);
+		
+		PHALCON_INIT_VAR(is_key);
+		PHALCON_CALL_FUNC_PARAMS_2(is_key, "in_array", field, primary_keys);
+		if (!zend_is_true(is_key)) {
+			if (Z_TYPE_P(snapshot) != IS_ARRAY || phalcon_mvc_model_value_changed(snapshot, field, value TSRMLS_CC)) {
+				phalcon_array_append(&update_fields, field, PH_SEPARATE TSRMLS_CC);
+			}
+		}
+		
+		if (Z_TYPE_P(value) == IS_NULL || (Z_TYPE_P(value) == IS_STRING && !Z_STRLEN_P(value))) {
+			PHALCON_INIT_VAR(r1);
+			is_equal_function(r1, field, identity_field TSRMLS_CC);
+			if (zend_is_true(identity_field) && zend_is_true(r1)) {
+				identity_missing = 1;
+			} else {
+				phalcon_array_append(&fields, field, PH_SEPARATE TSRMLS_CC);
+				phalcon_array_append(&values, null_value, PH_SEPARATE TSRMLS_CC);
+			}
+		} else {
+			phalcon_array_append(&fields, field, PH_SEPARATE TSRMLS_CC);
+			phalcon_array_append(&values, value, PH_SEPARATE TSRMLS_CC);
+		}
+		zend_hash_move_forward_ex(ah0, &hp0);
+		goto fes_8adf_18;
+	fee_8adf_18:
+	if(0){}
+	
+	PHALCON_INIT_VAR(schema);
+	PHALCON_CALL_METHOD(schema, this_ptr, "getschema", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(source);
+	PHALCON_CALL_METHOD(source, this_ptr, "getsource", PH_NO_CHECK);
+	if (zend_is_true(schema)) {
+		PHALCON_INIT_VAR(table);
+		PHALCON_CONCAT_VSV(table, schema, ".", source);
+	} else {
+		PHALCON_CPY_WRT(table, source);
+	}
+	
+	/** 
+	 * A conflict on another unique index updates an existing row, the dialect makes lastInsertId() report it
+	 */
+	PHALCON_INIT_VAR(upsert_identity);
+	if (identity_missing) {
+		ZVAL_ZVAL(upsert_identity, identity_field, 1, 0);
+	} else {
+		ZVAL_NULL(upsert_identity);
+	}
+	p1[0] = table;
+	p1[1] = values;
+	p1[2] = fields;
+	p1[3] = primary_keys;
+	p1[4] = update_fields;
+	p1[5] = upsert_identity;
+	
+	PHALCON_INIT_VAR(success);
+	PHALCON_CALL_METHOD_PARAMS(success, connection, "upsert", 6, p1, PH_NO_CHECK);
+	if (zend_is_true(success) && identity_missing) {
+		PHALCON_INIT_VAR(id);
+		PHALCON_CALL_METHOD(id, connection, "lastinsertid", PH_NO_CHECK);
+		if (zend_is_true(id)) {
+			phalcon_update_property_zval_zval(this_ptr, identity_field, id TSRMLS_CC);
+			identity_missing = 0;
+		}
+	}
+	
+	PHALCON_ALLOC_ZVAL_MM(r2);
+	PHALCON_CALL_METHOD_PARAMS_3(r2, this_ptr, "_postsave", disable_events, success, exists, PH_NO_CHECK);
+	if (zend_is_true(r2)) {
+		phalcon_update_property_null(this_ptr, SL("_related") TSRMLS_CC);
+		
+		PHALCON_INIT_VAR(c2);
+		ZVAL_STRING(c2, "modelsManager", 1);
+		
+		PHALCON_INIT_VAR(manager);
+		PHALCON_CALL_METHOD_PARAMS_1(manager, dependency_injector, "getshared", c2, PH_NO_CHECK);
+		
+		PHALCON_INIT_VAR(class_name);
+		phalcon_get_class(class_name, this_ptr TSRMLS_CC);
+		
+		/** 
+		 * An existing row may have been updated, other records could have been verified against it
+		 */
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(manager, "clearverifiedreferences", class_name, PH_NO_CHECK);
+		if (!identity_missing) {
+			PHALCON_INIT_VAR(snapshot);
+			phalcon_mvc_model_build_snapshot(snapshot, this_ptr, attributes TSRMLS_CC);
+			PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_snapshot", snapshot);
+			
+			/** 
+			 * The statement discarded the records stored in the identity map, the upserted record takes its place
+			 */
+			PHALCON_INIT_VAR(identity_key);
+			PHALCON_CALL_METHOD_PARAMS_1(identity_key, this_ptr, "_getidentitykey", meta_data, PH_NO_CHECK);
+			if (Z_TYPE_P(identity_key) != IS_NULL) {
+				PHALCON_CALL_METHOD_PARAMS_3_NORETURN(manager, "addrecord", class_name, identity_key, this_ptr, PH_NO_CHECK);
+			}
+		}
+	}
+	
+	RETURN_CTOR(r2);
+}
+
+/**
+ * Updates every record matching the conditions with a single UPDATE statement. Records are not loaded,
+ * so validations and events are not executed. When $checkForeignKeys is true the new values of "belongs to"
+ * virtual foreign keys are verified once for the whole statement
+ *
+ *<code>
+ * Robots::updateAll("type = ?", array("status" => "retired"), array("mechanical"));
+ *</code>
+ *
+ * @param string $conditions
+ * @param array $values
+ * @param array $bind
+ * @param boolean $checkForeignKeys
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model, updateAll){
+
+	zval *conditions = NULL, *values = NULL, *bind = NULL, *check_foreign_keys = NULL;
+	zval *dependency_injector = NULL, *class_name = NULL, *model = NULL, *connection = NULL;
+	zval *schema = NULL, *source = NULL, *table = NULL, *fields = NULL, *update_values = NULL;
+	zval *manager = NULL, *belongs_to = NULL, *relation = NULL, *options = NULL, *foreign_key = NULL;
+	zval *relation_fields = NULL, *referenced_fields = NULL, *relation_conditions = NULL;
+	zval *relation_bind = NULL, *field = NULL, *value = NULL, *referenced_field = NULL;
+	zval *relation_class = NULL, *referenced_model = NULL, *params = NULL, *rowcount = NULL;
+	zval *user_message = NULL, *success = NULL;
+	zval *c0 = NULL, *c1 = NULL;
+	zval *a0 = NULL;
+	zval *i0 = NULL;
+	zval *r0 = NULL, *r1 = NULL, *r2 = NULL;
+	zval *p0[] = { NULL, NULL, NULL, NULL, NULL };
+	HashTable *ah0;
+	HashPosition hp0, hp1;
+	zval **hd;
+	char *hash_index;
+	uint hash_index_len;
+	ulong hash_num;
+	int hash_type;
+	int eval_int, complete;
+	zend_class_entry *ce0, *ce1;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz|zz", &conditions, &values, &bind, &check_foreign_keys) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (!bind) {
+		PHALCON_ALLOC_ZVAL_MM(bind);
+		ZVAL_NULL(bind);
+	}
+	
+	if (!check_foreign_keys) {
+		PHALCON_ALLOC_ZVAL_MM(check_foreign_keys);
+		ZVAL_BOOL(check_foreign_keys, 0);
+	}
+	
+	if (Z_TYPE_P(values) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(values))) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Values passed to updateAll must be a non empty Array indexed by field");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(dependency_injector);
+	PHALCON_CALL_STATIC(dependency_injector, "phalcon\\di", "getdefault");
+	
+	PHALCON_INIT_VAR(class_name);
+	PHALCON_CALL_FUNC(class_name, "get_called_class");
+	ce0 = phalcon_fetch_class(class_name TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(model);
+	object_init_ex(model, ce0);
+	PHALCON_CALL_METHOD_PARAMS_1_NORETURN(model, "__construct", dependency_injector, PH_CHECK);
+	
+	PHALCON_INIT_VAR(connection);
+	PHALCON_CALL_METHOD(connection, model, "getconnection", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(schema);
+	PHALCON_CALL_METHOD(schema, model, "getschema", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(source);
+	PHALCON_CALL_METHOD(source, model, "getsource", PH_NO_CHECK);
+	if (zend_is_true(schema)) {
+		PHALCON_INIT_VAR(table);
+		PHALCON_CONCAT_VSV(table, schema, ".", source);
+	} else {
+		PHALCON_CPY_WRT(table, source);
+	}
+	
+	PHALCON_INIT_VAR(fields);
+	array_init(fields);
+	
+	PHALCON_INIT_VAR(update_values);
+	array_init(update_values);
+	
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(values), &hp1);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(values), (void**) &hd, &hp1) == SUCCESS) {
+		PHALCON_INIT_VAR(field);
+		PHALCON_GET_FOREACH_KEY(field, Z_ARRVAL_P(values), hp1);
+		if (Z_TYPE_P(field) != IS_STRING) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Values passed to updateAll must be a non empty Array indexed by field");
+			return;
+		}
+		phalcon_array_append(&fields, field, PH_SEPARATE TSRMLS_CC);
+		phalcon_array_append(&update_values, *hd, PH_SEPARATE TSRMLS_CC);
+		zend_hash_move_forward_ex(Z_ARRVAL_P(values), &hp1);
+	}
+	
+	PHALCON_INIT_VAR(c0);
+	ZVAL_STRING(c0, "modelsManager", 1);
+	
+	PHALCON_INIT_VAR(manager);
+	PHALCON_CALL_METHOD_PARAMS_1(manager, dependency_injector, "getshared", c0, PH_NO_CHECK);
+	
+	/** 
+	 * Every "belongs to" relation whose fields are all updated is verified with one query
+	 */
+	if (zend_is_true(check_foreign_keys)) {
+		PHALCON_INIT_VAR(belongs_to);
+		PHALCON_CALL_METHOD_PARAMS_1(belongs_to, manager, "getbelongsto", model, PH_NO_CHECK);
+		if (!phalcon_valid_foreach(belongs_to TSRMLS_CC)) {
+			return;
+		}
+		
+		ah0 = Z_ARRVAL_P(belongs_to);
+		zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+		fes_8adf_19:
+			if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
+				goto fee_8adf_19;
+			}
+			
+			PHALCON_INIT_VAR(relation);
+			ZVAL_ZVAL(relation, *hd, 1, 0);
+			zend_hash_move_forward_ex(ah0, &hp0);
+			
+			PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, relation, "op");
+			if (!eval_int) {
+				goto fes_8adf_19;
+			}
+			
+			PHALCON_INIT_VAR(options);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&options, relation, "op", PH_NOISY_CC);
+			PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, options, "foreignKey");
+			if (!eval_int) {
+				goto fes_8adf_19;
+			}
+			
+			PHALCON_INIT_VAR(foreign_key);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&foreign_key, options, "foreignKey", PH_NOISY_CC);
+			if (!zend_is_true(foreign_key)) {
+				goto fes_8adf_19;
+			}
+			
+			PHALCON_INIT_VAR(relation_fields);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&relation_fields, relation, "fi", PH_NOISY_CC);
+			
+			PHALCON_INIT_VAR(referenced_fields);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&referenced_fields, relation, "rf", PH_NOISY_CC);
+			if (Z_TYPE_P(relation_fields) != IS_ARRAY) { 
+				PHALCON_INIT_VAR(r0);
+				array_init(r0);
+				phalcon_array_append(&r0, relation_fields, PH_SEPARATE TSRMLS_CC);
+				PHALCON_CPY_WRT(relation_fields, r0);
+				
+				PHALCON_INIT_VAR(r1);
+				array_init(r1);
+				phalcon_array_append(&r1, referenced_fields, PH_SEPARATE TSRMLS_CC);
+				PHALCON_CPY_WRT(referenced_fields, r1);
+			}
+			
+			PHALCON_INIT_VAR(relation_conditions);
+			array_init(relation_conditions);
+			
+			PHALCON_INIT_VAR(relation_bind);
+			array_init(relation_bind);
+			
+			complete = 1;
+			zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(relation_fields), &hp1);
+			while (zend_hash_get_current_data_ex(Z_ARRVAL_P(relation_fields), (void**) &hd, &hp1) == SUCCESS) {
+				PHALCON_INIT_VAR(field);
+				ZVAL_ZVAL(field, *hd, 1, 0);
+				
+				eval_int = phalcon_array_isset(values, field);
+				if (!eval_int) {
+					complete = 0;
+					break;
+				}
+				
+				PHALCON_INIT_VAR(value);
+				phalcon_array_fetch(&value, values, field, PH_NOISY_CC);
+				if (Z_TYPE_P(value) == IS_NULL || Z_TYPE_P(value) == IS_OBJECT || (Z_TYPE_P(value) == IS_STRING && !Z_STRLEN_P(value))) {
+					complete = 0;
+					break;
+				}
+				
+				PHALCON_INIT_VAR(r2);
+				PHALCON_GET_FOREACH_KEY(r2, Z_ARRVAL_P(relation_fields), hp1);
+				
+				PHALCON_INIT_VAR(referenced_field);
+				phalcon_array_fetch(&referenced_field, referenced_fields, r2, PH_NOISY_CC);
+				
+				PHALCON_INIT_VAR(r2);
+				PHALCON_CONCAT_VS(r2, referenced_field, " = ?");
+				phalcon_array_append(&relation_conditions, r2, PH_SEPARATE TSRMLS_CC);
+				phalcon_array_append(&relation_bind, value, PH_SEPARATE TSRMLS_CC);
+				zend_hash_move_forward_ex(Z_ARRVAL_P(relation_fields), &hp1);
+			}
+			
+			if (!complete) {
+				goto fes_8adf_19;
+			}
+			
+			if (Z_TYPE_P(foreign_key) == IS_ARRAY) { 
+				PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, foreign_key, "conditions");
+				if (eval_int) {
+					PHALCON_INIT_VAR(r2);
+					PHALCON_ARRAY_FETCH_QUICK_STRING(&r2, foreign_key, "conditions", PH_NOISY_CC);
+					phalcon_array_append(&relation_conditions, r2, PH_SEPARATE TSRMLS_CC);
+				}
+			}
+			
+			PHALCON_INIT_VAR(relation_class);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&relation_class, relation, "rt", PH_NOISY_CC);
+			ce1 = phalcon_fetch_class(relation_class TSRMLS_CC);
+			
+			PHALCON_INIT_VAR(referenced_model);
+			object_init_ex(referenced_model, ce1);
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(referenced_model, "__construct", dependency_injector, PH_CHECK);
+			
+			PHALCON_INIT_VAR(r2);
+			PHALCON_CALL_METHOD(r2, model, "getconnectionservice", PH_NO_CHECK);
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(referenced_model, "setconnectionservice", r2, PH_NO_CHECK);
+			
+			PHALCON_INIT_VAR(c1);
+			ZVAL_STRING(c1, " AND ", 1);
+			
+			PHALCON_INIT_VAR(r2);
+			phalcon_fast_join(r2, c1, relation_conditions TSRMLS_CC);
+			
+			PHALCON_INIT_VAR(params);
+			array_init(params);
+			phalcon_array_append(&params, r2, PH_SEPARATE TSRMLS_CC);
+			phalcon_array_update_string(&params, SL("bind"), &relation_bind, PH_COPY | PH_SEPARATE TSRMLS_CC);
+			
+			PHALCON_INIT_VAR(a0);
+			array_init(a0);
+			phalcon_array_update_string(&params, SL("bindTypes"), &a0, PH_COPY | PH_SEPARATE TSRMLS_CC);
+			
+			PHALCON_INIT_VAR(rowcount);
+			PHALCON_CALL_METHOD_PARAMS_1(rowcount, referenced_model, "count", params, PH_NO_CHECK);
+			if (!zend_is_true(rowcount)) {
+				eval_int = 0;
+				if (Z_TYPE_P(foreign_key) == IS_ARRAY) { 
+					PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, foreign_key, "message");
+				}
+				if (eval_int) {
+					PHALCON_INIT_VAR(user_message);
+					PHALCON_ARRAY_FETCH_QUICK_STRING(&user_message, foreign_key, "message", PH_NOISY_CC);
+				} else {
+					PHALCON_INIT_VAR(c1);
+					ZVAL_STRING(c1, ", ", 1);
+					
+					PHALCON_INIT_VAR(r2);
+					phalcon_fast_join(r2, c1, relation_fields TSRMLS_CC);
+					
+					PHALCON_INIT_VAR(user_message);
+					PHALCON_CONCAT_SVS(user_message, "Value of fields \"", r2, "\" does not exist on referenced table");
+				}
+				
+				PHALCON_INIT_VAR(i0);
+				object_init_ex(i0, phalcon_mvc_model_exception_ce);
+				PHALCON_CALL_METHOD_PARAMS_1_NORETURN(i0, "__construct", user_message, PH_CHECK);
+				phalcon_throw_exception(i0 TSRMLS_CC);
+				return;
+			}
+			goto fes_8adf_19;
+		fee_8adf_19:
+		if(0){}
+		
+	}
+	
+	if (Z_TYPE_P(conditions) == IS_STRING && !Z_STRLEN_P(conditions)) {
+		PHALCON_INIT_VAR(conditions);
+		ZVAL_NULL(conditions);
 	}
 	
+	p0[0] = table;
+	p0[1] = fields;
+	p0[2] = update_values;
+	p0[3] = conditions;
+	p0[4] = bind;
+	
+	PHALCON_INIT_VAR(success);
+	PHALCON_CALL_METHOD_PARAMS(success, connection, "update", 5, p0, PH_NO_CHECK);
+	if (zend_is_true(success)) {
+		PHALCON_CALL_METHOD_NORETURN(manager, "clearrecords", PH_NO_CHECK);
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(manager, "clearverifiedreferences", class_name, PH_NO_CHECK);
+	}
 	
 	RETURN_CCTOR(success);
 }
 
 /**
- * Sends a pre-build UPDATE SQL statement to the relational database system
+ * Deletes every record matching the conditions with a single DELETE statement. Records are not loaded,
+ * so validations and events are not executed. When $checkForeignKeys is true the "has many" and "has one"
+ * virtual foreign keys are verified with one query per relation covering every deleted row
  *
- * @param Phalcon\Mvc\Model\Metadata $metaData
- * @param Phalcon\Db $connection
- * @param string $table
+ *<code>
+ * Robots::deleteAll("created_at < ?", array("2012-01-01"), true);
+ *</code>
+ *
+ * @param string $conditions
+ * @param array $bind
+ * @param boolean $checkForeignKeys
  * @return boolean
  */
-PHP_METHOD(Phalcon_Mvc_Model, _doLowUpdate){
-
-	zval *meta_data = NULL, *connection = NULL, *table = NULL, *null_value = NULL;
-	zval *fields = NULL, *values = NULL, *non_primary = NULL, *field = NULL, *value = NULL;
-	zval *c0 = NULL;
-	zval *t0 = NULL, *t1 = NULL, *t2 = NULL;
+PHP_METHOD(Phalcon_Mvc_Model, deleteAll){
+
+	zval *conditions = NULL, *bind = NULL, *check_foreign_keys = NULL;
+	zval *dependency_injector = NULL, *class_name = NULL, *model = NULL, *connection = NULL;
+	zval *schema = NULL, *source = NULL, *table = NULL, *manager = NULL, *relations = NULL;
+	zval *relation = NULL, *options = NULL, *foreign_key = NULL, *relation_fields = NULL;
+	zval *referenced_fields = NULL, *relation_conditions = NULL, *subquery = NULL;
+	zval *referenced_name = NULL, *referenced_model = NULL, *params = NULL, *rowcount = NULL;
+	zval *user_message = NULL, *success = NULL;
+	zval *c0 = NULL, *c1 = NULL;
+	zval *a0 = NULL;
+	zval *i0 = NULL;
 	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL;
 	HashTable *ah0;
 	HashPosition hp0;
 	zval **hd;
 	int eval_int;
+	zend_class_entry *ce0, *ce1;
 
 	PHALCON_MM_GROW();
 	
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zzz", &meta_data, &connection, &table) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|zzz", &conditions, &bind, &check_foreign_keys) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
 
-	PHALCON_INIT_VAR(null_value);
-	object_init_ex(null_value, phalcon_db_rawvalue_ce);
-	PHALCON_INIT_VAR(c0);
-	ZVAL_STRING(c0, "null", 1);
-	PHALCON_CALL_METHOD_PARAMS_1_NORETURN(null_value, "__construct", c0, PH_CHECK);
-	
-	PHALCON_INIT_VAR(fields);
-	array_init(fields);
-	
-	PHALCON_INIT_VAR(values);
-	array_init(values);
-	
-	PHALCON_INIT_VAR(non_primary);
-	PHALCON_CALL_METHOD_PARAMS_1(non_primary, meta_data, "getnonprimarykeyattributes", this_ptr, PH_NO_CHECK);
-	if (!phalcon_valid_foreach(non_primary TSRMLS_CC)) {
-		return;
+	if (!conditions) {
+		PHALCON_ALLOC_ZVAL_MM(conditions);
+		ZVAL_NULL(conditions);
 	}
 	
-	ah0 = Z_ARRVAL_P(non_primary);
-	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
-	fes_8adf_9:
-		if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
-			goto fee_8adf_9;
-		}
-		
-		PHALCON_INIT_VAR(field);
-		ZVAL_ZVAL(field, *hd, 1, 0);
-		phalcon_array_append(&fields, field, PH_SEPARATE TSRMLS_CC);
-		eval_int = phalcon_isset_property_zval(this_ptr, field TSRMLS_CC);
-		if (eval_int) {
-			PHALCON_INIT_VAR(value);
-			phalcon_read_property_zval(&value, this_ptr, field, PH_NOISY_CC);
-			
-			PHALCON_INIT_VAR(t0);
-			ZVAL_STRING(t0, "", 1);
-			
-			PHALCON_INIT_VAR(r0);
-			is_identical_function(r0, t0, value TSRMLS_CC);
-			
-			PHALCON_INIT_VAR(t1);
-			ZVAL_NULL(t1);
-			
-			PHALCON_INIT_VAR(r1);
-			is_identical_function(r1, t1, value TSRMLS_CC);
-			
-			PHALCON_INIT_VAR(r2);
-			ZVAL_BOOL(r2, zend_is_true(r0) || zend_is_true(r1));
-			if (zend_is_true(r2)) {
-				phalcon_array_append(&values, null_value, PH_SEPARATE TSRMLS_CC);
-			} else {
-				phalcon_array_append(&values, value, PH_SEPARATE TSRMLS_CC);
-			}
-		} else {
-			phalcon_array_append(&values, null_value, PH_SEPARATE TSRMLS_CC);
+	if (!bind) {
+		PHALCON_ALLOC_ZVAL_MM(bind);
+		array_init(bind);
+	} else {
+		if (Z_TYPE_P(bind) != IS_ARRAY) { 
+			PHALCON_INIT_VAR(bind);
+			array_init(bind);
 		}
-		zend_hash_move_forward_ex(ah0, &hp0);
-		goto fes_8adf_9;
-	fee_8adf_9:
-	if(0){}
-	
-	PHALCON_ALLOC_ZVAL_MM(t2);
-	phalcon_read_property(&t2, this_ptr, SL("_uniqueKey"), PH_NOISY_CC);
-	
-	PHALCON_ALLOC_ZVAL_MM(r3);
-	PHALCON_CALL_METHOD_PARAMS_4(r3, connection, "update", table, fields, values, t2, PH_NO_CHECK);
-	RETURN_CTOR(r3);
-}
-
-/**
- * Inserts or updates a model instance. Returning true on success or false otherwise.
- *
- * @return boolean
- */
-PHP_METHOD(Phalcon_Mvc_Model, save){
-
-	zval *dependency_injector = NULL, *meta_data = NULL, *connection = NULL;
-	zval *exists = NULL, *disable_events = NULL, *identity_field = NULL;
-	zval *schema = NULL, *source = NULL, *table = NULL, *success = NULL;
-	zval *c0 = NULL;
-	zval *a0 = NULL;
-	zval *r0 = NULL, *r1 = NULL;
-	zval *p0[] = { NULL, NULL, NULL, NULL, NULL };
-
-	PHALCON_MM_GROW();
-	PHALCON_INIT_VAR(dependency_injector);
-	phalcon_read_property(&dependency_injector, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
-	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
-		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A dependency injector container is required to obtain the services related to the ORM");
-		return;
 	}
 	
-	PHALCON_INIT_VAR(c0);
-	ZVAL_STRING(c0, "modelsMetadata", 1);
-	
-	PHALCON_INIT_VAR(meta_data);
-	PHALCON_CALL_METHOD_PARAMS_1(meta_data, dependency_injector, "getshared", c0, PH_NO_CHECK);
-	
-	PHALCON_INIT_VAR(connection);
-	PHALCON_CALL_METHOD(connection, this_ptr, "getconnection", PH_NO_CHECK);
+	if (!check_foreign_keys) {
+		PHALCON_ALLOC_ZVAL_MM(check_foreign_keys);
+		ZVAL_BOOL(check_foreign_keys, 0);
+	}
 	
-	PHALCON_INIT_VAR(exists);
-	PHALCON_CALL_METHOD_PARAMS_2(exists, this_ptr, "_exists", meta_data, connection, PH_NO_CHECK);
-	if (!zend_is_true(exists)) {
-		phalcon_update_property_long(this_ptr, SL("_operationMade"), 1 TSRMLS_CC);
-	} else {
-		phalcon_update_property_long(this_ptr, SL("_operationMade"), 2 TSRMLS_CC);
+	if (Z_TYPE_P(conditions) == IS_STRING && !Z_STRLEN_P(conditions)) {
+		PHALCON_INIT_VAR(conditions);
+		ZVAL_NULL(conditions);
 	}
 	
-	PHALCON_ALLOC_ZVAL_MM(a0);
-	array_init(a0);
-	phalcon_update_property_zval(this_ptr, SL("_errorMessages"), a0 TSRMLS_CC);
-	PHALCON_OBSERVE_VAR(disable_events);
-	phalcon_read_static_property(&disable_events, SL("phalcon\\mvc\\model"), SL("_disableEvents") TSRMLS_CC);
+	PHALCON_INIT_VAR(dependency_injector);
+	PHALCON_CALL_STATIC(dependency_injector, "phalcon\\di", "getdefault");
 	
-	PHALCON_INIT_VAR(identity_field);
-	PHALCON_CALL_METHOD_PARAMS_1(identity_field, meta_data, "getidentityfield", this_ptr, PH_NO_CHECK);
-	p0[0] = dependency_injector;
-	p0[1] = meta_data;
-	p0[2] = disable_events;
-	p0[3] = exists;
-	p0[4] = identity_field;
+	PHALCON_INIT_VAR(class_name);
+	PHALCON_CALL_FUNC(class_name, "get_called_class");
+	ce0 = phalcon_fetch_class(class_name TSRMLS_CC);
 	
-	PHALCON_ALLOC_ZVAL_MM(r0);
-	PHALCON_CALL_METHOD_PARAMS(r0, this_ptr, "_presave", 5, p0, PH_NO_CHECK);
-	if (Z_TYPE_P(r0) == IS_BOOL && !Z_BVAL_P(r0)) {
-		PHALCON_MM_RESTORE();
-		RETURN_FALSE;
-	}
+	PHALCON_INIT_VAR(model);
+	object_init_ex(model, ce0);
+	PHALCON_CALL_METHOD_PARAMS_1_NORETURN(model, "__construct", dependency_injector, PH_CHECK);
+	
+	PHALCON_INIT_VAR(connection);
+	PHALCON_CALL_METHOD(connection, model, "getconnection", PH_NO_CHECK);
 	
 	PHALCON_INIT_VAR(schema);
-	PHALCON_CALL_METHOD(schema, this_ptr, "getschema", PH_NO_CHECK);
+	PHALCON_CALL_METHOD(schema, model, "getschema", PH_NO_CHECK);
 	
 	PHALCON_INIT_VAR(source);
-	PHALCON_CALL_METHOD(source, this_ptr, "getsource", PH_NO_CHECK);
+	PHALCON_CALL_METHOD(source, model, "getsource", PH_NO_CHECK);
 	if (zend_is_true(schema)) {
 		PHALCON_INIT_VAR(table);
 		PHALCON_CONCAT_VSV(table, schema, ".", source);
@@ -2684,17 +5082,157 @@ PHP_METHOD(Phalcon_Mvc_Model, save){
 		PHALCON_CPY_WRT(table, source);
 	}
 	
-	if (zend_is_true(exists)) {
-		PHALCON_INIT_VAR(success);
-		PHALCON_CALL_METHOD_PARAMS_3(success, this_ptr, "_dolowupdate", meta_data, connection, table, PH_NO_CHECK);
-	} else {
-		PHALCON_INIT_VAR(success);
-		PHALCON_CALL_METHOD_PARAMS_4(success, this_ptr, "_dolowinsert", meta_data, connection, table, identity_field, PH_NO_CHECK);
+	PHALCON_INIT_VAR(c0);
+	ZVAL_STRING(c0, "modelsManager", 1);
+	
+	PHALCON_INIT_VAR(manager);
+	PHALCON_CALL_METHOD_PARAMS_1(manager, dependency_injector, "getshared", c0, PH_NO_CHECK);
+	
+	/** 
+	 * Referencing rows are searched with a subquery over the rows that are going to be deleted
+	 */
+	if (zend_is_true(check_foreign_keys)) {
+		PHALCON_INIT_VAR(relations);
+		PHALCON_CALL_METHOD_PARAMS_1(relations, manager, "gethasoneandhasmany", model, PH_NO_CHECK);
+		if (!phalcon_valid_foreach(relations TSRMLS_CC)) {
+			return;
+		}
+		
+		PHALCON_INIT_VAR(c1);
+		ZVAL_STRING(c1, ", ", 1);
+		
+		ah0 = Z_ARRVAL_P(relations);
+		zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+		fes_8adf_20:
+			if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
+				goto fee_8adf_20;
+			}
+			
+			PHALCON_INIT_VAR(relation);
+			ZVAL_ZVAL(relation, *hd, 1, 0);
+			zend_hash_move_forward_ex(ah0, &hp0);
+			
+			PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, relation, "op");
+			if (!eval_int) {
+				goto fes_8adf_20;
+			}
+			
+			PHALCON_INIT_VAR(options);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&options, relation, "op", PH_NOISY_CC);
+			PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, options, "foreignKey");
+			if (!eval_int) {
+				goto fes_8adf_20;
+			}
+			
+			PHALCON_INIT_VAR(foreign_key);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&foreign_key, options, "foreignKey", PH_NOISY_CC);
+			if (!zend_is_true(foreign_key)) {
+				goto fes_8adf_20;
+			}
+			
+			PHALCON_INIT_VAR(relation_fields);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&relation_fields, relation, "fi", PH_NOISY_CC);
+			
+			PHALCON_INIT_VAR(referenced_fields);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&referenced_fields, relation, "rf", PH_NOISY_CC);
+			if (Z_TYPE_P(relation_fields) == IS_ARRAY) { 
+				PHALCON_INIT_VAR(r0);
+				phalcon_fast_join(r0, c1, relation_fields TSRMLS_CC);
+				
+				PHALCON_INIT_VAR(r1);
+				phalcon_fast_join(r1, c1, referenced_fields TSRMLS_CC);
+				
+				PHALCON_INIT_VAR(r2);
+				PHALCON_CONCAT_SVS(r2, "(", r1, ")");
+			} else {
+				PHALCON_CPY_WRT(r0, relation_fields);
+				PHALCON_CPY_WRT(r2, referenced_fields);
+			}
+			
+			PHALCON_INIT_VAR(subquery);
+			if (Z_TYPE_P(conditions) != IS_NULL) {
+				PHALCON_CONCAT_SVSVSV(subquery, "SELECT ", r0, " FROM ", table, " WHERE ", conditions);
+			} else {
+				PHALCON_CONCAT_SVSV(subquery, "SELECT ", r0, " FROM ", table);
+			}
+			
+			PHALCON_INIT_VAR(relation_conditions);
+			array_init(relation_conditions);
+			
+			PHALCON_INIT_VAR(r3);
+			PHALCON_CONCAT_VSVS(r3, r2, " IN (", subquery, ")");
+			phalcon_array_append(&relation_conditions, r3, PH_SEPARATE TSRMLS_CC);
+			if (Z_TYPE_P(foreign_key) == IS_ARRAY) { 
+				PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, foreign_key, "conditions");
+				if (eval_int) {
+					PHALCON_INIT_VAR(r3);
+					PHALCON_ARRAY_FETCH_QUICK_STRING(&r3, foreign_key, "conditions", PH_NOISY_CC);
+					phalcon_array_append(&relation_conditions, r3, PH_SEPARATE TSRMLS_CC);
+				}
+			}
+			
+			PHALCON_INIT_VAR(referenced_name);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&referenced_name, relation, "rt", PH_NOISY_CC);
+			ce1 = phalcon_fetch_class(referenced_name TSRMLS_CC);
+			
+			PHALCON_INIT_VAR(referenced_model);
+			object_init_ex(referenced_model, ce1);
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(referenced_model, "__construct", dependency_injector, PH_CHECK);
+			
+			PHALCON_INIT_VAR(r3);
+			PHALCON_CALL_METHOD(r3, model, "getconnectionservice", PH_NO_CHECK);
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(referenced_model, "setconnectionservice", r3, PH_NO_CHECK);
+			
+			PHALCON_INIT_VAR(r3);
+			ZVAL_STRING(r3, " AND ", 1);
+			
+			PHALCON_INIT_VAR(r1);
+			phalcon_fast_join(r1, r3, relation_conditions TSRMLS_CC);
+			
+			PHALCON_INIT_VAR(params);
+			array_init(params);
+			phalcon_array_append(&params, r1, PH_SEPARATE TSRMLS_CC);
+			phalcon_array_update_string(&params, SL("bind"), &bind, PH_COPY | PH_SEPARATE TSRMLS_CC);
+			
+			PHALCON_INIT_VAR(a0);
+			array_init(a0);
+			phalcon_array_update_string(&params, SL("bindTypes"), &a0, PH_COPY | PH_SEPARATE TSRMLS_CC);
+			
+			PHALCON_INIT_VAR(rowcount);
+			PHALCON_CALL_METHOD_PARAMS_1(rowcount, referenced_model, "count", params, PH_NO_CHECK);
+			if (zend_is_true(rowcount)) {
+				eval_int = 0;
+				if (Z_TYPE_P(foreign_key) == IS_ARRAY) { 
+					PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, foreign_key, "message");
+				}
+				if (eval_int) {
+					PHALCON_INIT_VAR(user_message);
+					PHALCON_ARRAY_FETCH_QUICK_STRING(&user_message, foreign_key, "message", PH_NOISY_CC);
+				} else {
+					PHALCON_INIT_VAR(user_message);
+					PHALCON_CONCAT_SV(user_message, "Record is referenced by model ", referenced_name);
+				}
+				
+				PHALCON_INIT_VAR(i0);
+				object_init_ex(i0, phalcon_mvc_model_exception_ce);
+				PHALCON_CALL_METHOD_PARAMS_1_NORETURN(i0, "__construct", user_message, PH_CHECK);
+				phalcon_throw_exception(i0 TSRMLS_CC);
+				return;
+			}
+			goto fes_8adf_20;
+		fee_8adf_20:
+		if(0){}
+		
 	}
 	
-	PHALCON_ALLOC_ZVAL_MM(r1);
-	PHALCON_CALL_METHOD_PARAMS_3(r1, this_ptr, "_postsave", disable_events, success, exists, PH_NO_CHECK);
-	RETURN_CTOR(r1);
+	PHALCON_INIT_VAR(success);
+	PHALCON_CALL_METHOD_PARAMS_3(success, connection, "delete", table, conditions, bind, PH_NO_CHECK);
+	if (zend_is_true(success)) {
+		PHALCON_CALL_METHOD_NORETURN(manager, "clearrecords", PH_NO_CHECK);
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(manager, "clearverifiedreferences", class_name, PH_NO_CHECK);
+	}
+	
+	RETURN_CCTOR(success);
 }
 
 /**
@@ -2707,8 +5245,8 @@ PHP_METHOD(Phalcon_Mvc_Model, delete){
 	zval *dependency_injector = NULL, *schema = NULL, *source = NULL;
 	zval *meta_data = NULL, *connection = NULL, *table = NULL, *disable_events = NULL;
 	zval *values = NULL, *conditions = NULL, *primary_keys = NULL, *primary_key = NULL;
-	zval *success = NULL;
-	zval *c0 = NULL, *c1 = NULL, *c2 = NULL, *c3 = NULL;
+	zval *success = NULL, *identity_key = NULL, *manager = NULL, *class_name = NULL;
+	zval *c0 = NULL, *c1 = NULL, *c2 = NULL, *c3 = NULL, *c4 = NULL;
 	zval *a0 = NULL;
 	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL;
 	zval *t0 = NULL;
@@ -2718,7 +5256,7 @@ PHP_METHOD(Phalcon_Mvc_Model, delete){
 
 	PHALCON_MM_GROW();
 	PHALCON_INIT_VAR(dependency_injector);
-	phalcon_read_property(&dependency_injector, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&dependency_injector, this_ptr, "_dependencyInjector", PH_NOISY_CC);
 	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
 		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A dependency injector container is required to obtain the services related to the ORM");
 		return;
@@ -2749,7 +5287,7 @@ PHP_METHOD(Phalcon_Mvc_Model, delete){
 	
 	PHALCON_ALLOC_ZVAL_MM(a0);
 	array_init(a0);
-	phalcon_update_property_zval(this_ptr, SL("_errorMessages"), a0 TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_errorMessages", a0);
 	PHALCON_OBSERVE_VAR(disable_events);
 	phalcon_read_static_property(&disable_events, SL("phalcon\\mvc\\model"), SL("_disableEvents") TSRMLS_CC);
 	
@@ -2813,6 +5351,26 @@ PHP_METHOD(Phalcon_Mvc_Model, delete){
 	PHALCON_INIT_VAR(success);
 	PHALCON_CALL_METHOD_PARAMS_3(success, connection, "delete", table, conditions, values, PH_NO_CHECK);
 	if (zend_is_true(success)) {
+		phalcon_update_property_null(this_ptr, SL("_snapshot") TSRMLS_CC);
+		phalcon_update_property_null(this_ptr, SL("_related") TSRMLS_CC);
+		phalcon_update_property_bool(this_ptr, SL("_forceExists"), 0 TSRMLS_CC);
+		
+		PHALCON_INIT_VAR(c4);
+		ZVAL_STRING(c4, "modelsManager", 1);
+		
+		PHALCON_INIT_VAR(manager);
+		PHALCON_CALL_METHOD_PARAMS_1(manager, dependency_injector, "getshared", c4, PH_NO_CHECK);
+		
+		PHALCON_INIT_VAR(class_name);
+		phalcon_get_class(class_name, this_ptr TSRMLS_CC);
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(manager, "clearverifiedreferences", class_name, PH_NO_CHECK);
+		
+		PHALCON_INIT_VAR(identity_key);
+		PHALCON_CALL_METHOD_PARAMS_1(identity_key, this_ptr, "_getidentitykey", meta_data, PH_NO_CHECK);
+		if (Z_TYPE_P(identity_key) != IS_NULL) {
+			PHALCON_CALL_METHOD_PARAMS_2_NORETURN(manager, "removerecord", class_name, identity_key, PH_NO_CHECK);
+		}
+		
 		if (!zend_is_true(disable_events)) {
 			PHALCON_INIT_VAR(c3);
 			ZVAL_STRING(c3, "afterDelete", 1);
@@ -2899,7 +5457,7 @@ PHP_METHOD(Phalcon_Mvc_Model, hasOne){
 	}
 
 	PHALCON_INIT_VAR(dependency_injector);
-	phalcon_read_property(&dependency_injector, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&dependency_injector, this_ptr, "_dependencyInjector", PH_NOISY_CC);
 	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
 		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A dependency injector container is required to obtain the services related to the ORM");
 		return;
@@ -2953,7 +5511,7 @@ PHP_METHOD(Phalcon_Mvc_Model, belongsTo){
 	}
 	
 	PHALCON_INIT_VAR(dependency_injector);
-	phalcon_read_property(&dependency_injector, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&dependency_injector, this_ptr, "_dependencyInjector", PH_NOISY_CC);
 	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
 		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A dependency injector container is required to obtain the services related to the ORM");
 		return;
@@ -3007,7 +5565,7 @@ PHP_METHOD(Phalcon_Mvc_Model, hasMany){
 	}
 	
 	PHALCON_INIT_VAR(dependency_injector);
-	phalcon_read_property(&dependency_injector, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&dependency_injector, this_ptr, "_dependencyInjector", PH_NOISY_CC);
 	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
 		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A dependency injector container is required to obtain the services related to the ORM");
 		return;
@@ -3046,11 +5604,13 @@ PHP_METHOD(Phalcon_Mvc_Model, __call){
 	zval *method = NULL, *arguments = NULL, *dependency_injector = NULL;
 	zval *manager = NULL, *manager_method = NULL, *model_name = NULL;
 	zval *requested_relation = NULL, *query_method = NULL, *model_args = NULL;
+	zval *related = NULL, *related_records = NULL, *related_key = NULL;
 	zval *c0 = NULL, *c1 = NULL, *c2 = NULL, *c3 = NULL, *c4 = NULL, *c5 = NULL, *c6 = NULL;
 	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL, *r4 = NULL, *r5 = NULL, *r6 = NULL;
 	zval *r7 = NULL, *r8 = NULL, *r9 = NULL, *r10 = NULL;
 	zval *a0 = NULL;
 	zval *i0 = NULL;
+	int eval_int;
 
 	PHALCON_MM_GROW();
 	
@@ -3065,7 +5625,7 @@ PHP_METHOD(Phalcon_Mvc_Model, __call){
 	}
 	
 	PHALCON_INIT_VAR(dependency_injector);
-	phalcon_read_property(&dependency_injector, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&dependency_injector, this_ptr, "_dependencyInjector", PH_NOISY_CC);
 	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
 		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A dependency injector container is required to obtain the services related to the ORM");
 		return;
@@ -3101,6 +5661,24 @@ PHP_METHOD(Phalcon_Mvc_Model, __call){
 		PHALCON_INIT_VAR(requested_relation);
 		PHALCON_CALL_FUNC_PARAMS_2(requested_relation, "substr", method, c3);
 		
+		/** 
+		 * Eager loaded records are returned without querying again
+		 */
+		if (Z_TYPE_P(arguments) == IS_ARRAY && !zend_hash_num_elements(Z_ARRVAL_P(arguments))) {
+			PHALCON_INIT_VAR(related);
+			PHALCON_READ_PROPERTY_QUICK(&related, this_ptr, "_related", PH_NOISY_CC);
+			
+			PHALCON_INIT_VAR(related_key);
+			PHALCON_CALL_FUNC_PARAMS_1(related_key, "strtolower", requested_relation);
+			eval_int = phalcon_array_isset(related, related_key);
+			if (eval_int) {
+				PHALCON_INIT_VAR(related_records);
+				phalcon_array_fetch(&related_records, related, related_key, PH_NOISY_CC);
+				
+				RETURN_CCTOR(related_records);
+			}
+		}
+		
 		PHALCON_ALLOC_ZVAL_MM(r1);
 		PHALCON_CALL_METHOD_PARAMS_2(r1, manager, "existsbelongsto", model_name, requested_relation, PH_NO_CHECK);
 		if (zend_is_true(r1)) {
@@ -3216,7 +5794,7 @@ PHP_METHOD(Phalcon_Mvc_Model, serialize){
 
 	PHALCON_MM_GROW();
 	PHALCON_INIT_VAR(dependency_injector);
-	phalcon_read_property(&dependency_injector, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&dependency_injector, this_ptr, "_dependencyInjector", PH_NOISY_CC);
 	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
 		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A dependency injector container is required to obtain the services related to the ORM");
 		return;
@@ -3270,6 +5848,7 @@ PHP_METHOD(Phalcon_Mvc_Model, serialize){
 PHP_METHOD(Phalcon_Mvc_Model, unserialize){
 
 	zval *data = NULL, *attributes = NULL, *value = NULL, *key = NULL;
+	zval *dependency_injector = NULL, *manager = NULL, *c0 = NULL;
 	HashTable *ah0;
 	HashPosition hp0;
 	zval **hd;
@@ -3292,6 +5871,23 @@ PHP_METHOD(Phalcon_Mvc_Model, unserialize){
 			return;
 		}
 		
+		/** 
+		 * Records unserialized from the cache, like the ones eager loaded with a resultset, are bound
+		 * to the default container as the constructor would do
+		 */
+		PHALCON_INIT_VAR(dependency_injector);
+		PHALCON_CALL_STATIC(dependency_injector, "phalcon\\di", "getdefault");
+		if (Z_TYPE_P(dependency_injector) == IS_OBJECT) {
+			PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_dependencyInjector", dependency_injector);
+			
+			PHALCON_INIT_VAR(c0);
+			ZVAL_STRING(c0, "modelsManager", 1);
+			
+			PHALCON_INIT_VAR(manager);
+			PHALCON_CALL_METHOD_PARAMS_1(manager, dependency_injector, "getshared", c0, PH_NO_CHECK);
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(manager, "initialize", this_ptr, PH_NO_CHECK);
+		}
+		
 		ah0 = Z_ARRVAL_P(attributes);
 		zend_hash_internal_pointer_reset_ex(ah0, &hp0);
 		fes_8adf_12:
@@ -37,6 +37,7 @@
 #include "kernel/array.h"
 #include "kernel/exception.h"
 #include "kernel/concat.h"
+#include "kernel/operators.h"
 
 /**
  * Phalcon\Mvc\Model\Manager
@@ -613,12 +614,15 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, _getRelationRecords){
 	zval *relation = NULL, *method = NULL, *record = NULL, *conditions = NULL, *value = NULL;
 	zval *i = NULL, *referenced_field = NULL, *number_args = NULL, *key = NULL;
 	zval *find_params = NULL, *reference_table = NULL, *referenced_entity = NULL;
+	zval *referenced_values = NULL, *referenced_fields = NULL, *dependency_injector = NULL;
+	zval *meta_data = NULL, *primary_keys = NULL, *identity_key = NULL, *record_found = NULL;
+	zval *is_primary = NULL;
 	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL, *r4 = NULL, *r5 = NULL, *r6 = NULL;
 	zval *r7 = NULL, *r8 = NULL, *r9 = NULL, *r10 = NULL, *r11 = NULL, *r12 = NULL, *r13 = NULL;
 	zval *r14 = NULL, *r15 = NULL, *r16 = NULL, *r17 = NULL;
 	zval *t0 = NULL, *t1 = NULL, *t2 = NULL;
-	zval *c0 = NULL;
-	zval *a0 = NULL;
+	zval *c0 = NULL, *c1 = NULL, *c2 = NULL;
+	zval *a0 = NULL, *a1 = NULL;
 	HashTable *ah0, *ah1;
 	HashPosition hp0, hp1;
 	zval **hd;
@@ -638,6 +642,9 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, _getRelationRecords){
 	PHALCON_INIT_VAR(conditions);
 	array_init(conditions);
 	
+	PHALCON_INIT_VAR(referenced_values);
+	array_init(referenced_values);
+	
 	PHALCON_ALLOC_ZVAL_MM(r0);
 	phalcon_array_fetch_string(&r0, relation, SL("fi"), PH_NOISY_CC);
 	if (Z_TYPE_P(r0) != IS_ARRAY) { 
@@ -645,6 +652,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, _getRelationRecords){
 		phalcon_array_fetch_string(&r1, relation, SL("fi"), PH_NOISY_CC);
 		PHALCON_INIT_VAR(value);
 		PHALCON_CALL_METHOD_PARAMS_1(value, record, "readattribute", r1, PH_NO_CHECK);
+		phalcon_array_append(&referenced_values, value, PH_SEPARATE TSRMLS_CC);
 		
 		PHALCON_ALLOC_ZVAL_MM(r2);
 		phalcon_array_fetch_string(&r2, relation, SL("rf"), PH_NOISY_CC);
@@ -677,6 +685,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, _getRelationRecords){
 			phalcon_array_fetch(&r6, r5, i, PH_NOISY_CC);
 			PHALCON_INIT_VAR(value);
 			PHALCON_CALL_METHOD_PARAMS_1(value, record, "readattribute", r6, PH_NO_CHECK);
+			phalcon_array_append(&referenced_values, value, PH_SEPARATE TSRMLS_CC);
 			
 			PHALCON_INIT_VAR(r7);
 			phalcon_array_fetch_string(&r7, relation, SL("rf"), PH_NOISY_CC);
@@ -764,6 +773,52 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, _getRelationRecords){
 	PHALCON_CALL_METHOD(r16, record, "getconnectionservice", PH_NO_CHECK);
 	PHALCON_CALL_METHOD_PARAMS_1_NORETURN(referenced_entity, "setconnectionservice", r16, PH_NO_CHECK);
 	
+	/** 
+	 * belongsTo/hasOne traversals pointing to the primary key of the referenced model are served by the identity map
+	 */
+	PHALCON_INIT_VAR(identity_key);
+	ZVAL_NULL(identity_key);
+	if (ZEND_NUM_ARGS() == 3 && PHALCON_COMPARE_STRING(method, "findFirst")) {
+		PHALCON_INIT_VAR(referenced_fields);
+		phalcon_array_fetch_string(&referenced_fields, relation, SL("rf"), PH_NOISY_CC);
+		if (Z_TYPE_P(referenced_fields) != IS_ARRAY) { 
+			PHALCON_ALLOC_ZVAL_MM(a1);
+			array_init(a1);
+			phalcon_array_append(&a1, referenced_fields, PH_SEPARATE TSRMLS_CC);
+			PHALCON_CPY_WRT(referenced_fields, a1);
+		}
+		
+		PHALCON_INIT_VAR(dependency_injector);
+		PHALCON_CALL_STATIC(dependency_injector, "phalcon\\di", "getdefault");
+		if (Z_TYPE_P(dependency_injector) == IS_OBJECT) {
+			PHALCON_INIT_VAR(c1);
+			ZVAL_STRING(c1, "modelsMetadata", 1);
+			
+			PHALCON_INIT_VAR(meta_data);
+			PHALCON_CALL_METHOD_PARAMS_1(meta_data, dependency_injector, "getshared", c1, PH_NO_CHECK);
+			
+			PHALCON_INIT_VAR(primary_keys);
+			PHALCON_CALL_METHOD_PARAMS_1(primary_keys, meta_data, "getprimarykeyattributes", referenced_entity, PH_NO_CHECK);
+			
+			PHALCON_INIT_VAR(is_primary);
+			is_equal_function(is_primary, referenced_fields, primary_keys TSRMLS_CC);
+			if (zend_is_true(is_primary)) {
+				PHALCON_INIT_VAR(c2);
+				ZVAL_STRING(c2, ",", 1);
+				
+				PHALCON_INIT_VAR(identity_key);
+				phalcon_fast_join(identity_key, c2, referenced_values TSRMLS_CC);
+				
+				PHALCON_INIT_VAR(record_found);
+				PHALCON_CALL_METHOD_PARAMS_2(record_found, this_ptr, "getrecord", reference_table, identity_key, PH_NO_CHECK);
+				if (Z_TYPE_P(record_found) == IS_OBJECT) {
+					
+					RETURN_CCTOR(record_found);
+				}
+			}
+		}
+	}
+	
 	PHALCON_ALLOC_ZVAL_MM(a0);
 	array_init(a0);
 	phalcon_array_append(&a0, referenced_entity, PH_SEPARATE TSRMLS_CC);
@@ -771,6 +826,12 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, _getRelationRecords){
 	
 	PHALCON_ALLOC_ZVAL_MM(r17);
 	PHALCON_CALL_FUNC_PARAMS_2(r17, "call_user_func_array", a0, find_params);
+	if (Z_TYPE_P(identity_key) != IS_NULL) {
+		if (Z_TYPE_P(r17) == IS_OBJECT) {
+			PHALCON_CALL_METHOD_PARAMS_3_NORETURN(this_ptr, "addrecord", reference_table, identity_key, r17, PH_NO_CHECK);
+		}
+	}
+	
 	RETURN_CTOR(r17);
 }
 
@@ -1061,3 +1122,784 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, getHasOneAndHasMany){
 	RETURN_CTOR(r0);
 }
 
+
+/**
+ * Builds the key used to store a record in the identity map
+ */
+static void phalcon_mvc_model_manager_identity_key(zval *map_key, zval *model_name, zval *key TSRMLS_DC){
+
+	zval *lower_name = NULL;
+
+	PHALCON_ALLOC_ZVAL_MM(lower_name);
+	ZVAL_ZVAL(lower_name, model_name, 1, 0);
+	convert_to_string(lower_name);
+	zend_str_tolower(Z_STRVAL_P(lower_name), Z_STRLEN_P(lower_name));
+
+	PHALCON_CONCAT_VSV(map_key, lower_name, "-", key);
+}
+
+/**
+ * Returns the identity map ready to be used or NULL when it is disabled. Every write executed by a
+ * connection discards the records stored before it, the database could have changed any of them.
+ * The returned array is only referenced by the manager, it can be modified in place
+ */
+static zval *phalcon_mvc_model_manager_identity_map(zval *this_ptr TSRMLS_DC){
+
+	zval *identity_map, *generation, *empty_map, *copy;
+
+	identity_map = zend_read_property(phalcon_mvc_model_manager_ce, this_ptr, SL("_identityMap"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(identity_map) != IS_ARRAY) {
+		return NULL;
+	}
+
+	generation = zend_read_property(phalcon_mvc_model_manager_ce, this_ptr, SL("_identityMapGeneration"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(generation) != IS_LONG || (ulong) Z_LVAL_P(generation) != PHALCON_GLOBAL(db_write_generation)) {
+		ALLOC_INIT_ZVAL(empty_map);
+		array_init(empty_map);
+		zend_update_property(phalcon_mvc_model_manager_ce, this_ptr, SL("_identityMap"), empty_map TSRMLS_CC);
+		zval_ptr_dtor(&empty_map);
+		zend_update_property_long(phalcon_mvc_model_manager_ce, this_ptr, SL("_identityMapGeneration"), (long) PHALCON_GLOBAL(db_write_generation) TSRMLS_CC);
+		identity_map = zend_read_property(phalcon_mvc_model_manager_ce, this_ptr, SL("_identityMap"), 1 TSRMLS_CC);
+	}
+
+	if (Z_REFCOUNT_P(identity_map) > 1) {
+		ALLOC_INIT_ZVAL(copy);
+		ZVAL_ZVAL(copy, identity_map, 1, 0);
+		zend_update_property(phalcon_mvc_model_manager_ce, this_ptr, SL("_identityMap"), copy TSRMLS_CC);
+		zval_ptr_dtor(&copy);
+		identity_map = zend_read_property(phalcon_mvc_model_manager_ce, this_ptr, SL("_identityMap"), 1 TSRMLS_CC);
+	}
+
+	return identity_map;
+}
+
+/**
+ * Enables the identity map. findFirst lookups by primary key and belongsTo/hasOne traversals return the
+ * records already hydrated in the request instead of querying them again. When the map is full the oldest
+ * record is dropped
+ *
+ *<code>
+ * $modelsManager->enableIdentityMap(500);
+ *</code>
+ *
+ * @param int $limit
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, enableIdentityMap){
+
+	zval *limit = NULL, *identity_map = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|z", &limit) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (limit && Z_TYPE_P(limit) != IS_NULL) {
+		if (phalcon_get_intval(limit) <= 0) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The size of the identity map must be greater than zero");
+			return;
+		}
+		phalcon_update_property_long(this_ptr, SL("_identityMapLimit"), phalcon_get_intval(limit) TSRMLS_CC);
+	}
+	
+	PHALCON_INIT_VAR(identity_map);
+	PHALCON_READ_PROPERTY_QUICK(&identity_map, this_ptr, "_identityMap", PH_NOISY_CC);
+	if (Z_TYPE_P(identity_map) != IS_ARRAY) {
+		PHALCON_INIT_VAR(identity_map);
+		array_init(identity_map);
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_identityMap", identity_map);
+		phalcon_update_property_long(this_ptr, SL("_identityMapGeneration"), (long) PHALCON_GLOBAL(db_write_generation) TSRMLS_CC);
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Disables the identity map releasing the records stored in it
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, disableIdentityMap){
+
+	PHALCON_MM_GROW();
+	phalcon_update_property_null(this_ptr, SL("_identityMap") TSRMLS_CC);
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns a record already hydrated in the current request by its primary key. Records with
+ * changes that haven't been saved are not returned
+ *
+ *<code>
+ * $robot = $modelsManager->getRecord('Robots', 1);
+ *</code>
+ *
+ * @param string $modelName
+ * @param string $key
+ * @return Phalcon\Mvc\Model|false
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, getRecord){
+
+	zval *model_name = NULL, *key = NULL, *identity_map, *map_key = NULL;
+	zval *record = NULL, *has_snapshot = NULL, *changed = NULL;
+	int eval_int;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz", &model_name, &key) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	identity_map = phalcon_mvc_model_manager_identity_map(this_ptr TSRMLS_CC);
+	if (!identity_map) {
+		PHALCON_MM_RESTORE();
+		RETURN_FALSE;
+	}
+	
+	PHALCON_INIT_VAR(map_key);
+	phalcon_mvc_model_manager_identity_key(map_key, model_name, key TSRMLS_CC);
+	eval_int = phalcon_array_isset(identity_map, map_key);
+	if (eval_int) {
+		PHALCON_INIT_VAR(record);
+		phalcon_array_fetch(&record, identity_map, map_key, PH_NOISY_CC);
+		
+		PHALCON_INIT_VAR(has_snapshot);
+		PHALCON_CALL_METHOD(has_snapshot, record, "hassnapshotdata", PH_NO_CHECK);
+		if (zend_is_true(has_snapshot)) {
+			PHALCON_INIT_VAR(changed);
+			PHALCON_CALL_METHOD(changed, record, "getchangedfields", PH_NO_CHECK);
+			if (Z_TYPE_P(changed) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL_P(changed))) {
+				PHALCON_MM_RESTORE();
+				RETURN_FALSE;
+			}
+		}
+		
+		RETURN_CCTOR(record);
+	}
+	
+	PHALCON_MM_RESTORE();
+	RETURN_FALSE;
+}
+
+/**
+ * Stores a hydrated record in the identity map. Nothing is stored while the identity map is disabled
+ *
+ * @param string $modelName
+ * @param string $key
+ * @param Phalcon\Mvc\Model $record
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, addRecord){
+
+	zval *model_name = NULL, *key = NULL, *record = NULL, *identity_map;
+	zval *map_key = NULL, *limit;
+	HashTable *records;
+	char *str_index;
+	uint str_index_length;
+	ulong num_index;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zzz", &model_name, &key, &record) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(record) != IS_OBJECT) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Only model instances can be stored in the identity map");
+		return;
+	}
+	
+	/** The map is updated in place, storing a record doesn't copy the records already stored */
+	identity_map = phalcon_mvc_model_manager_identity_map(this_ptr TSRMLS_CC);
+	if (!identity_map) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+	
+	PHALCON_INIT_VAR(map_key);
+	phalcon_mvc_model_manager_identity_key(map_key, model_name, key TSRMLS_CC);
+	
+	/** The oldest records are dropped when the map is full */
+	limit = zend_read_property(phalcon_mvc_model_manager_ce, this_ptr, SL("_identityMapLimit"), 1 TSRMLS_CC);
+	records = Z_ARRVAL_P(identity_map);
+	while (zend_hash_num_elements(records) && zend_hash_num_elements(records) >= (uint) phalcon_get_intval(limit)) {
+		zend_hash_internal_pointer_reset(records);
+		if (zend_hash_get_current_key_ex(records, &str_index, &str_index_length, &num_index, 0, NULL) == HASH_KEY_IS_STRING) {
+			zend_hash_del(records, str_index, str_index_length);
+		} else {
+			zend_hash_index_del(records, num_index);
+		}
+	}
+	
+	phalcon_array_update_zval(&identity_map, map_key, &record, PH_COPY TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Removes a record from the identity map
+ *
+ * @param string $modelName
+ * @param string $key
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, removeRecord){
+
+	zval *model_name = NULL, *key = NULL, *identity_map, *map_key = NULL;
+	int eval_int;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz", &model_name, &key) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	identity_map = phalcon_mvc_model_manager_identity_map(this_ptr TSRMLS_CC);
+	if (!identity_map) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+	
+	PHALCON_INIT_VAR(map_key);
+	phalcon_mvc_model_manager_identity_key(map_key, model_name, key TSRMLS_CC);
+	eval_int = phalcon_array_isset(identity_map, map_key);
+	if (eval_int) {
+		phalcon_array_unset(identity_map, map_key);
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Removes every record from the identity map. Long running scripts should call this between units of work
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, clearRecords){
+
+	zval *identity_map = NULL, *a0 = NULL;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(identity_map);
+	PHALCON_READ_PROPERTY_QUICK(&identity_map, this_ptr, "_identityMap", PH_NOISY_CC);
+	if (Z_TYPE_P(identity_map) == IS_ARRAY) {
+		PHALCON_ALLOC_ZVAL_MM(a0);
+		array_init(a0);
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_identityMap", a0);
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Checks whether a foreign key lookup on a referenced model already succeeded in the current request
+ *
+ * @param string $modelName
+ * @param string $conditions
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, isVerifiedReference){
+
+	zval *model_name = NULL, *conditions = NULL, *verified = NULL, *lower_name = NULL;
+	zval *references = NULL;
+	int eval_int;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz", &model_name, &conditions) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_INIT_VAR(verified);
+	PHALCON_READ_PROPERTY_QUICK(&verified, this_ptr, "_verifiedReferences", PH_NOISY_CC);
+	if (Z_TYPE_P(verified) != IS_ARRAY) { 
+		PHALCON_MM_RESTORE();
+		RETURN_FALSE;
+	}
+	
+	PHALCON_INIT_VAR(lower_name);
+	ZVAL_ZVAL(lower_name, model_name, 1, 0);
+	convert_to_string(lower_name);
+	zend_str_tolower(Z_STRVAL_P(lower_name), Z_STRLEN_P(lower_name));
+	eval_int = phalcon_array_isset(verified, lower_name);
+	if (eval_int) {
+		PHALCON_INIT_VAR(references);
+		phalcon_array_fetch(&references, verified, lower_name, PH_NOISY_CC);
+		eval_int = phalcon_array_isset(references, conditions);
+		if (eval_int) {
+			PHALCON_MM_RESTORE();
+			RETURN_TRUE;
+		}
+	}
+	
+	PHALCON_MM_RESTORE();
+	RETURN_FALSE;
+}
+
+/**
+ * Remembers that a foreign key lookup on a referenced model succeeded, so records saved later in the
+ * request referencing the same row don't query it again
+ *
+ * @param string $modelName
+ * @param string $conditions
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, addVerifiedReference){
+
+	zval *model_name = NULL, *conditions = NULL, *verified = NULL, *lower_name = NULL;
+	zval *t0 = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz", &model_name, &conditions) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_INIT_VAR(verified);
+	PHALCON_READ_PROPERTY_QUICK(&verified, this_ptr, "_verifiedReferences", PH_NOISY_CC);
+	if (Z_TYPE_P(verified) != IS_ARRAY) { 
+		PHALCON_INIT_VAR(verified);
+		array_init(verified);
+	} else {
+		PHALCON_SEPARATE(verified);
+	}
+	
+	PHALCON_INIT_VAR(lower_name);
+	ZVAL_ZVAL(lower_name, model_name, 1, 0);
+	convert_to_string(lower_name);
+	zend_str_tolower(Z_STRVAL_P(lower_name), Z_STRLEN_P(lower_name));
+	PHALCON_INIT_VAR(t0);
+	ZVAL_BOOL(t0, 1);
+	phalcon_array_update_multi_2(&verified, lower_name, conditions, &t0, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_verifiedReferences", verified);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Forgets the verified foreign key lookups of a referenced model, or of every model when no name is passed.
+ * Records updated, upserted or deleted through the ORM invalidate the lookups of their model automatically
+ *
+ * @param string $modelName
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, clearVerifiedReferences){
+
+	zval *model_name = NULL, *verified = NULL, *lower_name = NULL;
+	zval *a0 = NULL;
+	int eval_int;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|z", &model_name) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (!model_name || Z_TYPE_P(model_name) == IS_NULL) {
+		PHALCON_ALLOC_ZVAL_MM(a0);
+		array_init(a0);
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_verifiedReferences", a0);
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	PHALCON_INIT_VAR(verified);
+	PHALCON_READ_PROPERTY_QUICK(&verified, this_ptr, "_verifiedReferences", PH_NOISY_CC);
+	if (Z_TYPE_P(verified) == IS_ARRAY) { 
+		PHALCON_INIT_VAR(lower_name);
+		ZVAL_ZVAL(lower_name, model_name, 1, 0);
+		convert_to_string(lower_name);
+		zend_str_tolower(Z_STRVAL_P(lower_name), Z_STRLEN_P(lower_name));
+		eval_int = phalcon_array_isset(verified, lower_name);
+		if (eval_int) {
+			PHALCON_SEPARATE(verified);
+			phalcon_array_unset(verified, lower_name);
+			PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_verifiedReferences", verified);
+		}
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Appends a record to the group of records sharing the same key
+ */
+static void phalcon_mvc_model_manager_group_append(zval *grouped, zval *key, zval *record TSRMLS_DC){
+
+	zval key_copy, *group = NULL, **group_ptr;
+
+	key_copy = *key;
+	zval_copy_ctor(&key_copy);
+	convert_to_string(&key_copy);
+
+	if (zend_symtable_find(Z_ARRVAL_P(grouped), Z_STRVAL(key_copy), Z_STRLEN(key_copy) + 1, (void**) &group_ptr) == FAILURE) {
+		ALLOC_INIT_ZVAL(group);
+		array_init(group);
+		zend_symtable_update(Z_ARRVAL_P(grouped), Z_STRVAL(key_copy), Z_STRLEN(key_copy) + 1, &group, sizeof(zval *), (void**) &group_ptr);
+	}
+
+	Z_ADDREF_P(record);
+	add_next_index_zval(*group_ptr, record);
+
+	zval_dtor(&key_copy);
+}
+
+/**
+ * Returns the group of records related to a key or NULL if there are no records
+ */
+static zval *phalcon_mvc_model_manager_group_find(zval *grouped, zval *key){
+
+	zval key_copy, **group_ptr;
+	int found;
+
+	key_copy = *key;
+	zval_copy_ctor(&key_copy);
+	convert_to_string(&key_copy);
+
+	found = zend_symtable_find(Z_ARRVAL_P(grouped), Z_STRVAL(key_copy), Z_STRLEN(key_copy) + 1, (void**) &group_ptr);
+	zval_dtor(&key_copy);
+
+	if (found == SUCCESS) {
+		return *group_ptr;
+	}
+
+	return NULL;
+}
+
+/**
+ * Loads the records related to a set of records running one IN query per relation instead of one
+ * query per record. The keys are queried in chunks of 1000 values, the related records are attached
+ * to every record so the magic getters return them without querying again
+ *
+ *<code>
+ * $robots = Robots::find(array('with' => array('RobotsParts')));
+ *</code>
+ *
+ * @param string $modelName
+ * @param array $records
+ * @param string|array $relations
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, eagerLoad){
+
+	zval *model_name = NULL, *records = NULL, *relations = NULL, *relation_name = NULL;
+	zval *related_key = NULL;
+	zval *relation = NULL, *relations_definition = NULL, *model_relations = NULL;
+	zval *fields = NULL, *referenced_fields = NULL, *reference_table = NULL;
+	zval *values = NULL, *record = NULL, *value = NULL, *chunks = NULL, *chunk = NULL;
+	zval *markers = NULL, *conditions = NULL, *find_params = NULL, *children = NULL;
+	zval *child = NULL, *grouped = NULL, *group_copy = NULL, *related = NULL;
+	zval *referenced_entity = NULL, *related_records = NULL, *exception_message = NULL;
+	zval *c0 = NULL, *c1 = NULL, *c2 = NULL, *c3 = NULL;
+	zval *a0 = NULL, *a1 = NULL, *a2 = NULL;
+	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL, *r4 = NULL;
+	zval *i0 = NULL;
+	zval *group;
+	HashTable *ah0, *ah1, *ah2, *ah3;
+	HashPosition hp0, hp1, hp2, hp3;
+	zval **hd;
+	int eval_int, relation_type;
+	zend_class_entry *ce0;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zzz", &model_name, &records, &relations) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(records) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Records to eager load must be an array");
+		return;
+	}
+	
+	if (Z_TYPE_P(relations) != IS_ARRAY) { 
+		PHALCON_ALLOC_ZVAL_MM(a0);
+		array_init(a0);
+		phalcon_array_append(&a0, relations, PH_SEPARATE TSRMLS_CC);
+		PHALCON_CPY_WRT(relations, a0);
+	}
+	
+	if (!zend_hash_num_elements(Z_ARRVAL_P(records))) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+	
+	PHALCON_INIT_VAR(c0);
+	ZVAL_LONG(c0, 1000);
+	
+	PHALCON_INIT_VAR(c1);
+	ZVAL_STRING(c1, ", ", 1);
+	
+	PHALCON_INIT_VAR(c2);
+	ZVAL_LONG(c2, 0);
+	
+	PHALCON_INIT_VAR(c3);
+	ZVAL_STRING(c3, "?", 1);
+	
+	ah0 = Z_ARRVAL_P(relations);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	fes_74b5_2:
+		if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
+			goto fee_74b5_2;
+		}
+		
+		PHALCON_GET_FOREACH_VALUE(relation_name);
+		
+		/** 
+		 * Relations are looked up in the same order used by the magic getters
+		 */
+		PHALCON_INIT_VAR(relation);
+		ZVAL_NULL(relation);
+		relation_type = 0;
+		
+		PHALCON_INIT_VAR(relations_definition);
+		phalcon_read_property(&relations_definition, this_ptr, SL("_belongsTo"), PH_NOISY_CC);
+		eval_int = phalcon_array_isset(relations_definition, model_name);
+		if (eval_int) {
+			PHALCON_INIT_VAR(model_relations);
+			phalcon_array_fetch(&model_relations, relations_definition, model_name, PH_NOISY_CC);
+			eval_int = phalcon_array_isset(model_relations, relation_name);
+			if (eval_int) {
+				PHALCON_INIT_VAR(relation);
+				phalcon_array_fetch(&relation, model_relations, relation_name, PH_NOISY_CC);
+				relation_type = 1;
+			}
+		}
+		
+		if (!relation_type) {
+			PHALCON_INIT_VAR(relations_definition);
+			phalcon_read_property(&relations_definition, this_ptr, SL("_hasMany"), PH_NOISY_CC);
+			eval_int = phalcon_array_isset(relations_definition, model_name);
+			if (eval_int) {
+				PHALCON_INIT_VAR(model_relations);
+				phalcon_array_fetch(&model_relations, relations_definition, model_name, PH_NOISY_CC);
+				eval_int = phalcon_array_isset(model_relations, relation_name);
+				if (eval_int) {
+					PHALCON_INIT_VAR(relation);
+					phalcon_array_fetch(&relation, model_relations, relation_name, PH_NOISY_CC);
+					relation_type = 2;
+				}
+			}
+		}
+		
+		if (!relation_type) {
+			PHALCON_INIT_VAR(relations_definition);
+			phalcon_read_property(&relations_definition, this_ptr, SL("_hasOne"), PH_NOISY_CC);
+			eval_int = phalcon_array_isset(relations_definition, model_name);
+			if (eval_int) {
+				PHALCON_INIT_VAR(model_relations);
+				phalcon_array_fetch(&model_relations, relations_definition, model_name, PH_NOISY_CC);
+				eval_int = phalcon_array_isset(model_relations, relation_name);
+				if (eval_int) {
+					PHALCON_INIT_VAR(relation);
+					phalcon_array_fetch(&relation, model_relations, relation_name, PH_NOISY_CC);
+					relation_type = 3;
+				}
+			}
+		}
+		
+		if (!relation_type) {
+			PHALCON_ALLOC_ZVAL_MM(i0);
+			object_init_ex(i0, phalcon_mvc_model_exception_ce);
+			
+			PHALCON_INIT_VAR(exception_message);
+			PHALCON_CONCAT_SVSVS(exception_message, "There is no relation '", relation_name, "' defined on model '", model_name, "'");
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(i0, "__construct", exception_message, PH_CHECK);
+			phalcon_throw_exception(i0 TSRMLS_CC);
+			return;
+		}
+		
+		/** 
+		 * The magic getters are case-insensitive, the records are attached using the lower-cased name
+		 */
+		PHALCON_INIT_VAR(related_key);
+		PHALCON_CALL_FUNC_PARAMS_1(related_key, "strtolower", relation_name);
+		
+		PHALCON_INIT_VAR(fields);
+		phalcon_array_fetch_string(&fields, relation, SL("fi"), PH_NOISY_CC);
+		
+		PHALCON_INIT_VAR(referenced_fields);
+		phalcon_array_fetch_string(&referenced_fields, relation, SL("rf"), PH_NOISY_CC);
+		if (Z_TYPE_P(fields) == IS_ARRAY) { 
+			if (zend_hash_num_elements(Z_ARRVAL_P(fields)) != 1) {
+				PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Only relations with a single field can be eager loaded");
+				return;
+			}
+			
+			PHALCON_INIT_VAR(r0);
+			phalcon_array_fetch_long(&r0, fields, 0, PH_NOISY_CC);
+			PHALCON_CPY_WRT(fields, r0);
+			
+			PHALCON_INIT_VAR(r1);
+			phalcon_array_fetch_long(&r1, referenced_fields, 0, PH_NOISY_CC);
+			PHALCON_CPY_WRT(referenced_fields, r1);
+		}
+		
+		PHALCON_INIT_VAR(reference_table);
+		phalcon_array_fetch_string(&reference_table, relation, SL("rt"), PH_NOISY_CC);
+		
+		/** 
+		 * Collect the distinct keys of the records
+		 */
+		PHALCON_INIT_VAR(values);
+		array_init(values);
+		
+		ah1 = Z_ARRVAL_P(records);
+		zend_hash_internal_pointer_reset_ex(ah1, &hp1);
+		fes_74b5_3:
+			if(zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) != SUCCESS){
+				goto fee_74b5_3;
+			}
+			
+			PHALCON_GET_FOREACH_VALUE(record);
+			
+			PHALCON_INIT_VAR(value);
+			PHALCON_CALL_METHOD_PARAMS_1(value, record, "readattribute", fields, PH_NO_CHECK);
+			if (Z_TYPE_P(value) != IS_NULL) {
+				phalcon_array_append(&values, value, PH_SEPARATE TSRMLS_CC);
+			}
+			zend_hash_move_forward_ex(ah1, &hp1);
+			goto fes_74b5_3;
+		fee_74b5_3:
+		if(0){}
+		
+		PHALCON_INIT_VAR(grouped);
+		array_init(grouped);
+		if (zend_hash_num_elements(Z_ARRVAL_P(values))) {
+			PHALCON_INIT_VAR(r2);
+			PHALCON_CALL_FUNC_PARAMS_1(r2, "array_unique", values);
+			
+			PHALCON_INIT_VAR(chunks);
+			PHALCON_CALL_FUNC_PARAMS_2(chunks, "array_chunk", r2, c0);
+			
+			ah2 = Z_ARRVAL_P(chunks);
+			zend_hash_internal_pointer_reset_ex(ah2, &hp2);
+			fes_74b5_4:
+				if(zend_hash_get_current_data_ex(ah2, (void**) &hd, &hp2) != SUCCESS){
+					goto fee_74b5_4;
+				}
+				
+				PHALCON_GET_FOREACH_VALUE(chunk);
+				
+				PHALCON_INIT_VAR(r3);
+				ZVAL_LONG(r3, zend_hash_num_elements(Z_ARRVAL_P(chunk)));
+				
+				PHALCON_INIT_VAR(r4);
+				PHALCON_CALL_FUNC_PARAMS_3(r4, "array_fill", c2, r3, c3);
+				
+				PHALCON_INIT_VAR(markers);
+				phalcon_fast_join(markers, c1, r4 TSRMLS_CC);
+				
+				PHALCON_INIT_VAR(conditions);
+				PHALCON_CONCAT_VSVS(conditions, referenced_fields, " IN (", markers, ")");
+				
+				PHALCON_INIT_VAR(find_params);
+				array_init(find_params);
+				phalcon_array_append(&find_params, conditions, PH_SEPARATE TSRMLS_CC);
+				phalcon_array_update_string(&find_params, SL("bind"), &chunk, PH_COPY | PH_SEPARATE TSRMLS_CC);
+				
+				PHALCON_INIT_VAR(a1);
+				array_init(a1);
+				phalcon_array_append(&a1, reference_table, PH_SEPARATE TSRMLS_CC);
+				add_next_index_stringl(a1, SL("find"), 1);
+				
+				PHALCON_INIT_VAR(a2);
+				array_init(a2);
+				phalcon_array_append(&a2, find_params, PH_SEPARATE TSRMLS_CC);
+				
+				PHALCON_INIT_VAR(children);
+				PHALCON_CALL_FUNC_PARAMS_2(children, "call_user_func_array", a1, a2);
+				
+				/** 
+				 * Group the related records by the referenced field
+				 */
+				PHALCON_CALL_METHOD_NORETURN(children, "rewind", PH_NO_CHECK);
+				ws_74b5_0:
+					
+					PHALCON_INIT_VAR(r0);
+					PHALCON_CALL_METHOD(r0, children, "valid", PH_NO_CHECK);
+					if (!zend_is_true(r0)) {
+						goto we_74b5_0;
+					}
+					
+					PHALCON_INIT_VAR(child);
+					PHALCON_CALL_METHOD(child, children, "current", PH_NO_CHECK);
+					
+					PHALCON_INIT_VAR(value);
+					PHALCON_CALL_METHOD_PARAMS_1(value, child, "readattribute", referenced_fields, PH_NO_CHECK);
+					phalcon_mvc_model_manager_group_append(grouped, value, child TSRMLS_CC);
+					PHALCON_CALL_METHOD_NORETURN(children, "next", PH_NO_CHECK);
+					goto ws_74b5_0;
+				we_74b5_0:
+				
+				zend_hash_move_forward_ex(ah2, &hp2);
+				goto fes_74b5_4;
+			fee_74b5_4:
+			if(0){}
+		}
+		
+		if (relation_type == 2) {
+			ce0 = phalcon_fetch_class(reference_table TSRMLS_CC);
+			
+			PHALCON_INIT_VAR(referenced_entity);
+			object_init_ex(referenced_entity, ce0);
+			PHALCON_CALL_METHOD_NORETURN(referenced_entity, "__construct", PH_CHECK);
+		}
+		
+		/** 
+		 * Attach the related records to every record
+		 */
+		ah3 = Z_ARRVAL_P(records);
+		zend_hash_internal_pointer_reset_ex(ah3, &hp3);
+		fes_74b5_5:
+			if(zend_hash_get_current_data_ex(ah3, (void**) &hd, &hp3) != SUCCESS){
+				goto fee_74b5_5;
+			}
+			
+			PHALCON_GET_FOREACH_VALUE(record);
+			
+			PHALCON_INIT_VAR(value);
+			PHALCON_CALL_METHOD_PARAMS_1(value, record, "readattribute", fields, PH_NO_CHECK);
+			group = phalcon_mvc_model_manager_group_find(grouped, value);
+			if (relation_type == 2) {
+				PHALCON_INIT_VAR(group_copy);
+				if (group) {
+					ZVAL_ZVAL(group_copy, group, 1, 0);
+				} else {
+					array_init(group_copy);
+				}
+				
+				PHALCON_INIT_VAR(related_records);
+				object_init_ex(related_records, phalcon_mvc_model_resultset_ce);
+				PHALCON_CALL_METHOD_PARAMS_2_NORETURN(related_records, "__construct", referenced_entity, group_copy, PH_CHECK);
+			} else {
+				PHALCON_INIT_VAR(related_records);
+				if (group) {
+					phalcon_array_fetch_long(&related_records, group, 0, PH_NOISY_CC);
+				} else {
+					ZVAL_BOOL(related_records, 0);
+				}
+			}
+			
+			PHALCON_INIT_VAR(related);
+			phalcon_read_property(&related, record, SL("_related"), PH_NOISY_CC);
+			if (Z_TYPE_P(related) != IS_ARRAY) { 
+				PHALCON_INIT_VAR(related);
+				array_init(related);
+			}
+			
+			phalcon_array_update_zval(&related, related_key, &related_records, PH_COPY | PH_SEPARATE TSRMLS_CC);
+			phalcon_update_property_zval(record, SL("_related"), related TSRMLS_CC);
+			zend_hash_move_forward_ex(ah3, &hp3);
+			goto fes_74b5_5;
+		fee_74b5_5:
+		if(0){}
+		
+		zend_hash_move_forward_ex(ah0, &hp0);
+		goto fes_74b5_2;
+	fee_74b5_2:
+	if(0){}
+	
+	PHALCON_MM_RESTORE();
+}
+
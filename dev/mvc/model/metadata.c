@@ -37,6 +37,7 @@
 #include "kernel/concat.h"
 #include "kernel/array.h"
 #include "kernel/exception.h"
+#include "kernel/operators.h"
 
 /**
  * Phalcon\Mvc\Model\MetaData
@@ -82,19 +83,16 @@ PHP_METHOD(Phalcon_Mvc_Model_MetaData, __construct){
 }
 
 /**
- * Initialize the metadata for certain table
- *
- * @param Phalcon\Mvc\Model $model
- * @param string $table
- * @param string $schema
+ * Resolves the meta-data of a table that isn't loaded yet and stores it in the adapter. The caller
+ * releases the lock of the table whatever happens here, exceptions included
  */
-PHP_METHOD(Phalcon_Mvc_Model_MetaData, _initializeMetaData){
+static void phalcon_mvc_model_metadata_load_table(zval *this_ptr, zval *model, zval *table, zval *schema, zval *key, int locked TSRMLS_DC){
 
-	zval *model = NULL, *table = NULL, *schema = NULL, *key = NULL, *connection = NULL, *exists = NULL;
+	zval *connection = NULL, *exists = NULL;
 	zval *complete_table = NULL, *attributes = NULL, *primary_keys = NULL;
 	zval *non_primary_keys = NULL, *numeric_typed = NULL, *not_null = NULL;
 	zval *field_types = NULL, *identity_field = NULL, *columns = NULL;
-	zval *column = NULL, *field_name = NULL, *table_metadata = NULL;
+	zval *column = NULL, *field_name = NULL, *table_metadata = NULL, *stored = NULL;
 	zval *t0 = NULL, *t1 = NULL, *t2 = NULL;
 	zval *i0 = NULL;
 	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL, *r4 = NULL, *r5 = NULL, *r6 = NULL;
@@ -102,7 +100,178 @@ PHP_METHOD(Phalcon_Mvc_Model_MetaData, _initializeMetaData){
 	HashTable *ah0;
 	HashPosition hp0;
 	zval **hd;
+
+	PHALCON_MM_GROW();
+	
+	/** 
+	 * The table could be stored by another process just before the lock was released
+	 */
+	if (locked) {
+		PHALCON_INIT_VAR(table_metadata);
+		PHALCON_CALL_METHOD_PARAMS_1(table_metadata, this_ptr, "readentry", key, PH_NO_CHECK);
+		if (Z_TYPE_P(table_metadata) == IS_ARRAY) { 
+			PHALCON_ALLOC_ZVAL_MM(t0);
+			phalcon_read_property(&t0, this_ptr, SL("_metaData"), PH_NOISY_CC);
+			phalcon_array_update_zval(&t0, key, &table_metadata, PH_COPY | PH_SEPARATE TSRMLS_CC);
+			phalcon_update_property_zval(this_ptr, SL("_metaData"), t0 TSRMLS_CC);
+			PHALCON_MM_RESTORE();
+			return;
+		}
+	}
+	
+	PHALCON_INIT_VAR(connection);
+	PHALCON_CALL_METHOD(connection, model, "getconnection", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(exists);
+	PHALCON_CALL_METHOD_PARAMS_2(exists, connection, "tableexists", table, schema, PH_NO_CHECK);
+	if (!zend_is_true(exists)) {
+		if (zend_is_true(schema)) {
+			PHALCON_INIT_VAR(complete_table);
+			PHALCON_CONCAT_VSV(complete_table, schema, "\".\"", table);
+		} else {
+			PHALCON_CPY_WRT(complete_table, table);
+		}
+		
+		PHALCON_ALLOC_ZVAL_MM(i0);
+		object_init_ex(i0, phalcon_mvc_model_exception_ce);
+		
+		PHALCON_ALLOC_ZVAL_MM(r0);
+		phalcon_get_class(r0, model TSRMLS_CC);
+		
+		PHALCON_ALLOC_ZVAL_MM(r1);
+		PHALCON_CONCAT_SVSV(r1, "Table \"", complete_table, "\" doesn't exist on database when dumping meta-data for ", r0);
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(i0, "__construct", r1, PH_CHECK);
+		phalcon_throw_exception(i0 TSRMLS_CC);
+		return;
+	}
+	
+	PHALCON_INIT_VAR(attributes);
+	array_init(attributes);
+	
+	PHALCON_INIT_VAR(primary_keys);
+	array_init(primary_keys);
+	
+	PHALCON_INIT_VAR(non_primary_keys);
+	array_init(non_primary_keys);
+	
+	PHALCON_INIT_VAR(numeric_typed);
+	array_init(numeric_typed);
+	
+	PHALCON_INIT_VAR(not_null);
+	array_init(not_null);
+	
+	PHALCON_INIT_VAR(field_types);
+	array_init(field_types);
+	
+	PHALCON_INIT_VAR(identity_field);
+	ZVAL_BOOL(identity_field, 0);
+	
+	PHALCON_INIT_VAR(columns);
+	PHALCON_CALL_METHOD_PARAMS_2(columns, connection, "describecolumns", table, schema, PH_NO_CHECK);
+	if (!phalcon_valid_foreach(columns TSRMLS_CC)) {
+		return;
+	}
+	
+	ah0 = Z_ARRVAL_P(columns);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	fes_c40c_0:
+		if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
+			goto fee_c40c_0;
+		}
+		
+		PHALCON_GET_FOREACH_VALUE(column);
+		PHALCON_INIT_VAR(field_name);
+		PHALCON_CALL_METHOD(field_name, column, "getname", PH_NO_CHECK);
+		phalcon_array_append(&attributes, field_name, PH_SEPARATE TSRMLS_CC);
+		
+		PHALCON_INIT_VAR(r2);
+		PHALCON_CALL_METHOD(r2, column, "isprimary", PH_NO_CHECK);
+		if (zend_is_true(r2)) {
+			phalcon_array_append(&primary_keys, field_name, PH_SEPARATE TSRMLS_CC);
+		} else {
+			phalcon_array_append(&non_primary_keys, field_name, PH_SEPARATE TSRMLS_CC);
+		}
+		
+		PHALCON_INIT_VAR(r3);
+		PHALCON_CALL_METHOD(r3, column, "isnumeric", PH_NO_CHECK);
+		if (zend_is_true(r3)) {
+			phalcon_array_update_zval_bool(&numeric_typed, field_name, 1, PH_SEPARATE TSRMLS_CC);
+		}
+		
+		PHALCON_INIT_VAR(r4);
+		PHALCON_CALL_METHOD(r4, column, "isnotnull", PH_NO_CHECK);
+		if (zend_is_true(r4)) {
+			phalcon_array_append(&not_null, field_name, PH_SEPARATE TSRMLS_CC);
+		}
+		
+		PHALCON_INIT_VAR(r5);
+		PHALCON_CALL_METHOD(r5, column, "isautoincrement", PH_NO_CHECK);
+		if (zend_is_true(r5)) {
+			PHALCON_CPY_WRT(identity_field, field_name);
+		}
+		
+		PHALCON_INIT_VAR(r6);
+		PHALCON_CALL_METHOD(r6, column, "gettype", PH_NO_CHECK);
+		phalcon_array_update_zval(&field_types, field_name, &r6, PH_COPY | PH_SEPARATE TSRMLS_CC);
+		zend_hash_move_forward_ex(ah0, &hp0);
+		goto fes_c40c_0;
+	fee_c40c_0:
+	if(0){}
+	
+	PHALCON_INIT_VAR(table_metadata);
+	array_init(table_metadata);
+	phalcon_array_update_long(&table_metadata, 0, &attributes, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_long(&table_metadata, 1, &primary_keys, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_long(&table_metadata, 2, &non_primary_keys, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_long(&table_metadata, 3, &not_null, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_long(&table_metadata, 4, &field_types, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_long(&table_metadata, 5, &numeric_typed, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_long(&table_metadata, 8, &identity_field, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+	PHALCON_ALLOC_ZVAL_MM(t1);
+	phalcon_read_property(&t1, this_ptr, SL("_metaData"), PH_NOISY_CC);
+	phalcon_array_update_zval(&t1, key, &table_metadata, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	phalcon_update_property_zval(this_ptr, SL("_metaData"), t1 TSRMLS_CC);
+	
+	/** 
+	 * Adapters storing every table by its key only write the introspected table,
+	 * the others write all the meta-data when the request finishes
+	 */
+	PHALCON_INIT_VAR(stored);
+	PHALCON_CALL_METHOD_PARAMS_2(stored, this_ptr, "writeentry", key, table_metadata, PH_NO_CHECK);
+	if (zend_is_true(stored)) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	PHALCON_ALLOC_ZVAL_MM(t2);
+	phalcon_read_property(&t2, this_ptr, SL("_changed"), PH_NOISY_CC);
+	if (!zend_is_true(t2)) {
+		PHALCON_ALLOC_ZVAL_MM(a0);
+		array_init(a0);
+		phalcon_array_append(&a0, this_ptr, PH_SEPARATE TSRMLS_CC);
+		add_next_index_stringl(a0, SL("storeMetaData"), 1);
+		PHALCON_CALL_FUNC_PARAMS_1_NORETURN("register_shutdown_function", a0);
+		phalcon_update_property_bool(this_ptr, SL("_changed"), 1 TSRMLS_CC);
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Initialize the metadata for certain table
+ *
+ * @param Phalcon\Mvc\Model $model
+ * @param string $table
+ * @param string $schema
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData, _initializeMetaData){
+
+	zval *model = NULL, *table = NULL, *schema = NULL, *key = NULL;
+	zval *table_metadata = NULL, *locked = NULL, *lock_timeout = NULL, *interval = NULL;
+	zval *t0 = NULL;
 	int eval_int;
+	long waited;
 
 	PHALCON_MM_GROW();
 	
@@ -118,136 +287,146 @@ PHP_METHOD(Phalcon_Mvc_Model_MetaData, _initializeMetaData){
 	phalcon_read_property(&t0, this_ptr, SL("_metaData"), PH_NOISY_CC);
 	eval_int = phalcon_array_isset(t0, key);
 	if (!eval_int) {
-		PHALCON_INIT_VAR(connection);
-		PHALCON_CALL_METHOD(connection, model, "getconnection", PH_NO_CHECK);
-		
-		PHALCON_INIT_VAR(exists);
-		PHALCON_CALL_METHOD_PARAMS_2(exists, connection, "tableexists", table, schema, PH_NO_CHECK);
-		if (!zend_is_true(exists)) {
-			if (zend_is_true(schema)) {
-				PHALCON_INIT_VAR(complete_table);
-				PHALCON_CONCAT_VSV(complete_table, schema, "\".\"", table);
-			} else {
-				PHALCON_CPY_WRT(complete_table, table);
-			}
-			
-			PHALCON_ALLOC_ZVAL_MM(i0);
-			object_init_ex(i0, phalcon_mvc_model_exception_ce);
-			
-			PHALCON_ALLOC_ZVAL_MM(r0);
-			phalcon_get_class(r0, model TSRMLS_CC);
-			
-			PHALCON_ALLOC_ZVAL_MM(r1);
-			PHALCON_CONCAT_SVSV(r1, "Table \"", complete_table, "\" doesn't exist on database when dumping meta-data for ", r0);
-			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(i0, "__construct", r1, PH_CHECK);
-			phalcon_throw_exception(i0 TSRMLS_CC);
-			return;
-		}
 		
-		PHALCON_INIT_VAR(attributes);
-		array_init(attributes);
-		
-		PHALCON_INIT_VAR(primary_keys);
-		array_init(primary_keys);
-		
-		PHALCON_INIT_VAR(non_primary_keys);
-		array_init(non_primary_keys);
-		
-		PHALCON_INIT_VAR(numeric_typed);
-		array_init(numeric_typed);
-		
-		PHALCON_INIT_VAR(not_null);
-		array_init(not_null);
-		
-		PHALCON_INIT_VAR(field_types);
-		array_init(field_types);
-		
-		PHALCON_INIT_VAR(identity_field);
-		ZVAL_BOOL(identity_field, 0);
-		
-		PHALCON_INIT_VAR(columns);
-		PHALCON_CALL_METHOD_PARAMS_2(columns, connection, "describecolumns", table, schema, PH_NO_CHECK);
-		if (!phalcon_valid_foreach(columns TSRMLS_CC)) {
-			return;
+		/** 
+		 * Adapters able to resolve a single table do it before introspecting the database
+		 */
+		PHALCON_INIT_VAR(table_metadata);
+		PHALCON_CALL_METHOD_PARAMS_1(table_metadata, this_ptr, "readentry", key, PH_NO_CHECK);
+		if (Z_TYPE_P(table_metadata) == IS_ARRAY) { 
+			phalcon_array_update_zval(&t0, key, &table_metadata, PH_COPY | PH_SEPARATE TSRMLS_CC);
+			phalcon_update_property_zval(this_ptr, SL("_metaData"), t0 TSRMLS_CC);
+			PHALCON_MM_RESTORE();
+			RETURN_NULL();
 		}
 		
-		ah0 = Z_ARRVAL_P(columns);
-		zend_hash_internal_pointer_reset_ex(ah0, &hp0);
-		fes_c40c_0:
-			if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
-				goto fee_c40c_0;
-			}
+		/** 
+		 * Only the process holding the lock introspects the table, the others wait until its
+		 * meta-data is stored and introspect the table by themselves if the lock isn't released in time
+		 */
+		PHALCON_INIT_VAR(locked);
+		PHALCON_CALL_METHOD_PARAMS_1(locked, this_ptr, "lockentry", key, PH_NO_CHECK);
+		if (!zend_is_true(locked)) {
+			PHALCON_ALLOC_ZVAL_MM(lock_timeout);
+			phalcon_read_property(&lock_timeout, this_ptr, SL("_lockTimeout"), PH_NOISY_CC);
 			
-			PHALCON_INIT_VAR(column);
-			ZVAL_ZVAL(column, *hd, 1, 0);
-			PHALCON_INIT_VAR(field_name);
-			PHALCON_CALL_METHOD(field_name, column, "getname", PH_NO_CHECK);
-			phalcon_array_append(&attributes, field_name, PH_SEPARATE TSRMLS_CC);
+			PHALCON_INIT_VAR(interval);
+			ZVAL_LONG(interval, 10000);
 			
-			PHALCON_INIT_VAR(r2);
-			PHALCON_CALL_METHOD(r2, column, "isprimary", PH_NO_CHECK);
-			if (zend_is_true(r2)) {
-				phalcon_array_append(&primary_keys, field_name, PH_SEPARATE TSRMLS_CC);
-			} else {
-				phalcon_array_append(&non_primary_keys, field_name, PH_SEPARATE TSRMLS_CC);
+			waited = 0;
+			while (waited < phalcon_get_intval(lock_timeout)) {
+				PHALCON_CALL_FUNC_PARAMS_1_NORETURN("usleep", interval);
+				waited += 10;
+				
+				PHALCON_INIT_VAR(table_metadata);
+				PHALCON_CALL_METHOD_PARAMS_1(table_metadata, this_ptr, "readentry", key, PH_NO_CHECK);
+				if (Z_TYPE_P(table_metadata) == IS_ARRAY) { 
+					phalcon_array_update_zval(&t0, key, &table_metadata, PH_COPY | PH_SEPARATE TSRMLS_CC);
+					phalcon_update_property_zval(this_ptr, SL("_metaData"), t0 TSRMLS_CC);
+					PHALCON_MM_RESTORE();
+					RETURN_NULL();
+				}
 			}
-			
-			PHALCON_INIT_VAR(r3);
-			PHALCON_CALL_METHOD(r3, column, "isnumeric", PH_NO_CHECK);
-			if (zend_is_true(r3)) {
-				phalcon_array_update_zval_bool(&numeric_typed, field_name, 1, PH_SEPARATE TSRMLS_CC);
-			}
-			
-			PHALCON_INIT_VAR(r4);
-			PHALCON_CALL_METHOD(r4, column, "isnotnull", PH_NO_CHECK);
-			if (zend_is_true(r4)) {
-				phalcon_array_append(&not_null, field_name, PH_SEPARATE TSRMLS_CC);
-			}
-			
-			PHALCON_INIT_VAR(r5);
-			PHALCON_CALL_METHOD(r5, column, "isautoincrement", PH_NO_CHECK);
-			if (zend_is_true(r5)) {
-				PHALCON_CPY_WRT(identity_field, field_name);
-			}
-			
-			PHALCON_INIT_VAR(r6);
-			PHALCON_CALL_METHOD(r6, column, "gettype", PH_NO_CHECK);
-			phalcon_array_update_zval(&field_types, field_name, &r6, PH_COPY | PH_SEPARATE TSRMLS_CC);
-			zend_hash_move_forward_ex(ah0, &hp0);
-			goto fes_c40c_0;
-		fee_c40c_0:
-		if(0){}
-		
-		PHALCON_INIT_VAR(table_metadata);
-		array_init(table_metadata);
-		phalcon_array_update_long(&table_metadata, 0, &attributes, PH_COPY | PH_SEPARATE TSRMLS_CC);
-		phalcon_array_update_long(&table_metadata, 1, &primary_keys, PH_COPY | PH_SEPARATE TSRMLS_CC);
-		phalcon_array_update_long(&table_metadata, 2, &non_primary_keys, PH_COPY | PH_SEPARATE TSRMLS_CC);
-		phalcon_array_update_long(&table_metadata, 3, &not_null, PH_COPY | PH_SEPARATE TSRMLS_CC);
-		phalcon_array_update_long(&table_metadata, 4, &field_types, PH_COPY | PH_SEPARATE TSRMLS_CC);
-		phalcon_array_update_long(&table_metadata, 5, &numeric_typed, PH_COPY | PH_SEPARATE TSRMLS_CC);
-		phalcon_array_update_long(&table_metadata, 8, &identity_field, PH_COPY | PH_SEPARATE TSRMLS_CC);
-		
-		PHALCON_ALLOC_ZVAL_MM(t1);
-		phalcon_read_property(&t1, this_ptr, SL("_metaData"), PH_NOISY_CC);
-		phalcon_array_update_zval(&t1, key, &table_metadata, PH_COPY TSRMLS_CC);
-		phalcon_update_property_zval(this_ptr, SL("_metaData"), t1 TSRMLS_CC);
+		}
 		
-		PHALCON_ALLOC_ZVAL_MM(t2);
-		phalcon_read_property(&t2, this_ptr, SL("_changed"), PH_NOISY_CC);
-		if (!zend_is_true(t2)) {
-			PHALCON_ALLOC_ZVAL_MM(a0);
-			array_init(a0);
-			phalcon_array_append(&a0, this_ptr, PH_SEPARATE TSRMLS_CC);
-			add_next_index_stringl(a0, SL("storeMetaData"), 1);
-			PHALCON_CALL_FUNC_PARAMS_1_NORETURN("register_shutdown_function", a0);
-			phalcon_update_property_bool(this_ptr, SL("_changed"), 1 TSRMLS_CC);
+		phalcon_mvc_model_metadata_load_table(this_ptr, model, table, schema, key, zend_is_true(locked) TSRMLS_CC);
+		if (zend_is_true(locked)) {
+			phalcon_call_method_cleanup(this_ptr, SL("unlockentry"), key TSRMLS_CC);
+		}
+		if (EG(exception)) {
+			PHALCON_MM_RESTORE();
+			return;
 		}
 	}
 	
 	PHALCON_MM_RESTORE();
 }
 
+/**
+ * Reads the meta-data of a single table from the adapter. Adapters storing the meta-data
+ * of every table together return null, their data was already loaded by read()
+ *
+ * @param string $key
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData, readEntry){
+
+	zval *key = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &key) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_MM_RESTORE();
+	RETURN_NULL();
+}
+
+/**
+ * Writes the meta-data of a single table. Adapters storing the meta-data of every table
+ * together return false, their data is written by storeMetaData()
+ *
+ * @param string $key
+ * @param array $data
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData, writeEntry){
+
+	zval *key = NULL, *data = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz", &key, &data) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_MM_RESTORE();
+	RETURN_FALSE;
+}
+
+/**
+ * Acquires the lock to introspect a table. Adapters not shared between processes always get it
+ *
+ * @param string $key
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData, lockEntry){
+
+	zval *key = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &key) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_MM_RESTORE();
+	RETURN_TRUE;
+}
+
+/**
+ * Releases the lock acquired by lockEntry()
+ *
+ * @param string $key
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData, unlockEntry){
+
+	zval *key = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &key) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_MM_RESTORE();
+}
+
 /**
  * Returns table attributes names (fields)
  *
@@ -494,6 +673,70 @@ PHP_METHOD(Phalcon_Mvc_Model_MetaData, getDataTypesNumeric){
 	RETURN_CCTOR(r2);
 }
 
+/**
+ * Returns the bind types for the placeholders named after attributes of the model.
+ * Integer attributes are bound as integers, other placeholders keep the type of their value
+ *
+ * @param Phalcon\Mvc\Model $model
+ * @param array $bindParams
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData, getBindTypes){
+
+	zval *model = NULL, *bind_params = NULL, *bind_types = NULL, *data_types = NULL;
+	zval *name = NULL, *data_type = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	char *hash_index;
+	uint hash_index_len;
+	ulong hash_num;
+	int hash_type;
+	int eval_int;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz", &model, &bind_params) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_INIT_VAR(bind_types);
+	array_init(bind_types);
+	if (Z_TYPE_P(bind_params) == IS_ARRAY) { 
+		PHALCON_INIT_VAR(data_types);
+		PHALCON_CALL_METHOD_PARAMS_1(data_types, this_ptr, "getdatatypes", model, PH_NO_CHECK);
+		if (Z_TYPE_P(data_types) == IS_ARRAY) { 
+			ah0 = Z_ARRVAL_P(bind_params);
+			zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+			fes_c40c_1:
+				if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
+					goto fee_c40c_1;
+				}
+				
+				PHALCON_INIT_VAR(name);
+				PHALCON_GET_FOREACH_KEY(name, ah0, hp0);
+				if (Z_TYPE_P(name) == IS_STRING) {
+					eval_int = phalcon_array_isset(data_types, name);
+					if (eval_int) {
+						PHALCON_INIT_VAR(data_type);
+						phalcon_array_fetch(&data_type, data_types, name, PH_NOISY_CC);
+						if (Z_TYPE_P(data_type) == IS_LONG && Z_LVAL_P(data_type) == 0) {
+							phalcon_array_update_string_long(&bind_types, Z_STRVAL_P(name), Z_STRLEN_P(name), 1, PH_SEPARATE TSRMLS_CC);
+						}
+					}
+				}
+				zend_hash_move_forward_ex(ah0, &hp0);
+				goto fes_c40c_1;
+			fee_c40c_1:
+			if(0){}
+		}
+	}
+	
+	
+	RETURN_CTOR(bind_types);
+}
+
 /**
  * Returns the name of identity field (if one is present)
  *
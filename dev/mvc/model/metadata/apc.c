@@ -44,9 +44,17 @@
  *
  * By default meta-data is stored 48 hours (172800 seconds)
  *
- * You can query the meta-data by printing apc_fetch('$PMM$') or apc_fetch('$PMM$my-local-app')
- *
+ * Every table is stored under its own key, only the tables introspected by a request are written
+ * and a lock prevents several processes from introspecting the same table at once.
+ * You can query the meta-data of a table by printing apc_fetch('$PMM$$robots') or apc_fetch('$PMM$my-local-app$robots')
  *
+ *<code>
+ * $metaData = new Phalcon\Mvc\Model\MetaData\Apc(array(
+ *     'suffix' => 'my-local-app',
+ *     'lifetime' => 86400,
+ *     'lockTimeout' => 1000
+ * ));
+ *</code>
  */
 
 /**
@@ -57,7 +65,7 @@
 PHP_METHOD(Phalcon_Mvc_Model_MetaData_Apc, __construct){
 
 	zval *options = NULL;
-	zval *r0 = NULL, *r1 = NULL;
+	zval *r0 = NULL, *r1 = NULL, *r2 = NULL;
 	int eval_int;
 
 	PHALCON_MM_GROW();
@@ -79,66 +87,200 @@ PHP_METHOD(Phalcon_Mvc_Model_MetaData_Apc, __construct){
 		phalcon_array_fetch_string(&r1, options, SL("lifetime"), PH_NOISY_CC);
 		phalcon_update_property_zval(this_ptr, SL("_ttl"), r1 TSRMLS_CC);
 	}
+	eval_int = phalcon_array_isset_string(options, SL("lockTimeout")+1);
+	if (eval_int) {
+		PHALCON_ALLOC_ZVAL_MM(r2);
+		phalcon_array_fetch_string(&r2, options, SL("lockTimeout"), PH_NOISY_CC);
+		phalcon_update_property_zval(this_ptr, SL("_lockTimeout"), r2 TSRMLS_CC);
+	}
+	PHALCON_CALL_PARENT_NORETURN(this_ptr, "Phalcon\\Mvc\\Model\\MetaData\\Apc", "__construct");
 	
 	PHALCON_MM_RESTORE();
 }
 
 /**
- * Reads meta-data from APC
+ * Nothing is read in advance, every table is fetched from APC by readEntry()
  *
  * @return array
  */
 PHP_METHOD(Phalcon_Mvc_Model_MetaData_Apc, read){
 
-	zval *key = NULL, *data = NULL;
-	zval *t0 = NULL;
 	zval *a0 = NULL;
 
 	PHALCON_MM_GROW();
+	PHALCON_ALLOC_ZVAL_MM(a0);
+	array_init(a0);
+	
+	RETURN_CTOR(a0);
+}
+
+/**
+ * Writes the meta-data of every table to APC
+ *
+ * @param array $data
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Apc, write){
+
+	zval *data = NULL, *key = NULL, *table_metadata = NULL;
+	HashPosition hp0;
+	zval **hd;
+	char *hash_index;
+	uint hash_index_len;
+	ulong hash_num;
+	int hash_type;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &data) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(data) == IS_ARRAY) { 
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(data), &hp0);
+		while (zend_hash_get_current_data_ex(Z_ARRVAL_P(data), (void**) &hd, &hp0) == SUCCESS) {
+			PHALCON_INIT_VAR(key);
+			PHALCON_GET_FOREACH_KEY(key, Z_ARRVAL_P(data), hp0);
+			PHALCON_INIT_VAR(table_metadata);
+			ZVAL_ZVAL(table_metadata, *hd, 1, 0);
+			zend_hash_move_forward_ex(Z_ARRVAL_P(data), &hp0);
+			PHALCON_CALL_METHOD_PARAMS_2_NORETURN(this_ptr, "writeentry", key, table_metadata, PH_NO_CHECK);
+		}
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Reads the meta-data of a single table from APC
+ *
+ * @param string $key
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Apc, readEntry){
+
+	zval *key = NULL, *apc_key = NULL, *data = NULL;
+	zval *t0 = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &key) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
 	PHALCON_ALLOC_ZVAL_MM(t0);
 	phalcon_read_property(&t0, this_ptr, SL("_suffix"), PH_NOISY_CC);
-	PHALCON_INIT_VAR(key);
-	PHALCON_CONCAT_SV(key, "$PMM$", t0);
+	
+	PHALCON_INIT_VAR(apc_key);
+	PHALCON_CONCAT_SVSV(apc_key, "$PMM$", t0, "$", key);
 	
 	PHALCON_INIT_VAR(data);
-	PHALCON_CALL_FUNC_PARAMS_1(data, "apc_fetch", key);
+	PHALCON_CALL_FUNC_PARAMS_1(data, "apc_fetch", apc_key);
 	if (Z_TYPE_P(data) == IS_ARRAY) { 
 		
 		RETURN_CCTOR(data);
 	}
 	
-	PHALCON_ALLOC_ZVAL_MM(a0);
-	array_init(a0);
-	
-	RETURN_CTOR(a0);
+	PHALCON_MM_RESTORE();
+	RETURN_NULL();
 }
 
 /**
- * Writes the meta-data to APC
+ * Writes the meta-data of a single table to APC
  *
+ * @param string $key
  * @param array $data
+ * @return boolean
  */
-PHP_METHOD(Phalcon_Mvc_Model_MetaData_Apc, write){
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Apc, writeEntry){
 
-	zval *data = NULL, *key = NULL;
+	zval *key = NULL, *data = NULL, *apc_key = NULL, *success = NULL;
 	zval *t0 = NULL, *t1 = NULL;
 
 	PHALCON_MM_GROW();
 	
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &data) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz", &key, &data) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
 
 	PHALCON_ALLOC_ZVAL_MM(t0);
 	phalcon_read_property(&t0, this_ptr, SL("_suffix"), PH_NOISY_CC);
-	PHALCON_INIT_VAR(key);
-	PHALCON_CONCAT_SV(key, "$PMM$", t0);
+	
+	PHALCON_INIT_VAR(apc_key);
+	PHALCON_CONCAT_SVSV(apc_key, "$PMM$", t0, "$", key);
 	
 	PHALCON_ALLOC_ZVAL_MM(t1);
 	phalcon_read_property(&t1, this_ptr, SL("_ttl"), PH_NOISY_CC);
-	PHALCON_CALL_FUNC_PARAMS_3_NORETURN("apc_store", key, data, t1);
 	
-	PHALCON_MM_RESTORE();
+	PHALCON_INIT_VAR(success);
+	PHALCON_CALL_FUNC_PARAMS_3(success, "apc_store", apc_key, data, t1);
+	
+	RETURN_CCTOR(success);
+}
+
+/**
+ * Acquires the lock to introspect a table. apc_add() only succeeds in one process,
+ * the lock expires by itself if the process holding it dies
+ *
+ * @param string $key
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Apc, lockEntry){
+
+	zval *key = NULL, *lock_key = NULL, *success = NULL;
+	zval *t0 = NULL;
+	zval *c0 = NULL, *c1 = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &key) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_ALLOC_ZVAL_MM(t0);
+	phalcon_read_property(&t0, this_ptr, SL("_suffix"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(lock_key);
+	PHALCON_CONCAT_SVSVS(lock_key, "$PMM$", t0, "$", key, "$lock");
+	
+	PHALCON_INIT_VAR(c0);
+	ZVAL_BOOL(c0, 1);
+	
+	PHALCON_INIT_VAR(c1);
+	ZVAL_LONG(c1, 10);
+	
+	PHALCON_INIT_VAR(success);
+	PHALCON_CALL_FUNC_PARAMS_3(success, "apc_add", lock_key, c0, c1);
+	
+	RETURN_CCTOR(success);
 }
 
+/**
+ * Releases the lock acquired by lockEntry()
+ *
+ * @param string $key
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Apc, unlockEntry){
+
+	zval *key = NULL, *lock_key = NULL;
+	zval *t0 = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &key) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_ALLOC_ZVAL_MM(t0);
+	phalcon_read_property(&t0, this_ptr, SL("_suffix"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(lock_key);
+	PHALCON_CONCAT_SVSVS(lock_key, "$PMM$", t0, "$", key, "$lock");
+	PHALCON_CALL_FUNC_PARAMS_1_NORETURN("apc_delete", lock_key);
+	
+	PHALCON_MM_RESTORE();
+}
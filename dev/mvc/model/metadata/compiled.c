@@ -0,0 +1,731 @@
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_phalcon.h"
+#include "phalcon.h"
+
+#include "Zend/zend_operators.h"
+#include "Zend/zend_exceptions.h"
+#include "Zend/zend_interfaces.h"
+
+#include "kernel/main.h"
+#include "kernel/memory.h"
+
+#include "kernel/array.h"
+#include "kernel/object.h"
+#include "kernel/concat.h"
+#include "kernel/fcall.h"
+#include "kernel/exception.h"
+
+#include "ext/standard/php_var.h"
+#include "ext/standard/php_smart_str.h"
+#include "ext/standard/flock_compat.h"
+
+#include <fcntl.h>
+
+#ifndef PHP_WIN32
+#include <sys/mman.h>
+#include <sys/file.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+/**
+ * Phalcon\Mvc\Model\MetaData\Compiled
+ *
+ * Reads model meta-data from a precompiled file mapped in memory. The file is mapped once per process
+ * and only the table requested by a model is decoded, so hundreds of tables don't add any cost to the
+ * requests not using them. The file is generated at deploy time with compile(), tables introspected later
+ * by a request are merged into it and the file is replaced at once, readers never see a partial file.
+ * Writers hold an exclusive lock on the file path.lock, so concurrent requests don't lose each other's tables
+ *
+ *<code>
+ * $metaData = new Phalcon\Mvc\Model\MetaData\Compiled(array(
+ *     'metaDataFile' => '../app/cache/metadata.bin'
+ * ));
+ *</code>
+ *
+ * The file starts with a header (magic "PMMC", version, number of tables) followed by an index sorted
+ * by table key pointing to the serialized meta-data of every table. Integers use the native byte order
+ */
+
+#define PHALCON_METADATA_MAGIC "PMMC"
+#define PHALCON_METADATA_VERSION 1
+
+typedef struct _phalcon_metadata_header {
+	char magic[4];
+	zend_uint version;
+	zend_uint count;
+	zend_uint reserved;
+} phalcon_metadata_header;
+
+typedef struct _phalcon_metadata_index {
+	zend_uint key_offset;
+	zend_uint key_length;
+	zend_uint data_offset;
+	zend_uint data_length;
+} phalcon_metadata_index;
+
+typedef struct _phalcon_metadata_map {
+	char *address;
+	size_t size;
+	ulong generation;
+	dev_t device;
+	ino_t inode;
+	time_t mtime;
+} phalcon_metadata_map;
+
+typedef struct _phalcon_metadata_entry {
+	char *key;
+	uint key_length;
+	smart_str data;
+} phalcon_metadata_entry;
+
+/**
+ * Releases the memory used by a mapped file
+ */
+static void phalcon_metadata_unmap(phalcon_metadata_map *map){
+	if (map->address) {
+		#ifndef PHP_WIN32
+		munmap(map->address, map->size);
+		#else
+		pefree(map->address, 1);
+		#endif
+		map->address = NULL;
+		map->size = 0;
+	}
+}
+
+/**
+ * Destructor for the files stored in the persistent maps table
+ */
+static void phalcon_metadata_map_dtor(void *data){
+	phalcon_metadata_unmap((phalcon_metadata_map *) data);
+}
+
+/**
+ * Maps a file in memory checking that its header and index are complete
+ */
+static int phalcon_metadata_map_file(phalcon_metadata_map *map, const char *path, size_t size){
+
+	phalcon_metadata_header *header;
+	int fd;
+
+	if (size < sizeof(phalcon_metadata_header)) {
+		return FAILURE;
+	}
+
+	fd = VCWD_OPEN(path, O_RDONLY | O_BINARY);
+	if (fd < 0) {
+		return FAILURE;
+	}
+
+	#ifndef PHP_WIN32
+	map->address = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map->address == MAP_FAILED) {
+		map->address = NULL;
+		return FAILURE;
+	}
+	#else
+	map->address = pemalloc(size, 1);
+	if (read(fd, map->address, size) != (int) size) {
+		close(fd);
+		pefree(map->address, 1);
+		map->address = NULL;
+		return FAILURE;
+	}
+	close(fd);
+	#endif
+
+	map->size = size;
+
+	header = (phalcon_metadata_header *) map->address;
+	if (memcmp(header->magic, PHALCON_METADATA_MAGIC, 4) || header->version != PHALCON_METADATA_VERSION || header->count > (size - sizeof(phalcon_metadata_header)) / sizeof(phalcon_metadata_index)) {
+		phalcon_metadata_unmap(map);
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * Returns the mapping of a meta-data file. The file is stat'ed again only when the function call cache
+ * generation changes, which happens when a request starts. A replaced file is mapped again by the next
+ * request of every process, the request in progress keeps reading the mapping it already has
+ */
+static phalcon_metadata_map *phalcon_metadata_get_map(const char *path, uint path_length TSRMLS_DC){
+
+	phalcon_metadata_map *map, new_map;
+	HashTable *maps;
+	struct stat st;
+
+	maps = PHALCON_GLOBAL(metadata_maps);
+	if (!maps) {
+		maps = (HashTable *) pemalloc(sizeof(HashTable), 1);
+		zend_hash_init(maps, 4, NULL, phalcon_metadata_map_dtor, 1);
+		PHALCON_GLOBAL(metadata_maps) = maps;
+	}
+
+	if (zend_hash_find(maps, path, path_length + 1, (void**) &map) == SUCCESS) {
+		if (map->generation == PHALCON_GLOBAL(fcall_generation)) {
+			return map;
+		}
+	} else {
+		map = NULL;
+	}
+
+	memset(&new_map, 0, sizeof(phalcon_metadata_map));
+	new_map.generation = PHALCON_GLOBAL(fcall_generation);
+
+	if (VCWD_STAT(path, &st) == 0) {
+		if (map && map->address && map->device == st.st_dev && map->inode == st.st_ino && map->mtime == st.st_mtime && map->size == (size_t) st.st_size) {
+			map->generation = new_map.generation;
+			return map;
+		}
+		new_map.device = st.st_dev;
+		new_map.inode = st.st_ino;
+		new_map.mtime = st.st_mtime;
+		phalcon_metadata_map_file(&new_map, path, (size_t) st.st_size);
+	}
+
+	/** Missing or invalid files are remembered until the generation changes */
+	zend_hash_update(maps, path, path_length + 1, &new_map, sizeof(phalcon_metadata_map), (void**) &map);
+	return map;
+}
+
+/**
+ * Looks up a table in the index of a mapped file using a binary search
+ */
+static int phalcon_metadata_map_find(phalcon_metadata_map *map, const char *key, uint key_length, const char **data, uint *data_length){
+
+	phalcon_metadata_header *header;
+	phalcon_metadata_index *index, *entry;
+	int low, high, middle, result;
+	uint length;
+
+	if (!map->address) {
+		return FAILURE;
+	}
+
+	header = (phalcon_metadata_header *) map->address;
+	index = (phalcon_metadata_index *) (map->address + sizeof(phalcon_metadata_header));
+
+	low = 0;
+	high = (int) header->count - 1;
+	while (low <= high) {
+
+		middle = low + (high - low) / 2;
+		entry = &index[middle];
+		if (entry->key_offset > map->size || entry->key_length > map->size - entry->key_offset) {
+			return FAILURE;
+		}
+
+		length = entry->key_length < key_length ? entry->key_length : key_length;
+		result = memcmp(map->address + entry->key_offset, key, length);
+		if (!result) {
+			result = (int) entry->key_length - (int) key_length;
+		}
+
+		if (!result) {
+			if (entry->data_offset > map->size || entry->data_length > map->size - entry->data_offset) {
+				return FAILURE;
+			}
+			*data = map->address + entry->data_offset;
+			*data_length = entry->data_length;
+			return SUCCESS;
+		}
+
+		if (result < 0) {
+			low = middle + 1;
+		} else {
+			high = middle - 1;
+		}
+	}
+
+	return FAILURE;
+}
+
+/**
+ * Adds the tables stored in a mapped file to the passed meta-data unless it already has them
+ */
+static void phalcon_metadata_map_merge(phalcon_metadata_map *map, HashTable *tables TSRMLS_DC){
+
+	phalcon_metadata_header *header;
+	phalcon_metadata_index *index, *entry;
+	php_unserialize_data_t var_hash;
+	const unsigned char *p;
+	char *key;
+	zval *table;
+	uint i;
+
+	if (!map->address) {
+		return;
+	}
+
+	header = (phalcon_metadata_header *) map->address;
+	index = (phalcon_metadata_index *) (map->address + sizeof(phalcon_metadata_header));
+
+	for (i = 0; i < header->count; i++) {
+
+		entry = &index[i];
+		if (entry->key_offset > map->size || entry->key_length > map->size - entry->key_offset) {
+			return;
+		}
+		if (entry->data_offset > map->size || entry->data_length > map->size - entry->data_offset) {
+			return;
+		}
+
+		key = estrndup(map->address + entry->key_offset, entry->key_length);
+		if (!zend_symtable_exists(tables, key, entry->key_length + 1)) {
+			ALLOC_INIT_ZVAL(table);
+			p = (const unsigned char *) map->address + entry->data_offset;
+			PHP_VAR_UNSERIALIZE_INIT(var_hash);
+			if (php_var_unserialize(&table, &p, p + entry->data_length, &var_hash TSRMLS_CC)) {
+				zend_symtable_update(tables, key, entry->key_length + 1, &table, sizeof(zval *), NULL);
+			} else {
+				zval_ptr_dtor(&table);
+			}
+			PHP_VAR_UNSERIALIZE_DESTROY(var_hash);
+		}
+		efree(key);
+	}
+}
+
+/**
+ * Orders the tables by key as the binary search expects
+ */
+static int phalcon_metadata_entry_compare(const void *a, const void *b){
+
+	const phalcon_metadata_entry *first = (const phalcon_metadata_entry *) a;
+	const phalcon_metadata_entry *second = (const phalcon_metadata_entry *) b;
+	uint length;
+	int result;
+
+	length = first->key_length < second->key_length ? first->key_length : second->key_length;
+	result = memcmp(first->key, second->key, length);
+	if (!result) {
+		result = (int) first->key_length - (int) second->key_length;
+	}
+
+	return result;
+}
+
+/**
+ * Takes the exclusive lock that serializes the writers of a compiled file, it returns -1 when the lock
+ * can't be taken
+ */
+static int phalcon_metadata_lock(const char *path){
+
+	char *lock_path;
+	int fd;
+
+	spprintf(&lock_path, 0, "%s.lock", path);
+	fd = VCWD_OPEN_MODE(lock_path, O_CREAT | O_RDWR | O_BINARY, 0666);
+	efree(lock_path);
+	if (fd < 0) {
+		return -1;
+	}
+
+	if (flock(fd, LOCK_EX)) {
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+/**
+ * Releases the lock taken by phalcon_metadata_lock()
+ */
+static void phalcon_metadata_unlock(int fd){
+	flock(fd, LOCK_UN);
+	close(fd);
+}
+
+/**
+ * Checks whether the passed meta-data has tables that are missing in a mapped file
+ */
+static int phalcon_metadata_map_missing(phalcon_metadata_map *map, HashTable *tables){
+
+	HashPosition pos;
+	zval **table;
+	char *str_index, *key;
+	const char *stored;
+	uint str_index_length, key_length, stored_length;
+	ulong num_index;
+	int missing = 0;
+
+	zend_hash_internal_pointer_reset_ex(tables, &pos);
+	while (!missing && zend_hash_get_current_data_ex(tables, (void**) &table, &pos) == SUCCESS) {
+		if (Z_TYPE_PP(table) == IS_ARRAY) {
+			if (zend_hash_get_current_key_ex(tables, &str_index, &str_index_length, &num_index, 0, &pos) == HASH_KEY_IS_STRING) {
+				missing = phalcon_metadata_map_find(map, str_index, str_index_length - 1, &stored, &stored_length) == FAILURE;
+			} else {
+				key_length = spprintf(&key, 0, "%ld", num_index);
+				missing = phalcon_metadata_map_find(map, key, key_length, &stored, &stored_length) == FAILURE;
+				efree(key);
+			}
+		}
+		zend_hash_move_forward_ex(tables, &pos);
+	}
+
+	return missing;
+}
+
+/**
+ * Writes the meta-data of every table to a temporary file that replaces the compiled file at once. The
+ * caller must hold the lock of the file, the temporary file is only used by one writer at a time
+ */
+static int phalcon_metadata_compile_file(const char *path, uint path_length, HashTable *tables TSRMLS_DC){
+
+	phalcon_metadata_entry *entries;
+	phalcon_metadata_header header;
+	phalcon_metadata_index *index;
+	php_serialize_data_t var_hash;
+	HashPosition pos;
+	zval **table;
+	char *str_index, *temp_path;
+	uint str_index_length, count, i, offset;
+	ulong num_index;
+	FILE *fp;
+	int status;
+
+	count = 0;
+	entries = ecalloc(zend_hash_num_elements(tables) + 1, sizeof(phalcon_metadata_entry));
+
+	PHP_VAR_SERIALIZE_INIT(var_hash);
+	zend_hash_internal_pointer_reset_ex(tables, &pos);
+	while (zend_hash_get_current_data_ex(tables, (void**) &table, &pos) == SUCCESS) {
+		if (Z_TYPE_PP(table) == IS_ARRAY) {
+			if (zend_hash_get_current_key_ex(tables, &str_index, &str_index_length, &num_index, 0, &pos) == HASH_KEY_IS_STRING) {
+				entries[count].key = estrndup(str_index, str_index_length - 1);
+				entries[count].key_length = str_index_length - 1;
+			} else {
+				entries[count].key_length = spprintf(&entries[count].key, 0, "%ld", num_index);
+			}
+			php_var_serialize(&entries[count].data, table, &var_hash TSRMLS_CC);
+			count++;
+		}
+		zend_hash_move_forward_ex(tables, &pos);
+	}
+	PHP_VAR_SERIALIZE_DESTROY(var_hash);
+
+	qsort(entries, count, sizeof(phalcon_metadata_entry), phalcon_metadata_entry_compare);
+
+	memcpy(header.magic, PHALCON_METADATA_MAGIC, 4);
+	header.version = PHALCON_METADATA_VERSION;
+	header.count = count;
+	header.reserved = 0;
+
+	index = ecalloc(count + 1, sizeof(phalcon_metadata_index));
+	offset = sizeof(phalcon_metadata_header) + count * sizeof(phalcon_metadata_index);
+	for (i = 0; i < count; i++) {
+		index[i].key_offset = offset;
+		index[i].key_length = entries[i].key_length;
+		offset += entries[i].key_length;
+		index[i].data_offset = offset;
+		index[i].data_length = entries[i].data.len;
+		offset += entries[i].data.len;
+	}
+
+	spprintf(&temp_path, 0, "%s.tmp", path);
+
+	status = FAILURE;
+	fp = VCWD_FOPEN(temp_path, "wb");
+	if (fp) {
+		status = SUCCESS;
+		if (fwrite(&header, sizeof(phalcon_metadata_header), 1, fp) != 1) {
+			status = FAILURE;
+		}
+		if (status == SUCCESS && count && fwrite(index, sizeof(phalcon_metadata_index), count, fp) != count) {
+			status = FAILURE;
+		}
+		for (i = 0; status == SUCCESS && i < count; i++) {
+			if (fwrite(entries[i].key, 1, entries[i].key_length, fp) != entries[i].key_length) {
+				status = FAILURE;
+			}
+			if (entries[i].data.len && fwrite(entries[i].data.c, 1, entries[i].data.len, fp) != entries[i].data.len) {
+				status = FAILURE;
+			}
+		}
+		if (fclose(fp)) {
+			status = FAILURE;
+		}
+		if (status == SUCCESS) {
+			#ifdef PHP_WIN32
+			VCWD_UNLINK(path);
+			#endif
+			if (VCWD_RENAME(temp_path, path)) {
+				status = FAILURE;
+			}
+		}
+		if (status == FAILURE) {
+			VCWD_UNLINK(temp_path);
+		}
+	}
+
+	for (i = 0; i < count; i++) {
+		efree(entries[i].key);
+		smart_str_free(&entries[i].data);
+	}
+	efree(entries);
+	efree(index);
+	efree(temp_path);
+
+	/** The next lookup maps the new file */
+	if (status == SUCCESS && PHALCON_GLOBAL(metadata_maps)) {
+		zend_hash_del(PHALCON_GLOBAL(metadata_maps), path, path_length + 1);
+	}
+
+	return status;
+}
+
+/**
+ * Phalcon\Mvc\Model\MetaData\Compiled constructor
+ *
+ * @param array $options
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Compiled, __construct){
+
+	zval *options = NULL, *meta_data_file = NULL;
+	int eval_int;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &options) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(options) != IS_ARRAY) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The options must be an array");
+		return;
+	}
+
+	eval_int = phalcon_array_isset_string(options, SL("metaDataFile")+1);
+	if (!eval_int) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The option 'metaDataFile' is required");
+		return;
+	}
+
+	PHALCON_INIT_VAR(meta_data_file);
+	phalcon_array_fetch_string(&meta_data_file, options, SL("metaDataFile"), PH_NOISY_CC);
+	if (Z_TYPE_P(meta_data_file) != IS_STRING || !Z_STRLEN_P(meta_data_file)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The option 'metaDataFile' must be a file path");
+		return;
+	}
+
+	phalcon_update_property_zval(this_ptr, SL("_metaDataFile"), meta_data_file TSRMLS_CC);
+	PHALCON_CALL_PARENT_NORETURN(this_ptr, "Phalcon\\Mvc\\Model\\MetaData\\Compiled", "__construct");
+
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Nothing is read in advance, the meta-data of every table is resolved by readEntry()
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Compiled, read){
+
+	zval *a0 = NULL;
+
+	PHALCON_MM_GROW();
+	PHALCON_ALLOC_ZVAL_MM(a0);
+	array_init(a0);
+
+	RETURN_CTOR(a0);
+}
+
+/**
+ * Reads the meta-data of a single table from the compiled file
+ *
+ * @param string $key
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Compiled, readEntry){
+
+	zval *key = NULL, *meta_data_file = NULL;
+	phalcon_metadata_map *map;
+	php_unserialize_data_t var_hash;
+	const unsigned char *p;
+	const char *data;
+	uint data_length;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &key) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(key) != IS_STRING) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_ALLOC_ZVAL_MM(meta_data_file);
+	phalcon_read_property(&meta_data_file, this_ptr, SL("_metaDataFile"), PH_NOISY_CC);
+	if (Z_TYPE_P(meta_data_file) != IS_STRING) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	map = phalcon_metadata_get_map(Z_STRVAL_P(meta_data_file), Z_STRLEN_P(meta_data_file) TSRMLS_CC);
+	if (phalcon_metadata_map_find(map, Z_STRVAL_P(key), Z_STRLEN_P(key), &data, &data_length) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	p = (const unsigned char *) data;
+	PHP_VAR_UNSERIALIZE_INIT(var_hash);
+	if (!php_var_unserialize(&return_value, &p, p + data_length, &var_hash TSRMLS_CC)) {
+		PHP_VAR_UNSERIALIZE_DESTROY(var_hash);
+		zval_dtor(return_value);
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+	PHP_VAR_UNSERIALIZE_DESTROY(var_hash);
+
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Merges the tables introspected by the request that are missing in the compiled file and replaces it.
+ * Nothing is written when the file already has every table. The file is checked again after taking the
+ * lock, a file replaced by another request in the meantime is merged instead of being overwritten
+ *
+ * @param array $data
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Compiled, write){
+
+	zval *data = NULL, *meta_data_file = NULL, *merged;
+	phalcon_metadata_map *map;
+	int fd;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &data) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_ALLOC_ZVAL_MM(meta_data_file);
+	phalcon_read_property(&meta_data_file, this_ptr, SL("_metaDataFile"), PH_NOISY_CC);
+	if (Z_TYPE_P(data) != IS_ARRAY || Z_TYPE_P(meta_data_file) != IS_STRING) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	map = phalcon_metadata_get_map(Z_STRVAL_P(meta_data_file), Z_STRLEN_P(meta_data_file) TSRMLS_CC);
+	if (!phalcon_metadata_map_missing(map, Z_ARRVAL_P(data))) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	/** Requests that can't take the lock keep their meta-data in memory only */
+	fd = phalcon_metadata_lock(Z_STRVAL_P(meta_data_file));
+	if (fd < 0) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	/** The file is stat'ed again, the mapping of the current request could be outdated */
+	zend_hash_del(PHALCON_GLOBAL(metadata_maps), Z_STRVAL_P(meta_data_file), Z_STRLEN_P(meta_data_file) + 1);
+	map = phalcon_metadata_get_map(Z_STRVAL_P(meta_data_file), Z_STRLEN_P(meta_data_file) TSRMLS_CC);
+	if (phalcon_metadata_map_missing(map, Z_ARRVAL_P(data))) {
+		ALLOC_INIT_ZVAL(merged);
+		array_init(merged);
+		zend_hash_copy(Z_ARRVAL_P(merged), Z_ARRVAL_P(data), (copy_ctor_func_t) zval_add_ref, NULL, sizeof(zval *));
+		phalcon_metadata_map_merge(map, Z_ARRVAL_P(merged) TSRMLS_CC);
+		phalcon_metadata_compile_file(Z_STRVAL_P(meta_data_file), Z_STRLEN_P(meta_data_file), Z_ARRVAL_P(merged) TSRMLS_CC);
+		zval_ptr_dtor(&merged);
+	}
+
+	phalcon_metadata_unlock(fd);
+
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Generates the compiled file from the passed meta-data or the meta-data loaded by this adapter.
+ * This is intended to be called at deploy time, after introspecting every model
+ *
+ *<code>
+ * foreach ($models as $model) {
+ *     $metaData->getAttributes($model);
+ * }
+ * $metaData->compile();
+ *</code>
+ *
+ * @param array $data
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Compiled, compile){
+
+	zval *data = NULL, *meta_data_file = NULL, *exception_message = NULL;
+	zval *i0 = NULL;
+	int fd, status;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|z", &data) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (!data || Z_TYPE_P(data) == IS_NULL) {
+		PHALCON_ALLOC_ZVAL_MM(data);
+		phalcon_read_property(&data, this_ptr, SL("_metaData"), PH_NOISY_CC);
+	}
+
+	if (Z_TYPE_P(data) != IS_ARRAY) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The meta-data to compile must be an array");
+		return;
+	}
+
+	PHALCON_ALLOC_ZVAL_MM(meta_data_file);
+	phalcon_read_property(&meta_data_file, this_ptr, SL("_metaDataFile"), PH_NOISY_CC);
+
+	status = FAILURE;
+	fd = phalcon_metadata_lock(Z_STRVAL_P(meta_data_file));
+	if (fd >= 0) {
+		status = phalcon_metadata_compile_file(Z_STRVAL_P(meta_data_file), Z_STRLEN_P(meta_data_file), Z_ARRVAL_P(data) TSRMLS_CC);
+		phalcon_metadata_unlock(fd);
+	}
+
+	if (status == FAILURE) {
+		PHALCON_INIT_VAR(exception_message);
+		PHALCON_CONCAT_SVS(exception_message, "Meta-data file '", meta_data_file, "' cannot be written");
+
+		PHALCON_ALLOC_ZVAL_MM(i0);
+		object_init_ex(i0, phalcon_mvc_model_exception_ce);
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(i0, "__construct", exception_message, PH_CHECK);
+		phalcon_throw_exception(i0 TSRMLS_CC);
+		return;
+	}
+
+	PHALCON_MM_RESTORE();
+}
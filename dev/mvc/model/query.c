@@ -39,22 +39,1178 @@
 #include "kernel/concat.h"
 #include "kernel/operators.h"
 
+#include "ext/standard/php_smart_str.h"
+
+#include "mvc/model/query/scanner.h"
+#include "mvc/model/query/lang.h"
+
+/**
+ * Destructor for the statements and plans stored in the persistent PHQL caches
+ */
+static void phalcon_mvc_model_query_cache_dtor(void *data){
+	zval **plan = (zval **) data;
+	phalcon_persistent_free(*plan);
+}
+
+/**
+ * Throws a Phalcon\Mvc\Model\Exception with a message allocated by spprintf
+ */
+static int phalcon_mvc_model_query_throw(char *message TSRMLS_DC){
+	phalcon_throw_exception_string(phalcon_mvc_model_exception_ce, message, strlen(message) TSRMLS_CC);
+	efree(message);
+	return FAILURE;
+}
+
+/**
+ * Returns a member of a node of the intermediate representation, NULL if it isn't present
+ */
+static zval *phalcon_mvc_model_query_node(zval *node, char *key, uint key_length){
+
+	zval **value;
+
+	if (node && Z_TYPE_P(node) == IS_ARRAY) {
+		if (zend_hash_find(Z_ARRVAL_P(node), key, key_length, (void**) &value) == SUCCESS) {
+			return *value;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Returns the type of a node of the intermediate representation
+ */
+static long phalcon_mvc_model_query_type(zval *node){
+
+	zval *type;
+
+	type = phalcon_mvc_model_query_node(node, SS("type"));
+	if (type && Z_TYPE_P(type) == IS_LONG) {
+		return Z_LVAL_P(type);
+	}
+
+	return 0;
+}
+
+/**
+ * The parser returns lists with only one element as the element itself, this copies both forms into a list
+ */
+static void phalcon_mvc_model_query_items(zval *items, zval *node){
+
+	zval **item;
+	HashPosition pos;
+
+	array_init(items);
+	if (!node || Z_TYPE_P(node) != IS_ARRAY) {
+		return;
+	}
+
+	if (zend_hash_index_exists(Z_ARRVAL_P(node), 0)) {
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(node), &pos);
+		while (zend_hash_get_current_data_ex(Z_ARRVAL_P(node), (void**) &item, &pos) == SUCCESS) {
+			Z_ADDREF_PP(item);
+			add_next_index_zval(items, *item);
+			zend_hash_move_forward_ex(Z_ARRVAL_P(node), &pos);
+		}
+	} else {
+		Z_ADDREF_P(node);
+		add_next_index_zval(items, node);
+	}
+}
+
+/**
+ * Returns the alias of a model in the statement, models without an explicit alias are referenced by their name
+ */
+static zval *phalcon_mvc_model_query_alias(zval *associated_name, zval *qualified_name){
+
+	zval *alias;
+
+	alias = phalcon_mvc_model_query_node(associated_name, SS("alias"));
+	if (alias && Z_TYPE_P(alias) == IS_STRING) {
+		return alias;
+	}
+
+	return phalcon_mvc_model_query_node(qualified_name, SS("name"));
+}
+
+/**
+ * Adds a model referenced by the statement to the references indexed by its alias
+ */
+static int phalcon_mvc_model_query_add_reference(zval *references, zval *associated_name, zval *qualified_name TSRMLS_DC){
+
+	zval *name, *alias;
+	char *message;
+
+	name = phalcon_mvc_model_query_node(qualified_name, SS("name"));
+	alias = phalcon_mvc_model_query_alias(associated_name, qualified_name);
+	if (!name || Z_TYPE_P(name) != IS_STRING || !alias) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Corrupted PHQL intermediate representation");
+		return FAILURE;
+	}
+
+	if (zend_hash_exists(Z_ARRVAL_P(references), Z_STRVAL_P(alias), Z_STRLEN_P(alias) + 1)) {
+		spprintf(&message, 0, "The alias '%s' is used more than once in the statement", Z_STRVAL_P(alias));
+		return phalcon_mvc_model_query_throw(message TSRMLS_CC);
+	}
+
+	add_assoc_stringl_ex(references, Z_STRVAL_P(alias), Z_STRLEN_P(alias) + 1, Z_STRVAL_P(name), Z_STRLEN_P(name), 1);
+	return SUCCESS;
+}
+
+/**
+ * Collects the models referenced by a statement indexed by their aliases
+ */
+static int phalcon_mvc_model_query_references(zval *references, zval *ast TSRMLS_DC){
+
+	zval *clause, *tables, *joins, *join, *items, **item;
+	HashPosition pos;
+	int status = SUCCESS;
+
+	array_init(references);
+
+	switch (phalcon_mvc_model_query_type(ast)) {
+
+		case PHQL_T_SELECT:
+			clause = phalcon_mvc_model_query_node(ast, SS("select"));
+			tables = phalcon_mvc_model_query_node(clause, SS("tables"));
+			joins = phalcon_mvc_model_query_node(clause, SS("joins"));
+
+			ALLOC_INIT_ZVAL(items);
+			phalcon_mvc_model_query_items(items, tables);
+			zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(items), &pos);
+			while (status == SUCCESS && zend_hash_get_current_data_ex(Z_ARRVAL_P(items), (void**) &item, &pos) == SUCCESS) {
+				status = phalcon_mvc_model_query_add_reference(references, *item, phalcon_mvc_model_query_node(*item, SS("qualifiedName")) TSRMLS_CC);
+				zend_hash_move_forward_ex(Z_ARRVAL_P(items), &pos);
+			}
+			zval_ptr_dtor(&items);
+
+			if (status == SUCCESS && joins) {
+				ALLOC_INIT_ZVAL(items);
+				phalcon_mvc_model_query_items(items, joins);
+				zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(items), &pos);
+				while (status == SUCCESS && zend_hash_get_current_data_ex(Z_ARRVAL_P(items), (void**) &item, &pos) == SUCCESS) {
+					join = phalcon_mvc_model_query_node(*item, SS("join"));
+					status = phalcon_mvc_model_query_add_reference(references, *item, phalcon_mvc_model_query_node(join, SS("qualifiedName")) TSRMLS_CC);
+					zend_hash_move_forward_ex(Z_ARRVAL_P(items), &pos);
+				}
+				zval_ptr_dtor(&items);
+			}
+			break;
+
+		case PHQL_T_INSERT:
+			status = phalcon_mvc_model_query_add_reference(references, NULL, phalcon_mvc_model_query_node(ast, SS("qualifiedName")) TSRMLS_CC);
+			break;
+
+		case PHQL_T_UPDATE:
+		case PHQL_T_DELETE:
+			clause = phalcon_mvc_model_query_node(ast, phalcon_mvc_model_query_type(ast) == PHQL_T_UPDATE ? "update" : "delete", sizeof("update"));
+			tables = phalcon_mvc_model_query_node(clause, SS("tables"));
+			status = phalcon_mvc_model_query_add_reference(references, tables, phalcon_mvc_model_query_node(tables, SS("qualifiedName")) TSRMLS_CC);
+			break;
+
+		default:
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Unknown PHQL statement");
+			return FAILURE;
+	}
+
+	return status;
+}
+
+/**
+ * Appends the result of a method of the dialect that receives a string. Identifiers and literals are escaped
+ * by the dialect of the connection, so every database system receives them quoted its own way
+ */
+static int phalcon_mvc_model_query_dialect(smart_str *sql, zval *dialect, char *method, uint method_length, char *str, uint str_length TSRMLS_DC){
+
+	zval *param, *escaped = NULL;
+
+	ALLOC_INIT_ZVAL(param);
+	ZVAL_STRINGL(param, str, str_length, 1);
+	zend_call_method(&dialect, Z_OBJCE_P(dialect), NULL, method, method_length, &escaped, 1, param, NULL TSRMLS_CC);
+	zval_ptr_dtor(&param);
+
+	/** Exceptions thrown by the dialect leave the memory stack like the ones thrown by the helpers */
+	if (!escaped || EG(exception)) {
+		if (escaped) {
+			zval_ptr_dtor(&escaped);
+		}
+		phalcon_memory_restore_stack(TSRMLS_C);
+		return FAILURE;
+	}
+
+	if (Z_TYPE_P(escaped) == IS_STRING) {
+		smart_str_appendl(sql, Z_STRVAL_P(escaped), Z_STRLEN_P(escaped));
+	}
+	zval_ptr_dtor(&escaped);
+
+	return SUCCESS;
+}
+
+/**
+ * Appends an identifier quoted by the dialect
+ */
+static int phalcon_mvc_model_query_escape(smart_str *sql, zval *dialect, char *str, uint str_length TSRMLS_DC){
+	return phalcon_mvc_model_query_dialect(sql, dialect, SL("escape"), str, str_length TSRMLS_CC);
+}
+
+/**
+ * Appends the table of a model, qualified by its schema, followed by the alias used in the statement
+ */
+static int phalcon_mvc_model_query_table(smart_str *sql, zval *dialect, zval *definition, zval *alias TSRMLS_DC){
+
+	zval *schema, *source;
+
+	schema = phalcon_mvc_model_query_node(definition, SS("schema"));
+	if (schema && Z_TYPE_P(schema) == IS_STRING && Z_STRLEN_P(schema)) {
+		if (phalcon_mvc_model_query_escape(sql, dialect, Z_STRVAL_P(schema), Z_STRLEN_P(schema) TSRMLS_CC) == FAILURE) {
+			return FAILURE;
+		}
+		smart_str_appendc(sql, '.');
+	}
+
+	source = phalcon_mvc_model_query_node(definition, SS("source"));
+	if (!source || Z_TYPE_P(source) != IS_STRING) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Corrupted PHQL intermediate representation");
+		return FAILURE;
+	}
+	if (phalcon_mvc_model_query_escape(sql, dialect, Z_STRVAL_P(source), Z_STRLEN_P(source) TSRMLS_CC) == FAILURE) {
+		return FAILURE;
+	}
+
+	if (alias) {
+		smart_str_appendl(sql, " AS ", 4);
+		return phalcon_mvc_model_query_escape(sql, dialect, Z_STRVAL_P(alias), Z_STRLEN_P(alias) TSRMLS_CC);
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * Appends a column to the SQL. Columns without a model alias are searched in every model of the statement
+ */
+static int phalcon_mvc_model_query_column(smart_str *sql, zval *column, zval *sources, zval *dialect, int qualify TSRMLS_DC){
+
+	zval *name, *domain, *attributes;
+	zval **definition;
+	char *message, *alias = NULL;
+	uint alias_length = 0, key_length;
+	ulong num_index;
+	HashPosition pos;
+	int matches = 0;
+
+	name = phalcon_mvc_model_query_node(column, SS("name"));
+	if (!name || Z_TYPE_P(name) != IS_STRING) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Corrupted PHQL intermediate representation");
+		return FAILURE;
+	}
+
+	domain = phalcon_mvc_model_query_node(column, SS("domain"));
+	if (domain && Z_TYPE_P(domain) == IS_STRING) {
+		if (zend_hash_find(Z_ARRVAL_P(sources), Z_STRVAL_P(domain), Z_STRLEN_P(domain) + 1, (void**) &definition) != SUCCESS) {
+			spprintf(&message, 0, "Unknown model or alias '%s' in column '%s.%s'", Z_STRVAL_P(domain), Z_STRVAL_P(domain), Z_STRVAL_P(name));
+			return phalcon_mvc_model_query_throw(message TSRMLS_CC);
+		}
+		attributes = phalcon_mvc_model_query_node(*definition, SS("attributes"));
+		if (!attributes || !zend_hash_exists(Z_ARRVAL_P(attributes), Z_STRVAL_P(name), Z_STRLEN_P(name) + 1)) {
+			spprintf(&message, 0, "Column '%s' doesn't belong to the model or alias '%s'", Z_STRVAL_P(name), Z_STRVAL_P(domain));
+			return phalcon_mvc_model_query_throw(message TSRMLS_CC);
+		}
+		alias = Z_STRVAL_P(domain);
+		alias_length = Z_STRLEN_P(domain);
+	} else {
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(sources), &pos);
+		while (zend_hash_get_current_data_ex(Z_ARRVAL_P(sources), (void**) &definition, &pos) == SUCCESS) {
+			attributes = phalcon_mvc_model_query_node(*definition, SS("attributes"));
+			if (attributes && zend_hash_exists(Z_ARRVAL_P(attributes), Z_STRVAL_P(name), Z_STRLEN_P(name) + 1)) {
+				if (zend_hash_get_current_key_ex(Z_ARRVAL_P(sources), &alias, &key_length, &num_index, 0, &pos) == HASH_KEY_IS_STRING) {
+					alias_length = key_length - 1;
+					matches++;
+				}
+			}
+			zend_hash_move_forward_ex(Z_ARRVAL_P(sources), &pos);
+		}
+		if (!matches) {
+			spprintf(&message, 0, "Column '%s' doesn't belong to any of the models in the statement", Z_STRVAL_P(name));
+			return phalcon_mvc_model_query_throw(message TSRMLS_CC);
+		}
+		if (matches > 1) {
+			spprintf(&message, 0, "The column '%s' is ambiguous, it must be qualified with the alias of its model", Z_STRVAL_P(name));
+			return phalcon_mvc_model_query_throw(message TSRMLS_CC);
+		}
+	}
+
+	if (qualify) {
+		if (phalcon_mvc_model_query_escape(sql, dialect, alias, alias_length TSRMLS_CC) == FAILURE) {
+			return FAILURE;
+		}
+		smart_str_appendc(sql, '.');
+	}
+
+	return phalcon_mvc_model_query_escape(sql, dialect, Z_STRVAL_P(name), Z_STRLEN_P(name) TSRMLS_CC);
+}
+
+/**
+ * Appends a string literal. PHQL strings escape quotes and backslashes with a backslash, the value is
+ * unescaped and quoted again by the dialect, which doubles or escapes them as its database system expects
+ */
+static int phalcon_mvc_model_query_string(smart_str *sql, zval *value, zval *dialect TSRMLS_DC){
+
+	smart_str literal = {0};
+	char *cursor, *end;
+	int status;
+
+	if (value && Z_TYPE_P(value) == IS_STRING) {
+		cursor = Z_STRVAL_P(value);
+		end = cursor + Z_STRLEN_P(value);
+		for (; cursor < end; cursor++) {
+			/** Other sequences, like \_ in the patterns of LIKE, are kept as they are */
+			if (*cursor == '\\' && cursor + 1 < end && (cursor[1] == '\'' || cursor[1] == '"' || cursor[1] == '\\')) {
+				cursor++;
+			}
+			smart_str_appendc(&literal, *cursor);
+		}
+	}
+	smart_str_0(&literal);
+
+	status = phalcon_mvc_model_query_dialect(sql, dialect, SL("escapestring"), literal.c ? literal.c : "", literal.len TSRMLS_CC);
+	smart_str_free(&literal);
+
+	return status;
+}
+
+static int phalcon_mvc_model_query_expr(smart_str *sql, zval *expr, zval *sources, zval *dialect, int qualify TSRMLS_DC);
+
+/**
+ * Appends a list of expressions separated by commas
+ */
+static int phalcon_mvc_model_query_expr_list(smart_str *sql, zval *list, zval *sources, zval *dialect, int qualify TSRMLS_DC){
+
+	zval *items, **item;
+	HashPosition pos;
+	int status = SUCCESS, first = 1;
+
+	ALLOC_INIT_ZVAL(items);
+	phalcon_mvc_model_query_items(items, list);
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(items), &pos);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(items), (void**) &item, &pos) == SUCCESS) {
+		if (!first) {
+			smart_str_appendl(sql, ", ", 2);
+		}
+		first = 0;
+		status = phalcon_mvc_model_query_expr(sql, *item, sources, dialect, qualify TSRMLS_CC);
+		if (status == FAILURE) {
+			break;
+		}
+		zend_hash_move_forward_ex(Z_ARRVAL_P(items), &pos);
+	}
+
+	zval_ptr_dtor(&items);
+	return status;
+}
+
+/**
+ * Appends the SQL of an expression, columns are resolved using the models of the statement
+ */
+static int phalcon_mvc_model_query_expr(smart_str *sql, zval *expr, zval *sources, zval *dialect, int qualify TSRMLS_DC){
+
+	zval *left, *right, *value, *arguments;
+	char *message, *op;
+	long type;
+
+	left = phalcon_mvc_model_query_node(expr, SS("left"));
+	right = phalcon_mvc_model_query_node(expr, SS("right"));
+
+	type = phalcon_mvc_model_query_type(expr);
+	switch (type) {
+
+		case PHQL_T_QUALIFIED:
+			return phalcon_mvc_model_query_column(sql, expr, sources, dialect, qualify TSRMLS_CC);
+
+		case PHQL_T_INTEGER:
+		case PHQL_T_DOUBLE:
+			value = phalcon_mvc_model_query_node(expr, SS("value"));
+			if (value && Z_TYPE_P(value) == IS_STRING) {
+				smart_str_appendl(sql, Z_STRVAL_P(value), Z_STRLEN_P(value));
+			}
+			return SUCCESS;
+
+		case PHQL_T_STRING:
+			return phalcon_mvc_model_query_string(sql, phalcon_mvc_model_query_node(expr, SS("value")), dialect TSRMLS_CC);
+
+		case PHQL_T_NULL:
+			smart_str_appendl(sql, "NULL", 4);
+			return SUCCESS;
+
+		case PHQL_T_ALL:
+			smart_str_appendc(sql, '*');
+			return SUCCESS;
+
+		/** Placeholders are passed as they are to Phalcon\Db\Adapter\Pdo::query */
+		case PHQL_T_NPLACEHOLDER:
+			value = phalcon_mvc_model_query_node(expr, SS("value"));
+			if (value && Z_TYPE_P(value) == IS_STRING) {
+				if (Z_STRVAL_P(value)[0] != '?') {
+					smart_str_appendc(sql, '?');
+				}
+				smart_str_appendl(sql, Z_STRVAL_P(value), Z_STRLEN_P(value));
+			}
+			return SUCCESS;
+
+		case PHQL_T_SPLACEHOLDER:
+			value = phalcon_mvc_model_query_node(expr, SS("value"));
+			if (value && Z_TYPE_P(value) == IS_STRING) {
+				smart_str_appendc(sql, ':');
+				smart_str_appendl(sql, Z_STRVAL_P(value) + (Z_STRVAL_P(value)[0] == ':'), Z_STRLEN_P(value) - (Z_STRVAL_P(value)[0] == ':'));
+				if (Z_STRLEN_P(value) < 1 || Z_STRVAL_P(value)[Z_STRLEN_P(value) - 1] != ':') {
+					smart_str_appendc(sql, ':');
+				}
+			}
+			return SUCCESS;
+
+		case PHQL_T_FCALL:
+			value = phalcon_mvc_model_query_node(expr, SS("name"));
+			if (!value || Z_TYPE_P(value) != IS_STRING) {
+				break;
+			}
+			smart_str_appendl(sql, Z_STRVAL_P(value), Z_STRLEN_P(value));
+			smart_str_appendc(sql, '(');
+			arguments = phalcon_mvc_model_query_node(expr, SS("arguments"));
+			if (arguments) {
+				if (phalcon_mvc_model_query_expr_list(sql, arguments, sources, dialect, qualify TSRMLS_CC) == FAILURE) {
+					return FAILURE;
+				}
+			}
+			smart_str_appendc(sql, ')');
+			return SUCCESS;
+
+		case PHQL_T_ENCLOSED:
+			if (!left) {
+				break;
+			}
+			smart_str_appendc(sql, '(');
+			if (phalcon_mvc_model_query_expr(sql, left, sources, dialect, qualify TSRMLS_CC) == FAILURE) {
+				return FAILURE;
+			}
+			smart_str_appendc(sql, ')');
+			return SUCCESS;
+
+		case PHQL_T_NOT:
+			if (!right) {
+				break;
+			}
+			smart_str_appendl(sql, "NOT ", 4);
+			return phalcon_mvc_model_query_expr(sql, right, sources, dialect, qualify TSRMLS_CC);
+
+		case PHQL_T_ISNULL:
+		case PHQL_T_ISNOTNULL:
+			if (!right) {
+				break;
+			}
+			if (phalcon_mvc_model_query_expr(sql, right, sources, dialect, qualify TSRMLS_CC) == FAILURE) {
+				return FAILURE;
+			}
+			if (type == PHQL_T_ISNULL) {
+				smart_str_appendl(sql, " IS NULL", 8);
+			} else {
+				smart_str_appendl(sql, " IS NOT NULL", 12);
+			}
+			return SUCCESS;
+
+		case PHQL_T_IN:
+			if (!left || !right) {
+				break;
+			}
+			if (phalcon_mvc_model_query_expr(sql, left, sources, dialect, qualify TSRMLS_CC) == FAILURE) {
+				return FAILURE;
+			}
+			smart_str_appendl(sql, " IN (", 5);
+			if (phalcon_mvc_model_query_expr_list(sql, right, sources, dialect, qualify TSRMLS_CC) == FAILURE) {
+				return FAILURE;
+			}
+			smart_str_appendc(sql, ')');
+			return SUCCESS;
+
+		default:
+			switch (type) {
+				case PHQL_T_ADD:
+					op = " + ";
+					break;
+				case PHQL_T_SUB:
+					op = " - ";
+					break;
+				case PHQL_T_MUL:
+					op = " * ";
+					break;
+				case PHQL_T_DIV:
+					op = " / ";
+					break;
+				case PHQL_T_AND:
+					op = " AND ";
+					break;
+				case PHQL_T_OR:
+					op = " OR ";
+					break;
+				case PHQL_T_EQUALS:
+					op = " = ";
+					break;
+				case PHQL_T_NOTEQUALS:
+					op = " <> ";
+					break;
+				case PHQL_T_LESS:
+					op = " < ";
+					break;
+				case PHQL_T_LESSEQUAL:
+					op = " <= ";
+					break;
+				case PHQL_T_GREATER:
+					op = " > ";
+					break;
+				case PHQL_T_GREATEREQUAL:
+					op = " >= ";
+					break;
+				case PHQL_T_LIKE:
+					op = " LIKE ";
+					break;
+				case PHQL_T_NLIKE:
+					op = " NOT LIKE ";
+					break;
+				default:
+					spprintf(&message, 0, "Unknown PHQL expression type %ld", type);
+					return phalcon_mvc_model_query_throw(message TSRMLS_CC);
+			}
+			if (!left || !right) {
+				break;
+			}
+			if (phalcon_mvc_model_query_expr(sql, left, sources, dialect, qualify TSRMLS_CC) == FAILURE) {
+				return FAILURE;
+			}
+			smart_str_appends(sql, op);
+			return phalcon_mvc_model_query_expr(sql, right, sources, dialect, qualify TSRMLS_CC);
+	}
+
+	PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Corrupted PHQL intermediate representation");
+	return FAILURE;
+}
+
+/**
+ * Registers the position of a column of the select list in the column map. Two columns with the same name
+ * would be hydrated into the same attribute, they must be told apart by an alias
+ */
+static int phalcon_mvc_model_query_map_column(zval *column_map, char *name, uint name_length, long position TSRMLS_DC){
+
+	char *message;
+
+	if (zend_symtable_exists(Z_ARRVAL_P(column_map), name, name_length + 1)) {
+		spprintf(&message, 0, "The column '%s' is ambiguous in the select list, it must have an alias", name);
+		return phalcon_mvc_model_query_throw(message TSRMLS_CC);
+	}
+
+	add_assoc_long_ex(column_map, name, name_length + 1, position);
+	return SUCCESS;
+}
+
+/**
+ * Appends every attribute of a model to the select list registering its position in the column map. When the
+ * columns of several models are selected the attributes are registered as alias.attribute
+ */
+static int phalcon_mvc_model_query_all_columns(smart_str *sql, char *alias, uint alias_length, zval *definition, zval *dialect, zval *column_map, long *position, int prefixed TSRMLS_DC){
+
+	zval *attributes;
+	char *key, *name;
+	uint key_length, name_length;
+	ulong num_index;
+	HashPosition pos;
+	int status;
+
+	attributes = phalcon_mvc_model_query_node(definition, SS("attributes"));
+	if (!attributes || Z_TYPE_P(attributes) != IS_ARRAY) {
+		return SUCCESS;
+	}
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(attributes), &pos);
+	while (zend_hash_get_current_key_ex(Z_ARRVAL_P(attributes), &key, &key_length, &num_index, 0, &pos) == HASH_KEY_IS_STRING) {
+		if (*position) {
+			smart_str_appendl(sql, ", ", 2);
+		}
+		if (phalcon_mvc_model_query_escape(sql, dialect, alias, alias_length TSRMLS_CC) == FAILURE) {
+			return FAILURE;
+		}
+		smart_str_appendc(sql, '.');
+		if (phalcon_mvc_model_query_escape(sql, dialect, key, key_length - 1 TSRMLS_CC) == FAILURE) {
+			return FAILURE;
+		}
+		if (prefixed) {
+			name_length = spprintf(&name, 0, "%s.%s", alias, key);
+			status = phalcon_mvc_model_query_map_column(column_map, name, name_length, *position TSRMLS_CC);
+			efree(name);
+		} else {
+			status = phalcon_mvc_model_query_map_column(column_map, key, key_length - 1, *position TSRMLS_CC);
+		}
+		if (status == FAILURE) {
+			return FAILURE;
+		}
+		(*position)++;
+		zend_hash_move_forward_ex(Z_ARRVAL_P(attributes), &pos);
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * Appends the limit of a statement to the plan, it is applied by the dialect of the connection
+ */
+static void phalcon_mvc_model_query_limit(zval *plan, zval *ast){
+
+	zval *limit, *value;
+
+	limit = phalcon_mvc_model_query_node(ast, SS("limit"));
+	value = phalcon_mvc_model_query_node(limit, SS("value"));
+	if (value && Z_TYPE_P(value) == IS_STRING) {
+		add_assoc_long_ex(plan, SS("limit"), ZEND_STRTOL(Z_STRVAL_P(value), NULL, 10));
+	}
+}
+
+/**
+ * Compiles a SELECT statement. Rows are mapped to the columns by their position in the select list, so
+ * aliases don't depend on the case folding of the database system
+ */
+static int phalcon_mvc_model_query_select(zval *plan, smart_str *sql, zval *ast, zval *sources, zval *dialect TSRMLS_DC){
+
+	zval *clause, *columns, *tables, *joins, *join, *expr, *alias, *name, *column_map, *items;
+	zval **item, **definition, **model_name;
+	char *message, *key;
+	uint key_length;
+	ulong num_index;
+	long position = 0, type;
+	HashPosition pos, pos1;
+	int status = SUCCESS;
+
+	clause = phalcon_mvc_model_query_node(ast, SS("select"));
+	columns = phalcon_mvc_model_query_node(clause, SS("columns"));
+	tables = phalcon_mvc_model_query_node(clause, SS("tables"));
+	joins = phalcon_mvc_model_query_node(clause, SS("joins"));
+
+	ALLOC_INIT_ZVAL(column_map);
+	array_init(column_map);
+
+	ALLOC_INIT_ZVAL(items);
+	phalcon_mvc_model_query_items(items, columns);
+
+	smart_str_appendl(sql, "SELECT ", 7);
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(items), &pos);
+	while (status == SUCCESS && zend_hash_get_current_data_ex(Z_ARRVAL_P(items), (void**) &item, &pos) == SUCCESS) {
+
+		switch (phalcon_mvc_model_query_type(*item)) {
+
+			case PHQL_T_ALL:
+				zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(sources), &pos1);
+				while (status == SUCCESS && zend_hash_get_current_data_ex(Z_ARRVAL_P(sources), (void**) &definition, &pos1) == SUCCESS) {
+					zend_hash_get_current_key_ex(Z_ARRVAL_P(sources), &key, &key_length, &num_index, 0, &pos1);
+					status = phalcon_mvc_model_query_all_columns(sql, key, key_length - 1, *definition, dialect, column_map, &position, zend_hash_num_elements(Z_ARRVAL_P(sources)) > 1 TSRMLS_CC);
+					zend_hash_move_forward_ex(Z_ARRVAL_P(sources), &pos1);
+				}
+				break;
+
+			case PHQL_T_DOMAINALL:
+				alias = phalcon_mvc_model_query_node(*item, SS("column"));
+				if (!alias || Z_TYPE_P(alias) != IS_STRING || zend_hash_find(Z_ARRVAL_P(sources), Z_STRVAL_P(alias), Z_STRLEN_P(alias) + 1, (void**) &definition) != SUCCESS) {
+					spprintf(&message, 0, "Unknown model or alias '%s' in the select list", alias && Z_TYPE_P(alias) == IS_STRING ? Z_STRVAL_P(alias) : "");
+					status = phalcon_mvc_model_query_throw(message TSRMLS_CC);
+					break;
+				}
+				status = phalcon_mvc_model_query_all_columns(sql, Z_STRVAL_P(alias), Z_STRLEN_P(alias), *definition, dialect, column_map, &position, 0 TSRMLS_CC);
+				break;
+
+			default:
+				expr = phalcon_mvc_model_query_node(*item, SS("column"));
+				if (position) {
+					smart_str_appendl(sql, ", ", 2);
+				}
+				status = phalcon_mvc_model_query_expr(sql, expr, sources, dialect, 1 TSRMLS_CC);
+				if (status == FAILURE) {
+					break;
+				}
+
+				/** Expressions without an alias are named by their position */
+				alias = phalcon_mvc_model_query_node(*item, SS("alias"));
+				if (alias && Z_TYPE_P(alias) == IS_STRING) {
+					smart_str_appendl(sql, " AS ", 4);
+					status = phalcon_mvc_model_query_escape(sql, dialect, Z_STRVAL_P(alias), Z_STRLEN_P(alias) TSRMLS_CC);
+					if (status == FAILURE) {
+						break;
+					}
+					status = phalcon_mvc_model_query_map_column(column_map, Z_STRVAL_P(alias), Z_STRLEN_P(alias), position TSRMLS_CC);
+				} else {
+					name = phalcon_mvc_model_query_node(expr, SS("name"));
+					if (phalcon_mvc_model_query_type(expr) == PHQL_T_QUALIFIED && name && Z_TYPE_P(name) == IS_STRING) {
+						status = phalcon_mvc_model_query_map_column(column_map, Z_STRVAL_P(name), Z_STRLEN_P(name), position TSRMLS_CC);
+					} else {
+						key_length = spprintf(&key, 0, "_%ld", position);
+						status = phalcon_mvc_model_query_map_column(column_map, key, key_length, position TSRMLS_CC);
+						efree(key);
+					}
+				}
+				position++;
+				break;
+		}
+
+		zend_hash_move_forward_ex(Z_ARRVAL_P(items), &pos);
+	}
+
+	/** Selecting all the columns of only one model returns complete models */
+	if (status == SUCCESS && zend_hash_num_elements(Z_ARRVAL_P(items)) == 1) {
+		zend_hash_internal_pointer_reset(Z_ARRVAL_P(items));
+		zend_hash_get_current_data(Z_ARRVAL_P(items), (void**) &item);
+		type = phalcon_mvc_model_query_type(*item);
+		definition = NULL;
+		if (type == PHQL_T_ALL && zend_hash_num_elements(Z_ARRVAL_P(sources)) == 1) {
+			zend_hash_internal_pointer_reset(Z_ARRVAL_P(sources));
+			zend_hash_get_current_data(Z_ARRVAL_P(sources), (void**) &definition);
+		} else {
+			if (type == PHQL_T_DOMAINALL) {
+				alias = phalcon_mvc_model_query_node(*item, SS("column"));
+				zend_hash_find(Z_ARRVAL_P(sources), Z_STRVAL_P(alias), Z_STRLEN_P(alias) + 1, (void**) &definition);
+			}
+		}
+		if (definition && zend_hash_find(Z_ARRVAL_PP(definition), SS("model"), (void**) &model_name) == SUCCESS) {
+			Z_ADDREF_PP(model_name);
+			add_assoc_zval_ex(plan, SS("model"), *model_name);
+		}
+	}
+
+	zval_ptr_dtor(&items);
+
+	if (status == FAILURE) {
+		zval_ptr_dtor(&column_map);
+		return FAILURE;
+	}
+
+	add_assoc_zval_ex(plan, SS("columnMap"), column_map);
+
+	/** Every model is aliased with the alias or the name used in the statement */
+	smart_str_appendl(sql, " FROM ", 6);
+
+	ALLOC_INIT_ZVAL(items);
+	phalcon_mvc_model_query_items(items, tables);
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(items), &pos);
+	while (status == SUCCESS && zend_hash_get_current_data_ex(Z_ARRVAL_P(items), (void**) &item, &pos) == SUCCESS) {
+		alias = phalcon_mvc_model_query_alias(*item, phalcon_mvc_model_query_node(*item, SS("qualifiedName")));
+		if (zend_hash_find(Z_ARRVAL_P(sources), Z_STRVAL_P(alias), Z_STRLEN_P(alias) + 1, (void**) &definition) == SUCCESS) {
+			if (pos != Z_ARRVAL_P(items)->pListHead) {
+				smart_str_appendl(sql, ", ", 2);
+			}
+			status = phalcon_mvc_model_query_table(sql, dialect, *definition, alias TSRMLS_CC);
+		}
+		zend_hash_move_forward_ex(Z_ARRVAL_P(items), &pos);
+	}
+	zval_ptr_dtor(&items);
+	if (status == FAILURE) {
+		return FAILURE;
+	}
+
+	if (joins) {
+		ALLOC_INIT_ZVAL(items);
+		phalcon_mvc_model_query_items(items, joins);
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(items), &pos);
+		while (status == SUCCESS && zend_hash_get_current_data_ex(Z_ARRVAL_P(items), (void**) &item, &pos) == SUCCESS) {
+
+			join = phalcon_mvc_model_query_node(*item, SS("join"));
+			alias = phalcon_mvc_model_query_alias(*item, phalcon_mvc_model_query_node(join, SS("qualifiedName")));
+			expr = phalcon_mvc_model_query_node(join, SS("expr"));
+			type = phalcon_mvc_model_query_type(join);
+
+			if (zend_hash_find(Z_ARRVAL_P(sources), Z_STRVAL_P(alias), Z_STRLEN_P(alias) + 1, (void**) &definition) == SUCCESS) {
+
+				/** Inner joins without conditions are cross joins, outer joins always need a condition */
+				if (!expr) {
+					if (type != PHQL_T_INNERJOIN) {
+						spprintf(&message, 0, "The outer join with '%s' requires an ON condition", Z_STRVAL_P(alias));
+						status = phalcon_mvc_model_query_throw(message TSRMLS_CC);
+						break;
+					}
+					smart_str_appendl(sql, " CROSS JOIN ", 12);
+				} else {
+					switch (type) {
+						case PHQL_T_LEFTJOIN:
+							smart_str_appendl(sql, " LEFT JOIN ", 11);
+							break;
+						case PHQL_T_RIGHTJOIN:
+							smart_str_appendl(sql, " RIGHT JOIN ", 12);
+							break;
+						default:
+							smart_str_appendl(sql, " INNER JOIN ", 12);
+							break;
+					}
+				}
+
+				status = phalcon_mvc_model_query_table(sql, dialect, *definition, alias TSRMLS_CC);
+				if (status == SUCCESS && expr) {
+					smart_str_appendl(sql, " ON ", 4);
+					status = phalcon_mvc_model_query_expr(sql, expr, sources, dialect, 1 TSRMLS_CC);
+				}
+			}
+
+			zend_hash_move_forward_ex(Z_ARRVAL_P(items), &pos);
+		}
+		zval_ptr_dtor(&items);
+		if (status == FAILURE) {
+			return FAILURE;
+		}
+	}
+
+	expr = phalcon_mvc_model_query_node(ast, SS("where"));
+	if (expr) {
+		smart_str_appendl(sql, " WHERE ", 7);
+		if (phalcon_mvc_model_query_expr(sql, expr, sources, dialect, 1 TSRMLS_CC) == FAILURE) {
+			return FAILURE;
+		}
+	}
+
+	expr = phalcon_mvc_model_query_node(ast, SS("groupBy"));
+	if (expr) {
+		smart_str_appendl(sql, " GROUP BY ", 10);
+		if (phalcon_mvc_model_query_expr_list(sql, expr, sources, dialect, 1 TSRMLS_CC) == FAILURE) {
+			return FAILURE;
+		}
+	}
+
+	expr = phalcon_mvc_model_query_node(ast, SS("having"));
+	if (expr) {
+		smart_str_appendl(sql, " HAVING ", 8);
+		if (phalcon_mvc_model_query_expr(sql, expr, sources, dialect, 1 TSRMLS_CC) == FAILURE) {
+			return FAILURE;
+		}
+	}
+
+	expr = phalcon_mvc_model_query_node(ast, SS("orderBy"));
+	if (expr) {
+		smart_str_appendl(sql, " ORDER BY ", 10);
+		if (phalcon_mvc_model_query_expr_list(sql, expr, sources, dialect, 1 TSRMLS_CC) == FAILURE) {
+			return FAILURE;
+		}
+	}
+
+	phalcon_mvc_model_query_limit(plan, ast);
+
+	return SUCCESS;
+}
+
+/**
+ * Compiles an INSERT statement, the values are assigned to every attribute of the model when the fields are not given
+ */
+static int phalcon_mvc_model_query_insert(zval *plan, smart_str *sql, zval *ast, zval *sources, zval *dialect TSRMLS_DC){
+
+	zval *qualified_name, *name, *attributes, *fields, *values, *items;
+	zval **definition, **item;
+	char *message, *key;
+	uint key_length;
+	ulong num_index;
+	HashPosition pos;
+	int status = SUCCESS, number_fields = 0, number_values;
+
+	qualified_name = phalcon_mvc_model_query_node(ast, SS("qualifiedName"));
+	name = phalcon_mvc_model_query_node(qualified_name, SS("name"));
+	if (zend_hash_find(Z_ARRVAL_P(sources), Z_STRVAL_P(name), Z_STRLEN_P(name) + 1, (void**) &definition) != SUCCESS) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Corrupted PHQL intermediate representation");
+		return FAILURE;
+	}
+
+	smart_str_appendl(sql, "INSERT INTO ", 12);
+	if (phalcon_mvc_model_query_table(sql, dialect, *definition, NULL TSRMLS_CC) == FAILURE) {
+		return FAILURE;
+	}
+	smart_str_appendl(sql, " (", 2);
+
+	fields = phalcon_mvc_model_query_node(ast, SS("fields"));
+	if (fields) {
+		ALLOC_INIT_ZVAL(items);
+		phalcon_mvc_model_query_items(items, fields);
+		number_fields = zend_hash_num_elements(Z_ARRVAL_P(items));
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(items), &pos);
+		while (zend_hash_get_current_data_ex(Z_ARRVAL_P(items), (void**) &item, &pos) == SUCCESS) {
+			if (pos != Z_ARRVAL_P(items)->pListHead) {
+				smart_str_appendl(sql, ", ", 2);
+			}
+			status = phalcon_mvc_model_query_column(sql, *item, sources, dialect, 0 TSRMLS_CC);
+			if (status == FAILURE) {
+				break;
+			}
+			zend_hash_move_forward_ex(Z_ARRVAL_P(items), &pos);
+		}
+		zval_ptr_dtor(&items);
+		if (status == FAILURE) {
+			return FAILURE;
+		}
+	} else {
+		attributes = phalcon_mvc_model_query_node(*definition, SS("attributes"));
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(attributes), &pos);
+		while (zend_hash_get_current_key_ex(Z_ARRVAL_P(attributes), &key, &key_length, &num_index, 0, &pos) == HASH_KEY_IS_STRING) {
+			if (number_fields++) {
+				smart_str_appendl(sql, ", ", 2);
+			}
+			if (phalcon_mvc_model_query_escape(sql, dialect, key, key_length - 1 TSRMLS_CC) == FAILURE) {
+				return FAILURE;
+			}
+			zend_hash_move_forward_ex(Z_ARRVAL_P(attributes), &pos);
+		}
+	}
+
+	values = phalcon_mvc_model_query_node(ast, SS("values"));
+	number_values = values && zend_hash_index_exists(Z_ARRVAL_P(values), 0) ? zend_hash_num_elements(Z_ARRVAL_P(values)) : 1;
+	if (number_values != number_fields) {
+		spprintf(&message, 0, "The statement inserts %d values into %d columns", number_values, number_fields);
+		return phalcon_mvc_model_query_throw(message TSRMLS_CC);
+	}
+
+	smart_str_appendl(sql, ") VALUES (", 10);
+	if (phalcon_mvc_model_query_expr_list(sql, values, sources, dialect, 0 TSRMLS_CC) == FAILURE) {
+		return FAILURE;
+	}
+	smart_str_appendc(sql, ')');
+
+	return SUCCESS;
+}
+
+/**
+ * Compiles UPDATE and DELETE statements. Their columns are not qualified because not every
+ * database system accepts aliases in them, PostgreSQL doesn't accept a LIMIT either
+ */
+static int phalcon_mvc_model_query_update(zval *plan, smart_str *sql, zval *ast, zval *sources, zval *dialect, int is_delete TSRMLS_DC){
+
+	zval *clause, *tables, *alias, *values, *items, *expr;
+	zval **definition, **item;
+	HashPosition pos;
+	int status = SUCCESS;
+
+	clause = phalcon_mvc_model_query_node(ast, is_delete ? "delete" : "update", sizeof("update"));
+	tables = phalcon_mvc_model_query_node(clause, SS("tables"));
+	alias = phalcon_mvc_model_query_alias(tables, phalcon_mvc_model_query_node(tables, SS("qualifiedName")));
+	if (!alias || zend_hash_find(Z_ARRVAL_P(sources), Z_STRVAL_P(alias), Z_STRLEN_P(alias) + 1, (void**) &definition) != SUCCESS) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Corrupted PHQL intermediate representation");
+		return FAILURE;
+	}
+
+	if (phalcon_mvc_model_query_node(ast, SS("limit")) && instanceof_function(Z_OBJCE_P(dialect), phalcon_db_dialect_postgresql_ce TSRMLS_CC)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "PostgreSQL doesn't support LIMIT in UPDATE and DELETE statements");
+		return FAILURE;
+	}
+
+	smart_str_appendl(sql, is_delete ? "DELETE FROM " : "UPDATE ", is_delete ? 12 : 7);
+	if (phalcon_mvc_model_query_table(sql, dialect, *definition, NULL TSRMLS_CC) == FAILURE) {
+		return FAILURE;
+	}
+
+	if (!is_delete) {
+		smart_str_appendl(sql, " SET ", 5);
+
+		values = phalcon_mvc_model_query_node(clause, SS("values"));
+
+		ALLOC_INIT_ZVAL(items);
+		phalcon_mvc_model_query_items(items, values);
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(items), &pos);
+		while (zend_hash_get_current_data_ex(Z_ARRVAL_P(items), (void**) &item, &pos) == SUCCESS) {
+			if (pos != Z_ARRVAL_P(items)->pListHead) {
+				smart_str_appendl(sql, ", ", 2);
+			}
+			status = phalcon_mvc_model_query_column(sql, phalcon_mvc_model_query_node(*item, SS("column")), sources, dialect, 0 TSRMLS_CC);
+			if (status == SUCCESS) {
+				smart_str_appendl(sql, " = ", 3);
+				status = phalcon_mvc_model_query_expr(sql, phalcon_mvc_model_query_node(*item, SS("expr")), sources, dialect, 0 TSRMLS_CC);
+			}
+			if (status == FAILURE) {
+				break;
+			}
+			zend_hash_move_forward_ex(Z_ARRVAL_P(items), &pos);
+		}
+		zval_ptr_dtor(&items);
+		if (status == FAILURE) {
+			return FAILURE;
+		}
+	}
+
+	expr = phalcon_mvc_model_query_node(ast, SS("where"));
+	if (expr) {
+		smart_str_appendl(sql, " WHERE ", 7);
+		if (phalcon_mvc_model_query_expr(sql, expr, sources, dialect, 0 TSRMLS_CC) == FAILURE) {
+			return FAILURE;
+		}
+	}
+
+	phalcon_mvc_model_query_limit(plan, ast);
+
+	return SUCCESS;
+}
+
+/**
+ * Compiles the intermediate representation of a statement into a plan with the SQL to execute
+ */
+static int phalcon_mvc_model_query_compile(zval *plan, zval *ast, zval *sources, zval *dialect TSRMLS_DC){
+
+	smart_str sql = {0};
+	long type;
+	int status;
+
+	type = phalcon_mvc_model_query_type(ast);
+	switch (type) {
+
+		case PHQL_T_SELECT:
+			status = phalcon_mvc_model_query_select(plan, &sql, ast, sources, dialect TSRMLS_CC);
+			break;
+
+		case PHQL_T_INSERT:
+			status = phalcon_mvc_model_query_insert(plan, &sql, ast, sources, dialect TSRMLS_CC);
+			break;
+
+		case PHQL_T_UPDATE:
+		case PHQL_T_DELETE:
+			status = phalcon_mvc_model_query_update(plan, &sql, ast, sources, dialect, type == PHQL_T_DELETE TSRMLS_CC);
+			break;
+
+		default:
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Unknown PHQL statement");
+			status = FAILURE;
+			break;
+	}
+
+	if (status == FAILURE) {
+		smart_str_free(&sql);
+		return FAILURE;
+	}
+
+	smart_str_0(&sql);
+	add_assoc_long_ex(plan, SS("type"), type);
+	add_assoc_stringl_ex(plan, SS("sql"), sql.c, sql.len, 0);
+
+	return SUCCESS;
+}
+
+/**
+ * Stores a persistent copy of a value in one of the PHQL caches, creating the cache on its first use.
+ * Applications generating different statements on every request must not exhaust the memory
+ */
+static void phalcon_mvc_model_query_cache_store(HashTable **cache, char *key, uint key_length, zval *value){
+
+	zval *persistent_value;
+
+	if (!*cache) {
+		*cache = (HashTable *) pemalloc(sizeof(HashTable), 1);
+		zend_hash_init(*cache, PHALCON_PHQL_CACHE_SIZE, NULL, phalcon_mvc_model_query_cache_dtor, 1);
+	}
+
+	if (zend_hash_num_elements(*cache) < PHALCON_PHQL_CACHE_SIZE) {
+		if (phalcon_persistent_copy(&persistent_value, value) == SUCCESS) {
+			zend_hash_update(*cache, key, key_length, &persistent_value, sizeof(zval *), NULL);
+		}
+	}
+}
+
+/**
+ * Appends a length-prefixed string to the key of a plan, so no two different inputs produce the same key
+ */
+static void phalcon_mvc_model_query_key_append(smart_str *key, char *str, uint str_length){
+	smart_str_append_unsigned(key, str_length);
+	smart_str_appendc(key, ':');
+	smart_str_appendl(key, str, str_length);
+}
+
+/**
+ * Builds the key of a compiled plan. The SQL depends on the statement, the dialect of the connection and
+ * the schemas, tables and attributes of the models, so all of them are part of the key
+ */
+static void phalcon_mvc_model_query_plan_key(smart_str *key, zval *phql, zval *dialect, zval *sources){
+
+	zval **definition, **value, **attributes;
+	HashPosition pos, attributes_pos;
+	char *alias, *attribute;
+	uint alias_length, attribute_length;
+	ulong num_index;
+
+	phalcon_mvc_model_query_key_append(key, Z_STRVAL_P(phql), Z_STRLEN_P(phql));
+
+	phalcon_mvc_model_query_key_append(key, Z_OBJCE_P(dialect)->name, Z_OBJCE_P(dialect)->name_length);
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(sources), &pos);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(sources), (void**) &definition, &pos) == SUCCESS) {
+
+		zend_hash_get_current_key_ex(Z_ARRVAL_P(sources), &alias, &alias_length, &num_index, 0, &pos);
+		phalcon_mvc_model_query_key_append(key, alias, alias_length - 1);
+
+		if (zend_hash_find(Z_ARRVAL_PP(definition), SS("model"), (void**) &value) == SUCCESS) {
+			phalcon_mvc_model_query_key_append(key, Z_STRVAL_PP(value), Z_STRLEN_PP(value));
+		}
+
+		if (zend_hash_find(Z_ARRVAL_PP(definition), SS("schema"), (void**) &value) == SUCCESS && Z_TYPE_PP(value) == IS_STRING) {
+			phalcon_mvc_model_query_key_append(key, Z_STRVAL_PP(value), Z_STRLEN_PP(value));
+		} else {
+			phalcon_mvc_model_query_key_append(key, "", 0);
+		}
+
+		if (zend_hash_find(Z_ARRVAL_PP(definition), SS("source"), (void**) &value) == SUCCESS && Z_TYPE_PP(value) == IS_STRING) {
+			phalcon_mvc_model_query_key_append(key, Z_STRVAL_PP(value), Z_STRLEN_PP(value));
+		}
+
+		if (zend_hash_find(Z_ARRVAL_PP(definition), SS("attributes"), (void**) &attributes) == SUCCESS) {
+			smart_str_append_unsigned(key, zend_hash_num_elements(Z_ARRVAL_PP(attributes)));
+			smart_str_appendc(key, ':');
+			zend_hash_internal_pointer_reset_ex(Z_ARRVAL_PP(attributes), &attributes_pos);
+			while (zend_hash_get_current_key_ex(Z_ARRVAL_PP(attributes), &attribute, &attribute_length, &num_index, 0, &attributes_pos) == HASH_KEY_IS_STRING) {
+				phalcon_mvc_model_query_key_append(key, attribute, attribute_length - 1);
+				zend_hash_move_forward_ex(Z_ARRVAL_PP(attributes), &attributes_pos);
+			}
+		}
+
+		zend_hash_move_forward_ex(Z_ARRVAL_P(sources), &pos);
+	}
+
+	smart_str_0(key);
+}
+
 /**
- * Phalcon\Model\Query
+ * Phalcon\Mvc\Model\Query
+ *
+ * Phalcon\Mvc\Model\Query executes PHQL statements. Statements are parsed by Phalcon\Mvc\Model\Query\Lang and
+ * compiled into SQL resolving the models and their attributes through the models meta-data. Identifiers and
+ * string literals are quoted by the dialect of the connection. The parsed statements are kept in the process
+ * memory, and so are the compiled plans, indexed by the statement, the dialect and the definitions of the
+ * models they reference, so a worker parses every distinct PHQL statement only once
+ *
+ *<code>
  *
- * Phalcon\Model\Query is designed to simplify building of search on models.
- * It provides a set of helpers to generate searchs in a dynamic way to support differents databases.
+ * $query = new Phalcon\Mvc\Model\Query("SELECT r.* FROM Robots r JOIN RobotsParts ON RobotsParts.robots_id = r.id WHERE r.type = :type: LIMIT 10");
+ * foreach ($query->execute(array("type" => "mechanical")) as $robot) {
+ *    echo $robot->name, "\n";
+ * }
  *
- * 
+ *</code>
  *
+ * Selecting all the columns of only one model returns complete models, other columns are returned as
+ * Phalcon\Mvc\Model\Row objects. INSERT, UPDATE and DELETE statements are executed directly on the database,
+ * they don't run the validations or the events of the models
  */
 
+/**
+ * Phalcon\Mvc\Model\Query constructor
+ *
+ * @param string $phql
+ */
 PHP_METHOD(Phalcon_Mvc_Model_Query, __construct){
 
+	zval *phql = NULL;
 	zval *a0 = NULL, *a1 = NULL, *a2 = NULL, *a3 = NULL;
 
 	PHALCON_MM_GROW();
 
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|z", &phql) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (phql) {
+		phalcon_update_property_zval(this_ptr, SL("_phql"), phql TSRMLS_CC);
+	}
+
 	PHALCON_ALLOC_ZVAL_MM(a0);
 	array_init(a0);
 	zend_update_property(phalcon_mvc_model_query_ce, this_ptr, SL("_data"), a0 TSRMLS_CC);
@@ -212,10 +1368,490 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, setLimit){
 	PHALCON_MM_RESTORE();
 }
 
-PHP_METHOD(Phalcon_Mvc_Model_Query, getResultset){
+/**
+ * Sets the dependency injection container
+ *
+ * @param Phalcon\DI $dependencyInjector
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query, setDI){
+
+	zval *dependency_injector = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &dependency_injector) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Dependency Injector is invalid");
+		return;
+	}
+	phalcon_update_property_zval(this_ptr, SL("_dependencyInjector"), dependency_injector TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns the dependency injection container, the default container is used when none was set
+ *
+ * @return Phalcon\DI
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query, getDI){
+
+	zval *dependency_injector = NULL;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_ALLOC_ZVAL_MM(dependency_injector);
+	PHALCON_READ_PROPERTY_QUICK(&dependency_injector, this_ptr, "_dependencyInjector", PH_NOISY_CC);
+	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
+		PHALCON_INIT_VAR(dependency_injector);
+		PHALCON_CALL_STATIC(dependency_injector, "phalcon\\di", "getdefault");
+		if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A dependency injector container is required to obtain the services related to the ORM");
+			return;
+		}
+		phalcon_update_property_zval(this_ptr, SL("_dependencyInjector"), dependency_injector TSRMLS_CC);
+	}
+
+	RETURN_CCTOR(dependency_injector);
+}
+
+/**
+ * Returns an instance of a model referenced by the statement, instances are reused by the query
+ *
+ * @param string $modelName
+ * @return Phalcon\Mvc\Model
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query, _getModel){
+
+	zval *model_name = NULL, *instances = NULL, *model = NULL, *dependency_injector = NULL;
+	zval **instance;
+	zend_class_entry **ce;
+	char *message;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &model_name) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(model_name) != IS_STRING) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Model name must be string");
+		return;
+	}
+
+	PHALCON_ALLOC_ZVAL_MM(instances);
+	PHALCON_READ_PROPERTY_QUICK(&instances, this_ptr, "_instances", PH_NOISY_CC);
+	if (Z_TYPE_P(instances) == IS_ARRAY) {
+		if (zend_hash_find(Z_ARRVAL_P(instances), Z_STRVAL_P(model_name), Z_STRLEN_P(model_name) + 1, (void**) &instance) == SUCCESS) {
+			RETURN_CCTOR(*instance);
+		}
+	} else {
+		PHALCON_INIT_VAR(instances);
+		array_init(instances);
+	}
+
+	if (zend_lookup_class(Z_STRVAL_P(model_name), Z_STRLEN_P(model_name), &ce TSRMLS_CC) == FAILURE || !instanceof_function(*ce, phalcon_mvc_model_ce TSRMLS_CC)) {
+		if (!EG(exception)) {
+			spprintf(&message, 0, "The model '%s' could not be loaded", Z_STRVAL_P(model_name));
+			phalcon_mvc_model_query_throw(message TSRMLS_CC);
+		} else {
+			PHALCON_MM_RESTORE();
+		}
+		return;
+	}
+
+	PHALCON_INIT_VAR(dependency_injector);
+	PHALCON_CALL_METHOD(dependency_injector, this_ptr, "getdi", PH_NO_CHECK);
+
+	PHALCON_INIT_VAR(model);
+	object_init_ex(model, *ce);
+	PHALCON_CALL_METHOD_PARAMS_1_NORETURN(model, "__construct", dependency_injector, PH_CHECK);
+
+	phalcon_array_update_zval(&instances, model_name, &model, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	phalcon_update_property_zval(this_ptr, SL("_instances"), instances TSRMLS_CC);
+
+	RETURN_CTOR(model);
+}
+
+/**
+ * Returns the definition of a model used to compile the statements: its schema, its table and the positions of its attributes
+ *
+ * @param string $modelName
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query, _getModelDefinition){
+
+	zval *model_name = NULL, *model = NULL, *schema = NULL, *source = NULL;
+	zval *dependency_injector = NULL, *meta_data = NULL, *attributes = NULL, *positions = NULL;
+	zval *definition = NULL, *c0 = NULL;
+	zval **attribute;
+	HashPosition pos;
+	long position = 0;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &model_name) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_INIT_VAR(model);
+	PHALCON_CALL_METHOD_PARAMS_1(model, this_ptr, "_getmodel", model_name, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(schema);
+	PHALCON_CALL_METHOD(schema, model, "getschema", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(source);
+	PHALCON_CALL_METHOD(source, model, "getsource", PH_NO_CHECK);
+
+	PHALCON_INIT_VAR(dependency_injector);
+	PHALCON_CALL_METHOD(dependency_injector, this_ptr, "getdi", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(c0);
+	ZVAL_STRING(c0, "modelsMetadata", 1);
+	
+	PHALCON_INIT_VAR(meta_data);
+	PHALCON_CALL_METHOD_PARAMS_1(meta_data, dependency_injector, "getshared", c0, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(attributes);
+	PHALCON_CALL_METHOD_PARAMS_1(attributes, meta_data, "getattributes", model, PH_NO_CHECK);
+
+	PHALCON_INIT_VAR(positions);
+	array_init(positions);
+	if (Z_TYPE_P(attributes) == IS_ARRAY) {
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(attributes), &pos);
+		while (zend_hash_get_current_data_ex(Z_ARRVAL_P(attributes), (void**) &attribute, &pos) == SUCCESS) {
+			if (Z_TYPE_PP(attribute) == IS_STRING) {
+				add_assoc_long_ex(positions, Z_STRVAL_PP(attribute), Z_STRLEN_PP(attribute) + 1, position++);
+			}
+			zend_hash_move_forward_ex(Z_ARRVAL_P(attributes), &pos);
+		}
+	}
+
+	PHALCON_INIT_VAR(definition);
+	array_init(definition);
+	phalcon_array_update_string(&definition, SL("model"), &model_name, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	if (zend_is_true(schema)) {
+		phalcon_array_update_string(&definition, SL("schema"), &schema, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	}
+	phalcon_array_update_string(&definition, SL("source"), &source, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_string(&definition, SL("attributes"), &positions, PH_COPY | PH_SEPARATE TSRMLS_CC);
+
+	RETURN_CTOR(definition);
+}
+
+/**
+ * Parses and compiles the PHQL statement returning its plan. The parsed statements are kept in the process
+ * memory indexed by their text, the plans are indexed by the statement, the dialect of the connection and
+ * the definitions of the models, so a plan is never reused for other tables, attributes or dialects
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query, parse){
+
+	zval *plan = NULL, *phql = NULL, *ast = NULL, *error_msg = NULL, *references = NULL;
+	zval *sources = NULL, *definition = NULL, *alias = NULL, *model = NULL;
+	zval *connection = NULL, *dialect = NULL;
+	zval **model_name, **cached;
+	HashPosition pos;
+	smart_str plan_key = {0};
+	char *key;
+	uint key_length;
+	ulong num_index;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_ALLOC_ZVAL_MM(plan);
+	PHALCON_READ_PROPERTY_QUICK(&plan, this_ptr, "_plan", PH_NOISY_CC);
+	if (Z_TYPE_P(plan) == IS_ARRAY) {
+		RETURN_CCTOR(plan);
+	}
+
+	PHALCON_ALLOC_ZVAL_MM(phql);
+	PHALCON_READ_PROPERTY_QUICK(&phql, this_ptr, "_phql", PH_NOISY_CC);
+	if (Z_TYPE_P(phql) != IS_STRING) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "PHQL statement must be string");
+		return;
+	}
+
+	PHALCON_ALLOC_ZVAL_MM(ast);
+	if (PHALCON_GLOBAL(phql_cache) && zend_hash_find(PHALCON_GLOBAL(phql_cache), Z_STRVAL_P(phql), Z_STRLEN_P(phql) + 1, (void**) &cached) == SUCCESS) {
+		phalcon_persistent_restore(ast, *cached);
+	} else {
+		if (phql_internal_parse_sql(&ast, Z_STRVAL_P(phql), &error_msg TSRMLS_CC) == FAILURE) {
+			if (error_msg && Z_TYPE_P(error_msg) == IS_STRING) {
+				phalcon_throw_exception_string(phalcon_mvc_model_exception_ce, Z_STRVAL_P(error_msg), Z_STRLEN_P(error_msg) TSRMLS_CC);
+			} else {
+				PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Error parsing PHQL");
+			}
+			return;
+		}
+		phalcon_mvc_model_query_cache_store(&PHALCON_GLOBAL(phql_cache), Z_STRVAL_P(phql), Z_STRLEN_P(phql) + 1, ast);
+	}
+
+	/** The helpers throw the exceptions themselves, the memory stack is already restored when they fail */
+	PHALCON_INIT_VAR(references);
+	if (phalcon_mvc_model_query_references(references, ast TSRMLS_CC) == FAILURE) {
+		return;
+	}
+
+	/** The SQL is generated by the dialect of the connection of the first model */
+	zend_hash_internal_pointer_reset(Z_ARRVAL_P(references));
+	if (zend_hash_get_current_data(Z_ARRVAL_P(references), (void**) &model_name) == FAILURE) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The PHQL statement doesn't reference any model");
+		return;
+	}
+
+	PHALCON_INIT_VAR(model);
+	PHALCON_CALL_METHOD_PARAMS_1(model, this_ptr, "_getmodel", *model_name, PH_NO_CHECK);
+
+	PHALCON_INIT_VAR(connection);
+	PHALCON_CALL_METHOD(connection, model, "getconnection", PH_NO_CHECK);
+
+	PHALCON_ALLOC_ZVAL_MM(dialect);
+	phalcon_read_property(&dialect, connection, SL("_dialect"), PH_NOISY_CC);
+	if (Z_TYPE_P(dialect) != IS_OBJECT || !instanceof_function(Z_OBJCE_P(dialect), phalcon_db_dialect_ce TSRMLS_CC)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The connection of the model doesn't have a valid dialect");
+		return;
+	}
+
+	PHALCON_INIT_VAR(sources);
+	array_init(sources);
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(references), &pos);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(references), (void**) &model_name, &pos) == SUCCESS) {
+
+		zend_hash_get_current_key_ex(Z_ARRVAL_P(references), &key, &key_length, &num_index, 0, &pos);
+
+		PHALCON_INIT_VAR(alias);
+		ZVAL_STRINGL(alias, key, key_length - 1, 1);
+
+		PHALCON_INIT_VAR(definition);
+		PHALCON_CALL_METHOD_PARAMS_1(definition, this_ptr, "_getmodeldefinition", *model_name, PH_NO_CHECK);
+		phalcon_array_update_zval(&sources, alias, &definition, PH_COPY | PH_SEPARATE TSRMLS_CC);
+
+		zend_hash_move_forward_ex(Z_ARRVAL_P(references), &pos);
+	}
+
+	phalcon_mvc_model_query_plan_key(&plan_key, phql, dialect, sources);
+
+	PHALCON_INIT_VAR(plan);
+	if (PHALCON_GLOBAL(phql_plans) && zend_hash_find(PHALCON_GLOBAL(phql_plans), plan_key.c, plan_key.len + 1, (void**) &cached) == SUCCESS) {
+		smart_str_free(&plan_key);
+		phalcon_persistent_restore(plan, *cached);
+		phalcon_update_property_zval(this_ptr, SL("_plan"), plan TSRMLS_CC);
+		RETURN_CCTOR(plan);
+	}
+
+	array_init(plan);
+	if (phalcon_mvc_model_query_compile(plan, ast, sources, dialect TSRMLS_CC) == FAILURE) {
+		smart_str_free(&plan_key);
+		return;
+	}
+	phalcon_array_update_string(&plan, SL("models"), &references, PH_COPY | PH_SEPARATE TSRMLS_CC);
+
+	phalcon_update_property_zval(this_ptr, SL("_plan"), plan TSRMLS_CC);
+
+	phalcon_mvc_model_query_cache_store(&PHALCON_GLOBAL(phql_plans), plan_key.c, plan_key.len + 1, plan);
+	smart_str_free(&plan_key);
+
+	RETURN_CTOR(plan);
+}
+
+/**
+ * Returns the SQL generated for the PHQL statement
+ *
+ * @return string
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query, getSql){
+
+	zval *plan = NULL, *sql = NULL, *limit = NULL, *models = NULL, *model = NULL;
+	zval *connection = NULL, *limited_sql = NULL;
+	zval **model_name;
+	int eval_int;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(plan);
+	PHALCON_CALL_METHOD(plan, this_ptr, "parse", PH_NO_CHECK);
+
+	PHALCON_INIT_VAR(sql);
+	PHALCON_ARRAY_FETCH_QUICK_STRING(&sql, plan, "sql", PH_NOISY_CC);
+
+	/** Limits are applied by the dialect of the connection */
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, plan, "limit");
+	if (eval_int) {
+		PHALCON_INIT_VAR(limit);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&limit, plan, "limit", PH_NOISY_CC);
 
+		PHALCON_INIT_VAR(models);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&models, plan, "models", PH_NOISY_CC);
+		zend_hash_internal_pointer_reset(Z_ARRVAL_P(models));
+		zend_hash_get_current_data(Z_ARRVAL_P(models), (void**) &model_name);
 
+		PHALCON_INIT_VAR(model);
+		PHALCON_CALL_METHOD_PARAMS_1(model, this_ptr, "_getmodel", *model_name, PH_NO_CHECK);
+
+		PHALCON_INIT_VAR(connection);
+		PHALCON_CALL_METHOD(connection, model, "getconnection", PH_NO_CHECK);
+
+		PHALCON_INIT_VAR(limited_sql);
+		PHALCON_CALL_METHOD_PARAMS_2(limited_sql, connection, "limit", sql, limit, PH_NO_CHECK);
+		PHALCON_CPY_WRT(sql, limited_sql);
+	}
+
+	RETURN_CCTOR(sql);
+}
+
+/**
+ * Executes the PHQL statement. SELECT statements return a Phalcon\Mvc\Model\Resultset, the other
+ * statements return the result of executing them on the connection of their model
+ *
+ *<code>
+ * $query = new Phalcon\Mvc\Model\Query("UPDATE Robots SET type = :type: WHERE id = ?0");
+ * $query->execute(array(0 => 10, "type" => "virtual"));
+ *</code>
+ *
+ * @param array $bindParams
+ * @param array $bindTypes
+ * @return mixed
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query, execute){
+
+	zval *bind_params = NULL, *bind_types = NULL, *plan = NULL, *sql = NULL, *limit = NULL;
+	zval *models = NULL, *model = NULL, *connection = NULL, *type = NULL, *result = NULL;
+	zval *prototype = NULL, *column_map = NULL;
+	zval *resultset = NULL, *success = NULL, *class_name = NULL, *limited_sql = NULL;
+	zval **model_name;
+	int eval_int;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|zz", &bind_params, &bind_types) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (!bind_params) {
+		PHALCON_INIT_VAR(bind_params);
+	}
 	
+	if (!bind_types) {
+		PHALCON_INIT_VAR(bind_types);
+	}
+
+	PHALCON_INIT_VAR(plan);
+	PHALCON_CALL_METHOD(plan, this_ptr, "parse", PH_NO_CHECK);
+
+	PHALCON_INIT_VAR(sql);
+	PHALCON_ARRAY_FETCH_QUICK_STRING(&sql, plan, "sql", PH_NOISY_CC);
+
+	PHALCON_INIT_VAR(type);
+	PHALCON_ARRAY_FETCH_QUICK_STRING(&type, plan, "type", PH_NOISY_CC);
+
+	/** The statement is executed on the connection of the first model it references */
+	PHALCON_INIT_VAR(models);
+	PHALCON_ARRAY_FETCH_QUICK_STRING(&models, plan, "models", PH_NOISY_CC);
+	zend_hash_internal_pointer_reset(Z_ARRVAL_P(models));
+	zend_hash_get_current_data(Z_ARRVAL_P(models), (void**) &model_name);
+
+	PHALCON_INIT_VAR(model);
+	PHALCON_CALL_METHOD_PARAMS_1(model, this_ptr, "_getmodel", *model_name, PH_NO_CHECK);
+
+	PHALCON_INIT_VAR(connection);
+	PHALCON_CALL_METHOD(connection, model, "getconnection", PH_NO_CHECK);
+
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, plan, "limit");
+	if (eval_int) {
+		PHALCON_INIT_VAR(limit);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&limit, plan, "limit", PH_NOISY_CC);
+
+		PHALCON_INIT_VAR(limited_sql);
+		PHALCON_CALL_METHOD_PARAMS_2(limited_sql, connection, "limit", sql, limit, PH_NO_CHECK);
+		PHALCON_CPY_WRT(sql, limited_sql);
+	}
+
+	if (phalcon_get_intval(type) != PHQL_T_SELECT) {
+		PHALCON_INIT_VAR(success);
+		PHALCON_CALL_METHOD_PARAMS_3(success, connection, "execute", sql, bind_params, bind_types, PH_NO_CHECK);
+
+		RETURN_CCTOR(success);
+	}
+
+	PHALCON_INIT_VAR(result);
+	PHALCON_CALL_METHOD_PARAMS_3(result, connection, "query", sql, bind_params, bind_types, PH_NO_CHECK);
+
+	/** The resultset counts the rows only when they are requested */
+	/** Complete models are hydrated into instances of their class, other columns into rows */
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, plan, "model");
+	if (eval_int) {
+		PHALCON_INIT_VAR(class_name);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&class_name, plan, "model", PH_NOISY_CC);
+
+		PHALCON_INIT_VAR(prototype);
+		PHALCON_CALL_METHOD_PARAMS_1(prototype, this_ptr, "_getmodel", class_name, PH_NO_CHECK);
+	} else {
+		PHALCON_INIT_VAR(prototype);
+		object_init_ex(prototype, phalcon_mvc_model_row_ce);
+	}
+
+	PHALCON_INIT_VAR(resultset);
+	object_init_ex(resultset, phalcon_mvc_model_resultset_ce);
+	PHALCON_CALL_METHOD_PARAMS_2_NORETURN(resultset, "__construct", prototype, result, PH_CHECK);
+
+	PHALCON_INIT_VAR(column_map);
+	PHALCON_ARRAY_FETCH_QUICK_STRING(&column_map, plan, "columnMap", PH_NOISY_CC);
+	phalcon_update_property_zval(resultset, SL("_columnMap"), column_map TSRMLS_CC);
+
+	RETURN_CTOR(resultset);
+}
+
+/**
+ * Executes the statement using the parameters set by setParameters
+ *
+ * @return Phalcon\Mvc\Model\Resultset
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query, getResultset){
+
+	zval *parameters = NULL, *resultset = NULL;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_ALLOC_ZVAL_MM(parameters);
+	PHALCON_READ_PROPERTY_QUICK(&parameters, this_ptr, "_parameters", PH_NOISY_CC);
+	if (Z_TYPE_P(parameters) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(parameters))) {
+		PHALCON_INIT_VAR(parameters);
+	}
+
+	PHALCON_INIT_VAR(resultset);
+	PHALCON_CALL_METHOD_PARAMS_1(resultset, this_ptr, "execute", parameters, PH_NO_CHECK);
+
+	RETURN_CCTOR(resultset);
+}
+
+/**
+ * Removes the statements parsed and the plans compiled by this process
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query, clearCache){
+
+	if (PHALCON_GLOBAL(phql_cache)) {
+		zend_hash_destroy(PHALCON_GLOBAL(phql_cache));
+		pefree(PHALCON_GLOBAL(phql_cache), 1);
+		PHALCON_GLOBAL(phql_cache) = NULL;
+	}
+
+	if (PHALCON_GLOBAL(phql_plans)) {
+		zend_hash_destroy(PHALCON_GLOBAL(phql_plans));
+		pefree(PHALCON_GLOBAL(phql_plans), 1);
+		PHALCON_GLOBAL(phql_plans) = NULL;
+	}
+
+	RETURN_NULL();
 }
 
 /**
@@ -25,38 +25,90 @@ static void phql_wrapper_free(void *pointer){
 	efree(pointer);
 }
 
+static void phql_arena_init(phql_arena *arena){
+	arena->cursor = arena->buffer;
+	arena->limit = arena->buffer + PHQL_ARENA_SIZE;
+	arena->blocks = NULL;
+}
+
+/**
+ * Allocates memory from the arena, a new block is chained when the current one is exhausted
+ */
+static void *phql_arena_alloc(phql_arena *arena, size_t bytes){
+
+	void **block;
+	size_t block_size;
+	char *pointer;
+
+	bytes = ZEND_MM_ALIGNED_SIZE(bytes);
+	if ((size_t) (arena->limit - arena->cursor) < bytes) {
+		block_size = bytes > PHQL_ARENA_SIZE ? bytes : PHQL_ARENA_SIZE;
+		block = emalloc(ZEND_MM_ALIGNED_SIZE(sizeof(void *)) + block_size);
+		*block = arena->blocks;
+		arena->blocks = block;
+		arena->cursor = (char *) block + ZEND_MM_ALIGNED_SIZE(sizeof(void *));
+		arena->limit = arena->cursor + block_size;
+	}
+
+	pointer = arena->cursor;
+	arena->cursor += bytes;
+	return pointer;
+}
+
+/**
+ * Releases everything allocated by a parse
+ */
+static void phql_arena_free(phql_arena *arena){
+
+	void **block, *next;
+
+	block = arena->blocks;
+	while (block) {
+		next = *block;
+		efree(block);
+		block = next;
+	}
+	arena->blocks = NULL;
+}
+
 static void phql_parse_with_token(void* phql_parser, int opcode, int parsercode, phql_scanner_token *token, phql_parser_status *parser_status){
 	phql_parser_token *pToken;
-	pToken = emalloc(sizeof(phql_parser_token));
+	pToken = phql_arena_alloc(parser_status->arena, sizeof(phql_parser_token));
 	pToken->opcode = opcode;
-	pToken->token = estrndup(token->value, token->len);
+	pToken->token = token->value;
 	pToken->token_len = token->len;
 	phql_(phql_parser, parsercode, pToken, parser_status);
-	efree(token->value);
 }
 
-int phql_parse_sql(zval *result, zval *sql){
-	zval *error_msg;
-	return phql_internal_parse_sql(&result, Z_STRVAL_P(sql), &error_msg);
+int phql_parse_sql(zval *result, zval *sql TSRMLS_DC){
+	zval *error_msg = NULL;
+	return phql_internal_parse_sql(&result, Z_STRVAL_P(sql), &error_msg TSRMLS_CC);
 }
 
-int phql_internal_parse_sql(zval **result, char *sql, zval **error_msg) {
+/**
+ * Parses a PHQL statement. The scanner and the parser keep their state in the stack of this function,
+ * the tokens point to the statement and the intermediate representation is built while reducing the rules
+ */
+int phql_internal_parse_sql(zval **result, char *sql, zval **error_msg TSRMLS_DC) {
 
 	char *error;
-	phql_scanner_state *state;
-	phql_scanner_token *token;
+	phql_scanner_state scanner_state, *state = &scanner_state;
+	phql_scanner_token scanner_token, *token = &scanner_token;
+	phql_parser_status status_buffer, *parser_status = &status_buffer;
+	phql_arena arena;
 	int scanner_status, status = SUCCESS;
-	phql_parser_status *parser_status = NULL;
-	TSRMLS_FETCH();
 
 	void* phql_parser = phql_Alloc(phql_wrapper_alloc);
 
-	parser_status = emalloc(sizeof(phql_parser_status));
-	state = emalloc(sizeof(phql_scanner_state));
-	token = emalloc(sizeof(phql_scanner_token));
+	phql_arena_init(&arena);
+
+	*error_msg = NULL;
 
 	parser_status->status = PHQL_PARSING_OK;
+	parser_status->ret = NULL;
+	parser_status->syntax_error = NULL;
 	parser_status->scanner_state = state;
+	parser_status->arena = &arena;
 	state->start = sql;
 
 	state->end = state->start;
@@ -243,16 +295,35 @@ int phql_internal_parse_sql(zval **result, char *sql, zval **error_msg) {
 	}
 
 	phql_Free(phql_parser, phql_wrapper_free);
+	phql_arena_free(&arena);
+
+	/** Errors found by the parser after the last token are reported too */
+	if (parser_status->status != PHQL_PARSING_OK) {
+		status = FAILURE;
+		if (!*error_msg) {
+			PHALCON_ALLOC_ZVAL_MM(*error_msg);
+			if (parser_status->syntax_error) {
+				ZVAL_STRING(*error_msg, parser_status->syntax_error, 1);
+			} else {
+				ZVAL_STRING(*error_msg, "Syntax error", 1);
+			}
+		}
+	}
+
+	if (parser_status->syntax_error) {
+		efree(parser_status->syntax_error);
+	}
 
-	if (parser_status->status == PHQL_PARSING_OK) {
+	if (status == SUCCESS && parser_status->ret) {
 		ZVAL_ZVAL(*result, parser_status->ret, 0, 0);
 		ZVAL_NULL(parser_status->ret);
 		zval_ptr_dtor(&parser_status->ret);
+	} else {
+		if (parser_status->ret) {
+			zval_ptr_dtor(&parser_status->ret);
+		}
+		status = FAILURE;
 	}
 
-	efree(parser_status);
-	efree(state);
-	efree(token);
-
 	return status;
 }
\ No newline at end of file
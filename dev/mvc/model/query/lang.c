@@ -33,12 +33,26 @@
 #include "kernel/memory.h"
 
 #include "kernel/fcall.h"
+#include "kernel/exception.h"
 #include "mvc/model/query/scanner.h"
 #include "mvc/model/query/lang.h"
 
+/**
+ * Phalcon\Mvc\Model\Query\Lang
+ *
+ * Parses PHQL statements returning their intermediate representation
+ */
+
+/**
+ * Parses a PHQL statement returning an intermediate representation (IR). A Phalcon\Mvc\Model\Exception
+ * is thrown when the statement has syntax errors
+ *
+ * @param string $phql
+ * @return array
+ */
 PHP_METHOD(Phalcon_Mvc_Model_Query_Lang, parseSQL){
 
-	zval *sql = NULL;
+	zval *sql = NULL, *error_msg = NULL;
 	zval *r0 = NULL;
 
 	PHALCON_MM_GROW();
@@ -48,8 +62,21 @@ PHP_METHOD(Phalcon_Mvc_Model_Query_Lang, parseSQL){
 		RETURN_NULL();
 	}
 
+	if (Z_TYPE_P(sql) != IS_STRING) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "PHQL statement must be string");
+		return;
+	}
+
 	PHALCON_ALLOC_ZVAL_MM(r0);
-	phql_parse_sql(r0, sql);
+	if (phql_internal_parse_sql(&r0, Z_STRVAL_P(sql), &error_msg TSRMLS_CC) == FAILURE) {
+		if (error_msg && Z_TYPE_P(error_msg) == IS_STRING) {
+			phalcon_throw_exception_string(phalcon_mvc_model_exception_ce, Z_STRVAL_P(error_msg), Z_STRLEN_P(error_msg) TSRMLS_CC);
+		} else {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Error parsing PHQL");
+		}
+		return;
+	}
+
 	RETURN_CTOR(r0);
 }
 
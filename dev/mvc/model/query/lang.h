@@ -17,22 +17,41 @@
   +------------------------------------------------------------------------+
 */
 
+/**
+ * Tokens point into the statement and are not null terminated, their values must always be copied
+ * using token_len. Only the statement itself is null terminated, the scanner uses it to find its end
+ */
 typedef struct _phql_parser_token {
     int opcode;	
 	char *token;
 	int token_len;
-	int free_flag;
 } phql_parser_token;
 
+/** Size of the memory blocks used by the parser, most statements fit in the first one */
+#define PHQL_ARENA_SIZE 2048
+
+/**
+ * Memory used by a parse. Tokens are taken from it and released at once when the parse finishes,
+ * the first block lives in the stack of the parser
+ */
+typedef struct _phql_arena {
+	char *cursor;
+	char *limit;
+	void *blocks;
+	char buffer[PHQL_ARENA_SIZE];
+} phql_arena;
+
 typedef struct _phql_parser_status {
     int status;
 	zval *ret;  
 	phql_scanner_state *scanner_state;
+	phql_arena *arena;
+	char *syntax_error;
 } phql_parser_status;
 
 #define PHQL_PARSING_OK 1
-#define PHQL_PARSING_FAILED 1
+#define PHQL_PARSING_FAILED 0
 
-extern int phql_parse_sql(zval *result, zval *sql);
-extern int phql_internal_parse_sql(zval **result, char *sql, zval **error_msg);
+extern int phql_parse_sql(zval *result, zval *sql TSRMLS_DC);
+extern int phql_internal_parse_sql(zval **result, char *sql, zval **error_msg TSRMLS_DC);
     
\ No newline at end of file
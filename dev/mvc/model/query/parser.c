@@ -1,10 +1,15 @@
 /* Driver template for the LEMON parser generator.
 ** The author disclaims copyright to this source code.
 */
+/*
+** The grammar this parser was generated from is not part of the tree, so this file
+** is maintained by hand and is the source of truth of the PHQL parser. The #line
+** markers of the generator were removed because they pointed to that grammar.
+** The code after the tables is base.c, keep both copies in sync.
+*/
 /* First off, code is include which follows the "include" declaration
 ** in the input file. */
 #include <stdio.h>
-#line 35 "parser.lemon"
 
 
 #ifdef HAVE_CONFIG_H
@@ -30,8 +35,6 @@ static zval *phql_ret_literal_zval(int type, phql_parser_token *T)
 	add_assoc_long(ret, "type", type);
 	if (T) {
 		add_assoc_stringl(ret, "value", T->token, T->token_len, 1);
-		efree(T->token);
-		efree(T);
 	}
 
 	return ret;
@@ -45,8 +48,6 @@ static zval *phql_ret_placeholder_zval(int type, phql_parser_token *T)
 	array_init(ret);
 	add_assoc_long(ret, "type", type);
 	add_assoc_stringl(ret, "value", T->token, T->token_len, 1);
-	efree(T->token);
-	efree(T);
 
 	return ret;
 }
@@ -61,13 +62,9 @@ static zval *phql_ret_qualified_name(phql_parser_token *A, phql_parser_token *B)
 	if (B != NULL) {
 		add_assoc_stringl(ret, "domain", A->token, A->token_len, 1);
 		add_assoc_stringl(ret, "name", B->token, B->token_len, 1);
-		efree(B->token);
-		efree(B);
 	} else {
 		add_assoc_stringl(ret, "name", A->token, A->token_len, 1);
 	}
-	efree(A->token);
-	efree(A);
 
 	return ret;
 }
@@ -207,36 +204,23 @@ static zval *phql_ret_delete_clause(zval *tables)
 	return ret;
 }
 
+/**
+ * Lists are built while reducing their rules, so items are appended to the list built so far
+ * instead of copying it for every new item
+ */
 static zval *phql_ret_zval_list(zval *list_left, zval *right_list)
 {
 
 	zval *ret;
-	HashPosition pos;
-	HashTable *list;
-
-	MAKE_STD_ZVAL(ret);
-	array_init(ret);
-
-	list = Z_ARRVAL_P(list_left);
-	if (zend_hash_index_exists(list, 0)) {
-		zend_hash_internal_pointer_reset_ex(list, &pos);
-		for (;; zend_hash_move_forward_ex(list, &pos)) {
-
-			zval ** item;
-
-			if (zend_hash_get_current_data_ex(list, (void**)&item, &pos) == FAILURE) {
-				break;
-			}
-
-			Z_ADDREF_PP(item);
-			add_next_index_zval(ret, *item);
 
-		}
-		zval_ptr_dtor(&list_left);
-	} else {
-		add_next_index_zval(ret, list_left);
+	if (zend_hash_index_exists(Z_ARRVAL_P(list_left), 0)) {
+		add_next_index_zval(list_left, right_list);
+		return list_left;
 	}
 
+	MAKE_STD_ZVAL(ret);
+	array_init(ret);
+	add_next_index_zval(ret, list_left);
 	add_next_index_zval(ret, right_list);
 
 	return ret;
@@ -255,13 +239,9 @@ static zval *phql_ret_column_item(int type, zval *column, phql_parser_token *ide
 	}
 	if (identifier_column) {
 		add_assoc_stringl(ret, "column", identifier_column->token, identifier_column->token_len, 1);
-		efree(identifier_column->token);
-		efree(identifier_column);
 	}
 	if (alias) {
 		add_assoc_stringl(ret, "alias", alias->token, alias->token_len, 1);
-		efree(alias->token);
-		efree(alias);
 	}
 
 	return ret;
@@ -277,8 +257,6 @@ static zval *phql_ret_assoc_name(zval *qualified_name, phql_parser_token *alias)
 	add_assoc_zval(ret, "qualifiedName", qualified_name);
 	if (alias) {
 		add_assoc_stringl(ret, "alias", alias->token, alias->token_len, 1);
-		efree(alias->token);
-		efree(alias);
 	}
 
 	return ret;
@@ -295,8 +273,6 @@ static zval *phql_ret_join_item(zval *join, phql_parser_token *alias)
 	add_assoc_zval(ret, "join", join);
 	if (alias) {
 		add_assoc_stringl(ret, "alias", alias->token, alias->token_len, 1);
-		efree(alias->token);
-		efree(alias);
 	}
 
 	return ret;
@@ -344,16 +320,15 @@ static zval *phql_ret_func_call(phql_parser_token *name, zval *arguments)
 	array_init(ret);
 	add_assoc_long(ret, "type", PHQL_T_FCALL);
 	add_assoc_stringl(ret, "name", name->token, name->token_len, 1);
-	efree(name->token);
-	efree(name);
 
-	add_assoc_zval(ret, "arguments", arguments);
+	if (arguments) {
+		add_assoc_zval(ret, "arguments", arguments);
+	}
 
 	return ret;
 }
 
 
-#line 357 "parser.c"
 /* Next is all token values, in a form suitable for use by makeheaders.
 ** This section will be null unless lemon is run with the -m switch.
 */
@@ -924,6 +899,50 @@ static void yy_destructor(YYCODETYPE yymajor, YYMINORTYPE *yypminor){
     ** which appear on the RHS of the rule, but which are not used
     ** inside the C code.
     */
+    case 48:
+    case 49:
+    case 50:
+    case 51:
+    case 52:
+    case 53:
+    case 54:
+    case 55:
+    case 56:
+    case 57:
+    case 58:
+    case 59:
+    case 60:
+    case 61:
+    case 62:
+    case 63:
+    case 64:
+    case 65:
+    case 66:
+    case 67:
+    case 68:
+    case 69:
+    case 70:
+    case 71:
+    case 72:
+    case 73:
+    case 74:
+    case 75:
+    case 76:
+    case 77:
+    case 78:
+    case 79:
+    case 80:
+    case 81:
+    case 82:
+    case 83:
+    case 84:
+    case 85:
+{
+	if ((yypminor->yy58)) {
+		zval_ptr_dtor(&(yypminor->yy58));
+	}
+}
+      break;
     default:  break;   /* If no destructor action specified: do nothing */
   }
 }
@@ -1257,11 +1276,9 @@ static void yy_reduce(
   **     break;
   */
       case 0:
-#line 389 "parser.lemon"
 {
 	status->ret = yymsp[0].minor.yy58;
 }
-#line 1265 "parser.c"
         break;
       case 1:
       case 2:
@@ -1288,179 +1305,129 @@ static void yy_reduce(
       case 106:
       case 108:
       case 113:
-#line 393 "parser.lemon"
 {
 	yygotominor.yy58 = yymsp[0].minor.yy58;
 }
-#line 1296 "parser.c"
         break;
       case 5:
-#line 409 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[0].minor.yy58, NULL, NULL, NULL, NULL, NULL);
 }
-#line 1303 "parser.c"
         break;
       case 6:
-#line 413 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-1].minor.yy58, yymsp[0].minor.yy58, NULL, NULL, NULL, NULL);
 }
-#line 1310 "parser.c"
         break;
       case 7:
-#line 417 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-2].minor.yy58, yymsp[-1].minor.yy58, yymsp[0].minor.yy58, NULL, NULL, NULL);
 }
-#line 1317 "parser.c"
         break;
       case 8:
-#line 421 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-2].minor.yy58, yymsp[-1].minor.yy58, NULL, yymsp[0].minor.yy58, NULL, NULL);
 }
-#line 1324 "parser.c"
         break;
       case 9:
-#line 425 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-3].minor.yy58, yymsp[-2].minor.yy58, NULL, yymsp[-1].minor.yy58, yymsp[0].minor.yy58, NULL);
 }
-#line 1331 "parser.c"
         break;
       case 10:
-#line 429 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-3].minor.yy58, yymsp[-2].minor.yy58, yymsp[0].minor.yy58, yymsp[-1].minor.yy58, NULL, NULL);
 }
-#line 1338 "parser.c"
         break;
       case 11:
-#line 433 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-4].minor.yy58, yymsp[-3].minor.yy58, yymsp[-1].minor.yy58, yymsp[-2].minor.yy58, NULL, yymsp[0].minor.yy58);
 }
-#line 1345 "parser.c"
         break;
       case 12:
-#line 437 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-4].minor.yy58, yymsp[-3].minor.yy58, yymsp[0].minor.yy58, yymsp[-2].minor.yy58, yymsp[-1].minor.yy58, NULL);
 }
-#line 1352 "parser.c"
         break;
       case 13:
-#line 441 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-2].minor.yy58, yymsp[-1].minor.yy58, NULL, NULL, NULL, yymsp[0].minor.yy58);
 }
-#line 1359 "parser.c"
         break;
       case 14:
-#line 445 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-3].minor.yy58, yymsp[-2].minor.yy58, yymsp[-1].minor.yy58, NULL, NULL, yymsp[0].minor.yy58);
 }
-#line 1366 "parser.c"
         break;
       case 15:
-#line 449 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-3].minor.yy58, yymsp[-2].minor.yy58, NULL, yymsp[-1].minor.yy58, NULL, yymsp[0].minor.yy58);
 }
-#line 1373 "parser.c"
         break;
       case 16:
-#line 453 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-1].minor.yy58, NULL, yymsp[0].minor.yy58, NULL, NULL, NULL);
 }
-#line 1380 "parser.c"
         break;
       case 17:
-#line 457 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-2].minor.yy58, NULL, yymsp[0].minor.yy58, yymsp[-1].minor.yy58, NULL, NULL);
 }
-#line 1387 "parser.c"
         break;
       case 18:
-#line 461 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-3].minor.yy58, NULL, yymsp[0].minor.yy58, yymsp[-2].minor.yy58, yymsp[-1].minor.yy58, NULL);
 }
-#line 1394 "parser.c"
         break;
       case 19:
-#line 465 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-2].minor.yy58, NULL, yymsp[-1].minor.yy58, NULL, NULL, yymsp[0].minor.yy58);
 }
-#line 1401 "parser.c"
         break;
       case 20:
-#line 469 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-3].minor.yy58, NULL, yymsp[-1].minor.yy58, yymsp[-2].minor.yy58, NULL, yymsp[0].minor.yy58);
 }
-#line 1408 "parser.c"
         break;
       case 21:
-#line 473 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-5].minor.yy58, yymsp[-4].minor.yy58, yymsp[-1].minor.yy58, yymsp[-3].minor.yy58, yymsp[-2].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1415 "parser.c"
         break;
       case 22:
-#line 477 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-1].minor.yy58, NULL, NULL, yymsp[0].minor.yy58, NULL, NULL);
 }
-#line 1422 "parser.c"
         break;
       case 23:
-#line 481 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-2].minor.yy58, NULL, NULL, yymsp[-1].minor.yy58, NULL, yymsp[0].minor.yy58);
 }
-#line 1429 "parser.c"
         break;
       case 24:
-#line 485 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-2].minor.yy58, NULL, NULL, yymsp[-1].minor.yy58, yymsp[0].minor.yy58, NULL);
 }
-#line 1436 "parser.c"
         break;
       case 25:
-#line 489 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-3].minor.yy58, NULL, NULL, yymsp[-2].minor.yy58, yymsp[-1].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1443 "parser.c"
         break;
       case 26:
-#line 493 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_statement(yymsp[-1].minor.yy58, NULL, NULL, NULL, NULL, yymsp[0].minor.yy58);
 }
-#line 1450 "parser.c"
         break;
       case 27:
-#line 497 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_clause(yymsp[-2].minor.yy58, yymsp[0].minor.yy58, NULL);
 }
-#line 1457 "parser.c"
         break;
       case 28:
-#line 501 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_select_clause(yymsp[-3].minor.yy58, yymsp[-1].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1464 "parser.c"
         break;
       case 29:
       case 36:
@@ -1470,417 +1437,301 @@ static void yy_reduce(
       case 78:
       case 83:
       case 105:
-#line 505 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_zval_list(yymsp[-2].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1478 "parser.c"
         break;
       case 31:
       case 107:
-#line 513 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_column_item(PHQL_T_ALL, NULL, NULL, NULL);
 }
-#line 1486 "parser.c"
         break;
       case 32:
-#line 517 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_column_item(PHQL_T_DOMAINALL, NULL, yymsp[-2].minor.yy0, NULL);
 }
-#line 1493 "parser.c"
         break;
       case 33:
-#line 521 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_column_item(PHQL_T_EXPR, yymsp[-2].minor.yy58, NULL, yymsp[0].minor.yy0);
 }
-#line 1500 "parser.c"
         break;
       case 34:
-#line 525 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_column_item(PHQL_T_EXPR, yymsp[-1].minor.yy58, NULL, yymsp[0].minor.yy0);
 }
-#line 1507 "parser.c"
         break;
       case 35:
-#line 529 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_column_item(PHQL_T_EXPR, yymsp[0].minor.yy58, NULL, NULL);
 }
-#line 1514 "parser.c"
         break;
       case 38:
-#line 541 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_zval_list(yymsp[-1].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1521 "parser.c"
         break;
       case 41:
-#line 553 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_join_item(yymsp[0].minor.yy58, NULL);
 }
-#line 1528 "parser.c"
         break;
       case 42:
-#line 557 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_join_item(yymsp[-2].minor.yy58, yymsp[0].minor.yy0);
 }
-#line 1535 "parser.c"
         break;
       case 43:
       case 45:
-#line 561 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_join_clause(PHQL_T_INNERJOIN, yymsp[0].minor.yy58, NULL);
 }
-#line 1543 "parser.c"
         break;
       case 44:
       case 46:
-#line 565 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_join_clause(PHQL_T_INNERJOIN, yymsp[-2].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1551 "parser.c"
         break;
       case 47:
-#line 577 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_join_clause(PHQL_T_LEFTJOIN, yymsp[0].minor.yy58, NULL);
 }
-#line 1558 "parser.c"
         break;
       case 48:
-#line 581 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_join_clause(PHQL_T_LEFTJOIN, yymsp[-2].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1565 "parser.c"
         break;
       case 49:
-#line 585 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_join_clause(PHQL_T_RIGHTJOIN, yymsp[0].minor.yy58, NULL);
 }
-#line 1572 "parser.c"
         break;
       case 50:
-#line 589 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_join_clause(PHQL_T_RIGHTJOIN, yymsp[-2].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1579 "parser.c"
         break;
       case 51:
-#line 594 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_insert_statement(yymsp[-4].minor.yy58, NULL, yymsp[-1].minor.yy58);
 }
-#line 1586 "parser.c"
         break;
       case 52:
-#line 598 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_insert_statement(yymsp[-7].minor.yy58, yymsp[-5].minor.yy58, yymsp[-1].minor.yy58);
 }
-#line 1593 "parser.c"
         break;
       case 58:
       case 121:
-#line 622 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_qualified_name(yymsp[0].minor.yy0, NULL);
 }
-#line 1601 "parser.c"
         break;
       case 59:
-#line 627 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_update_statement(yymsp[0].minor.yy58, NULL, NULL);
 }
-#line 1608 "parser.c"
         break;
       case 60:
-#line 631 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_update_statement(yymsp[-1].minor.yy58, yymsp[0].minor.yy58, NULL);
 }
-#line 1615 "parser.c"
         break;
       case 61:
-#line 635 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_update_statement(yymsp[-1].minor.yy58, NULL, yymsp[0].minor.yy58);
 }
-#line 1622 "parser.c"
         break;
       case 62:
-#line 639 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_update_statement(yymsp[-2].minor.yy58, yymsp[-1].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1629 "parser.c"
         break;
       case 63:
-#line 643 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_update_clause(yymsp[-2].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1636 "parser.c"
         break;
       case 66:
-#line 655 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_update_item(yymsp[-2].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1643 "parser.c"
         break;
       case 68:
-#line 664 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_delete_statement(yymsp[0].minor.yy58, NULL, NULL);
 }
-#line 1650 "parser.c"
         break;
       case 69:
-#line 668 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_delete_statement(yymsp[-1].minor.yy58, yymsp[0].minor.yy58, NULL);
 }
-#line 1657 "parser.c"
         break;
       case 70:
-#line 672 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_delete_statement(yymsp[-1].minor.yy58, NULL, yymsp[0].minor.yy58);
 }
-#line 1664 "parser.c"
         break;
       case 71:
-#line 676 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_delete_statement(yymsp[-2].minor.yy58, yymsp[-1].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1671 "parser.c"
         break;
       case 72:
-#line 680 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_delete_clause(yymsp[0].minor.yy58);
 }
-#line 1678 "parser.c"
         break;
       case 73:
-#line 684 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_assoc_name(yymsp[-2].minor.yy58, yymsp[0].minor.yy0);
 }
-#line 1685 "parser.c"
         break;
       case 74:
-#line 688 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_assoc_name(yymsp[-1].minor.yy58, yymsp[0].minor.yy0);
 }
-#line 1692 "parser.c"
         break;
       case 75:
-#line 692 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_assoc_name(yymsp[0].minor.yy58, NULL);
 }
-#line 1699 "parser.c"
         break;
       case 81:
       case 86:
       case 88:
       case 114:
-#line 716 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_literal_zval(PHQL_T_INTEGER, yymsp[0].minor.yy0);
 }
-#line 1709 "parser.c"
         break;
       case 89:
-#line 748 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_expr(PHQL_T_SUB, yymsp[-2].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1716 "parser.c"
         break;
       case 90:
-#line 752 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_expr(PHQL_T_ADD, yymsp[-2].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1723 "parser.c"
         break;
       case 91:
-#line 756 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_expr(PHQL_T_MUL, yymsp[-2].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1730 "parser.c"
         break;
       case 92:
-#line 760 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_expr(PHQL_T_DIV, yymsp[-2].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1737 "parser.c"
         break;
       case 93:
-#line 764 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_expr(PHQL_T_AND, yymsp[-2].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1744 "parser.c"
         break;
       case 94:
-#line 768 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_expr(PHQL_T_OR, yymsp[-2].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1751 "parser.c"
         break;
       case 95:
-#line 772 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_expr(PHQL_T_EQUALS, yymsp[-2].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1758 "parser.c"
         break;
       case 96:
-#line 776 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_expr(PHQL_T_NOTEQUALS, yymsp[-2].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1765 "parser.c"
         break;
       case 97:
-#line 780 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_expr(PHQL_T_LESS, yymsp[-2].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1772 "parser.c"
         break;
       case 98:
-#line 784 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_expr(PHQL_T_GREATER, yymsp[-2].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1779 "parser.c"
         break;
       case 99:
-#line 788 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_expr(PHQL_T_LIKE, yymsp[-2].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1786 "parser.c"
         break;
       case 100:
-#line 792 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_expr(PHQL_T_NLIKE, yymsp[-3].minor.yy58, yymsp[0].minor.yy58);
 }
-#line 1793 "parser.c"
         break;
       case 101:
-#line 796 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_expr(PHQL_T_IN, yymsp[-4].minor.yy58, yymsp[-1].minor.yy58);
 }
-#line 1800 "parser.c"
         break;
       case 103:
-#line 804 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_func_call(yymsp[-3].minor.yy0, yymsp[-1].minor.yy58);
 }
-#line 1807 "parser.c"
         break;
       case 104:
-#line 808 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_func_call(yymsp[-2].minor.yy0, NULL);
 }
-#line 1814 "parser.c"
         break;
       case 109:
-#line 828 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_expr(PHQL_T_ISNULL, NULL, yymsp[-2].minor.yy58);
 }
-#line 1821 "parser.c"
         break;
       case 110:
-#line 832 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_expr(PHQL_T_ISNOTNULL, NULL, yymsp[-3].minor.yy58);
 }
-#line 1828 "parser.c"
         break;
       case 111:
-#line 836 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_expr(PHQL_T_NOT, NULL, yymsp[0].minor.yy58);
 }
-#line 1835 "parser.c"
         break;
       case 112:
-#line 840 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_expr(PHQL_T_ENCLOSED, yymsp[-1].minor.yy58, NULL);
 }
-#line 1842 "parser.c"
         break;
       case 115:
-#line 852 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_literal_zval(PHQL_T_STRING, yymsp[0].minor.yy0);
 }
-#line 1849 "parser.c"
         break;
       case 116:
-#line 856 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_literal_zval(PHQL_T_DOUBLE, yymsp[0].minor.yy0);
 }
-#line 1856 "parser.c"
         break;
       case 117:
-#line 860 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_literal_zval(PHQL_T_NULL, NULL);
 }
-#line 1863 "parser.c"
         break;
       case 118:
-#line 864 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_placeholder_zval(PHQL_T_NPLACEHOLDER, yymsp[0].minor.yy0);
 }
-#line 1870 "parser.c"
         break;
       case 119:
-#line 868 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_placeholder_zval(PHQL_T_SPLACEHOLDER, yymsp[0].minor.yy0);
 }
-#line 1877 "parser.c"
         break;
       case 120:
-#line 872 "parser.lemon"
 {
 	yygotominor.yy58 = phql_ret_qualified_name(yymsp[-2].minor.yy0, yymsp[0].minor.yy0);
 }
-#line 1884 "parser.c"
         break;
   };
   yygoto = yyRuleInfo[yyruleno].lhs;
@@ -1922,12 +1773,16 @@ static void yy_syntax_error(
 ){
   phql_ARG_FETCH;
 #define TOKEN (yyminor.yy0)
-#line 384 "parser.lemon"
 
-	fprintf(stderr, "Syntax error near to %s!\n", status->scanner_state->start);
+	if (!status->syntax_error) {
+		if (status->scanner_state->start && *status->scanner_state->start) {
+			spprintf(&status->syntax_error, 0, "Syntax error, unexpected token near to '%s'", status->scanner_state->start);
+		} else {
+			status->syntax_error = estrdup("Syntax error, unexpected EOF");
+		}
+	}
 	status->status = PHQL_PARSING_FAILED;
 
-#line 1931 "parser.c"
   phql_ARG_STORE; /* Suppress warning about unused %extra_argument variable */
 }
 
@@ -2125,38 +1980,90 @@ static void phql_wrapper_free(void *pointer){
 	efree(pointer);
 }
 
+static void phql_arena_init(phql_arena *arena){
+	arena->cursor = arena->buffer;
+	arena->limit = arena->buffer + PHQL_ARENA_SIZE;
+	arena->blocks = NULL;
+}
+
+/**
+ * Allocates memory from the arena, a new block is chained when the current one is exhausted
+ */
+static void *phql_arena_alloc(phql_arena *arena, size_t bytes){
+
+	void **block;
+	size_t block_size;
+	char *pointer;
+
+	bytes = ZEND_MM_ALIGNED_SIZE(bytes);
+	if ((size_t) (arena->limit - arena->cursor) < bytes) {
+		block_size = bytes > PHQL_ARENA_SIZE ? bytes : PHQL_ARENA_SIZE;
+		block = emalloc(ZEND_MM_ALIGNED_SIZE(sizeof(void *)) + block_size);
+		*block = arena->blocks;
+		arena->blocks = block;
+		arena->cursor = (char *) block + ZEND_MM_ALIGNED_SIZE(sizeof(void *));
+		arena->limit = arena->cursor + block_size;
+	}
+
+	pointer = arena->cursor;
+	arena->cursor += bytes;
+	return pointer;
+}
+
+/**
+ * Releases everything allocated by a parse
+ */
+static void phql_arena_free(phql_arena *arena){
+
+	void **block, *next;
+
+	block = arena->blocks;
+	while (block) {
+		next = *block;
+		efree(block);
+		block = next;
+	}
+	arena->blocks = NULL;
+}
+
 static void phql_parse_with_token(void* phql_parser, int opcode, int parsercode, phql_scanner_token *token, phql_parser_status *parser_status){
 	phql_parser_token *pToken;
-	pToken = emalloc(sizeof(phql_parser_token));
+	pToken = phql_arena_alloc(parser_status->arena, sizeof(phql_parser_token));
 	pToken->opcode = opcode;
-	pToken->token = estrndup(token->value, token->len);
+	pToken->token = token->value;
 	pToken->token_len = token->len;
 	phql_(phql_parser, parsercode, pToken, parser_status);
-	efree(token->value);
 }
 
-int phql_parse_sql(zval *result, zval *sql){
-	zval *error_msg;
-	return phql_internal_parse_sql(&result, Z_STRVAL_P(sql), &error_msg);
+int phql_parse_sql(zval *result, zval *sql TSRMLS_DC){
+	zval *error_msg = NULL;
+	return phql_internal_parse_sql(&result, Z_STRVAL_P(sql), &error_msg TSRMLS_CC);
 }
 
-int phql_internal_parse_sql(zval **result, char *sql, zval **error_msg) {
+/**
+ * Parses a PHQL statement. The scanner and the parser keep their state in the stack of this function,
+ * the tokens point to the statement and the intermediate representation is built while reducing the rules
+ */
+int phql_internal_parse_sql(zval **result, char *sql, zval **error_msg TSRMLS_DC) {
 
 	char *error;
-	phql_scanner_state *state;
-	phql_scanner_token *token;
+	phql_scanner_state scanner_state, *state = &scanner_state;
+	phql_scanner_token scanner_token, *token = &scanner_token;
+	phql_parser_status status_buffer, *parser_status = &status_buffer;
+	phql_arena arena;
 	int scanner_status, status = SUCCESS;
-	phql_parser_status *parser_status = NULL;
-	TSRMLS_FETCH();
 
 	void* phql_parser = phql_Alloc(phql_wrapper_alloc);
 
-	parser_status = emalloc(sizeof(phql_parser_status));
-	state = emalloc(sizeof(phql_scanner_state));
-	token = emalloc(sizeof(phql_scanner_token));
+	phql_arena_init(&arena);
+
+	*error_msg = NULL;
 
 	parser_status->status = PHQL_PARSING_OK;
+	parser_status->ret = NULL;
+	parser_status->syntax_error = NULL;
 	parser_status->scanner_state = state;
+	parser_status->arena = &arena;
 	state->start = sql;
 
 	state->end = state->start;
@@ -2343,16 +2250,35 @@ int phql_internal_parse_sql(zval **result, char *sql, zval **error_msg) {
 	}
 
 	phql_Free(phql_parser, phql_wrapper_free);
+	phql_arena_free(&arena);
+
+	/** Errors found by the parser after the last token are reported too */
+	if (parser_status->status != PHQL_PARSING_OK) {
+		status = FAILURE;
+		if (!*error_msg) {
+			PHALCON_ALLOC_ZVAL_MM(*error_msg);
+			if (parser_status->syntax_error) {
+				ZVAL_STRING(*error_msg, parser_status->syntax_error, 1);
+			} else {
+				ZVAL_STRING(*error_msg, "Syntax error", 1);
+			}
+		}
+	}
 
-	if (parser_status->status == PHQL_PARSING_OK) {
+	if (parser_status->syntax_error) {
+		efree(parser_status->syntax_error);
+	}
+
+	if (status == SUCCESS && parser_status->ret) {
 		ZVAL_ZVAL(*result, parser_status->ret, 0, 0);
 		ZVAL_NULL(parser_status->ret);
 		zval_ptr_dtor(&parser_status->ret);
+	} else {
+		if (parser_status->ret) {
+			zval_ptr_dtor(&parser_status->ret);
+		}
+		status = FAILURE;
 	}
 
-	efree(parser_status);
-	efree(state);
-	efree(token);
-
 	return status;
 }
\ No newline at end of file
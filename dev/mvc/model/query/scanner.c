@@ -1,5 +1,9 @@
 /* Generated by re2c 0.13.5 on Fri Aug 17 18:51:19 2012 */
-#line 1 "scanner.re"
+/*
+ * The specification this scanner was generated from is not part of the tree, so this file
+ * is maintained by hand and is the source of truth of the PHQL scanner. The #line markers
+ * of the generator were removed because they pointed to that specification
+ */
 
 /*
   +------------------------------------------------------------------------+
@@ -41,7 +45,6 @@ int phql_get_token(phql_scanner_state *s, phql_scanner_token *token) {
 	while(PHQL_SCANNER_RETCODE_IMPOSSIBLE == status) {
 
 		
-#line 45 "scanner.c"
 		{
 			YYCTYPE yych;
 
@@ -149,15 +152,13 @@ yy2:
 			default:	goto yy3;
 			}
 yy3:
-#line 46 "scanner.re"
 			{
 			token->opcode = PHQL_T_INTEGER;
-			token->value = estrndup(q, YYCURSOR - q);
+			token->value = q;
 			token->len = YYCURSOR - q;
 			q = YYCURSOR;
 			return 0;
 		}
-#line 161 "scanner.c"
 yy4:
 			++YYCURSOR;
 			switch ((yych = *YYCURSOR)) {
@@ -174,12 +175,10 @@ yy4:
 			default:	goto yy5;
 			}
 yy5:
-#line 254 "scanner.re"
 			{
 			token->opcode = PHQL_T_DOT;
 			return 0;
 		}
-#line 183 "scanner.c"
 yy6:
 			++YYCURSOR;
 			switch ((yych = *YYCURSOR)) {
@@ -196,12 +195,10 @@ yy6:
 			default:	goto yy7;
 			}
 yy7:
-#line 324 "scanner.re"
 			{
 			status = PHQL_SCANNER_RETCODE_ERR;
 			break;
 		}
-#line 205 "scanner.c"
 yy8:
 			yych = *(YYMARKER = ++YYCURSOR);
 			switch (yych) {
@@ -278,15 +275,13 @@ yy9:
 			default:	goto yy67;
 			}
 yy10:
-#line 226 "scanner.re"
 			{
 			token->opcode = PHQL_T_IDENTIFIER;
-			token->value = estrndup(q, YYCURSOR - q);
+			token->value = q;
 			token->len = YYCURSOR - q;
 			q = YYCURSOR;
 			return 0;
 		}
-#line 290 "scanner.c"
 yy11:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -415,60 +410,46 @@ yy28:
 			goto yy67;
 yy29:
 			++YYCURSOR;
-#line 234 "scanner.re"
 			{
 			token->opcode = PHQL_T_ADD;
 			return 0;
 		}
-#line 424 "scanner.c"
 yy31:
 			++YYCURSOR;
-#line 239 "scanner.re"
 			{
 			token->opcode = PHQL_T_SUB;
 			return 0;
 		}
-#line 432 "scanner.c"
 yy33:
 			++YYCURSOR;
-#line 244 "scanner.re"
 			{
 			token->opcode = PHQL_T_MUL;
 			return 0;
 		}
-#line 440 "scanner.c"
 yy35:
 			++YYCURSOR;
-#line 249 "scanner.re"
 			{
 			token->opcode = PHQL_T_DIV;
 			return 0;
 		}
-#line 448 "scanner.c"
 yy37:
 			++YYCURSOR;
-#line 259 "scanner.re"
 			{
 			token->opcode = PHQL_T_COMMA;
 			return 0;
 		}
-#line 456 "scanner.c"
 yy39:
 			++YYCURSOR;
-#line 264 "scanner.re"
 			{
 			token->opcode = PHQL_T_BRACKET_OPEN;
 			return 0;
 		}
-#line 464 "scanner.c"
 yy41:
 			++YYCURSOR;
-#line 269 "scanner.re"
 			{
 			token->opcode = PHQL_T_BRACKET_CLOSE;
 			return 0;
 		}
-#line 472 "scanner.c"
 yy43:
 			++YYCURSOR;
 			switch ((yych = *YYCURSOR)) {
@@ -476,12 +457,10 @@ yy43:
 			default:	goto yy44;
 			}
 yy44:
-#line 299 "scanner.re"
 			{
 			token->opcode = PHQL_T_NOT;
 			return 0;
 		}
-#line 485 "scanner.c"
 yy45:
 			++YYCURSOR;
 			switch ((yych = *YYCURSOR)) {
@@ -490,12 +469,10 @@ yy45:
 			default:	goto yy46;
 			}
 yy46:
-#line 304 "scanner.re"
 			{
 			token->opcode = PHQL_T_LESS;
 			return 0;
 		}
-#line 499 "scanner.c"
 yy47:
 			++YYCURSOR;
 			switch ((yych = *YYCURSOR)) {
@@ -503,39 +480,31 @@ yy47:
 			default:	goto yy48;
 			}
 yy48:
-#line 309 "scanner.re"
 			{
 			token->opcode = PHQL_T_GREATER;
 			return 0;
 		}
-#line 512 "scanner.c"
 yy49:
 			++YYCURSOR;
-#line 294 "scanner.re"
 			{
 			token->opcode = PHQL_T_EQUALS;
 			return 0;
 		}
-#line 520 "scanner.c"
 yy51:
 			++YYCURSOR;
 			yych = *YYCURSOR;
 			goto yy57;
 yy52:
-#line 314 "scanner.re"
 			{
 			token->opcode = PHQL_T_IGNORE;
 			return 0;
 		}
-#line 531 "scanner.c"
 yy53:
 			++YYCURSOR;
-#line 319 "scanner.re"
 			{
 			status = PHQL_SCANNER_RETCODE_EOF;
 			break;
 		}
-#line 539 "scanner.c"
 yy55:
 			yych = *++YYCURSOR;
 			goto yy7;
@@ -552,36 +521,28 @@ yy57:
 			}
 yy58:
 			++YYCURSOR;
-#line 289 "scanner.re"
 			{
 			token->opcode = PHQL_T_GREATEREQUAL;
 			return 0;
 		}
-#line 561 "scanner.c"
 yy60:
 			++YYCURSOR;
-#line 284 "scanner.re"
 			{
 			token->opcode = PHQL_T_LESSEQUAL;
 			return 0;
 		}
-#line 569 "scanner.c"
 yy62:
 			++YYCURSOR;
-#line 279 "scanner.re"
 			{
 			token->opcode = PHQL_T_NOTEQUALS;
 			return 0;
 		}
-#line 577 "scanner.c"
 yy64:
 			++YYCURSOR;
-#line 274 "scanner.re"
 			{
 			token->opcode = PHQL_T_NOTEQUALS;
 			return 0;
 		}
-#line 585 "scanner.c"
 yy66:
 			++YYCURSOR;
 			yych = *YYCURSOR;
@@ -674,15 +635,13 @@ yy71:
 			}
 yy72:
 			++YYCURSOR;
-#line 217 "scanner.re"
 			{
 			token->opcode = PHQL_T_STRING;
-			token->value = estrndup(q, YYCURSOR - q - 1);
+			token->value = q;
 			token->len = YYCURSOR - q - 1;
 			q = YYCURSOR;
 			return 0;
 		}
-#line 686 "scanner.c"
 yy74:
 			++YYCURSOR;
 			yych = *YYCURSOR;
@@ -790,12 +749,10 @@ yy80:
 			default:	goto yy81;
 			}
 yy81:
-#line 201 "scanner.re"
 			{
 			token->opcode = PHQL_T_RIGHT;
 			return 0;
 		}
-#line 799 "scanner.c"
 yy82:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -879,12 +836,10 @@ yy84:
 			default:	goto yy85;
 			}
 yy85:
-#line 186 "scanner.re"
 			{
 			token->opcode = PHQL_T_JOIN;
 			return 0;
 		}
-#line 888 "scanner.c"
 yy86:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -975,12 +930,10 @@ yy89:
 			default:	goto yy90;
 			}
 yy90:
-#line 211 "scanner.re"
 			{
 			token->opcode = PHQL_T_NULL;
 			return 0;
 		}
-#line 984 "scanner.c"
 yy91:
 			++YYCURSOR;
 			switch ((yych = *YYCURSOR)) {
@@ -1050,12 +1003,10 @@ yy91:
 			default:	goto yy92;
 			}
 yy92:
-#line 156 "scanner.re"
 			{
 			token->opcode = PHQL_T_NOT;
 			return 0;
 		}
-#line 1059 "scanner.c"
 yy93:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -1155,12 +1106,10 @@ yy97:
 			default:	goto yy98;
 			}
 yy98:
-#line 171 "scanner.re"
 			{
 			token->opcode = PHQL_T_LIKE;
 			return 0;
 		}
-#line 1164 "scanner.c"
 yy99:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -1237,12 +1186,10 @@ yy100:
 			default:	goto yy101;
 			}
 yy101:
-#line 151 "scanner.re"
 			{
 			token->opcode = PHQL_T_LIMIT;
 			return 0;
 		}
-#line 1246 "scanner.c"
 yy102:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -1319,12 +1266,10 @@ yy103:
 			default:	goto yy104;
 			}
 yy104:
-#line 196 "scanner.re"
 			{
 			token->opcode = PHQL_T_LEFT;
 			return 0;
 		}
-#line 1328 "scanner.c"
 yy105:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -1422,12 +1367,10 @@ yy109:
 			default:	goto yy110;
 			}
 yy110:
-#line 146 "scanner.re"
 			{
 			token->opcode = PHQL_T_HAVING;
 			return 0;
 		}
-#line 1431 "scanner.c"
 yy111:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -1518,12 +1461,10 @@ yy114:
 			default:	goto yy115;
 			}
 yy115:
-#line 141 "scanner.re"
 			{
 			token->opcode = PHQL_T_GROUP;
 			return 0;
 		}
-#line 1527 "scanner.c"
 yy116:
 			++YYCURSOR;
 			switch ((yych = *YYCURSOR)) {
@@ -1593,12 +1534,10 @@ yy116:
 			default:	goto yy117;
 			}
 yy117:
-#line 136 "scanner.re"
 			{
 			token->opcode = PHQL_T_BY;
 			return 0;
 		}
-#line 1602 "scanner.c"
 yy118:
 			++YYCURSOR;
 			switch ((yych = *YYCURSOR)) {
@@ -1668,12 +1607,10 @@ yy118:
 			default:	goto yy119;
 			}
 yy119:
-#line 181 "scanner.re"
 			{
 			token->opcode = PHQL_T_ON;
 			return 0;
 		}
-#line 1677 "scanner.c"
 yy120:
 			++YYCURSOR;
 			switch ((yych = *YYCURSOR)) {
@@ -1743,12 +1680,10 @@ yy120:
 			default:	goto yy121;
 			}
 yy121:
-#line 166 "scanner.re"
 			{
 			token->opcode = PHQL_T_OR;
 			return 0;
 		}
-#line 1752 "scanner.c"
 yy122:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -1832,12 +1767,10 @@ yy124:
 			default:	goto yy125;
 			}
 yy125:
-#line 131 "scanner.re"
 			{
 			token->opcode = PHQL_T_ORDER;
 			return 0;
 		}
-#line 1841 "scanner.c"
 yy126:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -1928,12 +1861,10 @@ yy129:
 			default:	goto yy130;
 			}
 yy130:
-#line 121 "scanner.re"
 			{
 			token->opcode = PHQL_T_WHERE;
 			return 0;
 		}
-#line 1937 "scanner.c"
 yy131:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -2031,12 +1962,10 @@ yy135:
 			default:	goto yy136;
 			}
 yy136:
-#line 116 "scanner.re"
 			{
 			token->opcode = PHQL_T_VALUES;
 			return 0;
 		}
-#line 2040 "scanner.c"
 yy137:
 			++YYCURSOR;
 			switch ((yych = *YYCURSOR)) {
@@ -2106,12 +2035,10 @@ yy137:
 			default:	goto yy138;
 			}
 yy138:
-#line 176 "scanner.re"
 			{
 			token->opcode = PHQL_T_IN;
 			return 0;
 		}
-#line 2115 "scanner.c"
 yy139:
 			++YYCURSOR;
 			switch ((yych = *YYCURSOR)) {
@@ -2181,12 +2108,10 @@ yy139:
 			default:	goto yy140;
 			}
 yy140:
-#line 206 "scanner.re"
 			{
 			token->opcode = PHQL_T_IS;
 			return 0;
 		}
-#line 2190 "scanner.c"
 yy141:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -2284,12 +2209,10 @@ yy145:
 			default:	goto yy146;
 			}
 yy146:
-#line 191 "scanner.re"
 			{
 			token->opcode = PHQL_T_INNER;
 			return 0;
 		}
-#line 2293 "scanner.c"
 yy147:
 			++YYCURSOR;
 			switch ((yych = *YYCURSOR)) {
@@ -2359,12 +2282,10 @@ yy147:
 			default:	goto yy148;
 			}
 yy148:
-#line 111 "scanner.re"
 			{
 			token->opcode = PHQL_T_INTO;
 			return 0;
 		}
-#line 2368 "scanner.c"
 yy149:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -2448,12 +2369,10 @@ yy151:
 			default:	goto yy152;
 			}
 yy152:
-#line 106 "scanner.re"
 			{
 			token->opcode = PHQL_T_INSERT;
 			return 0;
 		}
-#line 2457 "scanner.c"
 yy153:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -2530,12 +2449,10 @@ yy154:
 			default:	goto yy155;
 			}
 yy155:
-#line 101 "scanner.re"
 			{
 			token->opcode = PHQL_T_AS;
 			return 0;
 		}
-#line 2539 "scanner.c"
 yy156:
 			++YYCURSOR;
 			switch ((yych = *YYCURSOR)) {
@@ -2605,12 +2522,10 @@ yy156:
 			default:	goto yy157;
 			}
 yy157:
-#line 161 "scanner.re"
 			{
 			token->opcode = PHQL_T_AND;
 			return 0;
 		}
-#line 2614 "scanner.c"
 yy158:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -2694,12 +2609,10 @@ yy160:
 			default:	goto yy161;
 			}
 yy161:
-#line 96 "scanner.re"
 			{
 			token->opcode = PHQL_T_FROM;
 			return 0;
 		}
-#line 2703 "scanner.c"
 yy162:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -2797,12 +2710,10 @@ yy166:
 			default:	goto yy167;
 			}
 yy167:
-#line 91 "scanner.re"
 			{
 			token->opcode = PHQL_T_DELETE;
 			return 0;
 		}
-#line 2806 "scanner.c"
 yy168:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -2881,12 +2792,10 @@ yy169:
 			default:	goto yy170;
 			}
 yy170:
-#line 86 "scanner.re"
 			{
 			token->opcode = PHQL_T_SET;
 			return 0;
 		}
-#line 2890 "scanner.c"
 yy171:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -2977,12 +2886,10 @@ yy174:
 			default:	goto yy175;
 			}
 yy175:
-#line 126 "scanner.re"
 			{
 			token->opcode = PHQL_T_SELECT;
 			return 0;
 		}
-#line 2986 "scanner.c"
 yy176:
 			yych = *++YYCURSOR;
 			switch (yych) {
@@ -3080,12 +2987,10 @@ yy180:
 			default:	goto yy181;
 			}
 yy181:
-#line 81 "scanner.re"
 			{
 			token->opcode = PHQL_T_UPDATE;
 			return 0;
 		}
-#line 3089 "scanner.c"
 yy182:
 			++YYCURSOR;
 			yych = *YYCURSOR;
@@ -3158,15 +3063,13 @@ yy182:
 			}
 yy184:
 			++YYCURSOR;
-#line 73 "scanner.re"
 			{
 			token->opcode = PHQL_T_SPLACEHOLDER;
-			token->value = estrndup(q, YYCURSOR - q - 1);
+			token->value = q;
 			token->len = YYCURSOR - q - 1;
 			q = YYCURSOR;
 			return 0;
 		}
-#line 3170 "scanner.c"
 yy186:
 			++YYCURSOR;
 			yych = *YYCURSOR;
@@ -3184,15 +3087,13 @@ yy186:
 			default:	goto yy188;
 			}
 yy188:
-#line 64 "scanner.re"
 			{
 			token->opcode = PHQL_T_NPLACEHOLDER;
-			token->value = estrndup(q, YYCURSOR - q);
+			token->value = q;
 			token->len = YYCURSOR - q;
 			q = YYCURSOR;
 			return 0;
 		}
-#line 3196 "scanner.c"
 yy189:
 			++YYCURSOR;
 			yych = *YYCURSOR;
@@ -3210,15 +3111,13 @@ yy189:
 			default:	goto yy191;
 			}
 yy191:
-#line 55 "scanner.re"
 			{
 			token->opcode = PHQL_T_DOUBLE;
-			token->value = estrndup(q, YYCURSOR - q);
+			token->value = q;
 			token->len = YYCURSOR - q;
 			q = YYCURSOR;
 			return 0;
 		}
-#line 3222 "scanner.c"
 yy192:
 			++YYCURSOR;
 			yych = *YYCURSOR;
@@ -3253,7 +3152,6 @@ yy194:
 			default:	goto yy3;
 			}
 		}
-#line 329 "scanner.re"
 
 	}
 
@@ -96,11 +96,17 @@
 #define PHQL_T_ISNULL 363
 #define PHQL_T_ISNOTNULL 364
 
+/**
+ * The scanner keeps all its state here, so several statements can be scanned at the same time
+ */
 typedef struct _phql_scanner_state {
 	char* start;
 	char* end;
 } phql_scanner_state;
 
+/**
+ * Tokens are not copied, their values point to the scanned statement and are not null terminated
+ */
 typedef struct _phql_scanner_token {
 	int opcode;
 	char *value;
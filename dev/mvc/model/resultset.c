@@ -36,6 +36,7 @@
 #include "kernel/fcall.h"
 #include "kernel/exception.h"
 #include "kernel/array.h"
+#include "kernel/operators.h"
 
 /**
  * Phalcon\Mvc\Model\Resultset
@@ -50,10 +51,91 @@
  */
 
 /**
- * Phalcon\Mvc\Model\Resultset constructor
+ * Returns the record every row is cloned from, it is created from the source model the first time it is needed.
+ * prototype is NULL when the resultset has no source model. On FAILURE the memory stack of the caller has already been restored
+ */
+static int phalcon_mvc_model_resultset_prototype(zval **prototype, zval *this_ptr TSRMLS_DC){
+
+	zval *model, *force_exists;
+
+	*prototype = zend_read_property(phalcon_mvc_model_resultset_ce, this_ptr, SL("_prototype"), 1 TSRMLS_CC);
+	if (Z_TYPE_PP(prototype) == IS_OBJECT) {
+		return SUCCESS;
+	}
+
+	*prototype = NULL;
+	model = zend_read_property(phalcon_mvc_model_resultset_ce, this_ptr, SL("_model"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(model) != IS_OBJECT) {
+		return SUCCESS;
+	}
+
+	ALLOC_INIT_ZVAL(*prototype);
+	if (phalcon_clone(*prototype, model TSRMLS_CC) == FAILURE) {
+		zval_ptr_dtor(prototype);
+		return FAILURE;
+	}
+
+	ALLOC_INIT_ZVAL(force_exists);
+	ZVAL_BOOL(force_exists, 1);
+	if (phalcon_call_method_one_param(NULL, *prototype, SL("setforceexists"), force_exists, PH_NO_CHECK, 1 TSRMLS_CC) == FAILURE) {
+		zval_ptr_dtor(&force_exists);
+		zval_ptr_dtor(prototype);
+		return FAILURE;
+	}
+	zval_ptr_dtor(&force_exists);
+
+	zend_update_property(phalcon_mvc_model_resultset_ce, this_ptr, SL("_prototype"), *prototype TSRMLS_CC);
+	zval_ptr_dtor(prototype);
+
+	*prototype = zend_read_property(phalcon_mvc_model_resultset_ce, this_ptr, SL("_prototype"), 1 TSRMLS_CC);
+	return SUCCESS;
+}
+
+/**
+ * Appends the rows of a batch returned by Phalcon\Db\Result\Pdo::fetchRows as associative arrays
+ */
+static void phalcon_mvc_model_resultset_append_rows(zval *return_value, zval *columns, zval *batch TSRMLS_DC){
+
+	zval *row;
+	zval **numeric_row, **column, **value;
+	HashPosition hp, hp1;
+	char *str_index;
+	uint str_index_length;
+	ulong num_index;
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(batch), &hp);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(batch), (void**) &numeric_row, &hp) == SUCCESS) {
+
+		if (Z_TYPE_PP(numeric_row) == IS_ARRAY) {
+			ALLOC_INIT_ZVAL(row);
+			array_init_size(row, zend_hash_num_elements(Z_ARRVAL_P(columns)));
+
+			zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(columns), &hp1);
+			while (zend_hash_get_current_data_ex(Z_ARRVAL_P(columns), (void**) &column, &hp1) == SUCCESS) {
+				if (zend_hash_get_current_key_ex(Z_ARRVAL_P(columns), &str_index, &str_index_length, &num_index, 0, &hp1) == HASH_KEY_IS_LONG && zend_hash_index_find(Z_ARRVAL_PP(numeric_row), num_index, (void**) &value) == SUCCESS) {
+					Z_ADDREF_PP(value);
+					if (Z_TYPE_PP(column) == IS_STRING) {
+						zend_symtable_update(Z_ARRVAL_P(row), Z_STRVAL_PP(column), Z_STRLEN_PP(column) + 1, value, sizeof(zval *), NULL);
+					} else {
+						zend_hash_index_update(Z_ARRVAL_P(row), phalcon_get_intval(*column), value, sizeof(zval *), NULL);
+					}
+				}
+				zend_hash_move_forward_ex(Z_ARRVAL_P(columns), &hp1);
+			}
+
+			add_next_index_zval(return_value, row);
+		}
+
+		zend_hash_move_forward_ex(Z_ARRVAL_P(batch), &hp);
+	}
+}
+
+/**
+ * Phalcon\Mvc\Model\Resultset constructor. An array of records can be passed instead of a result, rows passed
+ * as arrays are kept as they are and only hydrated into records when they are accessed
  *
  * @param Phalcon\Mvc\Model $model
- * @param Phalcon\Mvc\Model\Result $result
+ * @param Phalcon\Mvc\Model\Result|array $result
  * @param Phalcon\Cache\Backend $cache
  */
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, __construct){
@@ -72,56 +154,77 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, __construct){
 		ZVAL_NULL(cache);
 	}
 	
-	phalcon_update_property_zval(this_ptr, SL("_model"), model TSRMLS_CC);
-	phalcon_update_property_zval(this_ptr, SL("_result"), result TSRMLS_CC);
-	phalcon_update_property_zval(this_ptr, SL("_cache"), cache TSRMLS_CC);
-	phalcon_update_property_long(this_ptr, SL("_type"), 1 TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_model", model);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_cache", cache);
+	if (Z_TYPE_P(result) == IS_ARRAY) { 
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_rows", result);
+		phalcon_update_property_bool(this_ptr, SL("_result"), 0 TSRMLS_CC);
+		phalcon_update_property_long(this_ptr, SL("_type"), 0 TSRMLS_CC);
+	} else {
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_result", result);
+		phalcon_update_property_long(this_ptr, SL("_type"), 1 TSRMLS_CC);
+	}
 	
 	PHALCON_MM_RESTORE();
 }
 
 /**
- * Check whether internal resource has rows to fetch
+ * Check whether internal resource has rows to fetch. Rows are read from the result in batches, a batch is found by
+ * the position of its first row and the result is only moved when the current row is not in the batch. The row is
+ * kept as it was fetched, it is hydrated into a record only when it is accessed
  *
  * @return boolean
  */
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, valid){
 
-	zval *result = NULL, *row = NULL, *rows = NULL;
-	zval *t0 = NULL, *t1 = NULL;
-	zval *c0 = NULL, *c1 = NULL;
-	zval *r0 = NULL;
+	zval *result = NULL, *row = NULL, *rows = NULL, *batch = NULL;
+	zval *pointer = NULL, *offset = NULL;
+	zval *t0 = NULL;
+	zval *c1 = NULL;
+	zval **record;
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_type"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_type", PH_NOISY_CC);
 	if (zend_is_true(t0)) {
 		PHALCON_INIT_VAR(result);
-		phalcon_read_property(&result, this_ptr, SL("_result"), PH_NOISY_CC);
+		PHALCON_READ_PROPERTY_QUICK(&result, this_ptr, "_result", PH_NOISY_CC);
 		if (Z_TYPE_P(result) != IS_BOOL || (Z_TYPE_P(result) == IS_BOOL && Z_BVAL_P(result))) {
-			PHALCON_INIT_VAR(c0);
-			ZVAL_LONG(c0, 1);
-			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(result, "setfetchmode", c0, PH_NO_CHECK);
 			
-			PHALCON_INIT_VAR(row);
-			PHALCON_CALL_METHOD_PARAMS_1(row, result, "fetcharray", result, PH_NO_CHECK);
-			if (zend_is_true(row)) {
-				PHALCON_ALLOC_ZVAL_MM(t1);
-				phalcon_read_property(&t1, this_ptr, SL("_model"), PH_NOISY_CC);
-				PHALCON_ALLOC_ZVAL_MM(r0);
-				PHALCON_CALL_STATIC_PARAMS_2(r0, "phalcon\\mvc\\model", "dumpresult", t1, row);
-				phalcon_update_property_zval(this_ptr, SL("_activeRow"), r0 TSRMLS_CC);
-				PHALCON_MM_RESTORE();
-				RETURN_TRUE;
-			} else {
+			PHALCON_INIT_VAR(pointer);
+			PHALCON_READ_PROPERTY_QUICK(&pointer, this_ptr, "_pointer", PH_NOISY_CC);
+			
+			PHALCON_INIT_VAR(batch);
+			PHALCON_READ_PROPERTY_QUICK(&batch, this_ptr, "_batch", PH_NOISY_CC);
+			
+			PHALCON_INIT_VAR(offset);
+			PHALCON_READ_PROPERTY_QUICK(&offset, this_ptr, "_batchOffset", PH_NOISY_CC);
+			if (Z_TYPE_P(batch) != IS_ARRAY || zend_hash_index_find(Z_ARRVAL_P(batch), phalcon_get_intval(pointer) - phalcon_get_intval(offset), (void**) &record) != SUCCESS) {
+				
+				/** Results keep the rows they fetch, moving them backwards doesn't execute the query again */
+				PHALCON_CALL_METHOD_PARAMS_1_NORETURN(result, "dataseek", pointer, PH_NO_CHECK);
+				
 				PHALCON_INIT_VAR(c1);
-				ZVAL_LONG(c1, 2);
-				PHALCON_CALL_METHOD_PARAMS_1_NORETURN(result, "setfetchmode", c1, PH_NO_CHECK);
+				ZVAL_LONG(c1, 256);
+				
+				PHALCON_INIT_VAR(batch);
+				PHALCON_CALL_METHOD_PARAMS_1(batch, result, "fetchrows", c1, PH_NO_CHECK);
+				PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_batch", batch);
+				PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_batchOffset", pointer);
+				if (Z_TYPE_P(batch) != IS_ARRAY || zend_hash_index_find(Z_ARRVAL_P(batch), 0, (void**) &record) != SUCCESS) {
+					PHALCON_MM_RESTORE();
+					RETURN_FALSE;
+				}
 			}
+			
+			PHALCON_CPY_WRT(row, *record);
+			PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_activeRow", row);
+			PHALCON_MM_RESTORE();
+			RETURN_TRUE;
 		}
 	} else {
 		PHALCON_INIT_VAR(rows);
-		phalcon_read_property(&rows, this_ptr, SL("_rows"), PH_NOISY_CC);
+		PHALCON_READ_PROPERTY_QUICK(&rows, this_ptr, "_rows", PH_NOISY_CC);
 		Z_SET_ISREF_P(rows);
 		
 		PHALCON_INIT_VAR(row);
@@ -131,7 +234,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, valid){
 			Z_SET_ISREF_P(rows);
 			PHALCON_CALL_FUNC_PARAMS_1_NORETURN("next", rows);
 			Z_UNSET_ISREF_P(rows);
-			phalcon_update_property_zval(this_ptr, SL("_activeRow"), row TSRMLS_CC);
+			PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_activeRow", row);
 			PHALCON_MM_RESTORE();
 			RETURN_TRUE;
 		}
@@ -141,19 +244,100 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, valid){
 }
 
 /**
- * Returns current row in the resultset
+ * Returns current row in the resultset. Rows are hydrated into a record the first time they are accessed, every
+ * record is cloned from a prototype of the model. Rows fetched from the result are numeric, their columns are
+ * written directly using a column map built once per resultset
  *
  * @return Phalcon\Mvc\Model
  */
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, current){
 
+	zval *prototype, *object = NULL, *type = NULL, *result = NULL, *column_map = NULL, *snapshot = NULL;
+	zval *related, *pointer;
 	zval *t0 = NULL;
+	zval *r0 = NULL;
+	zval **records;
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_activeRow"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_activeRow", PH_NOISY_CC);
+	if (Z_TYPE_P(t0) != IS_ARRAY) {
+		RETURN_CCTOR(t0);
+	}
 	
-	RETURN_CCTOR(t0);
+	if (phalcon_mvc_model_resultset_prototype(&prototype, this_ptr TSRMLS_CC) == FAILURE) {
+		return;
+	}
+	
+	PHALCON_ALLOC_ZVAL_MM(type);
+	PHALCON_READ_PROPERTY_QUICK(&type, this_ptr, "_type", PH_NOISY_CC);
+	if (!zend_is_true(type)) {
+		if (!prototype) {
+			RETURN_CCTOR(t0);
+		}
+		
+		PHALCON_INIT_VAR(object);
+		if (phalcon_clone(object, prototype TSRMLS_CC) == FAILURE){
+			return;
+		}
+		phalcon_hydrate_object(object, NULL, t0, NULL TSRMLS_CC);
+		if (instanceof_function(Z_OBJCE_P(object), phalcon_mvc_model_ce TSRMLS_CC)) {
+			phalcon_update_property_zval(object, SL("_snapshot"), t0 TSRMLS_CC);
+			
+			/** 
+			 * Cached resultsets keep the records eager loaded with every row
+			 */
+			related = zend_read_property(phalcon_mvc_model_resultset_ce, this_ptr, SL("_related"), 1 TSRMLS_CC);
+			if (Z_TYPE_P(related) == IS_ARRAY) {
+				pointer = zend_read_property(phalcon_mvc_model_resultset_ce, this_ptr, SL("_pointer"), 1 TSRMLS_CC);
+				if (zend_hash_index_find(Z_ARRVAL_P(related), phalcon_get_intval(pointer), (void**) &records) == SUCCESS) {
+					phalcon_update_property_zval(object, SL("_related"), *records TSRMLS_CC);
+				}
+			}
+		}
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_activeRow", object);
+		
+		RETURN_CCTOR(object);
+	}
+	
+	if (!prototype) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The resultset does not have a source model");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(column_map);
+	PHALCON_READ_PROPERTY_QUICK(&column_map, this_ptr, "_columnMap", PH_NOISY_CC);
+	if (Z_TYPE_P(column_map) != IS_ARRAY) {
+		PHALCON_INIT_VAR(result);
+		PHALCON_READ_PROPERTY_QUICK(&result, this_ptr, "_result", PH_NOISY_CC);
+		
+		PHALCON_ALLOC_ZVAL_MM(r0);
+		PHALCON_CALL_METHOD(r0, result, "getcolumns", PH_NO_CHECK);
+		
+		PHALCON_INIT_VAR(column_map);
+		PHALCON_CALL_FUNC_PARAMS_1(column_map, "array_flip", r0);
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_columnMap", column_map);
+	}
+	
+	PHALCON_INIT_VAR(object);
+	if (phalcon_clone(object, prototype TSRMLS_CC) == FAILURE){
+		return;
+	}
+	
+	/** 
+	 * Rows returned by PHQL queries are hydrated into Phalcon\Mvc\Model\Row objects, they don't keep a snapshot
+	 */
+	if (instanceof_function(Z_OBJCE_P(object), phalcon_mvc_model_ce TSRMLS_CC)) {
+		PHALCON_INIT_VAR(snapshot);
+		array_init_size(snapshot, zend_hash_num_elements(Z_ARRVAL_P(column_map)));
+		phalcon_hydrate_object(object, column_map, t0, snapshot TSRMLS_CC);
+		phalcon_update_property_zval(object, SL("_snapshot"), snapshot TSRMLS_CC);
+	} else {
+		phalcon_hydrate_object(object, column_map, t0, NULL TSRMLS_CC);
+	}
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_activeRow", object);
+	
+	RETURN_CCTOR(object);
 }
 
 /**
@@ -166,10 +350,10 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, next){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_pointer"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_pointer", PH_NOISY_CC);
 	PHALCON_SEPARATE_NMO(t0);
 	increment_function(t0);
-	phalcon_update_property_zval(this_ptr, SL("_pointer"), t0 TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_pointer", t0);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -184,13 +368,13 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, key){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_pointer"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_pointer", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
 
 /**
- * Rewinds resultset to its beginning
+ * Rewinds resultset to its beginning. The rows fetched by the result are kept, so rewinding doesn't execute the query again
  *
  */
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, rewind){
@@ -201,20 +385,19 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, rewind){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_type"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_type", PH_NOISY_CC);
 	if (zend_is_true(t0)) {
 		PHALCON_INIT_VAR(result);
-		phalcon_read_property(&result, this_ptr, SL("_result"), PH_NOISY_CC);
+		PHALCON_READ_PROPERTY_QUICK(&result, this_ptr, "_result", PH_NOISY_CC);
 		if (Z_TYPE_P(result) != IS_BOOL || (Z_TYPE_P(result) == IS_BOOL && Z_BVAL_P(result))) {
-			phalcon_update_property_long(this_ptr, SL("pointer"), 1 TSRMLS_CC);
-			
 			PHALCON_INIT_VAR(c0);
 			ZVAL_LONG(c0, 0);
 			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(result, "dataseek", c0, PH_NO_CHECK);
+			phalcon_update_property_long(this_ptr, SL("_pointer"), 0 TSRMLS_CC);
 		}
 	} else {
 		PHALCON_ALLOC_ZVAL_MM(t1);
-		phalcon_read_property(&t1, this_ptr, SL("_rows"), PH_NOISY_CC);
+		PHALCON_READ_PROPERTY_QUICK(&t1, this_ptr, "_rows", PH_NOISY_CC);
 		Z_SET_ISREF_P(t1);
 		PHALCON_CALL_FUNC_PARAMS_1_NORETURN("reset", t1);
 		Z_UNSET_ISREF_P(t1);
@@ -232,7 +415,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, seek){
 
 	zval *position = NULL, *rows = NULL, *i = NULL;
 	zval *r0 = NULL, *r1 = NULL;
-	zval *t0 = NULL, *t1 = NULL;
+	zval *t0 = NULL;
 
 	PHALCON_MM_GROW();
 	
@@ -243,17 +426,14 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, seek){
 
 	PHALCON_ALLOC_ZVAL_MM(r0);
 	PHALCON_CALL_FUNC_PARAMS_1(r0, "intval", position);
-	phalcon_update_property_zval(this_ptr, SL("_pointer"), r0 TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_pointer", r0);
 	
+	/** Fresh resultsets read the row when it is validated, only arrays of rows are moved here */
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_type"), PH_NOISY_CC);
-	if (zend_is_true(t0)) {
-		PHALCON_ALLOC_ZVAL_MM(t1);
-		phalcon_read_property(&t1, this_ptr, SL("_result"), PH_NOISY_CC);
-		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(t1, "dataseek", position, PH_NO_CHECK);
-	} else {
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_type", PH_NOISY_CC);
+	if (!zend_is_true(t0)) {
 		PHALCON_INIT_VAR(rows);
-		phalcon_read_property(&rows, this_ptr, SL("_rows"), PH_NOISY_CC);
+		PHALCON_READ_PROPERTY_QUICK(&rows, this_ptr, "_rows", PH_NOISY_CC);
 		Z_SET_ISREF_P(rows);
 		PHALCON_CALL_FUNC_PARAMS_1_NORETURN("reset", rows);
 		Z_UNSET_ISREF_P(rows);
@@ -293,7 +473,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, count){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_count"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_count", PH_NOISY_CC);
 	PHALCON_ALLOC_ZVAL_MM(r0);
 	PHALCON_CALL_FUNC_PARAMS_1(r0, "is_null", t0);
 	if (zend_is_true(r0)) {
@@ -301,10 +481,10 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, count){
 		ZVAL_LONG(count, 0);
 		
 		PHALCON_ALLOC_ZVAL_MM(t1);
-		phalcon_read_property(&t1, this_ptr, SL("_type"), PH_NOISY_CC);
+		PHALCON_READ_PROPERTY_QUICK(&t1, this_ptr, "_type", PH_NOISY_CC);
 		if (zend_is_true(t1)) {
 			PHALCON_INIT_VAR(result);
-			phalcon_read_property(&result, this_ptr, SL("_result"), PH_NOISY_CC);
+			PHALCON_READ_PROPERTY_QUICK(&result, this_ptr, "_result", PH_NOISY_CC);
 			if (Z_TYPE_P(result) != IS_BOOL || (Z_TYPE_P(result) == IS_BOOL && Z_BVAL_P(result))) {
 				PHALCON_ALLOC_ZVAL_MM(r1);
 				PHALCON_CALL_METHOD(r1, result, "numrows", PH_NO_CHECK);
@@ -313,16 +493,16 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, count){
 			}
 		} else {
 			PHALCON_ALLOC_ZVAL_MM(t2);
-			phalcon_read_property(&t2, this_ptr, SL("_rows"), PH_NOISY_CC);
+			PHALCON_READ_PROPERTY_QUICK(&t2, this_ptr, "_rows", PH_NOISY_CC);
 			PHALCON_INIT_VAR(count);
 			phalcon_fast_count(count, t2 TSRMLS_CC);
 		}
 		
-		phalcon_update_property_zval(this_ptr, SL("_count"), count TSRMLS_CC);
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_count", count);
 	}
 	
 	PHALCON_ALLOC_ZVAL_MM(t3);
-	phalcon_read_property(&t3, this_ptr, SL("_count"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t3, this_ptr, "_count", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t3);
 }
@@ -505,7 +685,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, isFresh){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_type"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_type", PH_NOISY_CC);
 	PHALCON_INIT_VAR(t1);
 	ZVAL_LONG(t1, 1);
 	PHALCON_ALLOC_ZVAL_MM(r0);
@@ -525,7 +705,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, getCache){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_cache"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_cache", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
@@ -541,48 +721,196 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, getSourceModel){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_model"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_model", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
 
 /**
- * Serializing a resultset will dump all related rows into a big array
+ * Returns the rows of the resultset as arrays without building any record. Records already hydrated
+ * are converted using the attributes of the source model. The rows kept by the result are read again,
+ * so the resultset can still be traversed afterwards
+ *
+ *<code>
+ * echo json_encode(Robots::find()->toArray());
+ *</code>
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Resultset, toArray){
+
+	zval *result = NULL, *columns = NULL, *column_map = NULL, *batch = NULL, *rows = NULL, *row = NULL;
+	zval *dependency_injector = NULL, *meta_data = NULL, *attributes = NULL;
+	zval *value;
+	zval *t0 = NULL, *t1 = NULL;
+	zval *c0 = NULL, *c1 = NULL;
+	zval **record, **attribute;
+	HashPosition hp0, hp1;
+
+	PHALCON_MM_GROW();
+	array_init(return_value);
+	
+	PHALCON_ALLOC_ZVAL_MM(t0);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_type", PH_NOISY_CC);
+	if (zend_is_true(t0)) {
+		PHALCON_INIT_VAR(result);
+		PHALCON_READ_PROPERTY_QUICK(&result, this_ptr, "_result", PH_NOISY_CC);
+		if (Z_TYPE_P(result) == IS_OBJECT) {
+			PHALCON_INIT_VAR(c0);
+			ZVAL_LONG(c0, 0);
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(result, "dataseek", c0, PH_NO_CHECK);
+			
+			/** 
+			 * Resultsets created by PHQL queries map the columns by their position in the select list
+			 */
+			PHALCON_INIT_VAR(columns);
+			PHALCON_READ_PROPERTY_QUICK(&columns, this_ptr, "_columnMap", PH_NOISY_CC);
+			if (Z_TYPE_P(columns) == IS_ARRAY) {
+				PHALCON_INIT_VAR(column_map);
+				PHALCON_CALL_FUNC_PARAMS_1(column_map, "array_flip", columns);
+				PHALCON_CPY_WRT(columns, column_map);
+			} else {
+				PHALCON_INIT_VAR(columns);
+				PHALCON_CALL_METHOD(columns, result, "getcolumns", PH_NO_CHECK);
+			}
+			
+			PHALCON_INIT_VAR(c0);
+			ZVAL_LONG(c0, 256);
+			while (1) {
+				PHALCON_INIT_VAR(batch);
+				PHALCON_CALL_METHOD_PARAMS_1(batch, result, "fetchrows", c0, PH_NO_CHECK);
+				if (Z_TYPE_P(batch) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(batch))) {
+					break;
+				}
+				phalcon_mvc_model_resultset_append_rows(return_value, columns, batch TSRMLS_CC);
+			}
+		}
+		
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	PHALCON_INIT_VAR(rows);
+	PHALCON_READ_PROPERTY_QUICK(&rows, this_ptr, "_rows", PH_NOISY_CC);
+	if (Z_TYPE_P(rows) != IS_ARRAY) { 
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(rows), &hp0);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(rows), (void**) &record, &hp0) == SUCCESS) {
+		
+		if (Z_TYPE_PP(record) == IS_OBJECT) {
+			if (!attributes) {
+				PHALCON_INIT_VAR(dependency_injector);
+				PHALCON_CALL_STATIC(dependency_injector, "phalcon\\di", "getdefault");
+				
+				PHALCON_INIT_VAR(c1);
+				ZVAL_STRING(c1, "modelsMetadata", 1);
+				
+				PHALCON_INIT_VAR(meta_data);
+				PHALCON_CALL_METHOD_PARAMS_1(meta_data, dependency_injector, "getshared", c1, PH_NO_CHECK);
+				
+				PHALCON_ALLOC_ZVAL_MM(t1);
+				PHALCON_READ_PROPERTY_QUICK(&t1, this_ptr, "_model", PH_NOISY_CC);
+				if (Z_TYPE_P(t1) != IS_OBJECT) {
+					PHALCON_CPY_WRT(t1, *record);
+				}
+				
+				PHALCON_INIT_VAR(attributes);
+				PHALCON_CALL_METHOD_PARAMS_1(attributes, meta_data, "getattributes", t1, PH_NO_CHECK);
+			}
+			
+			PHALCON_INIT_VAR(row);
+			array_init(row);
+			if (Z_TYPE_P(attributes) == IS_ARRAY) { 
+				zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(attributes), &hp1);
+				while (zend_hash_get_current_data_ex(Z_ARRVAL_P(attributes), (void**) &attribute, &hp1) == SUCCESS) {
+					if (Z_TYPE_PP(attribute) == IS_STRING) {
+						value = zend_read_property(phalcon_lookup_class_ce(*record, Z_STRVAL_PP(attribute), Z_STRLEN_PP(attribute) TSRMLS_CC), *record, Z_STRVAL_PP(attribute), Z_STRLEN_PP(attribute), 1 TSRMLS_CC);
+						Z_ADDREF_P(value);
+						add_assoc_zval_ex(row, Z_STRVAL_PP(attribute), Z_STRLEN_PP(attribute) + 1, value);
+					}
+					zend_hash_move_forward_ex(Z_ARRVAL_P(attributes), &hp1);
+				}
+			}
+			
+			Z_ADDREF_P(row);
+			add_next_index_zval(return_value, row);
+		} else {
+			Z_ADDREF_PP(record);
+			add_next_index_zval(return_value, *record);
+		}
+		
+		zend_hash_move_forward_ex(Z_ARRVAL_P(rows), &hp0);
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Serializing a resultset will dump all related rows into a big array. Rows are stored as arrays together with
+ * the name of the source model, they are hydrated again only when they are accessed after unserializing.
+ * The records eager loaded with every row are stored too, so a cached resultset doesn't load them again
  *
  * @return string
  */
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, serialize){
 
-	zval *records = NULL, *data = NULL;
-	zval *r0 = NULL, *r1 = NULL, *r2 = NULL;
-	zval *t0 = NULL;
+	zval *records = NULL, *data = NULL, *model_name = NULL, *rows, *related = NULL, *record_related;
+	zval *r2 = NULL;
+	zval *t0 = NULL, *t1 = NULL;
+	zval **record;
+	HashPosition hp0;
+	ulong position = 0;
 
 	PHALCON_MM_GROW();
 	PHALCON_INIT_VAR(records);
-	array_init(records);
-	PHALCON_CALL_METHOD_NORETURN(this_ptr, "rewind", PH_NO_CHECK);
-	ws_ebc1_1:
-		
-		PHALCON_INIT_VAR(r0);
-		PHALCON_CALL_METHOD(r0, this_ptr, "valid", PH_NO_CHECK);
-		if (Z_TYPE_P(r0) != IS_BOOL || (Z_TYPE_P(r0) == IS_BOOL && !Z_BVAL_P(r0))) {
-			goto we_ebc1_1;
-		}
-		PHALCON_INIT_VAR(r1);
-		PHALCON_CALL_METHOD(r1, this_ptr, "current", PH_NO_CHECK);
-		phalcon_array_append(&records, r1, PH_SEPARATE TSRMLS_CC);
-		PHALCON_CALL_METHOD_NORETURN(this_ptr, "next", PH_NO_CHECK);
-		goto ws_ebc1_1;
-	we_ebc1_1:
+	PHALCON_CALL_METHOD(records, this_ptr, "toarray", PH_NO_CHECK);
 	
 	PHALCON_INIT_VAR(data);
 	array_init(data);
 	
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_cache"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_cache", PH_NOISY_CC);
 	phalcon_array_update_string(&data, SL("cache"), &t0, PH_COPY | PH_SEPARATE TSRMLS_CC);
 	phalcon_array_update_string(&data, SL("rows"), &records, PH_COPY | PH_SEPARATE TSRMLS_CC);
 	
+	PHALCON_ALLOC_ZVAL_MM(t1);
+	PHALCON_READ_PROPERTY_QUICK(&t1, this_ptr, "_model", PH_NOISY_CC);
+	if (Z_TYPE_P(t1) == IS_OBJECT) {
+		PHALCON_INIT_VAR(model_name);
+		phalcon_get_class(model_name, t1 TSRMLS_CC);
+		phalcon_array_update_string(&data, SL("model"), &model_name, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	}
+	
+	related = zend_read_property(phalcon_mvc_model_resultset_ce, this_ptr, SL("_related"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(related) != IS_ARRAY) {
+		related = NULL;
+		rows = zend_read_property(phalcon_mvc_model_resultset_ce, this_ptr, SL("_rows"), 1 TSRMLS_CC);
+		if (Z_TYPE_P(rows) == IS_ARRAY) {
+			zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(rows), &hp0);
+			while (zend_hash_get_current_data_ex(Z_ARRVAL_P(rows), (void**) &record, &hp0) == SUCCESS) {
+				if (Z_TYPE_PP(record) == IS_OBJECT && instanceof_function(Z_OBJCE_PP(record), phalcon_mvc_model_ce TSRMLS_CC)) {
+					record_related = zend_read_property(phalcon_mvc_model_ce, *record, SL("_related"), 1 TSRMLS_CC);
+					if (Z_TYPE_P(record_related) == IS_ARRAY) {
+						if (!related) {
+							PHALCON_INIT_VAR(related);
+							array_init(related);
+						}
+						Z_ADDREF_P(record_related);
+						add_index_zval(related, position, record_related);
+					}
+				}
+				position++;
+				zend_hash_move_forward_ex(Z_ARRVAL_P(rows), &hp0);
+			}
+		}
+	}
+	if (related) {
+		phalcon_array_update_string(&data, SL("related"), &related, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	}
+	
 	PHALCON_ALLOC_ZVAL_MM(r2);
 	PHALCON_CALL_FUNC_PARAMS_1(r2, "serialize", data);
 	RETURN_CTOR(r2);
@@ -595,8 +923,10 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, serialize){
  */
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, unserialize){
 
-	zval *data = NULL, *resultset = NULL;
+	zval *data = NULL, *resultset = NULL, *model_name = NULL, *model = NULL, *related = NULL;
 	zval *r0 = NULL, *r1 = NULL;
+	int eval_int;
+	zend_class_entry *ce0;
 
 	PHALCON_MM_GROW();
 	
@@ -611,12 +941,34 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, unserialize){
 	PHALCON_CALL_FUNC_PARAMS_1(resultset, "unserialize", data);
 	if (Z_TYPE_P(resultset) == IS_ARRAY) { 
 		PHALCON_ALLOC_ZVAL_MM(r0);
-		phalcon_array_fetch_string(&r0, resultset, SL("rows"), PH_NOISY_CC);
-		phalcon_update_property_zval(this_ptr, SL("_rows"), r0 TSRMLS_CC);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&r0, resultset, "rows", PH_NOISY_CC);
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_rows", r0);
 		
 		PHALCON_ALLOC_ZVAL_MM(r1);
-		phalcon_array_fetch_string(&r1, resultset, SL("cache"), PH_NOISY_CC);
-		phalcon_update_property_zval(this_ptr, SL("_cache"), r1 TSRMLS_CC);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&r1, resultset, "cache", PH_NOISY_CC);
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_cache", r1);
+		
+		/** 
+		 * Resultsets serialized with their source model keep raw rows that are hydrated on access
+		 */
+		PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, resultset, "model");
+		if (eval_int) {
+			PHALCON_INIT_VAR(model_name);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&model_name, resultset, "model", PH_NOISY_CC);
+			ce0 = phalcon_fetch_class(model_name TSRMLS_CC);
+			
+			PHALCON_INIT_VAR(model);
+			object_init_ex(model, ce0);
+			PHALCON_CALL_METHOD_NORETURN(model, "__construct", PH_CHECK);
+			PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_model", model);
+		}
+		
+		PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, resultset, "related");
+		if (eval_int) {
+			PHALCON_INIT_VAR(related);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&related, resultset, "related", PH_NOISY_CC);
+			PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_related", related);
+		}
 	} else {
 		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Invalid serialization data");
 		return;
@@ -43,8 +43,8 @@
  * Validates that a field or a combination of a set of fields are not
  * present more than once in the existing records of the related table
  *
- *
- *
+ * The values are bound to named placeholders, so the bind types are taken from the meta-data
+ * and the query is executed as a prepared statement
  */
 
 /**
@@ -55,7 +55,7 @@
 PHP_METHOD(Phalcon_Mvc_Model_Validator_Uniqueness, validate){
 
 	zval *record = NULL, *field = NULL, *conditions = NULL, *placeholders = NULL;
-	zval *number = NULL, *compose_field = NULL, *value = NULL, *dependency_injector = NULL;
+	zval *compose_field = NULL, *value = NULL, *dependency_injector = NULL;
 	zval *meta_data = NULL, *primary_fields = NULL, *primary_field = NULL;
 	zval *params = NULL, *class_name = NULL, *message = NULL;
 	zval *c0 = NULL, *c1 = NULL, *c2 = NULL, *c3 = NULL, *c4 = NULL, *c5 = NULL;
@@ -83,8 +83,6 @@ PHP_METHOD(Phalcon_Mvc_Model_Validator_Uniqueness, validate){
 	PHALCON_INIT_VAR(placeholders);
 	array_init(placeholders);
 	
-	PHALCON_INIT_VAR(number);
-	ZVAL_LONG(number, 0);
 	if (Z_TYPE_P(field) == IS_ARRAY) { 
 		if (!phalcon_valid_foreach(field TSRMLS_CC)) {
 			return;
@@ -103,11 +101,9 @@ PHP_METHOD(Phalcon_Mvc_Model_Validator_Uniqueness, validate){
 			PHALCON_CALL_METHOD_PARAMS_1(value, record, "readattribute", compose_field, PH_NO_CHECK);
 			
 			PHALCON_INIT_VAR(r0);
-			PHALCON_CONCAT_VSV(r0, compose_field, " = ?", number);
+			PHALCON_CONCAT_VSVS(r0, compose_field, " = :", compose_field, ":");
 			phalcon_array_append(&conditions, r0, PH_SEPARATE TSRMLS_CC);
-			phalcon_array_append(&placeholders, value, PH_SEPARATE TSRMLS_CC);
-			PHALCON_SEPARATE(number);
-			increment_function(number);
+			phalcon_array_update_zval(&placeholders, compose_field, &value, PH_COPY | PH_SEPARATE TSRMLS_CC);
 			zend_hash_move_forward_ex(ah0, &hp0);
 			goto fes_8aab_0;
 		fee_8aab_0:
@@ -118,11 +114,9 @@ PHP_METHOD(Phalcon_Mvc_Model_Validator_Uniqueness, validate){
 		PHALCON_CALL_METHOD_PARAMS_1(value, record, "readattribute", field, PH_NO_CHECK);
 		
 		PHALCON_ALLOC_ZVAL_MM(r1);
-		PHALCON_CONCAT_VS(r1, field, " = ?0");
+		PHALCON_CONCAT_VSVS(r1, field, " = :", field, ":");
 		phalcon_array_append(&conditions, r1, PH_SEPARATE TSRMLS_CC);
-		phalcon_array_append(&placeholders, value, PH_SEPARATE TSRMLS_CC);
-		PHALCON_SEPARATE(number);
-		increment_function(number);
+		phalcon_array_update_zval(&placeholders, field, &value, PH_COPY | PH_SEPARATE TSRMLS_CC);
 	}
 	
 	PHALCON_INIT_VAR(dependency_injector);
@@ -153,11 +147,9 @@ PHP_METHOD(Phalcon_Mvc_Model_Validator_Uniqueness, validate){
 		PHALCON_CALL_METHOD_PARAMS_1(value, record, "readattribute", primary_field, PH_NO_CHECK);
 		
 		PHALCON_INIT_VAR(r2);
-		PHALCON_CONCAT_VSV(r2, primary_field, " <> ?", number);
+		PHALCON_CONCAT_VSVS(r2, primary_field, " <> :", primary_field, ":");
 		phalcon_array_append(&conditions, r2, PH_SEPARATE TSRMLS_CC);
-		phalcon_array_append(&placeholders, value, PH_SEPARATE TSRMLS_CC);
-		PHALCON_SEPARATE(number);
-		increment_function(number);
+		phalcon_array_update_zval(&placeholders, primary_field, &value, PH_COPY | PH_SEPARATE TSRMLS_CC);
 		zend_hash_move_forward_ex(ah1, &hp1);
 		goto fes_8aab_1;
 	fee_8aab_1:
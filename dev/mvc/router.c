@@ -38,6 +38,366 @@
 #include "kernel/concat.h"
 #include "kernel/operators.h"
 
+#include "ext/standard/php_smart_str.h"
+
+/**
+ * Returns the literal prefix of a compiled pattern "#^...$#", that is, the leading characters
+ * every matching URI must start with. exact is set when the whole pattern is literal
+ */
+static char *phalcon_mvc_router_static_prefix(char *pattern, int pattern_length, int *prefix_length, int *exact){
+
+	int i, end;
+
+	*prefix_length = 0;
+	*exact = 0;
+
+	if (pattern_length < 4 || pattern[0] != '#' || pattern[1] != '^') {
+		return pattern;
+	}
+
+	end = pattern_length - 2;
+	if (pattern[end] != '$' || pattern[end + 1] != '#') {
+		return pattern + 2;
+	}
+
+	/** Alternations can make any prefix optional */
+	if (memchr(pattern + 2, '|', end - 2)) {
+		return pattern + 2;
+	}
+
+	for (i = 2; i < end; i++) {
+		if (strchr("\\()[]{}?*+.^$", pattern[i])) {
+			break;
+		}
+	}
+
+	*prefix_length = i - 2;
+	if (i == end) {
+		*exact = 1;
+	} else {
+		/** The last literal is optional if a quantifier follows it */
+		if (*prefix_length > 0 && (pattern[i] == '?' || pattern[i] == '*' || pattern[i] == '{')) {
+			(*prefix_length)--;
+		}
+	}
+
+	return pattern + 2;
+}
+
+/**
+ * Returns the length of the first URI segment in a literal prefix, or zero if the
+ * prefix doesn't contain a complete segment
+ */
+static int phalcon_mvc_router_first_segment(char *str, int length, int complete){
+
+	char *slash;
+
+	if (length < 2 || str[0] != '/') {
+		return 0;
+	}
+
+	slash = memchr(str + 1, '/', length - 1);
+	if (slash) {
+		return slash - str - 1;
+	}
+
+	if (complete) {
+		return length - 1;
+	}
+
+	return 0;
+}
+
+/**
+ * Builds the routes index. Routes whose pattern starts with a literal segment are grouped
+ * by that segment in _staticRoutes, the others are kept in _dynamicRoutes. Both groups map
+ * route positions to the literal prefix of the pattern
+ */
+static void phalcon_mvc_router_build_index(zval *this_ptr TSRMLS_DC){
+
+	zval *routes, *static_routes, *dynamic_routes, *bucket;
+	zval **route, **pattern, **bucket_ptr;
+	HashTable *ah0;
+	HashPosition hp0;
+	char *hash_index, *prefix, *segment;
+	uint hash_index_len;
+	ulong position;
+	int prefix_length, segment_length, exact;
+
+	ALLOC_INIT_ZVAL(static_routes);
+	array_init(static_routes);
+
+	ALLOC_INIT_ZVAL(dynamic_routes);
+	array_init(dynamic_routes);
+
+	routes = zend_read_property(phalcon_mvc_router_ce, this_ptr, SL("_routes"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(routes) == IS_ARRAY) {
+
+		ah0 = Z_ARRVAL_P(routes);
+		zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+		while (zend_hash_get_current_data_ex(ah0, (void**) &route, &hp0) == SUCCESS) {
+
+			if (zend_hash_get_current_key_ex(ah0, &hash_index, &hash_index_len, &position, 0, &hp0) == HASH_KEY_IS_LONG) {
+
+				prefix = "";
+				prefix_length = 0;
+				segment_length = 0;
+
+				if (Z_TYPE_PP(route) == IS_ARRAY) {
+					if (zend_hash_find(Z_ARRVAL_PP(route), "pattern", sizeof("pattern"), (void**) &pattern) == SUCCESS) {
+						if (Z_TYPE_PP(pattern) == IS_STRING) {
+							prefix = phalcon_mvc_router_static_prefix(Z_STRVAL_PP(pattern), Z_STRLEN_PP(pattern), &prefix_length, &exact);
+							segment_length = phalcon_mvc_router_first_segment(prefix, prefix_length, exact);
+						}
+					}
+				}
+
+				if (segment_length > 0) {
+					segment = estrndup(prefix + 1, segment_length);
+					if (zend_hash_find(Z_ARRVAL_P(static_routes), segment, segment_length + 1, (void**) &bucket_ptr) == SUCCESS) {
+						bucket = *bucket_ptr;
+					} else {
+						ALLOC_INIT_ZVAL(bucket);
+						array_init(bucket);
+						zend_hash_update(Z_ARRVAL_P(static_routes), segment, segment_length + 1, &bucket, sizeof(zval *), NULL);
+					}
+					efree(segment);
+					add_index_stringl(bucket, position, prefix, prefix_length, 1);
+				} else {
+					add_index_stringl(dynamic_routes, position, prefix, prefix_length, 1);
+				}
+			}
+
+			zend_hash_move_forward_ex(ah0, &hp0);
+		}
+	}
+
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_staticRoutes", static_routes);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_dynamicRoutes", dynamic_routes);
+
+	zval_ptr_dtor(&static_routes);
+	zval_ptr_dtor(&dynamic_routes);
+}
+
+/**
+ * Destructor for the compiled tables stored in the persistent routes cache
+ */
+static void phalcon_mvc_router_cache_dtor(void *data){
+	zval **table = (zval **) data;
+	phalcon_persistent_free(*table);
+}
+
+/**
+ * Appends an unambiguous representation of a route definition to the cache key. Definitions
+ * containing objects or resources can't be cached
+ */
+static int phalcon_mvc_router_definition_key(smart_str *key, zval *value){
+
+	zval **item;
+	HashPosition pos;
+	char *str_index;
+	uint str_index_length;
+	ulong num_index;
+
+	switch (Z_TYPE_P(value)) {
+
+		case IS_STRING:
+			smart_str_appendc(key, 's');
+			smart_str_append_long(key, Z_STRLEN_P(value));
+			smart_str_appendc(key, ':');
+			smart_str_appendl(key, Z_STRVAL_P(value), Z_STRLEN_P(value));
+			break;
+
+		case IS_LONG:
+		case IS_BOOL:
+			smart_str_appendc(key, Z_TYPE_P(value) == IS_LONG ? 'i' : 'b');
+			smart_str_append_long(key, Z_LVAL_P(value));
+			smart_str_appendc(key, ';');
+			break;
+
+		case IS_ARRAY:
+			smart_str_appendc(key, 'a');
+			smart_str_append_long(key, zend_hash_num_elements(Z_ARRVAL_P(value)));
+			smart_str_appendc(key, '{');
+			zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(value), &pos);
+			while (zend_hash_get_current_data_ex(Z_ARRVAL_P(value), (void**) &item, &pos) == SUCCESS) {
+				if (zend_hash_get_current_key_ex(Z_ARRVAL_P(value), &str_index, &str_index_length, &num_index, 0, &pos) == HASH_KEY_IS_STRING) {
+					smart_str_appendc(key, 's');
+					smart_str_append_long(key, str_index_length - 1);
+					smart_str_appendc(key, ':');
+					smart_str_appendl(key, str_index, str_index_length - 1);
+				} else {
+					smart_str_appendc(key, 'i');
+					smart_str_append_long(key, num_index);
+					smart_str_appendc(key, ';');
+				}
+				if (phalcon_mvc_router_definition_key(key, *item) == FAILURE) {
+					return FAILURE;
+				}
+				zend_hash_move_forward_ex(Z_ARRVAL_P(value), &pos);
+			}
+			smart_str_appendc(key, '}');
+			break;
+
+		case IS_DOUBLE:
+			smart_str_appendc(key, 'd');
+			smart_str_appendl(key, (char *) &Z_DVAL_P(value), sizeof(double));
+			break;
+
+		case IS_NULL:
+			smart_str_appendc(key, 'N');
+			break;
+
+		default:
+			return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * Builds the cache key of a set of routes. The key is the class of the router followed by the whole
+ * serialized definitions, a lookup hashes and compares the full text so different routes never share a table
+ */
+static int phalcon_mvc_router_cache_key(smart_str *key, zval *this_ptr, zval *routes, zval *pending_routes){
+
+	smart_str_appendl(key, Z_OBJCE_P(this_ptr)->name, Z_OBJCE_P(this_ptr)->name_length);
+	smart_str_appendc(key, '|');
+
+	if (phalcon_mvc_router_definition_key(key, routes) == FAILURE || phalcon_mvc_router_definition_key(key, pending_routes) == FAILURE) {
+		return FAILURE;
+	}
+
+	smart_str_0(key);
+	return SUCCESS;
+}
+
+/**
+ * Compiles the routes added in persistent mode. The compiled routes table and its index are
+ * kept in the process memory, so the next requests registering the same routes only copy them
+ */
+static int phalcon_mvc_router_compile_pending(zval *this_ptr TSRMLS_DC){
+
+	zval *routes, *pending_routes, *table, *persistent_table, *value;
+	zval **definition, **pattern, **paths, **cached;
+	HashTable *cache;
+	HashPosition pos;
+	smart_str key = {0};
+	int status, cacheable = 1;
+
+	pending_routes = zend_read_property(phalcon_mvc_router_ce, this_ptr, SL("_pendingRoutes"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(pending_routes) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(pending_routes))) {
+		return SUCCESS;
+	}
+
+	routes = zend_read_property(phalcon_mvc_router_ce, this_ptr, SL("_routes"), 1 TSRMLS_CC);
+
+	/** Routes that can't be cached are compiled on every request */
+	if (phalcon_mvc_router_cache_key(&key, this_ptr, routes, pending_routes) == FAILURE) {
+		smart_str_free(&key);
+		cacheable = 0;
+	}
+
+	cache = PHALCON_GLOBAL(router_cache);
+	if (cacheable && cache) {
+		if (zend_hash_find(cache, key.c, key.len + 1, (void**) &cached) == SUCCESS) {
+
+			smart_str_free(&key);
+
+			if (zend_hash_find(Z_ARRVAL_PP(cached), SS("routes"), (void**) &definition) == SUCCESS) {
+				ALLOC_INIT_ZVAL(value);
+				phalcon_persistent_restore(value, *definition);
+				PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_routes", value);
+				zval_ptr_dtor(&value);
+			}
+			if (zend_hash_find(Z_ARRVAL_PP(cached), SS("static"), (void**) &definition) == SUCCESS) {
+				ALLOC_INIT_ZVAL(value);
+				phalcon_persistent_restore(value, *definition);
+				PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_staticRoutes", value);
+				zval_ptr_dtor(&value);
+			}
+			if (zend_hash_find(Z_ARRVAL_PP(cached), SS("dynamic"), (void**) &definition) == SUCCESS) {
+				ALLOC_INIT_ZVAL(value);
+				phalcon_persistent_restore(value, *definition);
+				PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_dynamicRoutes", value);
+				zval_ptr_dtor(&value);
+			}
+
+			phalcon_update_property_null(this_ptr, SL("_pendingRoutes") TSRMLS_CC);
+			return SUCCESS;
+		}
+	}
+
+	/** Compile the routes as a non persistent router would do */
+	Z_ADDREF_P(pending_routes);
+	phalcon_update_property_null(this_ptr, SL("_pendingRoutes") TSRMLS_CC);
+	phalcon_update_property_bool(this_ptr, SL("_persistent"), 0 TSRMLS_CC);
+
+	/** A failed call already restored the memory stack of the caller */
+	status = SUCCESS;
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(pending_routes), &pos);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(pending_routes), (void**) &definition, &pos) == SUCCESS) {
+		if (zend_hash_index_find(Z_ARRVAL_PP(definition), 0, (void**) &pattern) == SUCCESS) {
+			if (zend_hash_index_find(Z_ARRVAL_PP(definition), 1, (void**) &paths) == SUCCESS) {
+				status = phalcon_call_method_two_params(NULL, this_ptr, SL("add"), *pattern, *paths, PH_NO_CHECK, 0 TSRMLS_CC);
+				if (status == FAILURE) {
+					break;
+				}
+			}
+		}
+		zend_hash_move_forward_ex(Z_ARRVAL_P(pending_routes), &pos);
+	}
+
+	zval_ptr_dtor(&pending_routes);
+	phalcon_update_property_bool(this_ptr, SL("_persistent"), 1 TSRMLS_CC);
+
+	if (status == FAILURE) {
+		smart_str_free(&key);
+		return FAILURE;
+	}
+
+	phalcon_mvc_router_build_index(this_ptr TSRMLS_CC);
+
+	if (!cacheable) {
+		return SUCCESS;
+	}
+
+	if (!cache) {
+		cache = (HashTable *) pemalloc(sizeof(HashTable), 1);
+		zend_hash_init(cache, PHALCON_ROUTER_CACHE_SIZE, NULL, phalcon_mvc_router_cache_dtor, 1);
+		PHALCON_GLOBAL(router_cache) = cache;
+	}
+
+	/** Applications generating different routes on every request must not exhaust the memory */
+	if (zend_hash_num_elements(cache) < PHALCON_ROUTER_CACHE_SIZE) {
+
+		ALLOC_INIT_ZVAL(table);
+		array_init(table);
+
+		value = zend_read_property(phalcon_mvc_router_ce, this_ptr, SL("_routes"), 1 TSRMLS_CC);
+		Z_ADDREF_P(value);
+		add_assoc_zval_ex(table, SS("routes"), value);
+
+		value = zend_read_property(phalcon_mvc_router_ce, this_ptr, SL("_staticRoutes"), 1 TSRMLS_CC);
+		Z_ADDREF_P(value);
+		add_assoc_zval_ex(table, SS("static"), value);
+
+		value = zend_read_property(phalcon_mvc_router_ce, this_ptr, SL("_dynamicRoutes"), 1 TSRMLS_CC);
+		Z_ADDREF_P(value);
+		add_assoc_zval_ex(table, SS("dynamic"), value);
+
+		if (phalcon_persistent_copy(&persistent_table, table) == SUCCESS) {
+			zend_hash_update(cache, key.c, key.len + 1, &persistent_table, sizeof(zval *), NULL);
+		}
+
+		zval_ptr_dtor(&table);
+	}
+
+	smart_str_free(&key);
+
+	return SUCCESS;
+}
+
 /**
  * Phalcon\Mvc\Router
  *
@@ -46,6 +406,18 @@
  * decomposing it into parameters to determine which module, controller, and
  * action of that controller should receive the request
  *
+ * Routes are indexed by the first literal segment of their patterns, so handling a URI
+ * only evaluates the regular expressions of the routes that could match it
+ *
+ * In persistent mode the compiled routes are kept in the process memory, so a worker compiles
+ * every distinct set of routes only once
+ *
+ *<code>
+ *	$router = new Phalcon\Mvc\Router();
+ *	$router->setPersistentRoutes(true);
+ *	$router->add('/products/{id:[0-9]+}', 'Products::show');
+ *</code>
+ *
  *
  *
  * Settings baseUri first:
@@ -83,7 +455,7 @@ PHP_METHOD(Phalcon_Mvc_Router, __construct){
 	add_assoc_long_ex(a5, SL("params")+1, 3);
 	phalcon_array_update_string(&a4, SL("paths"), &a5, PH_COPY | PH_SEPARATE TSRMLS_CC);
 	phalcon_array_append(&a1, a4, PH_SEPARATE TSRMLS_CC);
-	phalcon_update_property_zval(this_ptr, SL("_routes"), a1 TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_routes", a1);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -101,10 +473,10 @@ PHP_METHOD(Phalcon_Mvc_Router, _getRewriteUri){
 
 	PHALCON_MM_GROW();
 	phalcon_get_global(&g0, SL("_GET")+1 TSRMLS_CC);
-	eval_int = phalcon_array_isset_string(g0, SL("_url")+1);
+	PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, g0, "_url");
 	if (eval_int) {
 		PHALCON_ALLOC_ZVAL_MM(r0);
-		phalcon_array_fetch_string(&r0, g0, SL("_url"), PH_NOISY_CC);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&r0, g0, "_url", PH_NOISY_CC);
 		
 		RETURN_CCTOR(r0);
 	}
@@ -128,7 +500,7 @@ PHP_METHOD(Phalcon_Mvc_Router, setBaseUri){
 		RETURN_NULL();
 	}
 
-	phalcon_update_property_zval(this_ptr, SL("_baseUri"), base_uri TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_baseUri", base_uri);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -144,7 +516,7 @@ PHP_METHOD(Phalcon_Mvc_Router, setDefaultModule){
 		RETURN_NULL();
 	}
 
-	phalcon_update_property_zval(this_ptr, SL("_defaultModule"), module_name TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_defaultModule", module_name);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -160,7 +532,7 @@ PHP_METHOD(Phalcon_Mvc_Router, setDefaultController){
 		RETURN_NULL();
 	}
 
-	phalcon_update_property_zval(this_ptr, SL("_defaultController"), controller_name TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_defaultController", controller_name);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -176,7 +548,29 @@ PHP_METHOD(Phalcon_Mvc_Router, setDefaultAction){
 		RETURN_NULL();
 	}
 
-	phalcon_update_property_zval(this_ptr, SL("_defaultAction"), action_name TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_defaultAction", action_name);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Enables/disables the persistent mode. When enabled the routes are compiled on the first call
+ * to handle() and reused by the next requests served by the same process
+ *
+ * @param boolean $persistent
+ */
+PHP_METHOD(Phalcon_Mvc_Router, setPersistentRoutes){
+
+	zval *persistent = NULL;
+
+	PHALCON_MM_GROW();
+	
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &persistent) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	phalcon_update_property_bool(this_ptr, SL("_persistent"), zend_is_true(persistent) TSRMLS_CC);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -266,8 +660,8 @@ PHP_METHOD(Phalcon_Mvc_Router, add){
 	zval *c0 = NULL, *c1 = NULL, *c2 = NULL;
 	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL, *r4 = NULL, *r5 = NULL, *r6 = NULL;
 	zval *r7 = NULL, *r8 = NULL, *r9 = NULL, *r10 = NULL, *r11 = NULL;
-	zval *t0 = NULL, *t1 = NULL, *t2 = NULL;
-	zval *a0 = NULL;
+	zval *t0 = NULL, *t1 = NULL, *t2 = NULL, *t3 = NULL, *t4 = NULL;
+	zval *a0 = NULL, *a1 = NULL;
 	zval *p0[] = { NULL, NULL, NULL, NULL };
 	HashTable *ah0;
 	HashPosition hp0;
@@ -285,6 +679,28 @@ PHP_METHOD(Phalcon_Mvc_Router, add){
 		RETURN_NULL();
 	}
 
+	/** Persistent routes are compiled when handling the first URI */
+	PHALCON_ALLOC_ZVAL_MM(t3);
+	PHALCON_READ_PROPERTY_QUICK(&t3, this_ptr, "_persistent", PH_NOISY_CC);
+	if (zend_is_true(t3)) {
+		PHALCON_ALLOC_ZVAL_MM(a1);
+		array_init(a1);
+		phalcon_array_append(&a1, pattern, PH_SEPARATE TSRMLS_CC);
+		phalcon_array_append(&a1, paths, PH_SEPARATE TSRMLS_CC);
+		
+		PHALCON_ALLOC_ZVAL_MM(t4);
+		PHALCON_READ_PROPERTY_QUICK(&t4, this_ptr, "_pendingRoutes", PH_NOISY_CC);
+		if (Z_TYPE_P(t4) != IS_ARRAY) {
+			PHALCON_INIT_VAR(t4);
+			array_init(t4);
+		}
+		phalcon_array_append(&t4, a1, PH_SEPARATE TSRMLS_CC);
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_pendingRoutes", t4);
+		
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+	
 	if (Z_TYPE_P(paths) == IS_STRING) {
 		PHALCON_INIT_VAR(c0);
 		ZVAL_STRING(c0, "::", 1);
@@ -352,8 +768,7 @@ PHP_METHOD(Phalcon_Mvc_Router, add){
 				
 				PHALCON_INIT_VAR(n);
 				PHALCON_GET_FOREACH_KEY(n, ah0, hp0);
-				PHALCON_INIT_VAR(match);
-				ZVAL_ZVAL(match, *hd, 1, 0);
+				PHALCON_GET_FOREACH_VALUE(match);
 				PHALCON_INIT_VAR(r5);
 				phalcon_array_fetch_long(&r5, match, 0, PH_NOISY_CC);
 				PHALCON_INIT_VAR(r6);
@@ -390,9 +805,11 @@ PHP_METHOD(Phalcon_Mvc_Router, add){
 	phalcon_array_update_string(&a0, SL("paths"), &route_paths, PH_COPY | PH_SEPARATE TSRMLS_CC);
 	
 	PHALCON_ALLOC_ZVAL_MM(t2);
-	phalcon_read_property(&t2, this_ptr, SL("_routes"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t2, this_ptr, "_routes", PH_NOISY_CC);
 	phalcon_array_append(&t2, a0, 0 TSRMLS_CC);
-	phalcon_update_property_zval(this_ptr, SL("_routes"), t2 TSRMLS_CC);
+	PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_routes", t2);
+	phalcon_update_property_null(this_ptr, SL("_staticRoutes") TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_dynamicRoutes") TSRMLS_CC);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -406,19 +823,21 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 
 	zval *uri = NULL, *real_uri = NULL, *route_found = NULL, *parts = NULL, *params = NULL;
 	zval *matches = NULL, *route = NULL, *position = NULL, *part = NULL, *str_params = NULL;
-	zval *t0 = NULL, *t1 = NULL, *t2 = NULL;
-	zval *r0 = NULL, *r1 = NULL, *r2 = NULL, *r3 = NULL, *r4 = NULL, *r5 = NULL, *r6 = NULL;
+	zval *routes = NULL, *static_routes = NULL, *dynamic_routes = NULL;
+	zval *t1 = NULL, *t2 = NULL;
+	zval *r1 = NULL, *r2 = NULL, *r3 = NULL, *r4 = NULL, *r5 = NULL, *r6 = NULL;
 	zval *r7 = NULL, *r8 = NULL, *r9 = NULL;
 	zval *c0 = NULL, *c1 = NULL;
 	zval *a0 = NULL;
-	HashTable *ah0, *ah1;
-	HashPosition hp0, hp1;
+	zval **prefix_static, **prefix_dynamic, **prefix, **bucket;
+	HashTable *ah1, *static_hash, *dynamic_hash;
+	HashPosition hp1, hp_static, hp_dynamic;
 	zval **hd;
-	char *hash_index;
+	char *hash_index, *uri_str, *segment, *slash;
 	uint hash_index_len;
-	ulong hash_num;
+	ulong hash_num, position_static, position_dynamic, route_position;
 	int hash_type;
-	int eval_int;
+	int eval_int, uri_len, segment_len, has_static, has_dynamic;
 
 	PHALCON_MM_GROW();
 	
@@ -452,29 +871,106 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 	array_init(matches);
 	phalcon_update_property_bool(this_ptr, SL("_wasMatched"), 0 TSRMLS_CC);
 	
-	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_routes"), PH_NOISY_CC);
+	if (phalcon_mvc_router_compile_pending(this_ptr TSRMLS_CC) == FAILURE) {
+		return;
+	}
 	
-	PHALCON_ALLOC_ZVAL_MM(r0);
-	PHALCON_CALL_FUNC_PARAMS_1(r0, "array_reverse", t0);
-	if (!phalcon_valid_foreach(r0 TSRMLS_CC)) {
+	PHALCON_INIT_VAR(routes);
+	PHALCON_READ_PROPERTY_QUICK(&routes, this_ptr, "_routes", PH_NOISY_CC);
+	if (!phalcon_valid_foreach(routes TSRMLS_CC)) {
 		return;
 	}
 	
-	ah0 = Z_ARRVAL_P(r0);
-	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
-	fes_c9ff_1:
-		if(zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS){
-			goto fee_c9ff_1;
+	/** The index is rebuilt every time a route is added */
+	PHALCON_INIT_VAR(static_routes);
+	PHALCON_READ_PROPERTY_QUICK(&static_routes, this_ptr, "_staticRoutes", PH_NOISY_CC);
+	if (Z_TYPE_P(static_routes) != IS_ARRAY) {
+		phalcon_mvc_router_build_index(this_ptr TSRMLS_CC);
+		PHALCON_INIT_VAR(static_routes);
+		PHALCON_READ_PROPERTY_QUICK(&static_routes, this_ptr, "_staticRoutes", PH_NOISY_CC);
+	}
+	
+	PHALCON_INIT_VAR(dynamic_routes);
+	PHALCON_READ_PROPERTY_QUICK(&dynamic_routes, this_ptr, "_dynamicRoutes", PH_NOISY_CC);
+	
+	if (Z_TYPE_P(real_uri) == IS_STRING) {
+		uri_str = Z_STRVAL_P(real_uri);
+		uri_len = Z_STRLEN_P(real_uri);
+	} else {
+		uri_str = "";
+		uri_len = 0;
+	}
+	
+	/** Only routes starting with the same literal segment as the URI are candidates */
+	static_hash = NULL;
+	if (uri_len > 1 && uri_str[0] == '/') {
+		slash = memchr(uri_str + 1, '/', uri_len - 1);
+		if (slash) {
+			segment_len = slash - uri_str - 1;
+		} else {
+			segment_len = uri_len - 1;
+		}
+		if (segment_len > 0) {
+			segment = estrndup(uri_str + 1, segment_len);
+			if (zend_hash_find(Z_ARRVAL_P(static_routes), segment, segment_len + 1, (void**) &bucket) == SUCCESS) {
+				static_hash = Z_ARRVAL_PP(bucket);
+				zend_hash_internal_pointer_end_ex(static_hash, &hp_static);
+			}
+			efree(segment);
+		}
+	}
+	
+	dynamic_hash = Z_ARRVAL_P(dynamic_routes);
+	zend_hash_internal_pointer_end_ex(dynamic_hash, &hp_dynamic);
+	
+	/** Candidates are visited from the last added to the first one */
+	while (1) {
+	
+		has_static = 0;
+		if (static_hash) {
+			if (zend_hash_get_current_data_ex(static_hash, (void**) &prefix_static, &hp_static) == SUCCESS) {
+				zend_hash_get_current_key_ex(static_hash, &hash_index, &hash_index_len, &position_static, 0, &hp_static);
+				has_static = 1;
+			}
+		}
+		
+		has_dynamic = 0;
+		if (zend_hash_get_current_data_ex(dynamic_hash, (void**) &prefix_dynamic, &hp_dynamic) == SUCCESS) {
+			zend_hash_get_current_key_ex(dynamic_hash, &hash_index, &hash_index_len, &position_dynamic, 0, &hp_dynamic);
+			has_dynamic = 1;
+		}
+		
+		if (!has_static && !has_dynamic) {
+			break;
+		}
+		
+		if (has_static && (!has_dynamic || position_static > position_dynamic)) {
+			route_position = position_static;
+			prefix = prefix_static;
+			zend_hash_move_backwards_ex(static_hash, &hp_static);
+		} else {
+			route_position = position_dynamic;
+			prefix = prefix_dynamic;
+			zend_hash_move_backwards_ex(dynamic_hash, &hp_dynamic);
 		}
 		
-		PHALCON_INIT_VAR(route);
-		ZVAL_ZVAL(route, *hd, 1, 0);
+		if (Z_STRLEN_PP(prefix) > uri_len) {
+			continue;
+		}
+		if (memcmp(uri_str, Z_STRVAL_PP(prefix), Z_STRLEN_PP(prefix))) {
+			continue;
+		}
+		
+		if (zend_hash_index_find(Z_ARRVAL_P(routes), route_position, (void**) &hd) != SUCCESS) {
+			continue;
+		}
+		
+		PHALCON_GET_FOREACH_VALUE(route);
 		PHALCON_INIT_VAR(parts);
-		phalcon_array_fetch_string(&parts, route, SL("paths"), PH_NOISY_CC);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&parts, route, "paths", PH_NOISY_CC);
 		
 		PHALCON_INIT_VAR(r1);
-		phalcon_array_fetch_string(&r1, route, SL("pattern"), PH_NOISY_CC);
+		PHALCON_ARRAY_FETCH_QUICK_STRING(&r1, route, "pattern", PH_NOISY_CC);
 		Z_SET_ISREF_P(matches);
 		
 		PHALCON_INIT_VAR(r2);
@@ -482,7 +978,7 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 		Z_UNSET_ISREF_P(matches);
 		if (zend_is_true(r2)) {
 			PHALCON_INIT_VAR(r3);
-			phalcon_array_fetch_string(&r3, route, SL("paths"), PH_NOISY_CC);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&r3, route, "paths", PH_NOISY_CC);
 			if (!phalcon_valid_foreach(r3 TSRMLS_CC)) {
 				return;
 			}
@@ -496,8 +992,7 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 				
 				PHALCON_INIT_VAR(part);
 				PHALCON_GET_FOREACH_KEY(part, ah1, hp1);
-				PHALCON_INIT_VAR(position);
-				ZVAL_ZVAL(position, *hd, 1, 0);
+				PHALCON_GET_FOREACH_VALUE(position);
 				eval_int = phalcon_array_isset(matches, position);
 				if (eval_int) {
 					PHALCON_INIT_VAR(r4);
@@ -509,57 +1004,54 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 			fee_c9ff_2:
 			if(0){}
 			
-			phalcon_update_property_zval(this_ptr, SL("_matches"), matches TSRMLS_CC);
-			phalcon_update_property_zval(this_ptr, SL("_currentRoute"), route TSRMLS_CC);
+			PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_matches", matches);
+			PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_currentRoute", route);
 			
 			PHALCON_INIT_VAR(route_found);
 			ZVAL_BOOL(route_found, 1);
-			goto fee_c9ff_1;
+			break;
 		}
-		zend_hash_move_forward_ex(ah0, &hp0);
-		goto fes_c9ff_1;
-	fee_c9ff_1:
-	if(0){}
+	}
 	
 	if (zend_is_true(route_found)) {
-		eval_int = phalcon_array_isset_string(parts, SL("module")+1);
+		PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, parts, "module");
 		if (eval_int) {
 			PHALCON_ALLOC_ZVAL_MM(r5);
-			phalcon_array_fetch_string(&r5, parts, SL("module"), PH_NOISY_CC);
-			phalcon_update_property_zval(this_ptr, SL("_module"), r5 TSRMLS_CC);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&r5, parts, "module", PH_NOISY_CC);
+			PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_module", r5);
 			PHALCON_SEPARATE(parts);
 			phalcon_array_unset_string(parts, SL("module")+1);
 		} else {
 			PHALCON_ALLOC_ZVAL_MM(t1);
-			phalcon_read_property(&t1, this_ptr, SL("_defaultModule"), PH_NOISY_CC);
-			phalcon_update_property_zval(this_ptr, SL("_module"), t1 TSRMLS_CC);
+			PHALCON_READ_PROPERTY_QUICK(&t1, this_ptr, "_defaultModule", PH_NOISY_CC);
+			PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_module", t1);
 		}
-		eval_int = phalcon_array_isset_string(parts, SL("controller")+1);
+		PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, parts, "controller");
 		if (eval_int) {
 			PHALCON_ALLOC_ZVAL_MM(r6);
-			phalcon_array_fetch_string(&r6, parts, SL("controller"), PH_NOISY_CC);
-			phalcon_update_property_zval(this_ptr, SL("_controller"), r6 TSRMLS_CC);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&r6, parts, "controller", PH_NOISY_CC);
+			PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_controller", r6);
 			PHALCON_SEPARATE(parts);
 			phalcon_array_unset_string(parts, SL("controller")+1);
 		} else {
 			phalcon_update_property_null(this_ptr, SL("_controller") TSRMLS_CC);
 		}
 		
-		eval_int = phalcon_array_isset_string(parts, SL("action")+1);
+		PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, parts, "action");
 		if (eval_int) {
 			PHALCON_ALLOC_ZVAL_MM(r7);
-			phalcon_array_fetch_string(&r7, parts, SL("action"), PH_NOISY_CC);
-			phalcon_update_property_zval(this_ptr, SL("_action"), r7 TSRMLS_CC);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&r7, parts, "action", PH_NOISY_CC);
+			PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_action", r7);
 			PHALCON_SEPARATE(parts);
 			phalcon_array_unset_string(parts, SL("action")+1);
 		} else {
 			phalcon_update_property_null(this_ptr, SL("_action") TSRMLS_CC);
 		}
 		
-		eval_int = phalcon_array_isset_string(parts, SL("params")+1);
+		PHALCON_ARRAY_ISSET_QUICK_STRING(eval_int, parts, "params");
 		if (eval_int) {
 			PHALCON_ALLOC_ZVAL_MM(r8);
-			phalcon_array_fetch_string(&r8, parts, SL("params"), PH_NOISY_CC);
+			PHALCON_ARRAY_FETCH_QUICK_STRING(&r8, parts, "params", PH_NOISY_CC);
 			PHALCON_INIT_VAR(c0);
 			ZVAL_LONG(c0, 1);
 			PHALCON_INIT_VAR(str_params);
@@ -577,18 +1069,18 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 		
 		PHALCON_ALLOC_ZVAL_MM(r9);
 		PHALCON_CALL_FUNC_PARAMS_2(r9, "array_merge", params, parts);
-		phalcon_update_property_zval(this_ptr, SL("_params"), r9 TSRMLS_CC);
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_params", r9);
 		phalcon_update_property_bool(this_ptr, SL("_wasMatched"), 1 TSRMLS_CC);
 	} else {
 		PHALCON_ALLOC_ZVAL_MM(t2);
-		phalcon_read_property(&t2, this_ptr, SL("_defaultModule"), PH_NOISY_CC);
-		phalcon_update_property_zval(this_ptr, SL("_module"), t2 TSRMLS_CC);
+		PHALCON_READ_PROPERTY_QUICK(&t2, this_ptr, "_defaultModule", PH_NOISY_CC);
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_module", t2);
 		phalcon_update_property_null(this_ptr, SL("_controller") TSRMLS_CC);
 		phalcon_update_property_null(this_ptr, SL("_action") TSRMLS_CC);
 		
 		PHALCON_ALLOC_ZVAL_MM(a0);
 		array_init(a0);
-		phalcon_update_property_zval(this_ptr, SL("_params"), a0 TSRMLS_CC);
+		PHALCON_UPDATE_PROPERTY_QUICK(this_ptr, "_params", a0);
 		phalcon_update_property_bool(this_ptr, SL("_wasMatched"), 0 TSRMLS_CC);
 	}
 	
@@ -606,7 +1098,7 @@ PHP_METHOD(Phalcon_Mvc_Router, getModuleName){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_module"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_module", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
@@ -622,7 +1114,7 @@ PHP_METHOD(Phalcon_Mvc_Router, getControllerName){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_controller"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_controller", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
@@ -638,7 +1130,7 @@ PHP_METHOD(Phalcon_Mvc_Router, getActionName){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_action"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_action", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
@@ -654,7 +1146,7 @@ PHP_METHOD(Phalcon_Mvc_Router, getParams){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_params"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_params", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
@@ -670,7 +1162,7 @@ PHP_METHOD(Phalcon_Mvc_Router, getCurrentRoute){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_currentRoute"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_currentRoute", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
@@ -684,7 +1176,7 @@ PHP_METHOD(Phalcon_Mvc_Router, getMatches){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_matches"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_matches", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
@@ -695,7 +1187,7 @@ PHP_METHOD(Phalcon_Mvc_Router, wasMatched){
 
 	PHALCON_MM_GROW();
 	PHALCON_ALLOC_ZVAL_MM(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_wasMatched"), PH_NOISY_CC);
+	PHALCON_READ_PROPERTY_QUICK(&t0, this_ptr, "_wasMatched", PH_NOISY_CC);
 	
 	RETURN_CCTOR(t0);
 }
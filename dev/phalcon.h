@@ -52,6 +52,7 @@ extern zend_class_entry *phalcon_mvc_model_manager_ce;
 extern zend_class_entry *phalcon_mvc_model_metadata_memory_ce;
 extern zend_class_entry *phalcon_mvc_model_metadata_apc_ce;
 extern zend_class_entry *phalcon_mvc_model_metadata_session_ce;
+extern zend_class_entry *phalcon_mvc_model_metadata_compiled_ce;
 extern zend_class_entry *phalcon_mvc_model_resultset_ce;
 extern zend_class_entry *phalcon_mvc_model_transaction_ce;
 extern zend_class_entry *phalcon_mvc_application_ce;
@@ -160,6 +161,7 @@ PHP_METHOD(Phalcon_Mvc_Router, setBaseUri);
 PHP_METHOD(Phalcon_Mvc_Router, setDefaultModule);
 PHP_METHOD(Phalcon_Mvc_Router, setDefaultController);
 PHP_METHOD(Phalcon_Mvc_Router, setDefaultAction);
+PHP_METHOD(Phalcon_Mvc_Router, setPersistentRoutes);
 PHP_METHOD(Phalcon_Mvc_Router, compilePattern);
 PHP_METHOD(Phalcon_Mvc_Router, add);
 PHP_METHOD(Phalcon_Mvc_Router, handle);
@@ -262,6 +264,7 @@ PHP_METHOD(Phalcon_Mvc_Model, setDI);
 PHP_METHOD(Phalcon_Mvc_Model, getDI);
 PHP_METHOD(Phalcon_Mvc_Model, _createSQLSelect);
 PHP_METHOD(Phalcon_Mvc_Model, _getOrCreateResultset);
+PHP_METHOD(Phalcon_Mvc_Model, _eagerLoad);
 PHP_METHOD(Phalcon_Mvc_Model, setTransaction);
 PHP_METHOD(Phalcon_Mvc_Model, setSource);
 PHP_METHOD(Phalcon_Mvc_Model, getSource);
@@ -282,6 +285,7 @@ PHP_METHOD(Phalcon_Mvc_Model, sum);
 PHP_METHOD(Phalcon_Mvc_Model, maximum);
 PHP_METHOD(Phalcon_Mvc_Model, minimum);
 PHP_METHOD(Phalcon_Mvc_Model, average);
+PHP_METHOD(Phalcon_Mvc_Model, aggregate);
 PHP_METHOD(Phalcon_Mvc_Model, _callEvent);
 PHP_METHOD(Phalcon_Mvc_Model, _callEventCancel);
 PHP_METHOD(Phalcon_Mvc_Model, _cancelOperation);
@@ -290,12 +294,23 @@ PHP_METHOD(Phalcon_Mvc_Model, validate);
 PHP_METHOD(Phalcon_Mvc_Model, validationHasFailed);
 PHP_METHOD(Phalcon_Mvc_Model, getMessages);
 PHP_METHOD(Phalcon_Mvc_Model, _checkForeignKeys);
+PHP_METHOD(Phalcon_Mvc_Model, _checkForeignKeysBatch);
 PHP_METHOD(Phalcon_Mvc_Model, _checkForeignKeysReverse);
 PHP_METHOD(Phalcon_Mvc_Model, _preSave);
 PHP_METHOD(Phalcon_Mvc_Model, _postSave);
 PHP_METHOD(Phalcon_Mvc_Model, _doLowInsert);
 PHP_METHOD(Phalcon_Mvc_Model, _doLowUpdate);
+PHP_METHOD(Phalcon_Mvc_Model, _getIdentityKey);
+PHP_METHOD(Phalcon_Mvc_Model, hasSnapshotData);
+PHP_METHOD(Phalcon_Mvc_Model, getSnapshotData);
+PHP_METHOD(Phalcon_Mvc_Model, setSnapshotData);
+PHP_METHOD(Phalcon_Mvc_Model, getChangedFields);
+PHP_METHOD(Phalcon_Mvc_Model, hasChanged);
 PHP_METHOD(Phalcon_Mvc_Model, save);
+PHP_METHOD(Phalcon_Mvc_Model, saveMany);
+PHP_METHOD(Phalcon_Mvc_Model, upsert);
+PHP_METHOD(Phalcon_Mvc_Model, updateAll);
+PHP_METHOD(Phalcon_Mvc_Model, deleteAll);
 PHP_METHOD(Phalcon_Mvc_Model, delete);
 PHP_METHOD(Phalcon_Mvc_Model, readAttribute);
 PHP_METHOD(Phalcon_Mvc_Model, writeAttribute);
@@ -325,7 +340,15 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, where);
 PHP_METHOD(Phalcon_Mvc_Model_Query, setParameters);
 PHP_METHOD(Phalcon_Mvc_Model_Query, setInputData);
 PHP_METHOD(Phalcon_Mvc_Model_Query, setLimit);
+PHP_METHOD(Phalcon_Mvc_Model_Query, setDI);
+PHP_METHOD(Phalcon_Mvc_Model_Query, getDI);
+PHP_METHOD(Phalcon_Mvc_Model_Query, _getModel);
+PHP_METHOD(Phalcon_Mvc_Model_Query, _getModelDefinition);
+PHP_METHOD(Phalcon_Mvc_Model_Query, parse);
+PHP_METHOD(Phalcon_Mvc_Model_Query, getSql);
+PHP_METHOD(Phalcon_Mvc_Model_Query, execute);
 PHP_METHOD(Phalcon_Mvc_Model_Query, getResultset);
+PHP_METHOD(Phalcon_Mvc_Model_Query, clearCache);
 PHP_METHOD(Phalcon_Mvc_Model_Query, getConditions);
 PHP_METHOD(Phalcon_Mvc_Model_Query, fromInput);
 
@@ -365,12 +388,17 @@ PHP_METHOD(Phalcon_Mvc_Model_Transaction_Manager, collectTransactions);
 
 PHP_METHOD(Phalcon_Mvc_Model_MetaData, __construct);
 PHP_METHOD(Phalcon_Mvc_Model_MetaData, _initializeMetaData);
+PHP_METHOD(Phalcon_Mvc_Model_MetaData, readEntry);
+PHP_METHOD(Phalcon_Mvc_Model_MetaData, writeEntry);
+PHP_METHOD(Phalcon_Mvc_Model_MetaData, lockEntry);
+PHP_METHOD(Phalcon_Mvc_Model_MetaData, unlockEntry);
 PHP_METHOD(Phalcon_Mvc_Model_MetaData, getAttributes);
 PHP_METHOD(Phalcon_Mvc_Model_MetaData, getPrimaryKeyAttributes);
 PHP_METHOD(Phalcon_Mvc_Model_MetaData, getNonPrimaryKeyAttributes);
 PHP_METHOD(Phalcon_Mvc_Model_MetaData, getNotNullAttributes);
 PHP_METHOD(Phalcon_Mvc_Model_MetaData, getDataTypes);
 PHP_METHOD(Phalcon_Mvc_Model_MetaData, getDataTypesNumeric);
+PHP_METHOD(Phalcon_Mvc_Model_MetaData, getBindTypes);
 PHP_METHOD(Phalcon_Mvc_Model_MetaData, getIdentityField);
 PHP_METHOD(Phalcon_Mvc_Model_MetaData, storeMetaData);
 PHP_METHOD(Phalcon_Mvc_Model_MetaData, isEmpty);
@@ -404,6 +432,16 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, getBelongsTo);
 PHP_METHOD(Phalcon_Mvc_Model_Manager, getHasMany);
 PHP_METHOD(Phalcon_Mvc_Model_Manager, getHasOne);
 PHP_METHOD(Phalcon_Mvc_Model_Manager, getHasOneAndHasMany);
+PHP_METHOD(Phalcon_Mvc_Model_Manager, enableIdentityMap);
+PHP_METHOD(Phalcon_Mvc_Model_Manager, disableIdentityMap);
+PHP_METHOD(Phalcon_Mvc_Model_Manager, getRecord);
+PHP_METHOD(Phalcon_Mvc_Model_Manager, addRecord);
+PHP_METHOD(Phalcon_Mvc_Model_Manager, removeRecord);
+PHP_METHOD(Phalcon_Mvc_Model_Manager, clearRecords);
+PHP_METHOD(Phalcon_Mvc_Model_Manager, isVerifiedReference);
+PHP_METHOD(Phalcon_Mvc_Model_Manager, addVerifiedReference);
+PHP_METHOD(Phalcon_Mvc_Model_Manager, clearVerifiedReferences);
+PHP_METHOD(Phalcon_Mvc_Model_Manager, eagerLoad);
 
 PHP_METHOD(Phalcon_Mvc_Model_MetaData_Memory, read);
 PHP_METHOD(Phalcon_Mvc_Model_MetaData_Memory, write);
@@ -411,11 +449,21 @@ PHP_METHOD(Phalcon_Mvc_Model_MetaData_Memory, write);
 PHP_METHOD(Phalcon_Mvc_Model_MetaData_Apc, __construct);
 PHP_METHOD(Phalcon_Mvc_Model_MetaData_Apc, read);
 PHP_METHOD(Phalcon_Mvc_Model_MetaData_Apc, write);
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Apc, readEntry);
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Apc, writeEntry);
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Apc, lockEntry);
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Apc, unlockEntry);
 
 PHP_METHOD(Phalcon_Mvc_Model_MetaData_Session, __construct);
 PHP_METHOD(Phalcon_Mvc_Model_MetaData_Session, read);
 PHP_METHOD(Phalcon_Mvc_Model_MetaData_Session, write);
 
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Compiled, __construct);
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Compiled, read);
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Compiled, readEntry);
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Compiled, write);
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Compiled, compile);
+
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, __construct);
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, valid);
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, current);
@@ -433,6 +481,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, getLast);
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, isFresh);
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, getCache);
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, getSourceModel);
+PHP_METHOD(Phalcon_Mvc_Model_Resultset, toArray);
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, serialize);
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, unserialize);
 
@@ -465,8 +514,12 @@ PHP_METHOD(Phalcon_Db, setEventsManager);
 PHP_METHOD(Phalcon_Db, fetchOne);
 PHP_METHOD(Phalcon_Db, fetchAll);
 PHP_METHOD(Phalcon_Db, insert);
+PHP_METHOD(Phalcon_Db, insertMany);
+PHP_METHOD(Phalcon_Db, upsert);
 PHP_METHOD(Phalcon_Db, update);
 PHP_METHOD(Phalcon_Db, delete);
+PHP_METHOD(Phalcon_Db, getSqlTemplate);
+PHP_METHOD(Phalcon_Db, setSqlTemplate);
 PHP_METHOD(Phalcon_Db, begin);
 PHP_METHOD(Phalcon_Db, rollback);
 PHP_METHOD(Phalcon_Db, commit);
@@ -629,6 +682,8 @@ PHP_METHOD(Phalcon_Db_Reference, __set_state);
 PHP_METHOD(Phalcon_Db_Dialect, limit);
 PHP_METHOD(Phalcon_Db_Dialect, forUpdate);
 PHP_METHOD(Phalcon_Db_Dialect, sharedLock);
+PHP_METHOD(Phalcon_Db_Dialect, escape);
+PHP_METHOD(Phalcon_Db_Dialect, escapeString);
 PHP_METHOD(Phalcon_Db_Dialect, getColumnList);
 PHP_METHOD(Phalcon_Db_Dialect, getColumnDefinition);
 PHP_METHOD(Phalcon_Db_Dialect, addColumn);
@@ -725,11 +780,17 @@ PHP_METHOD(Phalcon_Db_Result_Pdo, fetchArray);
 PHP_METHOD(Phalcon_Db_Result_Pdo, numRows);
 PHP_METHOD(Phalcon_Db_Result_Pdo, dataSeek);
 PHP_METHOD(Phalcon_Db_Result_Pdo, setFetchMode);
+PHP_METHOD(Phalcon_Db_Result_Pdo, getColumns);
+PHP_METHOD(Phalcon_Db_Result_Pdo, fetchRows);
 PHP_METHOD(Phalcon_Db_Result_Pdo, getInternalResult);
 
 PHP_METHOD(Phalcon_Db_Dialect_Mysql, limit);
 PHP_METHOD(Phalcon_Db_Dialect_Mysql, forUpdate);
 PHP_METHOD(Phalcon_Db_Dialect_Mysql, sharedLock);
+PHP_METHOD(Phalcon_Db_Dialect_Mysql, getMaxBindParams);
+PHP_METHOD(Phalcon_Db_Dialect_Mysql, escape);
+PHP_METHOD(Phalcon_Db_Dialect_Mysql, escapeString);
+PHP_METHOD(Phalcon_Db_Dialect_Mysql, upsert);
 PHP_METHOD(Phalcon_Db_Dialect_Mysql, getColumnList);
 PHP_METHOD(Phalcon_Db_Dialect_Mysql, getColumnDefinition);
 PHP_METHOD(Phalcon_Db_Dialect_Mysql, addColumn);
@@ -754,6 +815,10 @@ PHP_METHOD(Phalcon_Db_Dialect_Mysql, tableOptions);
 PHP_METHOD(Phalcon_Db_Dialect_Postgresql, limit);
 PHP_METHOD(Phalcon_Db_Dialect_Postgresql, forUpdate);
 PHP_METHOD(Phalcon_Db_Dialect_Postgresql, sharedLock);
+PHP_METHOD(Phalcon_Db_Dialect_Postgresql, getMaxBindParams);
+PHP_METHOD(Phalcon_Db_Dialect_Postgresql, escape);
+PHP_METHOD(Phalcon_Db_Dialect_Postgresql, escapeString);
+PHP_METHOD(Phalcon_Db_Dialect_Postgresql, upsert);
 PHP_METHOD(Phalcon_Db_Dialect_Postgresql, getColumnList);
 PHP_METHOD(Phalcon_Db_Dialect_Postgresql, getColumnDefinition);
 PHP_METHOD(Phalcon_Db_Dialect_Postgresql, addColumn);
@@ -1037,6 +1102,10 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_router_setdefaultaction, 0, 0, 1)
 	ZEND_ARG_INFO(0, actionName)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_router_setpersistentroutes, 0, 0, 1)
+	ZEND_ARG_INFO(0, persistent)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_router_compilepattern, 0, 0, 1)
 	ZEND_ARG_INFO(0, pattern)
 ZEND_END_ARG_INFO()
@@ -1246,6 +1315,31 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_setforceexists, 0, 0, 1)
 	ZEND_ARG_INFO(0, forceExists)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_setsnapshotdata, 0, 0, 1)
+	ZEND_ARG_INFO(0, data)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_savemany, 0, 0, 1)
+	ZEND_ARG_INFO(0, records)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_updateall, 0, 0, 2)
+	ZEND_ARG_INFO(0, conditions)
+	ZEND_ARG_INFO(0, values)
+	ZEND_ARG_INFO(0, bind)
+	ZEND_ARG_INFO(0, checkForeignKeys)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_deleteall, 0, 0, 0)
+	ZEND_ARG_INFO(0, conditions)
+	ZEND_ARG_INFO(0, bind)
+	ZEND_ARG_INFO(0, checkForeignKeys)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_haschanged, 0, 0, 0)
+	ZEND_ARG_INFO(0, fieldName)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_dumpresult, 0, 0, 2)
 	ZEND_ARG_INFO(0, base)
 	ZEND_ARG_INFO(0, result)
@@ -1279,6 +1373,11 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_average, 0, 0, 0)
 	ZEND_ARG_INFO(0, parameters)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_aggregate, 0, 0, 1)
+	ZEND_ARG_INFO(0, aggregates)
+	ZEND_ARG_INFO(0, parameters)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_appendmessage, 0, 0, 1)
 	ZEND_ARG_INFO(0, message)
 ZEND_END_ARG_INFO()
@@ -1325,6 +1424,10 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_validator_email_validate, 0, 0,
 	ZEND_ARG_INFO(0, record)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_query___construct, 0, 0, 0)
+	ZEND_ARG_INFO(0, phql)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_query_setmanager, 0, 0, 1)
 	ZEND_ARG_INFO(0, manager)
 ZEND_END_ARG_INFO()
@@ -1349,6 +1452,23 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_query_setlimit, 0, 0, 1)
 	ZEND_ARG_INFO(0, limit)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_query_setdi, 0, 0, 1)
+	ZEND_ARG_INFO(0, dependencyInjector)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_query__getmodel, 0, 0, 1)
+	ZEND_ARG_INFO(0, modelName)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_query__getmodeldefinition, 0, 0, 1)
+	ZEND_ARG_INFO(0, modelName)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_query_execute, 0, 0, 0)
+	ZEND_ARG_INFO(0, bindParams)
+	ZEND_ARG_INFO(0, bindTypes)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_query_frominput, 0, 0, 2)
 	ZEND_ARG_INFO(0, modelName)
 	ZEND_ARG_INFO(0, data)
@@ -1403,6 +1523,23 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata___construct, 0, 0, 0)
 	ZEND_ARG_INFO(0, options)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_readentry, 0, 0, 1)
+	ZEND_ARG_INFO(0, key)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_writeentry, 0, 0, 2)
+	ZEND_ARG_INFO(0, key)
+	ZEND_ARG_INFO(0, data)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_lockentry, 0, 0, 1)
+	ZEND_ARG_INFO(0, key)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_unlockentry, 0, 0, 1)
+	ZEND_ARG_INFO(0, key)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_getattributes, 0, 0, 1)
 	ZEND_ARG_INFO(0, model)
 ZEND_END_ARG_INFO()
@@ -1423,6 +1560,11 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_getdatatypes, 0, 0, 1)
 	ZEND_ARG_INFO(0, model)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_getbindtypes, 0, 0, 2)
+	ZEND_ARG_INFO(0, model)
+	ZEND_ARG_INFO(0, bindParams)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_getdatatypesnumeric, 0, 0, 1)
 	ZEND_ARG_INFO(0, model)
 ZEND_END_ARG_INFO()
@@ -1541,6 +1683,46 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_manager_gethasoneandhasmany, 0,
 	ZEND_ARG_INFO(0, model)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_manager_enableidentitymap, 0, 0, 0)
+	ZEND_ARG_INFO(0, limit)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_manager_getrecord, 0, 0, 2)
+	ZEND_ARG_INFO(0, modelName)
+	ZEND_ARG_INFO(0, key)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_manager_addrecord, 0, 0, 3)
+	ZEND_ARG_INFO(0, modelName)
+	ZEND_ARG_INFO(0, key)
+	ZEND_ARG_INFO(0, record)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_manager_removerecord, 0, 0, 2)
+	ZEND_ARG_INFO(0, modelName)
+	ZEND_ARG_INFO(0, key)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_manager_isverifiedreference, 0, 0, 2)
+	ZEND_ARG_INFO(0, modelName)
+	ZEND_ARG_INFO(0, conditions)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_manager_addverifiedreference, 0, 0, 2)
+	ZEND_ARG_INFO(0, modelName)
+	ZEND_ARG_INFO(0, conditions)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_manager_clearverifiedreferences, 0, 0, 0)
+	ZEND_ARG_INFO(0, modelName)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_manager_eagerload, 0, 0, 3)
+	ZEND_ARG_INFO(0, modelName)
+	ZEND_ARG_INFO(0, records)
+	ZEND_ARG_INFO(0, relations)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_apc___construct, 0, 0, 1)
 	ZEND_ARG_INFO(0, options)
 ZEND_END_ARG_INFO()
@@ -1549,6 +1731,23 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_apc_write, 0, 0, 1)
 	ZEND_ARG_INFO(0, data)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_apc_readentry, 0, 0, 1)
+	ZEND_ARG_INFO(0, key)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_apc_writeentry, 0, 0, 2)
+	ZEND_ARG_INFO(0, key)
+	ZEND_ARG_INFO(0, data)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_apc_lockentry, 0, 0, 1)
+	ZEND_ARG_INFO(0, key)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_apc_unlockentry, 0, 0, 1)
+	ZEND_ARG_INFO(0, key)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_session___construct, 0, 0, 1)
 	ZEND_ARG_INFO(0, options)
 ZEND_END_ARG_INFO()
@@ -1557,6 +1756,22 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_session_write, 0, 0, 1
 	ZEND_ARG_INFO(0, data)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_compiled___construct, 0, 0, 1)
+	ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_compiled_readentry, 0, 0, 1)
+	ZEND_ARG_INFO(0, key)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_compiled_write, 0, 0, 1)
+	ZEND_ARG_INFO(0, data)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_compiled_compile, 0, 0, 0)
+	ZEND_ARG_INFO(0, data)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_resultset___construct, 0, 0, 2)
 	ZEND_ARG_INFO(0, model)
 	ZEND_ARG_INFO(0, result)
@@ -1633,11 +1848,15 @@ ZEND_END_ARG_INFO()
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_fetchone, 0, 0, 1)
 	ZEND_ARG_INFO(0, sqlQuery)
 	ZEND_ARG_INFO(0, fetchMode)
+	ZEND_ARG_INFO(0, placeholders)
+	ZEND_ARG_INFO(0, dataTypes)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_fetchall, 0, 0, 1)
 	ZEND_ARG_INFO(0, sqlQuery)
 	ZEND_ARG_INFO(0, fetchMode)
+	ZEND_ARG_INFO(0, placeholders)
+	ZEND_ARG_INFO(0, dataTypes)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_insert, 0, 0, 2)
@@ -1646,11 +1865,28 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_insert, 0, 0, 2)
 	ZEND_ARG_INFO(0, fields)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_insertmany, 0, 0, 2)
+	ZEND_ARG_INFO(0, table)
+	ZEND_ARG_INFO(0, rows)
+	ZEND_ARG_INFO(0, fields)
+	ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_upsert, 0, 0, 4)
+	ZEND_ARG_INFO(0, table)
+	ZEND_ARG_INFO(0, values)
+	ZEND_ARG_INFO(0, fields)
+	ZEND_ARG_INFO(0, keyFields)
+	ZEND_ARG_INFO(0, updateFields)
+	ZEND_ARG_INFO(0, identityField)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_update, 0, 0, 3)
 	ZEND_ARG_INFO(0, table)
 	ZEND_ARG_INFO(0, fields)
 	ZEND_ARG_INFO(0, values)
 	ZEND_ARG_INFO(0, whereCondition)
+	ZEND_ARG_INFO(0, whereBind)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_delete, 0, 0, 1)
@@ -1659,6 +1895,15 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_delete, 0, 0, 1)
 	ZEND_ARG_INFO(0, placeholders)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_getsqltemplate, 0, 0, 1)
+	ZEND_ARG_INFO(0, key)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_setsqltemplate, 0, 0, 2)
+	ZEND_ARG_INFO(0, key)
+	ZEND_ARG_INFO(0, sqlStatement)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_logger_debug, 0, 0, 1)
 	ZEND_ARG_INFO(0, message)
 ZEND_END_ARG_INFO()
@@ -1990,11 +2235,15 @@ ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_adapter_pdo_query, 0, 0, 1)
 	ZEND_ARG_INFO(0, sqlStatement)
+	ZEND_ARG_INFO(0, placeholders)
+	ZEND_ARG_INFO(0, dataTypes)
+	ZEND_ARG_INFO(0, unbuffered)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_adapter_pdo_execute, 0, 0, 1)
 	ZEND_ARG_INFO(0, sqlStatement)
 	ZEND_ARG_INFO(0, placeholders)
+	ZEND_ARG_INFO(0, dataTypes)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_adapter_pdo_escapestring, 0, 0, 1)
@@ -2148,6 +2397,8 @@ ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_result_pdo___construct, 0, 0, 1)
 	ZEND_ARG_INFO(0, result)
+	ZEND_ARG_INFO(0, unbuffered)
+	ZEND_ARG_INFO(0, exactRowCount)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_result_pdo_dataseek, 0, 0, 1)
@@ -2158,6 +2409,10 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_result_pdo_setfetchmode, 0, 0, 1)
 	ZEND_ARG_INFO(0, fetchMode)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_result_pdo_fetchrows, 0, 0, 1)
+	ZEND_ARG_INFO(0, limit)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_dialect_mysql_limit, 0, 0, 2)
 	ZEND_ARG_INFO(0, sqlQuery)
 	ZEND_ARG_INFO(0, number)
@@ -2171,6 +2426,23 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_dialect_mysql_sharedlock, 0, 0, 1)
 	ZEND_ARG_INFO(0, sqlQuery)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_dialect_mysql_escape, 0, 0, 1)
+	ZEND_ARG_INFO(0, str)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_dialect_mysql_escapestring, 0, 0, 1)
+	ZEND_ARG_INFO(0, str)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_dialect_mysql_upsert, 0, 0, 4)
+	ZEND_ARG_INFO(0, table)
+	ZEND_ARG_INFO(0, fields)
+	ZEND_ARG_INFO(0, placeholders)
+	ZEND_ARG_INFO(0, keyFields)
+	ZEND_ARG_INFO(0, updateFields)
+	ZEND_ARG_INFO(0, identityField)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_dialect_mysql_getcolumnlist, 0, 0, 1)
 	ZEND_ARG_INFO(0, columnList)
 ZEND_END_ARG_INFO()
@@ -2286,6 +2558,23 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_dialect_postgresql_sharedlock, 0, 0, 1
 	ZEND_ARG_INFO(0, sqlQuery)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_dialect_postgresql_escape, 0, 0, 1)
+	ZEND_ARG_INFO(0, str)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_dialect_postgresql_escapestring, 0, 0, 1)
+	ZEND_ARG_INFO(0, str)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_dialect_postgresql_upsert, 0, 0, 4)
+	ZEND_ARG_INFO(0, table)
+	ZEND_ARG_INFO(0, fields)
+	ZEND_ARG_INFO(0, placeholders)
+	ZEND_ARG_INFO(0, keyFields)
+	ZEND_ARG_INFO(0, updateFields)
+	ZEND_ARG_INFO(0, identityField)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_dialect_postgresql_getcolumnlist, 0, 0, 1)
 	ZEND_ARG_INFO(0, columnList)
 ZEND_END_ARG_INFO()
@@ -2759,6 +3048,7 @@ PHALCON_INIT_FUNCS(phalcon_mvc_router_method_entry){
 	PHP_ME(Phalcon_Mvc_Router, setDefaultModule, arginfo_phalcon_mvc_router_setdefaultmodule, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Router, setDefaultController, arginfo_phalcon_mvc_router_setdefaultcontroller, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Router, setDefaultAction, arginfo_phalcon_mvc_router_setdefaultaction, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Router, setPersistentRoutes, arginfo_phalcon_mvc_router_setpersistentroutes, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Router, compilePattern, arginfo_phalcon_mvc_router_compilepattern, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Router, add, arginfo_phalcon_mvc_router_add, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Router, handle, arginfo_phalcon_mvc_router_handle, ZEND_ACC_PUBLIC) 
@@ -2879,6 +3169,7 @@ PHALCON_INIT_FUNCS(phalcon_mvc_model_method_entry){
 	PHP_ME(Phalcon_Mvc_Model, getDI, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model, _createSQLSelect, NULL, ZEND_ACC_PROTECTED|ZEND_ACC_STATIC) 
 	PHP_ME(Phalcon_Mvc_Model, _getOrCreateResultset, NULL, ZEND_ACC_PROTECTED|ZEND_ACC_STATIC) 
+	PHP_ME(Phalcon_Mvc_Model, _eagerLoad, NULL, ZEND_ACC_PROTECTED|ZEND_ACC_STATIC) 
 	PHP_ME(Phalcon_Mvc_Model, setTransaction, arginfo_phalcon_mvc_model_settransaction, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model, setSource, NULL, ZEND_ACC_PROTECTED) 
 	PHP_ME(Phalcon_Mvc_Model, getSource, NULL, ZEND_ACC_PUBLIC) 
@@ -2899,6 +3190,7 @@ PHALCON_INIT_FUNCS(phalcon_mvc_model_method_entry){
 	PHP_ME(Phalcon_Mvc_Model, maximum, arginfo_phalcon_mvc_model_maximum, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
 	PHP_ME(Phalcon_Mvc_Model, minimum, arginfo_phalcon_mvc_model_minimum, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
 	PHP_ME(Phalcon_Mvc_Model, average, arginfo_phalcon_mvc_model_average, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
+	PHP_ME(Phalcon_Mvc_Model, aggregate, arginfo_phalcon_mvc_model_aggregate, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
 	PHP_ME(Phalcon_Mvc_Model, _callEvent, NULL, ZEND_ACC_PROTECTED) 
 	PHP_ME(Phalcon_Mvc_Model, _callEventCancel, NULL, ZEND_ACC_PROTECTED) 
 	PHP_ME(Phalcon_Mvc_Model, _cancelOperation, NULL, ZEND_ACC_PROTECTED) 
@@ -2907,12 +3199,23 @@ PHALCON_INIT_FUNCS(phalcon_mvc_model_method_entry){
 	PHP_ME(Phalcon_Mvc_Model, validationHasFailed, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model, getMessages, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model, _checkForeignKeys, NULL, ZEND_ACC_PROTECTED) 
+	PHP_ME(Phalcon_Mvc_Model, _checkForeignKeysBatch, NULL, ZEND_ACC_PROTECTED) 
 	PHP_ME(Phalcon_Mvc_Model, _checkForeignKeysReverse, NULL, ZEND_ACC_PROTECTED) 
 	PHP_ME(Phalcon_Mvc_Model, _preSave, NULL, ZEND_ACC_PROTECTED) 
 	PHP_ME(Phalcon_Mvc_Model, _postSave, NULL, ZEND_ACC_PROTECTED) 
 	PHP_ME(Phalcon_Mvc_Model, _doLowInsert, NULL, ZEND_ACC_PROTECTED) 
 	PHP_ME(Phalcon_Mvc_Model, _doLowUpdate, NULL, ZEND_ACC_PROTECTED) 
+	PHP_ME(Phalcon_Mvc_Model, _getIdentityKey, NULL, ZEND_ACC_PROTECTED) 
+	PHP_ME(Phalcon_Mvc_Model, hasSnapshotData, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model, getSnapshotData, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model, setSnapshotData, arginfo_phalcon_mvc_model_setsnapshotdata, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model, getChangedFields, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model, hasChanged, arginfo_phalcon_mvc_model_haschanged, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model, save, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model, saveMany, arginfo_phalcon_mvc_model_savemany, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
+	PHP_ME(Phalcon_Mvc_Model, upsert, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model, updateAll, arginfo_phalcon_mvc_model_updateall, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
+	PHP_ME(Phalcon_Mvc_Model, deleteAll, arginfo_phalcon_mvc_model_deleteall, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
 	PHP_ME(Phalcon_Mvc_Model, delete, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model, readAttribute, arginfo_phalcon_mvc_model_readattribute, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model, writeAttribute, arginfo_phalcon_mvc_model_writeattribute, ZEND_ACC_PUBLIC) 
@@ -2956,14 +3259,22 @@ PHALCON_INIT_FUNCS(phalcon_mvc_model_validator_email_method_entry){
 };
 
 PHALCON_INIT_FUNCS(phalcon_mvc_model_query_method_entry){
-	PHP_ME(Phalcon_Mvc_Model_Query, __construct, NULL, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR) 
+	PHP_ME(Phalcon_Mvc_Model_Query, __construct, arginfo_phalcon_mvc_model_query___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR) 
 	PHP_ME(Phalcon_Mvc_Model_Query, setManager, arginfo_phalcon_mvc_model_query_setmanager, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_Query, from, arginfo_phalcon_mvc_model_query_from, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_Query, where, arginfo_phalcon_mvc_model_query_where, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_Query, setParameters, arginfo_phalcon_mvc_model_query_setparameters, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_Query, setInputData, arginfo_phalcon_mvc_model_query_setinputdata, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_Query, setLimit, arginfo_phalcon_mvc_model_query_setlimit, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_Query, setDI, arginfo_phalcon_mvc_model_query_setdi, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_Query, getDI, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_Query, _getModel, arginfo_phalcon_mvc_model_query__getmodel, ZEND_ACC_PROTECTED) 
+	PHP_ME(Phalcon_Mvc_Model_Query, _getModelDefinition, arginfo_phalcon_mvc_model_query__getmodeldefinition, ZEND_ACC_PROTECTED) 
+	PHP_ME(Phalcon_Mvc_Model_Query, parse, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_Query, getSql, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_Query, execute, arginfo_phalcon_mvc_model_query_execute, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_Query, getResultset, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_Query, clearCache, NULL, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
 	PHP_ME(Phalcon_Mvc_Model_Query, getConditions, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_Query, fromInput, arginfo_phalcon_mvc_model_query_frominput, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
 	PHP_FE_END
@@ -3019,12 +3330,17 @@ PHALCON_INIT_FUNCS(phalcon_mvc_model_transaction_manager_method_entry){
 PHALCON_INIT_FUNCS(phalcon_mvc_model_metadata_method_entry){
 	PHP_ME(Phalcon_Mvc_Model_MetaData, __construct, arginfo_phalcon_mvc_model_metadata___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR) 
 	PHP_ME(Phalcon_Mvc_Model_MetaData, _initializeMetaData, NULL, ZEND_ACC_PROTECTED) 
+	PHP_ME(Phalcon_Mvc_Model_MetaData, readEntry, arginfo_phalcon_mvc_model_metadata_readentry, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_MetaData, writeEntry, arginfo_phalcon_mvc_model_metadata_writeentry, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_MetaData, lockEntry, arginfo_phalcon_mvc_model_metadata_lockentry, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_MetaData, unlockEntry, arginfo_phalcon_mvc_model_metadata_unlockentry, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_MetaData, getAttributes, arginfo_phalcon_mvc_model_metadata_getattributes, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_MetaData, getPrimaryKeyAttributes, arginfo_phalcon_mvc_model_metadata_getprimarykeyattributes, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_MetaData, getNonPrimaryKeyAttributes, arginfo_phalcon_mvc_model_metadata_getnonprimarykeyattributes, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_MetaData, getNotNullAttributes, arginfo_phalcon_mvc_model_metadata_getnotnullattributes, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_MetaData, getDataTypes, arginfo_phalcon_mvc_model_metadata_getdatatypes, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_MetaData, getDataTypesNumeric, arginfo_phalcon_mvc_model_metadata_getdatatypesnumeric, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_MetaData, getBindTypes, arginfo_phalcon_mvc_model_metadata_getbindtypes, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_MetaData, getIdentityField, arginfo_phalcon_mvc_model_metadata_getidentityfield, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_MetaData, storeMetaData, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_MetaData, isEmpty, NULL, ZEND_ACC_PUBLIC) 
@@ -3064,6 +3380,16 @@ PHALCON_INIT_FUNCS(phalcon_mvc_model_manager_method_entry){
 	PHP_ME(Phalcon_Mvc_Model_Manager, getHasMany, arginfo_phalcon_mvc_model_manager_gethasmany, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_Manager, getHasOne, arginfo_phalcon_mvc_model_manager_gethasone, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_Manager, getHasOneAndHasMany, arginfo_phalcon_mvc_model_manager_gethasoneandhasmany, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_Manager, enableIdentityMap, arginfo_phalcon_mvc_model_manager_enableidentitymap, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_Manager, disableIdentityMap, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_Manager, getRecord, arginfo_phalcon_mvc_model_manager_getrecord, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_Manager, addRecord, arginfo_phalcon_mvc_model_manager_addrecord, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_Manager, removeRecord, arginfo_phalcon_mvc_model_manager_removerecord, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_Manager, clearRecords, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_Manager, isVerifiedReference, arginfo_phalcon_mvc_model_manager_isverifiedreference, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_Manager, addVerifiedReference, arginfo_phalcon_mvc_model_manager_addverifiedreference, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_Manager, clearVerifiedReferences, arginfo_phalcon_mvc_model_manager_clearverifiedreferences, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_Manager, eagerLoad, arginfo_phalcon_mvc_model_manager_eagerload, ZEND_ACC_PUBLIC) 
 	PHP_FE_END
 };
 
@@ -3077,6 +3403,10 @@ PHALCON_INIT_FUNCS(phalcon_mvc_model_metadata_apc_method_entry){
 	PHP_ME(Phalcon_Mvc_Model_MetaData_Apc, __construct, arginfo_phalcon_mvc_model_metadata_apc___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR) 
 	PHP_ME(Phalcon_Mvc_Model_MetaData_Apc, read, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_MetaData_Apc, write, arginfo_phalcon_mvc_model_metadata_apc_write, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_MetaData_Apc, readEntry, arginfo_phalcon_mvc_model_metadata_apc_readentry, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_MetaData_Apc, writeEntry, arginfo_phalcon_mvc_model_metadata_apc_writeentry, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_MetaData_Apc, lockEntry, arginfo_phalcon_mvc_model_metadata_apc_lockentry, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_MetaData_Apc, unlockEntry, arginfo_phalcon_mvc_model_metadata_apc_unlockentry, ZEND_ACC_PUBLIC) 
 	PHP_FE_END
 };
 
@@ -3087,6 +3417,15 @@ PHALCON_INIT_FUNCS(phalcon_mvc_model_metadata_session_method_entry){
 	PHP_FE_END
 };
 
+PHALCON_INIT_FUNCS(phalcon_mvc_model_metadata_compiled_method_entry){
+	PHP_ME(Phalcon_Mvc_Model_MetaData_Compiled, __construct, arginfo_phalcon_mvc_model_metadata_compiled___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR) 
+	PHP_ME(Phalcon_Mvc_Model_MetaData_Compiled, read, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_MetaData_Compiled, readEntry, arginfo_phalcon_mvc_model_metadata_compiled_readentry, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_MetaData_Compiled, write, arginfo_phalcon_mvc_model_metadata_compiled_write, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_MetaData_Compiled, compile, arginfo_phalcon_mvc_model_metadata_compiled_compile, ZEND_ACC_PUBLIC) 
+	PHP_FE_END
+};
+
 PHALCON_INIT_FUNCS(phalcon_mvc_model_resultset_method_entry){
 	PHP_ME(Phalcon_Mvc_Model_Resultset, __construct, arginfo_phalcon_mvc_model_resultset___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR) 
 	PHP_ME(Phalcon_Mvc_Model_Resultset, valid, NULL, ZEND_ACC_PUBLIC) 
@@ -3105,6 +3444,7 @@ PHALCON_INIT_FUNCS(phalcon_mvc_model_resultset_method_entry){
 	PHP_ME(Phalcon_Mvc_Model_Resultset, isFresh, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_Resultset, getCache, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_Resultset, getSourceModel, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Model_Resultset, toArray, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_Resultset, serialize, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_Model_Resultset, unserialize, arginfo_phalcon_mvc_model_resultset_unserialize, ZEND_ACC_PUBLIC) 
 	PHP_FE_END
@@ -3150,8 +3490,12 @@ PHALCON_INIT_FUNCS(phalcon_db_method_entry){
 	PHP_ME(Phalcon_Db, fetchOne, arginfo_phalcon_db_fetchone, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db, fetchAll, arginfo_phalcon_db_fetchall, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db, insert, arginfo_phalcon_db_insert, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db, insertMany, arginfo_phalcon_db_insertmany, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db, upsert, arginfo_phalcon_db_upsert, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db, update, arginfo_phalcon_db_update, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db, delete, arginfo_phalcon_db_delete, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db, getSqlTemplate, arginfo_phalcon_db_getsqltemplate, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db, setSqlTemplate, arginfo_phalcon_db_setsqltemplate, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db, begin, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db, rollback, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db, commit, NULL, ZEND_ACC_PUBLIC) 
@@ -3374,6 +3718,8 @@ PHALCON_INIT_FUNCS(phalcon_db_dialect_method_entry){
 	PHP_ME(Phalcon_Db_Dialect, limit, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Dialect, forUpdate, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Dialect, sharedLock, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Dialect, escape, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Dialect, escapeString, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Dialect, getColumnList, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Dialect, getColumnDefinition, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Dialect, addColumn, NULL, ZEND_ACC_PUBLIC) 
@@ -3494,6 +3840,8 @@ PHALCON_INIT_FUNCS(phalcon_db_result_pdo_method_entry){
 	PHP_ME(Phalcon_Db_Result_Pdo, numRows, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Result_Pdo, dataSeek, arginfo_phalcon_db_result_pdo_dataseek, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Result_Pdo, setFetchMode, arginfo_phalcon_db_result_pdo_setfetchmode, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Result_Pdo, getColumns, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Result_Pdo, fetchRows, arginfo_phalcon_db_result_pdo_fetchrows, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Result_Pdo, getInternalResult, NULL, ZEND_ACC_PUBLIC) 
 	PHP_FE_END
 };
@@ -3502,6 +3850,10 @@ PHALCON_INIT_FUNCS(phalcon_db_dialect_mysql_method_entry){
 	PHP_ME(Phalcon_Db_Dialect_Mysql, limit, arginfo_phalcon_db_dialect_mysql_limit, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Dialect_Mysql, forUpdate, arginfo_phalcon_db_dialect_mysql_forupdate, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Dialect_Mysql, sharedLock, arginfo_phalcon_db_dialect_mysql_sharedlock, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Dialect_Mysql, getMaxBindParams, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Dialect_Mysql, escape, arginfo_phalcon_db_dialect_mysql_escape, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Dialect_Mysql, escapeString, arginfo_phalcon_db_dialect_mysql_escapestring, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Dialect_Mysql, upsert, arginfo_phalcon_db_dialect_mysql_upsert, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Dialect_Mysql, getColumnList, arginfo_phalcon_db_dialect_mysql_getcolumnlist, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Dialect_Mysql, getColumnDefinition, arginfo_phalcon_db_dialect_mysql_getcolumndefinition, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Dialect_Mysql, addColumn, arginfo_phalcon_db_dialect_mysql_addcolumn, ZEND_ACC_PUBLIC) 
@@ -3529,6 +3881,10 @@ PHALCON_INIT_FUNCS(phalcon_db_dialect_postgresql_method_entry){
 	PHP_ME(Phalcon_Db_Dialect_Postgresql, limit, arginfo_phalcon_db_dialect_postgresql_limit, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
 	PHP_ME(Phalcon_Db_Dialect_Postgresql, forUpdate, arginfo_phalcon_db_dialect_postgresql_forupdate, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Dialect_Postgresql, sharedLock, arginfo_phalcon_db_dialect_postgresql_sharedlock, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Dialect_Postgresql, getMaxBindParams, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Dialect_Postgresql, escape, arginfo_phalcon_db_dialect_postgresql_escape, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Dialect_Postgresql, escapeString, arginfo_phalcon_db_dialect_postgresql_escapestring, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Dialect_Postgresql, upsert, arginfo_phalcon_db_dialect_postgresql_upsert, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Dialect_Postgresql, getColumnList, arginfo_phalcon_db_dialect_postgresql_getcolumnlist, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
 	PHP_ME(Phalcon_Db_Dialect_Postgresql, getColumnDefinition, arginfo_phalcon_db_dialect_postgresql_getcolumndefinition, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
 	PHP_ME(Phalcon_Db_Dialect_Postgresql, addColumn, arginfo_phalcon_db_dialect_postgresql_addcolumn, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
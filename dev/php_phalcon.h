@@ -23,11 +23,16 @@
 #define PHP_PHALCON_VERSION "0.5.0a4"
 #define PHP_PHALCON_EXTNAME "phalcon"
 
-#define PHALCON_MAX_MEMORY_STACK 48
+#define PHALCON_MEMORY_FRAME_CHUNK 16
+
+#define PHALCON_ROUTER_CACHE_SIZE 16
+
+#define PHALCON_PHQL_CACHE_SIZE 256
 
 typedef struct _phalcon_memory_entry {
 	int pointer;
-	zval **addresses[PHALCON_MAX_MEMORY_STACK];
+	int capacity;
+	zval ***addresses;
 	struct _phalcon_memory_entry *prev;
 	struct _phalcon_memory_entry *next;
 } phalcon_memory_entry;
@@ -36,6 +41,12 @@ ZEND_BEGIN_MODULE_GLOBALS(phalcon)
 	int phalcon_memory_stack;
 	phalcon_memory_entry *start_memory;
 	phalcon_memory_entry *active_memory;
+	HashTable *router_cache;
+	HashTable *metadata_maps;
+	HashTable *phql_cache;
+	HashTable *phql_plans;
+	ulong fcall_generation;
+	ulong db_write_generation;
 #ifndef PHALCON_RELEASE
 	int phalcon_stack_stats;
 #endif
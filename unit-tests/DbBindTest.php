@@ -93,6 +93,11 @@ class DbBindTest extends PHPUnit_Framework_TestCase
 
 		$conditions = $connection->bindParams("column3 IN (:val1:, :val2:, :val3:) AND column4 > ?2", array('val1' => 'hello', 'val2' => 100, 'val3' => "'hahaha'", 2 => 'le-nice'));
 		$this->assertEquals($conditions, "column3 IN ('hello', 100, '''hahaha''') AND column4 > 'le-nice'");
+
+		//Casts are not taken as placeholders
+		$row = $connection->fetchOne("SELECT id::text::varchar AS code, ':name:'::text AS literal FROM robots WHERE id = :id:::integer", Phalcon\Db::FETCH_ASSOC, array('id' => '1'));
+		$this->assertEquals($row['code'], '1');
+		$this->assertEquals($row['literal'], ':name:');
 	}
 
 }
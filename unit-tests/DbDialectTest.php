@@ -313,6 +313,13 @@ class DbDialectTest extends PHPUnit_Framework_TestCase
 		$this->assertEquals($dialect->dropForeignKey('table', null, 'fk1'), 'ALTER TABLE `table` DROP FOREIGN KEY `fk1`');
 		$this->assertEquals($dialect->dropForeignKey('table', 'schema', 'fk1'), 'ALTER TABLE `schema`.`table` DROP FOREIGN KEY `fk1`');
 
+		$this->assertEquals($dialect->upsert('table', array('id', 'name'), array('?', '?'), array('id')), 'INSERT INTO table (id, name) VALUES (?, ?) ON DUPLICATE KEY UPDATE name = VALUES(name)');
+		$this->assertEquals($dialect->upsert('table', array('id', 'name', 'total'), array('?', '?', 'NOW()'), array('id', 'name')), 'INSERT INTO table (id, name, total) VALUES (?, ?, NOW()) ON DUPLICATE KEY UPDATE total = VALUES(total)');
+		$this->assertEquals($dialect->upsert('table', array('id'), array('?'), array('id')), 'INSERT INTO table (id) VALUES (?) ON DUPLICATE KEY UPDATE id = id');
+		$this->assertEquals($dialect->upsert('table', array('id', 'name', 'total'), array('?', '?', '?'), array('id'), array('total')), 'INSERT INTO table (id, name, total) VALUES (?, ?, ?) ON DUPLICATE KEY UPDATE total = VALUES(total)');
+		$this->assertEquals($dialect->upsert('table', array('code', 'name'), array('?', '?'), array('id'), null, 'id'), 'INSERT INTO table (code, name) VALUES (?, ?) ON DUPLICATE KEY UPDATE code = VALUES(code), name = VALUES(name), id = LAST_INSERT_ID(id)');
+		$this->assertEquals($dialect->upsert('table', array('code', 'name'), array('?', '?'), array('id'), array(), 'id'), 'INSERT INTO table (code, name) VALUES (?, ?) ON DUPLICATE KEY UPDATE id = LAST_INSERT_ID(id)');
+
 		//Create tables
 		$definition = array(
 			'columns' => array(
@@ -344,4 +351,16 @@ class DbDialectTest extends PHPUnit_Framework_TestCase
 
 	}
 
+	public function testPostgresqlDialect()
+	{
+
+		$dialect = new \Phalcon\Db\Dialect\Postgresql();
+
+		$this->assertEquals($dialect->upsert('table', array('id', 'name'), array('?', '?'), array('id')), 'INSERT INTO table (id, name) VALUES (?, ?) ON CONFLICT (id) DO UPDATE SET name = EXCLUDED.name');
+		$this->assertEquals($dialect->upsert('table', array('id', 'name', 'total'), array('?', '?', 'NOW()'), array('id', 'name')), 'INSERT INTO table (id, name, total) VALUES (?, ?, NOW()) ON CONFLICT (id, name) DO UPDATE SET total = EXCLUDED.total');
+		$this->assertEquals($dialect->upsert('table', array('id', 'name', 'total'), array('?', '?', '?'), array('id'), array('total')), 'INSERT INTO table (id, name, total) VALUES (?, ?, ?) ON CONFLICT (id) DO UPDATE SET total = EXCLUDED.total');
+		$this->assertEquals($dialect->upsert('table', array('id'), array('?'), array('id')), 'INSERT INTO table (id) VALUES (?) ON CONFLICT (id) DO NOTHING');
+
+	}
+
 }
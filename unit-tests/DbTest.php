@@ -32,6 +32,29 @@ class DbTest extends PHPUnit_Framework_TestCase
 
 	}
 
+	public function testDbLazyMysql()
+	{
+
+		require 'unit-tests/config.db.php';
+
+		$connection = new Phalcon\Db\Adapter\Pdo\Mysql(array_merge($configMysql, array('lazy' => true)));
+		$this->assertFalse($connection->isUnderTransaction());
+
+		$this->_executeTests($connection);
+
+		$this->assertTrue(is_object($connection->getInternalHandler()));
+	}
+
+	public function testDbNativePreparesMysql()
+	{
+
+		require 'unit-tests/config.db.php';
+
+		$connection = new Phalcon\Db\Adapter\Pdo\Mysql(array_merge($configMysql, array('nativePrepares' => true)));
+
+		$this->_executeTests($connection);
+	}
+
 	public function testDbPostgresql()
 	{
 
@@ -42,6 +65,44 @@ class DbTest extends PHPUnit_Framework_TestCase
 		$this->_executeTests($connection);
 	}
 
+	public function testDbResultExecutesOnceMysql()
+	{
+
+		require 'unit-tests/config.db.php';
+
+		$connection = new Phalcon\Db\Adapter\Pdo\Mysql($configMysql);
+
+		//The difference between two readings of the counter is the cost of reading it
+		$before = $this->_getSelects($connection);
+		$overhead = $this->_getSelects($connection) - $before;
+
+		$before = $this->_getSelects($connection);
+
+		$result = $connection->query("SELECT * FROM personas LIMIT 5");
+		$result->setFetchMode(Phalcon\Db::FETCH_NUM);
+		$rows = array();
+		for ($i = 0; $i < 2; $i++) {
+			$result->dataSeek(0);
+			while ($row = $result->fetchArray()) {
+				$rows[$i][] = $row;
+			}
+		}
+		$this->assertEquals(count($rows[0]), 5);
+		$this->assertEquals($rows[0], $rows[1]);
+
+		$result->dataSeek(2);
+		$this->assertEquals($result->fetchArray(), $rows[0][2]);
+		$this->assertEquals($result->numRows(), 5);
+
+		$this->assertEquals($this->_getSelects($connection) - $before - $overhead, 1);
+	}
+
+	protected function _getSelects($connection)
+	{
+		$status = $connection->fetchOne("SHOW SESSION STATUS LIKE 'Com_select'", Phalcon\Db::FETCH_NUM);
+		return (int) $status[1];
+	}
+
 	protected function _executeTests($connection)
 	{
 
@@ -84,6 +145,26 @@ class DbTest extends PHPUnit_Framework_TestCase
 		$row = $result->fetchArray();
 		$this->assertEquals($row, false);
 
+		$result = $connection->query("SELECT * FROM personas LIMIT 5");
+		$result->setFetchMode(Phalcon\Db::FETCH_ASSOC);
+		$first = $result->fetchArray();
+		$result->dataSeek(3);
+		$fourth = $result->fetchArray();
+		$result->dataSeek(0);
+		$this->assertEquals($result->fetchArray(), $first);
+		$result->setFetchMode(Phalcon\Db::FETCH_NUM);
+		$result->dataSeek(3);
+		$this->assertEquals($result->fetchArray(), array_values($fourth));
+		$this->assertEquals($result->numRows(), 5);
+		$this->assertTrue($result->getInternalResult() instanceof PDOStatement);
+
+		$result = $connection->query("SELECT * FROM personas LIMIT 5");
+		$result->setFetchMode(Phalcon\Db::FETCH_ASSOC);
+		$this->assertEquals($result->numRows(), 5);
+		$result->dataSeek(0);
+		$this->assertEquals($result->fetchArray(), $first);
+		$this->assertTrue($result->getInternalResult() instanceof PDOStatement);
+
 		$result = $connection->execute("DELETE FROM prueba");
 		$this->assertTrue($result);
 
@@ -113,6 +194,14 @@ class DbTest extends PHPUnit_Framework_TestCase
 			$this->assertTrue($success);
 		}
 
+		$this->assertNull($connection->getSqlTemplate('prueba-by-estado'));
+		$connection->setSqlTemplate('prueba-by-estado', 'SELECT COUNT(*) AS rowcount FROM prueba WHERE estado = ?');
+		$sql = $connection->getSqlTemplate('prueba-by-estado');
+		$this->assertEquals($sql, 'SELECT COUNT(*) AS rowcount FROM prueba WHERE estado = ?');
+
+		$row = $connection->fetchOne($sql, Phalcon\Db::FETCH_ASSOC, array('F'));
+		$this->assertEquals($row['rowcount'], 50);
+
 		$success = $connection->update('prueba', array("nombre", "estado"), array("LOL 1000", "X"), "estado='E'");
 		$this->assertTrue($success);
 
@@ -122,6 +211,23 @@ class DbTest extends PHPUnit_Framework_TestCase
 		$success = $connection->update('prueba', array("nombre"), array(new Phalcon\Db\RawValue('current_date')), "estado='X'");
 		$this->assertTrue($success);
 
+		//Only the updates with bound conditions keep their statement
+		$sqlTemplates = new ReflectionProperty('Phalcon\Db', '_sqlTemplates');
+		$sqlTemplates->setAccessible(true);
+		$numberTemplates = count($sqlTemplates->getValue($connection));
+
+		$success = $connection->update('prueba', array("nombre"), array("LOL 4000"), "estado='Y'");
+		$this->assertTrue($success);
+		$this->assertEquals(count($sqlTemplates->getValue($connection)), $numberTemplates);
+
+		$success = $connection->update('prueba', array("nombre"), array("LOL 5000"), "estado = ?", array('X'));
+		$this->assertTrue($success);
+		$this->assertEquals(count($sqlTemplates->getValue($connection)), $numberTemplates + 1);
+
+		$success = $connection->update('prueba', array("nombre"), array("LOL 6000"), "estado = ?", array('Y'));
+		$this->assertTrue($success);
+		$this->assertEquals(count($sqlTemplates->getValue($connection)), $numberTemplates + 1);
+
 		$connection->delete("prueba", "estado='X'");
 		$this->assertTrue($success);
 
@@ -129,6 +235,55 @@ class DbTest extends PHPUnit_Framework_TestCase
 		$this->assertTrue($success);
 		$this->assertEquals($connection->affectedRows(), 53);
 
+		$rows = array();
+		for ($i=0; $i<25; $i++) {
+			$rows[] = array("LOL ".$i, "M");
+		}
+		$rows[] = array(new Phalcon\Db\RawValue('current_date'), "M");
+		$success = $connection->insertMany('prueba', $rows, array('nombre', 'estado'), array('rows' => 10));
+		$this->assertTrue($success);
+
+		$row = $connection->fetchOne("SELECT COUNT(*) FROM prueba WHERE estado = 'M'", Phalcon\Db::FETCH_NUM);
+		$this->assertEquals($row[0], 26);
+
+		$success = $connection->delete("prueba", "estado='M'");
+		$this->assertTrue($success);
+		$this->assertEquals($connection->affectedRows(), 26);
+
+		//Upserts
+		$success = $connection->upsert('prueba', array(90001, 'UPSERT', 'U'), array('id', 'nombre', 'estado'), array('id'));
+		$this->assertTrue($success);
+
+		$success = $connection->upsert('prueba', array(90001, 'UPSERTED', 'V'), array('id', 'nombre', 'estado'), array('id'), array('nombre'));
+		$this->assertTrue($success);
+
+		$row = $connection->fetchOne("SELECT nombre, estado FROM prueba WHERE id = 90001", Phalcon\Db::FETCH_NUM);
+		$this->assertEquals($row, array('UPSERTED', 'U'));
+
+		$success = $connection->upsert('prueba', array(90001, 'IGNORED', 'V'), array('id', 'nombre', 'estado'), array('id'), array('estado'));
+		$this->assertTrue($success);
+
+		$row = $connection->fetchOne("SELECT nombre, estado FROM prueba WHERE id = 90001", Phalcon\Db::FETCH_NUM);
+		$this->assertEquals($row, array('UPSERTED', 'V'));
+
+		$success = $connection->delete("prueba", "id = 90001");
+		$this->assertTrue($success);
+		$this->assertEquals($connection->affectedRows(), 1);
+
+		//Chunks already sent are rolled back when a later one fails
+		$rows[] = array("LOL", "M", "X");
+		try {
+			$connection->insertMany('prueba', $rows, array('nombre', 'estado'), array('rows' => 10));
+			$this->assertTrue(false);
+		}
+		catch(Phalcon\Db\Exception $e){
+			$this->assertEquals($e->getMessage(), "Every row passed to insertMany must have the same number of values");
+		}
+		$this->assertFalse($connection->isUnderTransaction());
+
+		$row = $connection->fetchOne("SELECT COUNT(*) FROM prueba WHERE estado = 'M'", Phalcon\Db::FETCH_NUM);
+		$this->assertEquals($row[0], 0);
+
 		$row = $connection->fetchOne("SELECT * FROM personas");
 		$this->assertEquals(count($row), 22);
 
@@ -142,6 +297,29 @@ class DbTest extends PHPUnit_Framework_TestCase
 		$this->assertEquals(count($rows), 10);
 		$this->assertEquals(count($rows[0]), 11);
 
+		$result = $connection->query("SELECT * FROM personas WHERE estado = ?0 LIMIT 3", array(0 => 'A'));
+		$this->assertTrue(is_object($result));
+		$this->assertEquals($result->numRows(), 3);
+
+		$row = $connection->fetchOne("SELECT COUNT(*) AS rowcount FROM personas WHERE estado = :estado: AND estado <> ':estado:'", Phalcon\Db::FETCH_ASSOC, array('estado' => 'A'));
+		$this->assertTrue($row['rowcount'] > 0);
+
+		$first = $connection->fetchOne("SELECT COUNT(*) AS rowcount FROM personas WHERE estado = ?", Phalcon\Db::FETCH_ASSOC, array('A'));
+		$second = $connection->fetchOne("SELECT COUNT(*) AS rowcount FROM personas WHERE estado = ?", Phalcon\Db::FETCH_ASSOC, array('A'));
+		$this->assertEquals($first, $second);
+		$this->assertEquals($first, $row);
+
+		$rows = $connection->fetchAll("SELECT * FROM personas WHERE estado = ?1 AND cupo > ?0 LIMIT 10", Phalcon\Db::FETCH_ASSOC, array(0 => 0, 1 => 'A'), array(0 => Phalcon\Db\Column::BIND_PARAM_INT));
+		$this->assertEquals(count($rows), 10);
+
+		try {
+			$connection->query("SELECT * FROM personas WHERE estado = ?1", array(0 => 'A'));
+			$this->assertTrue(false);
+		}
+		catch(Phalcon\Db\Exception $e){
+			$this->assertTrue(true);
+		}
+
 	}
 
 }
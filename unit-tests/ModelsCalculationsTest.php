@@ -111,6 +111,10 @@ class ModelsCalculationsTest extends PHPUnit_Framework_TestCase
 		$group = Personnes::count(array("group" => "ciudad_id", "order" => "rowcount DESC"));
 		$this->assertEquals($group[0]->rowcount, 727);
 
+		$group = Personnes::count(array("group" => "ciudad_id", "order" => "rowcount DESC", "limit" => 3));
+		$this->assertEquals(3, count($group));
+		$this->assertEquals($group[0]->rowcount, 727);
+
 		//Summatory
 		$total = Personnes::sum(array("column" => "cupo"));
 		$this->assertEquals(995066020.00, $total);
@@ -186,6 +190,37 @@ class ModelsCalculationsTest extends PHPUnit_Framework_TestCase
 		$group = Personnes::minimum(array("column" => "ciudad_id", "group" => "estado", "order" => "minimum ASC"));
 		$this->assertEquals($group[0]->minimum, 20404);
 
+		//Several aggregates in one query
+		$totals = Personnes::aggregate(array('count' => '*', 'sum' => 'cupo', 'avg' => 'cupo'));
+		$this->assertEquals($totals['count'], 2180);
+		$this->assertEquals($totals['sum'], 995066020.00);
+		$this->assertEquals(456452.30, sprintf("%.2f", $totals['avg']));
+
+		$totals = Personnes::aggregate(array('maximum' => 'ciudad_id', 'minimum' => 'ciudad_id'), "estado='I'");
+		$this->assertEquals($totals['maximum'], 127591);
+		$this->assertEquals($totals['minimum'], 127591);
+
+		$group = Personnes::aggregate(array('total' => array('count', '*'), 'cupo' => array('sum', 'cupo')), array("group" => "estado", "order" => "estado"));
+		$this->assertEquals(2, count($group));
+		$this->assertEquals($group[0]['estado'], 'A');
+		$this->assertEquals($group[0]['total'], 2178);
+		$this->assertEquals($group[0]['cupo'], 994499000.00);
+		$this->assertEquals($group[1]['total'], 2);
+		$this->assertEquals($group[1]['cupo'], 567020.00);
+
+		$group = Personnes::aggregate(array('total' => array('count', '*')), array("group" => "estado", "order" => "total DESC", "limit" => 1));
+		$this->assertEquals(1, count($group));
+		$this->assertEquals($group[0]['estado'], 'A');
+		$this->assertEquals($group[0]['total'], 2178);
+
+		try {
+			Personnes::aggregate(array('median' => 'cupo'));
+			$this->assertTrue(false);
+		}
+		catch(Phalcon\Mvc\Model\Exception $e){
+			$this->assertEquals($e->getMessage(), "Unknown aggregate function 'median'");
+		}
+
 		spl_autoload_unregister(array($this, 'modelsAutoloader'));
 	}
 
@@ -145,6 +145,86 @@ class ModelsForeignKeysTest extends PHPUnit_Framework_TestCase
 
 		$this->assertEquals($part->getMessages(), $messages);
 
+		//Set based foreign keys
+		try {
+			RobotsParts::updateAll("robots_id = ?", array("robots_id" => 100), array(1), true);
+			$this->assertTrue(false);
+		}
+		catch(Phalcon\Mvc\Model\Exception $e){
+			$this->assertEquals($e->getMessage(), 'The robot code does not exist');
+		}
+
+		try {
+			Robots::deleteAll("id = ?", array($robot->id), true);
+			$this->assertTrue(false);
+		}
+		catch(Phalcon\Mvc\Model\Exception $e){
+			$this->assertEquals($e->getMessage(), 'Record is referenced by model RobotsParts');
+		}
+
+		//Verified references
+		$manager = $di->getShared('modelsManager');
+		$this->assertFalse($manager->isVerifiedReference('Robots', "id = '100'"));
+
+		$manager->addVerifiedReference('Robots', "id = '100'");
+		$this->assertTrue($manager->isVerifiedReference('robots', "id = '100'"));
+
+		$manager->clearVerifiedReferences('Robots');
+		$this->assertFalse($manager->isVerifiedReference('Robots', "id = '100'"));
+
+		//Lookups done by save are remembered
+		$robotPart = new RobotsParts();
+		$robotPart->robots_id = 2;
+		$robotPart->parts_id = 1;
+		$this->assertTrue($robotPart->save());
+		$this->assertTrue($manager->isVerifiedReference('Robots', "id = '2'"));
+		$this->assertTrue($manager->isVerifiedReference('Parts', "id = '1'"));
+
+		$robotPart = new RobotsParts();
+		$robotPart->robots_id = 2;
+		$robotPart->parts_id = 2;
+		$this->assertTrue($robotPart->save());
+
+		//Updating a referenced record forgets the lookups of its model
+		$robot = Robots::findFirst(2);
+		$year = $robot->year;
+		$robot->year = $year + 1;
+		$this->assertTrue($robot->save());
+		$this->assertFalse($manager->isVerifiedReference('Robots', "id = '2'"));
+		$this->assertTrue($manager->isVerifiedReference('Parts', "id = '1'"));
+
+		$robot->year = $year;
+		$this->assertTrue($robot->save());
+
+		//saveMany verifies the keys in batch, keyed by the values of the records
+		$manager->clearVerifiedReferences();
+
+		$robotsParts = array();
+		foreach (array('01', 2, 3) as $robotId) {
+			$robotPart = new RobotsParts();
+			$robotPart->robots_id = $robotId;
+			$robotPart->parts_id = 1;
+			$robotsParts[] = $robotPart;
+		}
+		$this->assertTrue(RobotsParts::saveMany($robotsParts));
+		$this->assertTrue($manager->isVerifiedReference('Robots', "id = '01'"));
+		$this->assertTrue($manager->isVerifiedReference('Robots', "id = '2'"));
+		$this->assertTrue($manager->isVerifiedReference('Robots', "id = '3'"));
+		$this->assertFalse($manager->isVerifiedReference('Robots', "id = '1'"));
+
+		$robotsParts = array();
+		foreach (array(3, 100) as $robotId) {
+			$robotPart = new RobotsParts();
+			$robotPart->robots_id = $robotId;
+			$robotPart->parts_id = 1;
+			$robotsParts[] = $robotPart;
+		}
+		$this->assertFalse(RobotsParts::saveMany($robotsParts));
+		$this->assertFalse($manager->isVerifiedReference('Robots', "id = '100'"));
+
+		$this->assertTrue(RobotsParts::deleteAll("id > 3"));
+		$this->assertEquals(RobotsParts::count(), 3);
+
 	}
 
 }
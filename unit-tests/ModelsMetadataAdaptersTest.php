@@ -156,6 +156,7 @@ class ModelsMetadataAdaptersTest extends PHPUnit_Framework_TestCase
 		}
 
 		apc_delete('$PMM$my-local-app');
+		apc_delete('$PMM$my-local-app$robots');
 
 		$di = $this->_getDI();
 
@@ -174,12 +175,115 @@ class ModelsMetadataAdaptersTest extends PHPUnit_Framework_TestCase
 
 		Robots::findFirst();
 
+		//Only the introspected table is written, under its own key
+		$this->assertEquals(apc_fetch('$PMM$my-local-app$robots'), $this->_data['robots']);
+		$this->assertFalse(apc_fetch('$PMM$my-local-app$robots$lock'));
+
 		$metaData->storeMetaData();
 
-		$this->assertEquals(apc_fetch('$PMM$my-local-app'), $this->_data);
+		$this->assertFalse(apc_fetch('$PMM$my-local-app'));
 
 		$this->assertFalse($metaData->isEmpty());
 
+		//A table locked by another process is read as soon as it's stored
+		$metaData = new Phalcon\Mvc\Model\Metadata\Apc(array(
+			'suffix' => 'my-local-app',
+			'lockTimeout' => 50
+		));
+
+		$this->assertTrue($metaData->lockEntry('robots'));
+		$this->assertFalse($metaData->lockEntry('robots'));
+		$this->assertEquals($metaData->getAttributes(new Robots()), $this->_data['robots'][0]);
+		$metaData->unlockEntry('robots');
+		$this->assertTrue($metaData->lockEntry('robots'));
+		$metaData->unlockEntry('robots');
+
+		//A lock that isn't released in time is waited for, then the table is introspected
+		apc_delete('$PMM$my-local-app$robots');
+
+		$metaData = new Phalcon\Mvc\Model\Metadata\Apc(array(
+			'suffix' => 'my-local-app',
+			'lockTimeout' => 50
+		));
+
+		$this->assertTrue($metaData->lockEntry('robots'));
+
+		$start = microtime(true);
+		$this->assertEquals($metaData->getAttributes(new Robots()), $this->_data['robots'][0]);
+		$this->assertGreaterThanOrEqual(0.05, microtime(true) - $start);
+		$this->assertEquals(apc_fetch('$PMM$my-local-app$robots'), $this->_data['robots']);
+
+		$metaData->unlockEntry('robots');
+
+		//The lock is released when the introspection fails
+		$metaData = new Phalcon\Mvc\Model\Metadata\Apc(array(
+			'suffix' => 'my-local-app'
+		));
+
+		try {
+			$metaData->getAttributes(new Robotters());
+			$this->assertTrue(false);
+		}
+		catch(Phalcon\Mvc\Model\Exception $e){
+			$this->assertEquals($e->getMessage(), 'Table "robotters" doesn\'t exist on database when dumping meta-data for Robotters');
+		}
+
+		$this->assertFalse(apc_fetch('$PMM$my-local-app$robotters$lock'));
+		$this->assertTrue($metaData->lockEntry('robotters'));
+		$metaData->unlockEntry('robotters');
+
+	}
+
+	public function testMetadataCompiled()
+	{
+
+		$metaDataFile = 'unit-tests/cache/metadata.bin';
+		if (file_exists($metaDataFile)) {
+			unlink($metaDataFile);
+		}
+
+		$di = $this->_getDI();
+
+		$di->set('modelsMetadata', function() use ($metaDataFile) {
+			return new Phalcon\Mvc\Model\Metadata\Compiled(array(
+				'metaDataFile' => $metaDataFile
+			));
+		});
+
+		$metaData = $di->getShared('modelsMetadata');
+
+		$this->assertTrue($metaData->isEmpty());
+		$this->assertNull($metaData->readEntry('robots'));
+
+		Robots::findFirst();
+
+		//The first request compiles the file when it doesn't exist
+		$metaData->storeMetaData();
+		$this->assertTrue(file_exists($metaDataFile));
+		$this->assertEquals($metaData->readEntry('robots'), $this->_data['robots']);
+		$this->assertNull($metaData->readEntry('robot'));
+
+		//Tables already in the file are not rewritten by write()
+		$metaData->write(array('robots' => array()));
+		$this->assertEquals($metaData->readEntry('robots'), $this->_data['robots']);
+
+		//Tables missing in the file are merged into it
+		$metaData->write(array('robots' => array(), 'people' => array(0 => array('cedula'))));
+		$this->assertEquals($metaData->readEntry('people'), array(0 => array('cedula')));
+		$this->assertEquals($metaData->readEntry('robots'), $this->_data['robots']);
+
+		$metaData->compile(array('robots' => $this->_data['robots'], 'parts' => array(0 => array('id'))));
+		$this->assertEquals($metaData->readEntry('parts'), array(0 => array('id')));
+
+		//Another adapter reads the tables from the file without introspecting them
+		$compiled = new Phalcon\Mvc\Model\Metadata\Compiled(array(
+			'metaDataFile' => $metaDataFile
+		));
+		$this->assertEquals($compiled->getAttributes(new Robots()), $this->_data['robots'][0]);
+		$this->assertEquals($compiled->getIdentityField(new Robots()), 'id');
+
+		unlink($metaDataFile);
+
 	}
 
 }
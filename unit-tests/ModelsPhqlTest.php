@@ -0,0 +1,260 @@
+<?php
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+class ModelsPhqlTest extends PHPUnit_Framework_TestCase
+{
+
+	public function __construct()
+	{
+		spl_autoload_register(array($this, 'modelsAutoloader'));
+	}
+
+	public function __destruct()
+	{
+		spl_autoload_unregister(array($this, 'modelsAutoloader'));
+	}
+
+	public function modelsAutoloader($className)
+	{
+		if (file_exists('unit-tests/models/'.$className.'.php')) {
+			require 'unit-tests/models/'.$className.'.php';
+		}
+	}
+
+	protected function _getDI()
+	{
+
+		Phalcon\DI::reset();
+
+		$di = new Phalcon\DI();
+
+		$di->set('modelsManager', function(){
+			return new Phalcon\Mvc\Model\Manager();
+		});
+
+		$di->set('modelsMetadata', function(){
+			return new Phalcon\Mvc\Model\Metadata\Memory();
+		});
+
+		return $di;
+	}
+
+	public function testPhqlMysql()
+	{
+		$di = $this->_getDI();
+
+		$di->set('db', function(){
+			require 'unit-tests/config.db.php';
+			return new Phalcon\Db\Adapter\Pdo\Mysql($configMysql);
+		});
+
+		$this->_executeTests($di, '`', true);
+	}
+
+	public function testPhqlPostgresql()
+	{
+		$di = $this->_getDI();
+
+		$di->set('db', function(){
+			require 'unit-tests/config.db.php';
+			return new Phalcon\Db\Adapter\Pdo\Postgresql($configPostgresql);
+		});
+
+		$this->_executeTests($di, '"', false);
+	}
+
+	public function testPhqlPlansByDialect()
+	{
+		Phalcon\Mvc\Model\Query::clearCache();
+
+		$di = $this->_getDI();
+		$di->set('db', function(){
+			require 'unit-tests/config.db.php';
+			return new Phalcon\Db\Adapter\Pdo\Mysql($configMysql);
+		});
+
+		$query = new Phalcon\Mvc\Model\Query("SELECT r.name FROM Robots r WHERE r.type = 'mechanical'");
+		$query->setDI($di);
+		$this->assertEquals($query->getSql(), "SELECT `r`.`name` FROM `robots` AS `r` WHERE `r`.`type` = 'mechanical'");
+
+		//The same statement is compiled again for a connection with other dialect
+		$di = $this->_getDI();
+		$di->set('db', function(){
+			require 'unit-tests/config.db.php';
+			return new Phalcon\Db\Adapter\Pdo\Postgresql($configPostgresql);
+		});
+
+		$query = new Phalcon\Mvc\Model\Query("SELECT r.name FROM Robots r WHERE r.type = 'mechanical'");
+		$query->setDI($di);
+		$this->assertEquals($query->getSql(), 'SELECT "r"."name" FROM "robots" AS "r" WHERE "r"."type" = \'mechanical\'');
+	}
+
+	protected function _executeTests($di, $q, $limitsWrites)
+	{
+
+		Phalcon\Mvc\Model\Query::clearCache();
+
+		//Complete models
+		$query = new Phalcon\Mvc\Model\Query("SELECT * FROM Robots ORDER BY id");
+		$query->setDI($di);
+		$sql = "SELECT `Robots`.`id`, `Robots`.`name`, `Robots`.`type`, `Robots`.`year` FROM `robots` AS `Robots` ORDER BY `Robots`.`id`";
+		$this->assertEquals($query->getSql(), str_replace('`', $q, $sql));
+
+		$robots = $query->execute();
+		$this->assertEquals(count($robots), 3);
+		foreach ($robots as $number => $robot) {
+			$this->assertEquals(get_class($robot), 'Robots');
+			$this->assertEquals($robot->id, $number+1);
+		}
+
+		//Columns and placeholders
+		$query = new Phalcon\Mvc\Model\Query("SELECT r.id, r.name AS robot FROM Robots r WHERE r.id = ?0 OR r.type = :type:");
+		$query->setDI($di);
+		$sql = "SELECT `r`.`id`, `r`.`name` AS `robot` FROM `robots` AS `r` WHERE `r`.`id` = ?0 OR `r`.`type` = :type:";
+		$this->assertEquals($query->getSql(), str_replace('`', $q, $sql));
+
+		$rows = $query->execute(array(0 => 1, "type" => "cyborg"));
+		$this->assertEquals(count($rows), 2);
+		foreach ($rows as $row) {
+			$this->assertEquals(get_class($row), 'Phalcon\Mvc\Model\Row');
+			$this->assertTrue(isset($row->robot));
+		}
+
+		//Joins and aggregates
+		$query = new Phalcon\Mvc\Model\Query("SELECT r.name, COUNT(*) AS parts FROM Robots r JOIN RobotsParts ON RobotsParts.robots_id = r.id GROUP BY r.name");
+		$query->setDI($di);
+		$rows = $query->execute();
+		$this->assertEquals(count($rows), 1);
+		$this->assertEquals($rows->getFirst()->name, 'Robotina');
+		$this->assertEquals($rows->getFirst()->parts, 3);
+
+		//Columns with the same name in several models are not overwritten
+		$query = new Phalcon\Mvc\Model\Query("SELECT * FROM Robots r JOIN RobotsParts ON RobotsParts.robots_id = r.id ORDER BY RobotsParts.id");
+		$query->setDI($di);
+		$rows = $query->execute();
+		$this->assertEquals(count($rows), 3);
+		foreach ($rows as $number => $row) {
+			$this->assertEquals($row->{'r.id'}, 1);
+			$this->assertEquals($row->{'RobotsParts.id'}, $number+1);
+			$this->assertEquals($row->{'RobotsParts.robots_id'}, 1);
+		}
+
+		try {
+			$query = new Phalcon\Mvc\Model\Query("SELECT r.id, RobotsParts.id FROM Robots r JOIN RobotsParts ON RobotsParts.robots_id = r.id");
+			$query->setDI($di);
+			$query->execute();
+			$this->assertTrue(false);
+		}
+		catch(Phalcon\Mvc\Model\Exception $e){
+			$this->assertEquals($e->getMessage(), "The column 'id' is ambiguous in the select list, it must have an alias");
+		}
+
+		$query = new Phalcon\Mvc\Model\Query("SELECT r.id, RobotsParts.id AS part FROM Robots r JOIN RobotsParts ON RobotsParts.robots_id = r.id ORDER BY RobotsParts.id");
+		$query->setDI($di);
+		$rows = $query->execute();
+		$this->assertEquals($rows->getFirst()->id, 1);
+		$this->assertEquals($rows->getLast()->part, 3);
+
+		//The plans are reused by other instances
+		$query = new Phalcon\Mvc\Model\Query("SELECT * FROM Robots ORDER BY id");
+		$query->setDI($di);
+		$this->assertEquals(count($query->execute()), 3);
+
+		$query = new Phalcon\Mvc\Model\Query("SELECT * FROM Robots ORDER BY id LIMIT 2");
+		$query->setDI($di);
+		$this->assertEquals(count($query->execute()), 2);
+
+		//Literals are quoted again by the dialect
+		$query = new Phalcon\Mvc\Model\Query("INSERT INTO Robots (name, type, year) VALUES ('Astro\\'s Boy', 'mechanical', 1952)");
+		$query->setDI($di);
+		$sql = "INSERT INTO `robots` (`name`, `type`, `year`) VALUES ('Astro''s Boy', 'mechanical', 1952)";
+		$this->assertEquals($query->getSql(), str_replace('`', $q, $sql));
+		$this->assertTrue($query->execute());
+
+		$query = new Phalcon\Mvc\Model\Query("UPDATE Robots SET year = year + 1 WHERE name = :name:");
+		$query->setDI($di);
+		$this->assertTrue($query->execute(array("name" => "Astro's Boy")));
+
+		$query = new Phalcon\Mvc\Model\Query("SELECT r.name, r.year FROM Robots r WHERE r.id > 3");
+		$query->setDI($di);
+		$rows = $query->execute();
+		$this->assertEquals(count($rows), 1);
+		$this->assertEquals($rows->getFirst()->name, "Astro's Boy");
+		$this->assertEquals($rows->getFirst()->year, 1953);
+
+		$query = new Phalcon\Mvc\Model\Query("DELETE FROM Robots WHERE id > 3 LIMIT 1");
+		$query->setDI($di);
+		if ($limitsWrites) {
+			$this->assertTrue($query->execute());
+		} else {
+			try {
+				$query->execute();
+				$this->assertTrue(false);
+			}
+			catch(Phalcon\Mvc\Model\Exception $e){
+				$this->assertEquals($e->getMessage(), "PostgreSQL doesn't support LIMIT in UPDATE and DELETE statements");
+			}
+		}
+
+		$query = new Phalcon\Mvc\Model\Query("DELETE FROM Robots WHERE id > 3");
+		$query->setDI($di);
+		$this->assertTrue($query->execute());
+
+		$query = new Phalcon\Mvc\Model\Query("SELECT * FROM Robots");
+		$query->setDI($di);
+		$this->assertEquals(count($query->execute()), 3);
+
+		//Columns are checked against the meta-data
+		try {
+			$query = new Phalcon\Mvc\Model\Query("SELECT r.nonexistent FROM Robots r");
+			$query->setDI($di);
+			$query->execute();
+			$this->assertTrue(false);
+		}
+		catch(Phalcon\Mvc\Model\Exception $e){
+			$this->assertEquals($e->getMessage(), "Column 'nonexistent' doesn't belong to the model or alias 'r'");
+		}
+
+		//Syntax errors
+		try {
+			$query = new Phalcon\Mvc\Model\Query("SELECT FROM Robots");
+			$query->setDI($di);
+			$query->execute();
+			$this->assertTrue(false);
+		}
+		catch(Phalcon\Mvc\Model\Exception $e){
+			$this->assertTrue(true);
+		}
+
+		//Nodes already reduced are released when the statement is malformed
+		try {
+			Phalcon\Mvc\Model\Query\Lang::parseSQL("SELECT r.name, r.year FROM Robots r WHERE r.id > 3 AND ORDER BY r.name");
+			$this->assertTrue(false);
+		}
+		catch(Phalcon\Mvc\Model\Exception $e){
+			$this->assertTrue(true);
+		}
+
+		$ir = Phalcon\Mvc\Model\Query\Lang::parseSQL("SELECT r.name FROM Robots r WHERE r.id > 3");
+		$this->assertTrue(is_array($ir));
+
+	}
+
+}
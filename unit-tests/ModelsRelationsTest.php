@@ -130,6 +130,92 @@ class ModelsRelationsTest extends PHPUnit_Framework_TestCase
 		$part = $robotPart->getParts();
 		$this->assertEquals(get_class($part), 'Parts');
 
+		//Identity map
+		$this->assertNotSame(Robots::findFirst(1), Robots::findFirst(1));
+		$this->assertFalse($manager->getRecord('Robots', 1));
+
+		$manager->enableIdentityMap();
+
+		$robot = $robotPart->getRobots();
+		$this->assertSame($robot, $robotPart->getRobots());
+		$this->assertSame($robot, Robots::findFirst((int) $robotPart->robots_id));
+
+		$firstRobot = Robots::findFirst(1);
+		$this->assertSame($firstRobot, Robots::findFirst(1));
+		$this->assertSame($firstRobot, $manager->getRecord('Robots', 1));
+
+		//Records with unsaved changes are not shared
+		$firstRobot->name = 'Changed';
+		$this->assertFalse($manager->getRecord('Robots', 1));
+		$this->assertNotSame($firstRobot, Robots::findFirst(1));
+
+		//Writes executed by the connection clear the map
+		$firstRobot = Robots::findFirst(1);
+		$this->assertSame($firstRobot, $manager->getRecord('Robots', 1));
+		$firstRobot->getConnection()->execute('UPDATE robots SET year = year WHERE id = 1');
+		$this->assertFalse($manager->getRecord('Robots', 1));
+
+		$firstRobot = Robots::findFirst(1);
+		$this->assertSame($firstRobot, $manager->getRecord('Robots', 1));
+		$firstRobot->year = $firstRobot->year + 1;
+		$this->assertTrue($firstRobot->save());
+		$this->assertFalse($manager->getRecord('Robots', 1));
+		$firstRobot->year = $firstRobot->year - 1;
+		$this->assertTrue($firstRobot->save());
+
+		//The size of the map is bounded
+		$manager->enableIdentityMap(1);
+		$firstRobot = Robots::findFirst(1);
+		$secondRobot = Robots::findFirst(2);
+		$this->assertFalse($manager->getRecord('Robots', 1));
+		$this->assertSame($secondRobot, $manager->getRecord('Robots', 2));
+		$manager->enableIdentityMap(1024);
+
+		$firstRobot = Robots::findFirst(1);
+
+		$manager->removeRecord('Robots', 1);
+		$this->assertFalse($manager->getRecord('Robots', 1));
+		$this->assertNotSame($firstRobot, Robots::findFirst(1));
+
+		$manager->clearRecords();
+		$this->assertFalse($manager->getRecord('Robots', 1));
+
+		$manager->disableIdentityMap();
+		Robots::findFirst(1);
+		$this->assertFalse($manager->getRecord('Robots', 1));
+
+		//Eager loading
+		$robots = Robots::find(array('order' => 'id', 'with' => 'RobotsParts'));
+		$this->assertEquals(count($robots), count(Robots::find()));
+		foreach ($robots as $robot) {
+			$robotsParts = $robot->getRobotsParts();
+			$this->assertEquals(get_class($robotsParts), 'Phalcon\Mvc\Model\Resultset');
+			$this->assertEquals(count($robotsParts), $robot->countRobotsParts());
+			foreach ($robotsParts as $robotPart) {
+				$this->assertEquals($robotPart->robots_id, $robot->id);
+			}
+		}
+
+		$robotsParts = RobotsParts::find(array('with' => array('Robots', 'Parts')));
+		$this->assertEquals(count($robotsParts), count(RobotsParts::find()));
+		foreach ($robotsParts as $robotPart) {
+			$this->assertEquals(get_class($robotPart->getRobots()), 'Robots');
+			$this->assertEquals($robotPart->getRobots()->id, $robotPart->robots_id);
+			$this->assertEquals($robotPart->getParts()->id, $robotPart->parts_id);
+		}
+
+		$robotPart = RobotsParts::findFirst(array('with' => 'Parts'));
+		$this->assertEquals($robotPart->getParts()->id, $robotPart->parts_id);
+		$this->assertSame($robotPart->getParts(), $robotPart->getparts());
+
+		try {
+			Robots::find(array('with' => 'Unknown'));
+			$this->assertTrue(false);
+		}
+		catch(Phalcon\Mvc\Model\Exception $e){
+			$this->assertEquals($e->getMessage(), "There is no relation 'Unknown' defined on model 'Robots'");
+		}
+
 	}
 
 }
\ No newline at end of file
@@ -216,4 +216,92 @@ class ModelsResultsetCacheTest extends PHPUnit_Framework_TestCase
 		));
 	}
 
+	protected function _testCacheAggregate($di)
+	{
+
+		$frontCache = new Phalcon\Cache\Frontend\Data();
+		$cache = new Phalcon\Cache\Backend\File($frontCache, array(
+			'cacheDir' => 'unit-tests/cache/'
+		));
+
+		$params = array('cache' => $cache, 'conditions' => 'id > ?0', 'bind' => array(0));
+
+		$totals = Robots::aggregate(array('count' => '*', 'max' => 'id'), $params);
+		$this->assertEquals($totals['count'], 3);
+		$this->assertEquals($totals['max'], 3);
+		$this->assertEquals(count($cache->queryKeys()), 1);
+
+		$this->assertEquals(Robots::aggregate(array('count' => '*', 'max' => 'id'), $params), $totals);
+		$this->assertEquals(count($cache->queryKeys()), 1);
+
+		$totals = Robots::aggregate(array('count' => '*'), array('cache' => array('key' => 'robots-count', 'service' => 'otherCache')));
+		$this->assertEquals($totals['count'], 3);
+		$this->assertEquals($di->getShared('otherCache')->get('robots-count'), $totals);
+	}
+
+	public function testCacheEagerLoadMysql()
+	{
+		$di = $this->_prepareTestMysql();
+
+		$di->set('modelsCache', function(){
+			$frontCache = new Phalcon\Cache\Frontend\Data();
+			return new Phalcon\Cache\Backend\File($frontCache, array(
+				'cacheDir' => 'unit-tests/cache/'
+			));
+		});
+
+		$robots = Robots::find(array('cache' => 60, 'order' => 'id', 'with' => 'RobotsParts'));
+		$this->assertTrue($robots->isFresh());
+		$this->assertEquals(count($robots->getFirst()->getRobotsParts()), 3);
+
+		//The difference between two readings of the counter is the cost of reading it
+		$connection = $di->getShared('db');
+		$before = $this->_getSelects($connection);
+		$overhead = $this->_getSelects($connection) - $before;
+
+		$before = $this->_getSelects($connection);
+
+		//The records eager loaded are restored from the cache with the rows
+		$robots = Robots::find(array('cache' => 60, 'order' => 'id', 'with' => 'RobotsParts'));
+		$this->assertFalse($robots->isFresh());
+		$number = 0;
+		foreach ($robots as $robot) {
+			$this->assertEquals(count($robot->getRobotsParts()), $number ? 0 : 3);
+			$number++;
+		}
+		$this->assertEquals($number, 3);
+
+		$this->assertEquals($this->_getSelects($connection) - $before - $overhead, 0);
+	}
+
+	protected function _getSelects($connection)
+	{
+		$status = $connection->fetchOne("SHOW SESSION STATUS LIKE 'Com_select'", Phalcon\Db::FETCH_NUM);
+		return (int) $status[1];
+	}
+
+	public function testCacheAggregateMysql()
+	{
+		$di = $this->_prepareTestMysql();
+		$di->set('otherCache', function(){
+			$frontCache = new Phalcon\Cache\Frontend\Data();
+			return new Phalcon\Cache\Backend\File($frontCache, array(
+				'cacheDir' => 'unit-tests/cache/'
+			));
+		});
+		$this->_testCacheAggregate($di);
+	}
+
+	public function testCacheAggregatePostgresql()
+	{
+		$di = $this->_prepareTestPostgresql();
+		$di->set('otherCache', function(){
+			$frontCache = new Phalcon\Cache\Frontend\Data();
+			return new Phalcon\Cache\Backend\File($frontCache, array(
+				'cacheDir' => 'unit-tests/cache/'
+			));
+		});
+		$this->_testCacheAggregate($di);
+	}
+
 }
@@ -138,6 +138,155 @@ class ModelsResultsetTest extends PHPUnit_Framework_TestCase
 
 		$this->assertFalse(isset($robots[4]));
 
+		//Every row is hydrated into its own record
+		$first = $robots[0];
+		$second = $robots[1];
+		$this->assertNotSame($first, $second);
+		$this->assertEquals($first->id, 1);
+		$this->assertEquals($second->id, 2);
+		$this->assertEquals($first->name, 'Robotina');
+
+		$number = 0;
+		foreach (Robots::find(array('columns' => 'id, name', 'order' => 'id')) as $robot) {
+			$this->assertEquals($robot->id, $number+1);
+			$this->assertFalse(isset($robot->type));
+			$number++;
+		}
+		$this->assertEquals($number, 3);
+
+	}
+
+	public function testTraversalsExecuteOnceMysql()
+	{
+		$this->_prepareTestMysql();
+
+		$connection = Phalcon\DI::getDefault()->getShared('db');
+
+		//The meta-data is read before counting the queries
+		Robots::findFirst();
+
+		//The difference between two readings of the counter is the cost of reading it
+		$before = $this->_getSelects($connection);
+		$overhead = $this->_getSelects($connection) - $before;
+
+		$before = $this->_getSelects($connection);
+
+		$robots = Robots::find(array('order' => 'id'));
+		for ($i = 0; $i < 2; $i++) {
+			$number = 0;
+			foreach ($robots as $key => $robot) {
+				$this->assertEquals($key, $number);
+				$this->assertEquals($robot->id, $number+1);
+				$number++;
+			}
+			$this->assertEquals($number, 3);
+		}
+
+		$this->assertEquals($robots[1]->id, 2);
+		$this->assertEquals($robots->getFirst()->id, 1);
+		$this->assertEquals(count($robots->toArray()), 3);
+		$this->assertEquals(count($robots), 3);
+
+		//toArray doesn't consume the rows of the resultset
+		$robots = Robots::find(array('order' => 'id'));
+		$robots->rewind();
+		$this->assertTrue($robots->valid());
+		$this->assertEquals($robots->current()->id, 1);
+		$this->assertEquals(count($robots->toArray()), 3);
+		$robots->next();
+		$this->assertTrue($robots->valid());
+		$this->assertEquals($robots->current()->id, 2);
+
+		//A row is hydrated once, the same record is returned until the cursor moves
+		$robot = $robots->current();
+		$robot->name = 'Changed';
+		$this->assertSame($robots->current(), $robot);
+		$this->assertEquals($robots->current()->name, 'Changed');
+
+		$this->assertEquals($this->_getSelects($connection) - $before - $overhead, 2);
+	}
+
+	protected function _getSelects($connection)
+	{
+		$status = $connection->fetchOne("SHOW SESSION STATUS LIKE 'Com_select'", Phalcon\Db::FETCH_NUM);
+		return (int) $status[1];
+	}
+
+	public function testStreamMysql()
+	{
+		$this->_prepareTestMysql();
+
+		$this->_applyStreamTests();
+	}
+
+	public function testStreamPostgresql()
+	{
+		$this->_prepareTestPostgresql();
+
+		$this->_applyStreamTests();
+	}
+
+	protected function _applyStreamTests()
+	{
+
+		$number = 0;
+		foreach (Robots::find(array('order' => 'id', 'stream' => true)) as $robot) {
+			$this->assertEquals($robot->id, $number+1);
+			$number++;
+		}
+		$this->assertEquals($number, 3);
+
+		$robots = Robots::find(array('id > ?0', 'bind' => array(1), 'order' => 'id', 'stream' => true));
+		$robot = $robots->getFirst();
+		$this->assertEquals($robot->id, 2);
+
+		try {
+			$robots->rewind();
+			$this->assertTrue(false);
+		}
+		catch(Phalcon\Db\Exception $e){
+			$this->assertTrue(true);
+		}
+
+		//The connection can be used again once the streamed resultset is released
+		unset($robots);
+		$this->assertEquals(Robots::count(), 3);
+
+		//Streamed resultsets can't be counted
+		$robots = Robots::find(array('order' => 'id', 'stream' => true));
+		try {
+			count($robots);
+			$this->assertTrue(false);
+		}
+		catch(Phalcon\Db\Exception $e){
+			$this->assertEquals($e->getMessage(), 'The number of rows is not available for unbuffered results');
+		}
+		unset($robots);
+
+	}
+
+	public function testStreamUnbufferedMysql()
+	{
+		$this->_prepareTestMysql();
+
+		//The rows are read from the server while iterating, the connection is busy until all of them are fetched
+		$personas = Personas::find(array('stream' => true));
+		$personas->rewind();
+		$this->assertTrue($personas->valid());
+		try {
+			Robots::count();
+			$this->assertTrue(false);
+		}
+		catch(Phalcon\Db\Exception $e){
+			$this->assertTrue(true);
+		}
+		unset($personas);
+
+		//Other queries keep buffering their rows
+		$robots = Robots::find(array('order' => 'id'));
+		$this->assertEquals(count($robots), 3);
+		$this->assertEquals(Robots::count(), 3);
+
 	}
 
 	public function testSerializeMysql()
@@ -170,4 +319,42 @@ class ModelsResultsetTest extends PHPUnit_Framework_TestCase
 
 	}
 
+	public function testToArrayMysql()
+	{
+		$this->_prepareTestMysql();
+
+		$this->_applyToArrayTests();
+	}
+
+	public function testToArrayPostgresql()
+	{
+		$this->_prepareTestPostgresql();
+
+		$this->_applyToArrayTests();
+	}
+
+	protected function _applyToArrayTests()
+	{
+
+		$rows = Robots::find(array('order' => 'id'))->toArray();
+		$this->assertEquals(count($rows), 3);
+		$this->assertTrue(is_array($rows[0]));
+		$this->assertEquals($rows[0]['id'], 1);
+		$this->assertEquals($rows[0]['name'], 'Robotina');
+		$this->assertEquals($rows[2]['type'], 'cyborg');
+
+		//Serialized resultsets keep the rows as arrays until they are accessed
+		$data = serialize(Robots::find(array('order' => 'id')));
+		$this->assertFalse(strpos($data, 'O:6:"Robots"'));
+
+		$robots = unserialize($data);
+		$this->assertEquals(get_class($robots->getSourceModel()), 'Robots');
+		$this->assertEquals($robots->toArray(), $rows);
+
+		$robot = $robots[1];
+		$this->assertEquals(get_class($robot), 'Robots');
+		$this->assertEquals($robot->name, 'Astro Boy');
+
+	}
+
 }
\ No newline at end of file
@@ -253,6 +253,42 @@ class ModelsTest extends PHPUnit_Framework_TestCase
 		$this->assertEquals($persona->nombres, 'LOST LOST');
 		$this->assertEquals($persona->estado, 'X');
 
+		//Snapshots
+		$this->assertTrue($persona->hasSnapshotData());
+		$this->assertFalse($persona->hasChanged());
+
+		$persona->nombres = 'LOST UPDATED';
+		$this->assertTrue($persona->hasChanged('nombres'));
+		$this->assertFalse($persona->hasChanged('estado'));
+		$this->assertEquals($persona->getChangedFields(), array('nombres'));
+
+		$this->assertTrue($persona->save());
+		$this->assertFalse($persona->hasChanged());
+		$this->assertTrue($persona->save());
+
+		$persona = Personas::findFirst(array("estado='X'"));
+		$this->assertEquals($persona->nombres, 'LOST UPDATED');
+
+		//A record whose primary key changed is not the row kept in its snapshot
+		$cedula = $persona->cedula;
+		$newCedula = 'CELL'.mt_rand(10000, 99999);
+		$persona->cedula = $newCedula;
+		$persona->nombres = 'LOST MOVED';
+		$this->assertTrue($persona->save());
+
+		$original = Personas::findFirst(array("cedula = '".$cedula."'"));
+		$this->assertEquals($original->nombres, 'LOST UPDATED');
+
+		$moved = Personas::findFirst(array("cedula = '".$newCedula."'"));
+		$this->assertNotEquals($moved, false);
+		$this->assertEquals($moved->nombres, 'LOST MOVED');
+
+		//Bulk updates
+		$this->assertTrue(Personas::updateAll("estado = ?", array("nombres" => "LOST BULK"), array("X")));
+
+		$persona = Personas::findFirst(array("estado='X'"));
+		$this->assertEquals($persona->nombres, 'LOST BULK');
+
 		//Grouping
 		$difEstados = People::count(array("distinct" => "estado"));
 		$this->assertEquals($difEstados, 3);
@@ -265,6 +301,37 @@ class ModelsTest extends PHPUnit_Framework_TestCase
 		$this->assertTrue($persona->delete());
 		$this->assertEquals($before-1, People::count());
 
+		//Upserts
+		Prueba::deleteAll("id = 90002");
+
+		$prueba = new Prueba();
+		$prueba->id = 90002;
+		$prueba->nombre = 'UPSERT';
+		$prueba->estado = 'U';
+		$this->assertTrue($prueba->upsert());
+		$this->assertFalse($prueba->hasChanged());
+
+		$prueba = Prueba::findFirst(90002);
+		$this->assertEquals($prueba->nombre, 'UPSERT');
+
+		$prueba->nombre = 'UPSERTED';
+		$this->assertTrue($prueba->upsert());
+
+		$prueba = Prueba::findFirst(90002);
+		$this->assertEquals($prueba->nombre, 'UPSERTED');
+		$this->assertEquals($prueba->estado, 'U');
+
+		$prueba = new Prueba();
+		$prueba->nombre = 'UPSERT NEW';
+		$prueba->estado = 'U';
+		$this->assertTrue($prueba->upsert());
+		$this->assertTrue($prueba->id > 0);
+
+		$inserted = Prueba::findFirst((int) $prueba->id);
+		$this->assertEquals($inserted->nombre, 'UPSERT NEW');
+
+		$this->assertTrue(Prueba::deleteAll("estado = 'U'"));
+
 		spl_autoload_unregister(array($this, 'modelsAutoloader'));
 	}
 
@@ -153,4 +153,179 @@ class RouterTest extends PHPUnit_Framework_TestCase
 
 	}
 
+	public function testRouterPrecedence()
+	{
+
+		$router = new Phalcon\Mvc\Router();
+
+		for ($i = 0; $i < 300; $i++) {
+			$router->add('/section'.$i.'/:action', array(
+				'controller' => 'section'.$i,
+				'action' => 1
+			));
+		}
+
+		$router->add('/products/:action', array(
+			'controller' => 'products',
+			'action' => 1
+		));
+
+		$router->add('/products/{id:[0-9]+}', array(
+			'controller' => 'products',
+			'action' => 'show'
+		));
+
+		$router->add('/products', array(
+			'controller' => 'products',
+			'action' => 'index'
+		));
+
+		$router->add('/{lang:[a-z]+}/products', array(
+			'controller' => 'products',
+			'action' => 'list'
+		));
+
+		$tests = array(
+			array(
+				'uri' => '/section0/edit',
+				'controller' => 'section0',
+				'action' => 'edit',
+				'params' => array()
+			),
+			array(
+				'uri' => '/section299/edit',
+				'controller' => 'section299',
+				'action' => 'edit',
+				'params' => array()
+			),
+			array(
+				'uri' => '/products/edit',
+				'controller' => 'products',
+				'action' => 'edit',
+				'params' => array()
+			),
+			array(
+				'uri' => '/products/100',
+				'controller' => 'products',
+				'action' => 'show',
+				'params' => array('id' => '100')
+			),
+			array(
+				'uri' => '/products',
+				'controller' => 'products',
+				'action' => 'index',
+				'params' => array()
+			),
+			array(
+				'uri' => '/es/products',
+				'controller' => 'products',
+				'action' => 'list',
+				'params' => array('lang' => 'es')
+			),
+			array(
+				'uri' => '/sections/edit',
+				'controller' => 'sections',
+				'action' => 'edit',
+				'params' => array()
+			),
+		);
+
+		foreach ($tests as $n => $test) {
+			$this->_runTest($router, $test);
+		}
+
+		//Routes added after handling a URI must be taken into account
+		$router->add('/section0/:action', array(
+			'controller' => 'overridden',
+			'action' => 1
+		));
+
+		$this->_runTest($router, array(
+			'uri' => '/section0/edit',
+			'controller' => 'overridden',
+			'action' => 'edit',
+			'params' => array()
+		));
+
+	}
+
+	public function testRouterPersistent()
+	{
+
+		$tests = array(
+			array(
+				'uri' => '/admin/posts/edit/100',
+				'controller' => 'posts',
+				'action' => 'edit',
+				'params' => array('id' => 100)
+			),
+			array(
+				'uri' => '/posts/1999/s/le-nice-title',
+				'controller' => 'posts',
+				'action' => 'show',
+				'params' => array('year' => '1999', 'title' => 'le-nice-title')
+			),
+			array(
+				'uri' => '/documentation/index',
+				'controller' => 'documentation',
+				'action' => 'index',
+				'params' => array()
+			)
+		);
+
+		//The second router reuses the routes compiled by the first one
+		for ($i = 0; $i < 2; $i++) {
+
+			$router = new Phalcon\Mvc\Router();
+			$router->setPersistentRoutes(true);
+
+			$router->add('/admin/:controller/:action/:int', array(
+				'controller' => 1,
+				'action' => 2,
+				'id' => 3
+			));
+
+			$router->add("/posts/{year:[0-9]+}/s/{title:[a-z\-]+}", "Posts::show");
+
+			foreach ($tests as $n => $test) {
+				$this->_runTest($router, $test);
+			}
+
+			$router->add("/posts/{year:[0-9]+}/s/{title:[a-z\-]+}", "Blog::show");
+
+			$this->_runTest($router, array(
+				'uri' => '/posts/1999/s/le-nice-title',
+				'controller' => 'blog',
+				'action' => 'show',
+				'params' => array('year' => '1999', 'title' => 'le-nice-title')
+			));
+		}
+
+	}
+
+	public function testRouterPersistentKeys()
+	{
+
+		//Definitions that only differ in the type of a value don't share the compiled routes
+		$router = new Phalcon\Mvc\Router();
+		$router->setPersistentRoutes(true);
+		$router->add('/rates/([a-z]+)', array('controller' => 1.0, 'action' => 'index'));
+		$router->handle('/rates/monthly');
+		$this->assertEquals($router->getControllerName(), 'monthly');
+
+		$router = new Phalcon\Mvc\Router();
+		$router->setPersistentRoutes(true);
+		$router->add('/rates/([a-z]+)', array('controller' => null, 'action' => 'index'));
+		$router->handle('/rates/monthly');
+		$this->assertEquals($router->getControllerName(), null);
+
+		//Definitions with objects are compiled without the cache
+		$router = new Phalcon\Mvc\Router();
+		$router->setPersistentRoutes(true);
+		$router->add('/rates/([a-z]+)', array('controller' => 1, 'action' => 'index', 'handler' => new stdClass()));
+		$router->handle('/rates/monthly');
+		$this->assertEquals($router->getControllerName(), 'monthly');
+
+	}
+
 }
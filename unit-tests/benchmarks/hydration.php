@@ -0,0 +1,82 @@
+<?php
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+/**
+ * Compares the native hydration of Phalcon\Mvc\Model\Resultset with hydrating every row through
+ * Phalcon\Mvc\Model::dumpResult, using the robots and parts tables
+ *
+ *   php unit-tests/benchmarks/hydration.php
+ */
+
+require 'unit-tests/config.db.php';
+
+spl_autoload_register(function($className){
+	if (file_exists('unit-tests/models/'.$className.'.php')) {
+		require 'unit-tests/models/'.$className.'.php';
+	}
+});
+
+$di = new Phalcon\DI();
+
+$di->set('modelsManager', function(){
+	return new Phalcon\Mvc\Model\Manager();
+});
+
+$di->set('modelsMetadata', function(){
+	return new Phalcon\Mvc\Model\Metadata\Memory();
+});
+
+$di->set('db', function() use ($configMysql) {
+	return new Phalcon\Db\Adapter\Pdo\Mysql($configMysql);
+});
+
+$iterations = 500;
+
+foreach (array('Robots', 'Parts') as $modelName) {
+
+	$start = microtime(true);
+	$rows = 0;
+	for ($i = 0; $i < $iterations; $i++) {
+		foreach ($modelName::find() as $record) {
+			$rows++;
+		}
+	}
+	$elapsed = microtime(true) - $start;
+
+	echo sprintf("%s resultset, %d rows: %.2f us/row", $modelName, $rows, $elapsed / $rows * 1000000), PHP_EOL;
+
+	$model = new $modelName();
+	$source = $model->getSource();
+	$connection = $di->getShared('db');
+
+	$start = microtime(true);
+	$rows = 0;
+	for ($i = 0; $i < $iterations; $i++) {
+		$result = $connection->query('SELECT * FROM '.$source);
+		$result->setFetchMode(Phalcon\Db::FETCH_ASSOC);
+		while ($row = $result->fetchArray()) {
+			$record = Phalcon\Mvc\Model::dumpResult($model, $row);
+			$rows++;
+		}
+	}
+	$elapsed = microtime(true) - $start;
+
+	echo sprintf("%s dumpResult, %d rows: %.2f us/row", $modelName, $rows, $elapsed / $rows * 1000000), PHP_EOL;
+}
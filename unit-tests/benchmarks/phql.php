@@ -0,0 +1,78 @@
+<?php
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+/**
+ * Measures the throughput of the PHQL parser, Phalcon\Mvc\Model\Query\Lang::parseSQL, over a
+ * set of statements like the ones issued by applications. Statements with long lists show
+ * how the cost grows with the number of items
+ *
+ *   php unit-tests/benchmarks/phql.php
+ */
+
+$iterations = 20000;
+
+$corpus = array(
+	'SELECT * FROM Robots',
+	'SELECT r.* FROM Robots r WHERE r.id = ?0',
+	'SELECT r.id, r.name, r.type FROM Robots r WHERE r.type = :type: AND r.year > 1950 ORDER BY r.name LIMIT 10',
+	'SELECT r.name, COUNT(*) AS parts FROM Robots r JOIN RobotsParts ON RobotsParts.robots_id = r.id GROUP BY r.name HAVING COUNT(*) > 1',
+	'SELECT p.name FROM Parts p LEFT JOIN RobotsParts ON RobotsParts.parts_id = p.id WHERE RobotsParts.id IS NULL',
+	'SELECT r.name FROM Robots r WHERE r.name LIKE :name: OR (r.year < 1970 AND NOT r.type = \'cyborg\')',
+	'SELECT r.id FROM Robots r WHERE r.id IN (1, 2, 3, 4, 5) ORDER BY 1',
+	'INSERT INTO Robots (name, type, year) VALUES (:name:, :type:, :year:)',
+	'UPDATE Robots SET name = :name:, year = year + 1 WHERE id = ?0',
+	'DELETE FROM Robots WHERE id = ?0 LIMIT 1',
+);
+
+echo 'Corpus', PHP_EOL;
+
+$total = 0;
+foreach ($corpus as $phql) {
+
+	Phalcon\Mvc\Model\Query\Lang::parseSQL($phql);
+
+	$start = microtime(true);
+	for ($i = 0; $i < $iterations; $i++) {
+		Phalcon\Mvc\Model\Query\Lang::parseSQL($phql);
+	}
+	$elapsed = microtime(true) - $start;
+	$total += $elapsed;
+
+	echo sprintf("%8.2f us/parse  %s", $elapsed / $iterations * 1000000, $phql), PHP_EOL;
+}
+
+echo sprintf("%8.2f us/parse  average", $total / ($iterations * count($corpus)) * 1000000), PHP_EOL, PHP_EOL;
+
+echo 'Lists', PHP_EOL;
+
+foreach (array(10, 100, 1000) as $numberItems) {
+
+	$phql = 'SELECT r.id FROM Robots r WHERE r.id IN ('.join(', ', range(1, $numberItems)).')';
+
+	$listIterations = (int) ($iterations / $numberItems * 10);
+
+	$start = microtime(true);
+	for ($i = 0; $i < $listIterations; $i++) {
+		Phalcon\Mvc\Model\Query\Lang::parseSQL($phql);
+	}
+	$elapsed = microtime(true) - $start;
+
+	echo sprintf("%5d items: %.2f us/parse, %.3f us/item", $numberItems, $elapsed / $listIterations * 1000000, $elapsed / $listIterations / $numberItems * 1000000), PHP_EOL;
+}
@@ -0,0 +1,60 @@
+<?php
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+/**
+ * Measures the iteration of Phalcon\Mvc\Model\Resultset over the test database
+ *
+ *   php unit-tests/benchmarks/resultset.php
+ */
+
+require 'unit-tests/config.db.php';
+
+spl_autoload_register(function($className){
+	if (file_exists('unit-tests/models/'.$className.'.php')) {
+		require 'unit-tests/models/'.$className.'.php';
+	}
+});
+
+$di = new Phalcon\DI();
+
+$di->set('modelsManager', function(){
+	return new Phalcon\Mvc\Model\Manager();
+});
+
+$di->set('modelsMetadata', function(){
+	return new Phalcon\Mvc\Model\Metadata\Memory();
+});
+
+$di->set('db', function() use ($configMysql) {
+	return new Phalcon\Db\Adapter\Pdo\Mysql($configMysql);
+});
+
+$iterations = 100;
+
+$start = microtime(true);
+$rows = 0;
+for ($i = 0; $i < $iterations; $i++) {
+	foreach (People::find(array('limit' => 1000)) as $people) {
+		$rows++;
+	}
+}
+$elapsed = microtime(true) - $start;
+
+echo sprintf("%d rows: %.2f us/row", $rows, $elapsed / $rows * 1000000), PHP_EOL;
@@ -0,0 +1,56 @@
+<?php
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+/**
+ * Measures Phalcon\Mvc\Router::handle with an increasing number of routes. The matched
+ * route is the first one added, which is the worst case for a linear scan
+ *
+ *   php unit-tests/benchmarks/router.php
+ */
+
+$iterations = 10000;
+
+foreach (array(10, 100, 1000) as $numberRoutes) {
+
+	$router = new Phalcon\Mvc\Router();
+
+	$router->add('/target/:action/:int', array(
+		'controller' => 'target',
+		'action' => 1,
+		'id' => 2
+	));
+
+	for ($i = 0; $i < $numberRoutes; $i++) {
+		$router->add('/resource'.$i.'/{id:[0-9]+}/:action', array(
+			'controller' => 'resource'.$i,
+			'action' => 2
+		));
+	}
+
+	$router->handle('/target/edit/10');
+
+	$start = microtime(true);
+	for ($i = 0; $i < $iterations; $i++) {
+		$router->handle('/target/edit/10');
+	}
+	$elapsed = microtime(true) - $start;
+
+	echo sprintf("%5d routes: %.2f us/lookup", $numberRoutes, $elapsed / $iterations * 1000000), PHP_EOL;
+}
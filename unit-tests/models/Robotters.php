@@ -0,0 +1,11 @@
+<?php
+
+class Robotters extends Phalcon\Mvc\Model
+{
+
+	public function getSource()
+	{
+		return 'robotters';
+	}
+
+}